@@ -0,0 +1,182 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include "googletest/include/gtest/gtest.h"
+#include "nanobench.h"
+#include "sus/cmp/ord.h"
+#include "sus/iter/iterator.h"
+#include "sus/iter/zip.h"
+#include "sus/prelude.h"
+
+using sus::iter::zip;
+
+// Compares folding over iterator adaptors with the equivalent hand-written
+// loops. The adaptors fold over their inner iterators with the inner
+// iterators' own `fold()`, so these should be close to the loops.
+
+namespace {
+// The items are small so that their sums do not overflow, and are primitive
+// so that the loops are free to vectorize.
+static sus::Vec<uint32_t> generate_data(usize sz) {
+  sus::Vec<uint32_t> data;
+  data.reserve(sz);
+  for (u32 i; i < u32::try_from(sz).unwrap(); i += 1u) {
+    data.push(uint32_t{i % 16u});
+  }
+  return data;
+}
+
+constexpr auto add = [](uint32_t acc, const uint32_t& i) { return acc + i; };
+}  // namespace
+
+static void sum_chain(ankerl::nanobench::Bench& b, usize num_elements) {
+  auto x = generate_data(num_elements);
+  auto y = generate_data(num_elements);
+
+  b.run(fmt::format("loop, n = {}", num_elements), [&]() {
+    uint32_t sum = 0u;
+    for (uint32_t i : x) sum += i;
+    for (uint32_t i : y) sum += i;
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  b.run(fmt::format("chain fold, n = {}", num_elements), [&]() {
+    auto sum = x.iter().chain(y.iter()).fold(uint32_t{0u}, add);
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  b.run(fmt::format("chain next, n = {}", num_elements), [&]() {
+    uint32_t sum = 0u;
+    for (uint32_t i : x.iter().chain(y.iter())) sum += i;
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+}
+
+TEST(BenchIterFold, SumChain_1000) {
+  auto b = ankerl::nanobench::Bench();
+  sum_chain(b, 1'000u);
+}
+TEST(BenchIterFold, SumChain_100_000) {
+  auto b = ankerl::nanobench::Bench();
+  sum_chain(b, 100'000u);
+}
+
+static void sum_flat_map(ankerl::nanobench::Bench& b, usize num_elements) {
+  // Split the items into rows of 64.
+  auto rows = sus::Vec<sus::Vec<uint32_t>>();
+  for (usize i; i < num_elements; i += 64u)
+    rows.push(generate_data(::sus::cmp::min(64_usize, num_elements - i)));
+
+  b.run(fmt::format("loop, n = {}", num_elements), [&]() {
+    uint32_t sum = 0u;
+    for (const sus::Vec<uint32_t>& row : rows) {
+      for (uint32_t i : row) sum += i;
+    }
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  b.run(fmt::format("flat_map fold, n = {}", num_elements), [&]() {
+    auto sum = rows.iter()
+                   .flat_map([](const sus::Vec<uint32_t>& row) {
+                     return row.iter();
+                   })
+                   .fold(uint32_t{0u}, add);
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  b.run(fmt::format("flat_map next, n = {}", num_elements), [&]() {
+    uint32_t sum = 0u;
+    for (uint32_t i : rows.iter().flat_map(
+             [](const sus::Vec<uint32_t>& row) { return row.iter(); }))
+      sum += i;
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+}
+
+TEST(BenchIterFold, SumFlatMap_1000) {
+  auto b = ankerl::nanobench::Bench();
+  sum_flat_map(b, 1'000u);
+}
+TEST(BenchIterFold, SumFlatMap_100_000) {
+  auto b = ankerl::nanobench::Bench();
+  sum_flat_map(b, 100'000u);
+}
+
+static void dot_zip(ankerl::nanobench::Bench& b, usize num_elements) {
+  auto x = generate_data(num_elements);
+  auto y = generate_data(num_elements);
+
+  b.run(fmt::format("loop, n = {}", num_elements), [&]() {
+    uint32_t dot = 0u;
+    for (usize i; i < num_elements; i += 1u) dot += x[i] * y[i];
+    ankerl::nanobench::doNotOptimizeAway(dot);
+  });
+  b.run(fmt::format("zip fold, n = {}", num_elements), [&]() {
+    auto dot = zip(x.iter(), y.iter())
+                   .fold(uint32_t{0u}, [](uint32_t acc, auto pair) {
+                     auto [l, r] = pair;
+                     return acc + l * r;
+                   });
+    ankerl::nanobench::doNotOptimizeAway(dot);
+  });
+}
+
+TEST(BenchIterFold, DotZip_1000) {
+  auto b = ankerl::nanobench::Bench();
+  dot_zip(b, 1'000u);
+}
+TEST(BenchIterFold, DotZip_100_000) {
+  auto b = ankerl::nanobench::Bench();
+  dot_zip(b, 100'000u);
+}
+
+static void sum_skip_step_by(ankerl::nanobench::Bench& b,
+                             usize num_elements) {
+  auto x = generate_data(num_elements);
+
+  b.run(fmt::format("skip loop, n = {}", num_elements), [&]() {
+    uint32_t sum = 0u;
+    for (usize i = 3u; i < num_elements; i += 1u) sum += x[i];
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  b.run(fmt::format("skip fold, n = {}", num_elements), [&]() {
+    auto sum = x.iter().skip(3u).fold(uint32_t{0u}, add);
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  b.run(fmt::format("step_by loop, n = {}", num_elements), [&]() {
+    uint32_t sum = 0u;
+    for (usize i; i < num_elements; i += 4u) sum += x[i];
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  b.run(fmt::format("step_by fold, n = {}", num_elements), [&]() {
+    auto sum = x.iter().step_by(4u).fold(uint32_t{0u}, add);
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  b.run(fmt::format("chain count, n = {}", num_elements), [&]() {
+    auto count = x.iter().chain(x.iter()).count();
+    ankerl::nanobench::doNotOptimizeAway(count);
+  });
+  b.run(fmt::format("chain all, n = {}", num_elements), [&]() {
+    bool all = x.iter().chain(x.iter()).all(
+        [](const uint32_t& i) { return i < 16u; });
+    ankerl::nanobench::doNotOptimizeAway(all);
+  });
+}
+
+TEST(BenchIterFold, SumSkipStepBy_1000) {
+  auto b = ankerl::nanobench::Bench();
+  sum_skip_step_by(b, 1'000u);
+}
+TEST(BenchIterFold, SumSkipStepBy_100_000) {
+  auto b = ankerl::nanobench::Bench();
+  sum_skip_step_by(b, 100'000u);
+}
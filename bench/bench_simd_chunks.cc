@@ -19,6 +19,7 @@
 #include "sus/prelude.h"
 
 using sus::iter::zip;
+using sus::iter::__private::TrustedRandomAccess;
 
 // Benchmarks based on
 // https://matklad.github.io/2023/04/09/can-you-trust-a-compiler-to-optimize-your-code.html
@@ -65,6 +66,17 @@ auto common_prefix_naive(sus::Slice<u8> xs, sus::Slice<u8> ys)
   return result;
 }
 
+// Zipping slice iterators walks them by a single index up to the shorter
+// length, with no per-step check for the end of each one, so the zip loops
+// below can vectorize like the raw pointer loop.
+static_assert(TrustedRandomAccess<decltype(zip(sus::Slice<u8>().iter(),
+                                               sus::Slice<u8>().iter()))>);
+static_assert(
+    TrustedRandomAccess<decltype(zip(sus::Slice<u8>().chunks_exact(16u),
+                                     sus::Slice<u8>().chunks_exact(16u)))>);
+static_assert(TrustedRandomAccess<decltype(zip(sus::Slice<u8>(),
+                                               sus::Slice<u8>()))>);
+
 // This should be about the same as common_prefix_naive, it's just nicer
 // iterating.
 auto common_prefix_zip(sus::Slice<u8> xs, sus::Slice<u8> ys)
@@ -128,6 +140,32 @@ auto common_prefix_no_shortcircuit(sus::Slice<u8> xs,
   return result;
 }
 
+// Like `common_prefix_no_shortcircuit` but the chunks are arrays, so the
+// inner loop has a compile-time trip count and can be fully vectorized.
+auto common_prefix_as_chunks(sus::Slice<u8> xs, sus::Slice<u8> ys) -> usize {
+  constexpr auto chunk_size = size_t{16};
+  auto result = 0_usize;
+  auto [xs_chunks, xs_rem] = xs.as_chunks<chunk_size>();
+  auto [ys_chunks, ys_rem] = ys.as_chunks<chunk_size>();
+  for (auto [xs_chunk, ys_chunk] : zip(xs_chunks, ys_chunks)) {
+    bool chunk_equal = true;
+    for (size_t i = 0u; i < chunk_size; ++i) {
+      // NB: &, unlike &&, doesn't short-circuit.
+      chunk_equal = chunk_equal & (xs_chunk[i] == ys_chunk[i]);
+    }
+    if (!chunk_equal) {
+      break;
+    }
+    result += chunk_size;
+  }
+  for (auto [x, y] : zip(xs[sus::ops::range_from(result)],
+                         ys[sus::ops::range_from(result)])) {
+    if (x != y) break;
+    result += 1u;
+  }
+  return result;
+}
+
 auto common_prefix_take_while(sus::Slice<u8> xs,
                               sus::Slice<u8> ys) -> usize {
   constexpr auto chunk_size = 16_usize;
@@ -189,6 +227,13 @@ TEST(BenchSimdChunks, common_prefix) {
   });
   EXPECT_EQ(result, first_result);
 
+  b.run("common_prefix_as_chunks", [&]() {
+    auto r = common_prefix_as_chunks(v1, v2);
+    ankerl::nanobench::doNotOptimizeAway(r);
+    result = r;
+  });
+  EXPECT_EQ(result, first_result);
+
   b.run("common_prefix_take_while", [&]() {
     auto r = common_prefix_take_while(v1, v2);
     ankerl::nanobench::doNotOptimizeAway(r);
@@ -16,9 +16,13 @@
 // IWYU pragma: friend "sus/.*"
 #pragma once
 
+#include <concepts>
+
+#include "sus/choice/__private/nothing.h"
 #include "sus/choice/__private/type_list.h"
 #include "sus/cmp/eq.h"
 #include "sus/cmp/ord.h"
+#include "sus/hash/hash.h"
 
 namespace sus::choice_type::__private {
 
@@ -117,4 +121,19 @@ template <class TagType1, class Types1, class TagType2, class Types2>
 concept ChoiceIsAnyOrd =
     ChoiceIsAnyOrdHelper<TagType1, Types1, TagType2, Types2>::value;
 
+template <class Types>
+struct ChoiceIsHashHelper;
+
+template <class... Types>
+struct ChoiceIsHashHelper<TypeList<Types...>> {
+  // A tag without values is stored as `Nothing`, and has nothing to hash.
+  static constexpr bool value =
+      (... && (std::same_as<Types, Nothing> || ::sus::hash::Hash<Types>));
+};
+
+// Out of line from the requires clause, in a struct, to work around
+// https://gcc.gnu.org/bugzilla/show_bug.cgi?id=108067.
+template <class Types>
+concept ChoiceIsHash = ChoiceIsHashHelper<Types>::value;
+
 }  // namespace sus::choice_type::__private
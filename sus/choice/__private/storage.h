@@ -22,6 +22,7 @@
 
 #include "sus/choice/__private/nothing.h"
 #include "sus/choice/__private/pack_index.h"
+#include "sus/hash/hash.h"
 #include "sus/macros/no_unique_address.h"
 #include "sus/mem/move.h"
 #include "sus/tuple/tuple.h"
@@ -265,6 +266,14 @@ union Storage<I, ::sus::Tuple<Ts...>, Elements...> {
       return more_.partial_ord(index, other.more_);
     }
   }
+  template <::sus::hash::Hasher H>
+  inline constexpr void hash(size_t index, H& state) const& noexcept {
+    if (index == I) {
+      ::sus::hash::hash_into(tuple_, state);
+    } else {
+      more_.hash(index, state);
+    }
+  }
 
   constexpr auto as() const& {
     return [this]<size_t... Is>(std::index_sequence<Is...>) {
@@ -374,6 +383,10 @@ union Storage<I, Nothing, Elements...> {
       return more_.partial_ord(index, other.more_);
     }
   }
+  template <::sus::hash::Hasher H>
+  inline constexpr void hash(size_t index, H& state) const& noexcept {
+    if (index != I) more_.hash(index, state);
+  }
 
   [[_sus_no_unique_address]] Storage<I + 1, Elements...> more_;
 };
@@ -498,6 +511,14 @@ union Storage<I, ::sus::Tuple<T>, Elements...> {
       return more_.partial_ord(index, other.more_);
     }
   }
+  template <::sus::hash::Hasher H>
+  inline constexpr void hash(size_t index, H& state) const& noexcept {
+    if (index == I) {
+      ::sus::hash::hash_into(tuple_, state);
+    } else {
+      more_.hash(index, state);
+    }
+  }
 
   inline constexpr decltype(auto) as() const& {
     return tuple_.template at<0>();
@@ -589,6 +610,11 @@ union Storage<I, ::sus::Tuple<Ts...>> {
     sus_check(index == I);
     return std::partial_order(tuple_, other.tuple_);
   }
+  template <::sus::hash::Hasher H>
+  inline constexpr void hash(size_t index, H& state) const& noexcept {
+    sus_check(index == I);
+    ::sus::hash::hash_into(tuple_, state);
+  }
 
   constexpr auto as() const& {
     return [this]<size_t... Is>(std::index_sequence<Is...>) {
@@ -645,6 +671,10 @@ union Storage<I, Nothing> {
     sus_check(index == I);
     return std::partial_ordering::equivalent;
   }
+  template <::sus::hash::Hasher H>
+  inline constexpr void hash(size_t index, H&) const& noexcept {
+    sus_check(index == I);
+  }
 };
 
 template <size_t I, class T>
@@ -722,6 +752,11 @@ union Storage<I, ::sus::Tuple<T>> {
     sus_check(index == I);
     return std::partial_order(tuple_, other.tuple_);
   }
+  template <::sus::hash::Hasher H>
+  inline constexpr void hash(size_t index, H& state) const& noexcept {
+    sus_check(index == I);
+    ::sus::hash::hash_into(tuple_, state);
+  }
 
   inline constexpr decltype(auto) as() const& {
     return tuple_.template at<0>();
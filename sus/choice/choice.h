@@ -32,6 +32,7 @@
 #include "sus/choice/macros.h"
 #include "sus/cmp/eq.h"
 #include "sus/cmp/ord.h"
+#include "sus/hash/hash.h"
 #include "sus/lib/__private/forward_decl.h"
 #include "sus/macros/lifetimebound.h"
 #include "sus/macros/no_unique_address.h"
@@ -911,6 +912,18 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
       const Choice<__private::TypeList<RhsTs...>, RhsTag, RhsTags...>& r) =
       delete;
 
+  /// Feeds the active tag and the values stored with it into the `Hasher`.
+  ///
+  /// Satisfies the [`Hash`]($sus::hash::Hash) concept for `Choice` if the
+  /// types inside satisfy `Hash`.
+  template <::sus::hash::Hasher H>
+    requires(__private::ChoiceIsHash<__private::TypeList<Ts...>>)
+  constexpr void hash(H& state) const& noexcept {
+    sus_check(index_ != kUseAfterMove);
+    ::sus::hash::hash_into(index_, state);
+    storage_.hash(index_, state);
+  }
+
   // Stream support.
   _sus_format_to_stream(Choice);
 
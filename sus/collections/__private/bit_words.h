@@ -0,0 +1,143 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include "sus/assertions/debug_check.h"
+#include "sus/macros/pure.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+
+// Operations on arrays of 64-bit words that hold one bit per element, which
+// back BitVec and BitSet.
+//
+// Bit `i` is stored in word `i / 64` at position `i % 64`, counting from the
+// least significant bit. The bits in the last word past the end of the
+// bit array are always zero, so that whole words can be counted and compared
+// without masking them.
+//
+// The bulk operations are plain loops over whole words with no dependency
+// between iterations, which the compiler can vectorize.
+
+namespace sus::collections::__private {
+
+/// The number of bits held in each word.
+inline constexpr usize kBitsPerWord = 64u;
+
+/// Returns the number of words needed to hold `bits` bits.
+__sus_pure_const constexpr usize words_for_bits(usize bits) noexcept {
+  return bits / kBitsPerWord + (bits % kBitsPerWord != 0u ? 1u : 0u);
+}
+
+/// Returns the index of the word holding bit `bit`.
+__sus_pure_const constexpr usize word_index(usize bit) noexcept {
+  return bit / kBitsPerWord;
+}
+
+/// Returns a mask selecting bit `bit` in the word that holds it.
+__sus_pure_const constexpr u64 bit_mask(usize bit) noexcept {
+  return u64(1u) << (bit % kBitsPerWord);
+}
+
+/// Returns a mask of the bits in the last word which are part of an array of
+/// `bits` bits. The mask is all ones if the last word is full.
+__sus_pure_const constexpr u64 last_word_mask(usize bits) noexcept {
+  const usize used = bits % kBitsPerWord;
+  if (used == 0u) return u64::MAX;
+  return (u64(1u) << used) - 1u;
+}
+
+/// Returns the number of set bits in the `n` words.
+constexpr usize count_ones_words(const u64* words, usize n) noexcept {
+  usize count = 0u;
+  for (usize i = 0u; i < n; i += 1u)
+    count += usize::from(words[size_t{i}].count_ones());
+  return count;
+}
+
+/// Returns whether any bit in the `n` words is set.
+constexpr bool any_words(const u64* words, usize n) noexcept {
+  // Or-ing the words together has no early exit, but it lets the loop be
+  // vectorized.
+  u64 acc = 0u;
+  for (usize i = 0u; i < n; i += 1u) acc |= words[size_t{i}];
+  return acc != 0u;
+}
+
+/// Sets each of the `n` words in `dst` to `dst & src`.
+constexpr void and_words(u64* dst, const u64* src, usize n) noexcept {
+  for (usize i = 0u; i < n; i += 1u) dst[size_t{i}] &= src[size_t{i}];
+}
+
+/// Sets each of the `n` words in `dst` to `dst | src`.
+constexpr void or_words(u64* dst, const u64* src, usize n) noexcept {
+  for (usize i = 0u; i < n; i += 1u) dst[size_t{i}] |= src[size_t{i}];
+}
+
+/// Sets each of the `n` words in `dst` to `dst ^ src`.
+constexpr void xor_words(u64* dst, const u64* src, usize n) noexcept {
+  for (usize i = 0u; i < n; i += 1u) dst[size_t{i}] ^= src[size_t{i}];
+}
+
+/// Sets each of the `n` words in `dst` to `dst & !src`.
+constexpr void and_not_words(u64* dst, const u64* src, usize n) noexcept {
+  for (usize i = 0u; i < n; i += 1u) dst[size_t{i}] &= ~src[size_t{i}];
+}
+
+/// Inverts each bit in the `n` words of an array of `bits` bits, leaving the
+/// bits past the end of the array unset.
+constexpr void not_words(u64* words, usize n, usize bits) noexcept {
+  for (usize i = 0u; i < n; i += 1u) words[size_t{i}] = ~words[size_t{i}];
+  if (n > 0u) words[size_t{n - 1u}] &= last_word_mask(bits);
+}
+
+/// Returns the number of set bits before bit `bit`.
+constexpr usize rank_words(const u64* words, usize bit) noexcept {
+  const usize full = word_index(bit);
+  usize count = count_ones_words(words, full);
+  const usize rest = bit % kBitsPerWord;
+  if (rest != 0u) {
+    const u64 below = (u64(1u) << rest) - 1u;
+    count += usize::from((words[size_t{full}] & below).count_ones());
+  }
+  return count;
+}
+
+/// Returns the position of the set bit in `word` which has `k` set bits below
+/// it. The word must have more than `k` set bits.
+constexpr u32 select_in_word(u64 word, usize k) noexcept {
+  sus_debug_check(k < usize::from(word.count_ones()));
+  // Clear the lowest set bit `k` times.
+  for (; k > 0u; k -= 1u) word &= word - 1u;
+  return word.trailing_zeros();
+}
+
+/// Returns the position of the set bit which has `k` set bits before it, if
+/// there are more than `k` set bits in the `n` words.
+constexpr Option<usize> select_words(const u64* words, usize n,
+                                     usize k) noexcept {
+  for (usize i = 0u; i < n; i += 1u) {
+    const usize ones = usize::from(words[size_t{i}].count_ones());
+    if (k < ones) {
+      return Option<usize>(i * kBitsPerWord +
+                           usize::from(select_in_word(words[size_t{i}], k)));
+    }
+    k -= ones;
+  }
+  return Option<usize>();
+}
+
+}  // namespace sus::collections::__private
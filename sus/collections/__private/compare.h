@@ -0,0 +1,153 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+
+#include <compare>
+#include <type_traits>
+
+#include "sus/num/integer_concepts.h"
+
+// Comparison of the elements of two slices.
+//
+// When two elements are equal exactly when their bytes are equal, a range of
+// them is compared with memcmp(), which is vectorized by the C library. That
+// holds for integers, including the sus::num integer types, for enums that use
+// the built-in comparison operators, and for pointers to the same type. It
+// does not hold for floats, where `-0.0 == 0.0` and `NaN != NaN`, nor for
+// user-defined types in general: even without padding, their `operator==` may
+// not compare every byte.
+//
+// memcmp() orders the bytes as `unsigned char`, which is lexicographic order
+// for slices of unsigned bytes. For wider types, it finds the block holding
+// the first difference, and only that block is compared element by element.
+
+namespace sus::collections::__private {
+
+namespace compare {
+
+/// Enums with a user-declared `operator==` or `operator<=>`, which must be
+/// called instead of comparing bytes. Calling an operator with function-call
+/// syntax only finds declared functions, never the built-in operator.
+template <class E>
+concept UserComparedEnum =
+    std::is_enum_v<E> && (requires(const E& e) { operator==(e, e); } ||
+                          requires(const E& e) { operator<=>(e, e); });
+
+/// Types whose values are equal exactly when their object representations are.
+template <class T>
+concept Bitwise =
+    !std::is_volatile_v<T> &&
+    (std::is_integral_v<T> || (std::is_enum_v<T> && !UserComparedEnum<T>) ||
+     std::is_pointer_v<T> || ::sus::num::Integer<T>);
+
+/// Whether the values of `T` are compared as unsigned integers.
+template <class T>
+consteval bool is_unsigned_repr() noexcept {
+  if constexpr (::sus::num::Integer<T>)
+    return std::is_unsigned_v<decltype(T::primitive_value)>;
+  else if constexpr (std::is_enum_v<T>)
+    return std::is_unsigned_v<std::underlying_type_t<T>>;
+  else if constexpr (std::is_pointer_v<T>)
+    return true;
+  else
+    return std::is_unsigned_v<T>;
+}
+
+/// Types whose values are equal to each other exactly when their object
+/// representations are. Pointers are only compared to pointers to the same
+/// type, as converting between pointers to base and derived classes may
+/// change their address.
+template <class T, class U>
+concept BitwiseEq =
+    Bitwise<T> && Bitwise<U> && sizeof(T) == sizeof(U) &&
+    is_unsigned_repr<T>() == is_unsigned_repr<U>() &&
+    std::is_pointer_v<T> == std::is_pointer_v<U> &&
+    (!std::is_pointer_v<T> ||
+     std::same_as<std::remove_cv_t<std::remove_pointer_t<T>>,
+                  std::remove_cv_t<std::remove_pointer_t<U>>>);
+
+/// Types which are ordered by memcmp() of their object representations.
+template <class T, class U>
+concept BytewiseOrd = BitwiseEq<T, U> && !std::is_pointer_v<T> &&
+                      sizeof(T) == 1u && is_unsigned_repr<T>();
+
+/// The number of elements compared by each memcmp() while looking for the
+/// first difference between slices of `BitwiseEq` types.
+template <class T>
+inline constexpr size_t kBlockLen = 64u / sizeof(T) > 0u ? 64u / sizeof(T) : 1u;
+
+/// Returns the length of the prefix of [l, l + len) and [r, r + len) which is
+/// made of whole blocks that are equal.
+template <class T, class U>
+size_t equal_blocks_len(const T* l, const U* r, size_t len) noexcept {
+  size_t i = 0u;
+  while (len - i >= kBlockLen<T> &&
+         memcmp(l + i, r + i, kBlockLen<T> * sizeof(T)) == 0)
+    i += kBlockLen<T>;
+  return i;
+}
+
+}  // namespace compare
+
+/// Returns whether each of the `len` elements at `l` is equal to the element
+/// at the same position in `r`.
+template <class T, class U>
+constexpr bool slice_eq(const T* l, const U* r, size_t len) noexcept {
+  if constexpr (compare::BitwiseEq<T, U>) {
+    if (!std::is_constant_evaluated()) {
+      // memcmp() requires non-null pointers, even when comparing nothing.
+      return len == 0u || memcmp(l, r, len * sizeof(T)) == 0;
+    }
+  }
+  for (size_t i = 0u; i < len; ++i) {
+    if (!(l[i] == r[i])) return false;
+  }
+  return true;
+}
+
+/// Compares the `l_len` elements at `l` with the `r_len` elements at `r`
+/// lexicographically. The first pair of elements that are not equivalent
+/// determines the order, or if one slice is a prefix of the other, the
+/// shorter slice is ordered first.
+template <class Ordering, class T, class U>
+constexpr Ordering slice_cmp(const T* l, size_t l_len, const U* r,
+                             size_t r_len) noexcept {
+  const size_t len = l_len < r_len ? l_len : r_len;
+  size_t i = 0u;
+  if constexpr (compare::BitwiseEq<T, U>) {
+    if (!std::is_constant_evaluated() && len > 0u) {
+      if constexpr (compare::BytewiseOrd<T, U>) {
+        const int c = memcmp(l, r, len);
+        if (c < 0) return Ordering::less;
+        if (c > 0) return Ordering::greater;
+        return l_len <=> r_len;
+      } else {
+        i = compare::equal_blocks_len(l, r, len);
+      }
+    }
+  }
+  for (; i < len; ++i) {
+    const auto c = l[i] <=> r[i];
+    if (c != 0) return c;
+  }
+  return l_len <=> r_len;
+}
+
+}  // namespace sus::collections::__private
@@ -0,0 +1,382 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "sus/collections/__private/select.h"
+#include "sus/collections/__private/sort_stable.h"
+#include "sus/collections/__private/sort_unstable.h"
+#include "sus/collections/__private/thread_pool.h"
+#include "sus/mem/move.h"
+#include "sus/mem/swap.h"
+
+// Parallel sorting and selection on the shared `ThreadPool`.
+//
+// The unstable sort and selection are quicksort and quickselect where each
+// partition step is itself run in parallel: the range is split into chunks
+// that are partitioned independently, then the elements left on the wrong side
+// of the partition point are swapped across in parallel. Subranges are then
+// sorted in parallel by forking.
+//
+// The stable sort is a merge sort that sorts both halves in parallel, then
+// merges them in parallel by splitting the merge at the median of the longer
+// half.
+//
+// Small ranges fall back to the sequential algorithms, which also means that
+// the comparator is never called concurrently when there are no worker
+// threads. Otherwise, the comparator must be safe to call from multiple
+// threads at once.
+
+namespace sus::collections::__private {
+
+namespace par {
+
+/// Ranges at most this long are sorted sequentially.
+inline constexpr size_t kSequentialThreshold = 1u << 13u;
+/// Ranges shorter than this are partitioned sequentially.
+inline constexpr size_t kParallelPartitionThreshold = 1u << 16u;
+/// The smallest number of elements given to each thread when partitioning.
+inline constexpr size_t kMinPartitionChunk = 1u << 12u;
+/// The most chunks a range is split into when partitioning.
+inline constexpr size_t kMaxPartitionChunks = 64u;
+
+/// Reorders [begin, end) so that elements matching `pred` come first, and
+/// returns how many match.
+template <class T, class Pred>
+size_t partition_seq(T* begin, T* end, Pred& pred) noexcept {
+  T* first = begin;
+  T* last = end;
+  while (true) {
+    while (first != last && pred(*first)) ++first;
+    if (first == last) break;
+    do {
+      --last;
+    } while (first != last && !pred(*last));
+    if (first == last) break;
+    ::sus::mem::swap(*first, *last);
+    ++first;
+  }
+  return static_cast<size_t>(first - begin);
+}
+
+/// A range of positions holding elements on the wrong side of the partition.
+struct Misplaced {
+  size_t start;
+  size_t len;
+};
+
+/// Reorders the `len` elements at `data` so that elements matching `pred` come
+/// first, and returns how many match. The work is split across the pool.
+template <class T, class Pred>
+size_t partition(ThreadPool& pool, T* data, size_t len, Pred& pred) noexcept {
+  size_t chunks = pool.num_threads();
+  if (chunks > len / kMinPartitionChunk) chunks = len / kMinPartitionChunk;
+  if (chunks > kMaxPartitionChunks) chunks = kMaxPartitionChunks;
+  if (len < kParallelPartitionThreshold || chunks < 2u)
+    return partition_seq(data, data + len, pred);
+
+  auto chunk_start = [&](size_t i) { return len * i / chunks; };
+
+  // Partition each chunk on its own, recording where its non-matching
+  // elements start.
+  size_t splits[kMaxPartitionChunks];
+  auto partition_chunk = [&](size_t i) {
+    const size_t start = chunk_start(i);
+    splits[i] = start + partition_seq(data + start, data + chunk_start(i + 1u),
+                                      pred);
+  };
+  pool.for_each_index(chunks, partition_chunk);
+
+  size_t mid = 0u;
+  for (size_t i = 0u; i < chunks; ++i) mid += splits[i] - chunk_start(i);
+
+  // Non-matching elements before `mid` and matching elements after `mid` are
+  // misplaced, and there are the same number of each.
+  Misplaced left[kMaxPartitionChunks];
+  Misplaced right[kMaxPartitionChunks];
+  size_t num_left = 0u, num_right = 0u, total = 0u;
+  for (size_t i = 0u; i < chunks; ++i) {
+    const size_t start = chunk_start(i);
+    const size_t end = chunk_start(i + 1u);
+    // Non-matching elements in [splits[i], end) that are before `mid`.
+    if (splits[i] < mid) {
+      const size_t hi = end < mid ? end : mid;
+      if (hi > splits[i]) {
+        left[num_left++] = Misplaced{splits[i], hi - splits[i]};
+        total += hi - splits[i];
+      }
+    }
+    // Matching elements in [start, splits[i]) that are at or after `mid`.
+    if (splits[i] > mid) {
+      const size_t lo = start > mid ? start : mid;
+      if (splits[i] > lo) right[num_right++] = Misplaced{lo, splits[i] - lo};
+    }
+  }
+  if (total == 0u) return mid;
+
+  // Swap the k-th misplaced element on the left with the k-th on the right,
+  // with each thread taking a contiguous run of k.
+  auto swap_part = [&](size_t part) {
+    size_t k = total * part / chunks;
+    const size_t k_end = total * (part + 1u) / chunks;
+    if (k == k_end) return;
+    size_t li = 0u, lo = k;
+    while (lo >= left[li].len) lo -= left[li++].len;
+    size_t ri = 0u, ro = k;
+    while (ro >= right[ri].len) ro -= right[ri++].len;
+    for (; k < k_end; ++k) {
+      ::sus::mem::swap(data[left[li].start + lo], data[right[ri].start + ro]);
+      if (++lo == left[li].len) {
+        lo = 0u;
+        ++li;
+      }
+      if (++ro == right[ri].len) {
+        ro = 0u;
+        ++ri;
+      }
+    }
+  };
+  pool.for_each_index(chunks, swap_part);
+  return mid;
+}
+
+/// Moves a pivot to `data[0]` chosen as the median of 3, or the pseudomedian
+/// of 9 for long ranges.
+template <class T, class Less>
+void choose_pivot(T* data, size_t len, Less& less) noexcept {
+  const size_t s2 = len / 2u;
+  T* const end = data + len;
+  if (len > pdqsort::kNintherThreshold) {
+    pdqsort::sort3(data, data + s2, end - 1, less);
+    pdqsort::sort3(data + 1, data + (s2 - 1u), end - 2, less);
+    pdqsort::sort3(data + 2, data + (s2 + 1u), end - 3, less);
+    pdqsort::sort3(data + (s2 - 1u), data + s2, data + (s2 + 1u), less);
+    ::sus::mem::swap(*data, *(data + s2));
+  } else {
+    pdqsort::sort3(data + s2, data, end - 1, less);
+  }
+}
+
+/// The result of partitioning a range around a pivot: [0, less_len) is less
+/// than the pivot at `less_len`, [less_len, greater_start) is equal to the
+/// pivot, and [greater_start, len) is greater than or equal to it.
+struct PivotSplit {
+  size_t less_len;
+  size_t greater_start;
+};
+
+/// Partitions the `len` elements at `data` around a pivot, in parallel.
+template <class T, class Less>
+PivotSplit partition_around_pivot(ThreadPool& pool, T* data, size_t len,
+                                  Less& less) noexcept {
+  choose_pivot(data, len, less);
+  size_t l;
+  {
+    const T& pivot = data[0u];
+    auto is_less = [&](const T& t) { return less(t, pivot); };
+    l = partition(pool, data + 1u, len - 1u, is_less);
+  }
+  ::sus::mem::swap(data[0u], data[l]);
+  size_t greater_start = l + 1u;
+  if (l < len / 8u) {
+    // Few elements are less than the pivot, which happens when many elements
+    // are equal to it. Move those next to the pivot, where they are in their
+    // final position and need not be sorted any further.
+    const T& pivot = data[l];
+    auto not_greater = [&](const T& t) { return !less(pivot, t); };
+    greater_start +=
+        partition(pool, data + greater_start, len - greater_start, not_greater);
+  }
+  return PivotSplit{l, greater_start};
+}
+
+/// Whether a partition left too much of the range still to be processed,
+/// which indicates a bad pivot choice.
+constexpr bool is_unbalanced(size_t len, PivotSplit split) noexcept {
+  const size_t l = split.less_len;
+  const size_t r = len - split.greater_start;
+  return (l > r ? l : r) > len - len / 8u;
+}
+
+template <class T, class Less>
+void quicksort(ThreadPool& pool, T* data, size_t len, Less& less,
+               int bad_allowed) noexcept {
+  if (len <= kSequentialThreshold) {
+    sort_unstable(data, len, less);
+    return;
+  }
+  const PivotSplit split = partition_around_pivot(pool, data, len, less);
+  // Too many bad pivots, so use the sequential sort, which falls back to
+  // heapsort to guarantee O(n * log(n)).
+  if (is_unbalanced(len, split) && --bad_allowed == 0) {
+    sort_unstable(data, split.less_len, less);
+    sort_unstable(data + split.greater_start, len - split.greater_start, less);
+    return;
+  }
+  auto sort_left = [&]() {
+    quicksort(pool, data, split.less_len, less, bad_allowed);
+  };
+  auto sort_right = [&]() {
+    quicksort(pool, data + split.greater_start, len - split.greater_start,
+              less, bad_allowed);
+  };
+  pool.join(sort_left, sort_right);
+}
+
+/// Merges the sorted runs `a` and `b`, which are moved into the uninitialized
+/// memory at `out`. Equal elements from `a` are placed before those from `b`.
+template <class T, class Less>
+void merge_into(ThreadPool& pool, T* a, size_t a_len, T* b, size_t b_len,
+                T* out, Less& less) noexcept {
+  if (a_len + b_len <= kSequentialThreshold) {
+    T* const a_end = a + a_len;
+    T* const b_end = b + b_len;
+    while (a != a_end && b != b_end) {
+      if (less(*b, *a))
+        std::construct_at(out++, ::sus::move(*b++));
+      else
+        std::construct_at(out++, ::sus::move(*a++));
+    }
+    while (a != a_end) std::construct_at(out++, ::sus::move(*a++));
+    while (b != b_end) std::construct_at(out++, ::sus::move(*b++));
+    return;
+  }
+
+  // Split the longer run at its middle, and the other run where that middle
+  // element would be inserted, so that each pair of halves can be merged
+  // independently.
+  size_t a_mid, b_mid;
+  if (a_len >= b_len) {
+    a_mid = a_len / 2u;
+    b_mid = static_cast<size_t>(
+        mergesort::lower_bound(b, b + b_len, a[a_mid], less) - b);
+  } else {
+    b_mid = b_len / 2u;
+    a_mid = static_cast<size_t>(
+        mergesort::upper_bound(a, a + a_len, b[b_mid], less) - a);
+  }
+  auto merge_left = [&]() { merge_into(pool, a, a_mid, b, b_mid, out, less); };
+  auto merge_right = [&]() {
+    merge_into(pool, a + a_mid, a_len - a_mid, b + b_mid, b_len - b_mid,
+               out + a_mid + b_mid, less);
+  };
+  pool.join(merge_left, merge_right);
+}
+
+/// Moves the `len` elements at `from` back into `to`, destroying them in
+/// `from`.
+template <class T>
+void move_back(ThreadPool& pool, T* from, T* to, size_t len) noexcept {
+  const size_t chunks = (len + kSequentialThreshold - 1u) / kSequentialThreshold;
+  auto move_chunk = [&](size_t i) {
+    const size_t start = len * i / chunks;
+    const size_t end = len * (i + 1u) / chunks;
+    for (size_t j = start; j < end; ++j) {
+      to[j] = ::sus::move(from[j]);
+      std::destroy_at(from + j);
+    }
+  };
+  pool.for_each_index(chunks, move_chunk);
+}
+
+/// Stable sort of the `len` elements at `data`, using the uninitialized
+/// `scratch` memory of the same length for merging.
+template <class T, class Less>
+void merge_sort(ThreadPool& pool, T* data, T* scratch, size_t len,
+               Less& less) noexcept {
+  if (len <= kSequentialThreshold) {
+    sort_stable(data, len, less);
+    return;
+  }
+  const size_t mid = len / 2u;
+  auto sort_left = [&]() { merge_sort(pool, data, scratch, mid, less); };
+  auto sort_right = [&]() {
+    merge_sort(pool, data + mid, scratch + mid, len - mid, less);
+  };
+  pool.join(sort_left, sort_right);
+  // The halves are already in order.
+  if (!less(data[mid], data[mid - 1u])) return;
+  merge_into(pool, data, mid, data + mid, len - mid, scratch, less);
+  move_back(pool, scratch, data, len);
+}
+
+/// Quickselect with parallel partitioning, which narrows down the range
+/// containing `index` until it is small enough to handle sequentially.
+template <class T, class Less>
+void select_nth(ThreadPool& pool, T* data, size_t len, size_t index,
+                Less& less) noexcept {
+  int bad_allowed = pdqsort::log2(len);
+  while (len > kSequentialThreshold && pool.num_threads() > 1u) {
+    const PivotSplit split = partition_around_pivot(pool, data, len, less);
+    if (index >= split.less_len && index < split.greater_start) return;
+    if (is_unbalanced(len, split) && --bad_allowed == 0) break;
+    if (index < split.less_len) {
+      len = split.less_len;
+    } else {
+      data += split.greater_start;
+      index -= split.greater_start;
+      len -= split.greater_start;
+    }
+  }
+  select_nth_unstable(data, len, index, less);
+}
+
+}  // namespace par
+
+/// Sorts the `len` elements at `data` with `less(a, b)` returning whether `a`
+/// is strictly less than `b`, using the shared thread pool. Equal elements
+/// may be reordered.
+template <class T, class Less>
+void par_sort_unstable(T* data, size_t len, Less& less) noexcept {
+  ThreadPool& pool = ThreadPool::global();
+  if (len <= par::kSequentialThreshold || pool.num_threads() == 1u) {
+    sort_unstable(data, len, less);
+    return;
+  }
+  par::quicksort(pool, data, len, less, pdqsort::log2(len));
+}
+
+/// Sorts the `len` elements at `data` with `less(a, b)` returning whether `a`
+/// is strictly less than `b`, using the shared thread pool. Equal elements
+/// keep their relative order.
+template <class T, class Less>
+void par_sort_stable(T* data, size_t len, Less& less) noexcept {
+  ThreadPool& pool = ThreadPool::global();
+  if (len <= par::kSequentialThreshold || pool.num_threads() == 1u) {
+    sort_stable(data, len, less);
+    return;
+  }
+  std::allocator<T> alloc;
+  T* const scratch = alloc.allocate(len);
+  par::merge_sort(pool, data, scratch, len, less);
+  alloc.deallocate(scratch, len);
+}
+
+/// Reorders the `len` elements at `data` such that the element at `index` is
+/// the one that would be there if the elements were sorted, with elements that
+/// are not greater before it and elements that are not less after it. Uses the
+/// shared thread pool.
+template <class T, class Less>
+void par_select_nth_unstable(T* data, size_t len, size_t index,
+                             Less& less) noexcept {
+  par::select_nth(ThreadPool::global(), data, len, index, less);
+}
+
+}  // namespace sus::collections::__private
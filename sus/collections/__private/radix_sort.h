@@ -0,0 +1,273 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <type_traits>
+
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/marker/unsafe.h"
+#include "sus/mem/move.h"
+#include "sus/num/__private/intrinsics.h"
+#include "sus/num/float_concepts.h"
+#include "sus/num/integer_concepts.h"
+#include "sus/ptr/copy.h"
+
+// A least-significant-digit radix sort, which sorts by one byte of the key at a
+// time from lowest to highest, with a stable counting sort for each byte.
+//
+// Keys are mapped to unsigned integers whose natural order is the order of the
+// keys:
+// * Signed integers have their sign bit flipped.
+// * Floats are ordered by `total_cmp()`, which matches the order of their bits
+//   once negative values have all their bits flipped and positive values have
+//   their sign bit flipped.
+//
+// The sort is O(n * k) for keys of k bytes, and needs a scratch buffer as large
+// as the input. Passes where every key has the same byte are skipped, so small
+// values in a wide type are sorted with fewer passes.
+
+namespace sus::collections::__private {
+
+namespace radix {
+
+/// Slices shorter than this are not worth the histogram setup and the scratch
+/// allocation, and are sorted with a comparison sort instead.
+inline constexpr size_t kRadixSortThreshold = 256u;
+
+/// Maps a key type to an unsigned integer `Bits` type with the same ordering.
+template <class Key>
+struct KeyBits;
+
+template <class Key>
+  requires(::sus::num::Unsigned<Key>)
+struct KeyBits<Key> {
+  using Bits = decltype(Key::primitive_value);
+  static constexpr Bits to_bits(const Key& k) noexcept {
+    return k.primitive_value;
+  }
+};
+
+template <class Key>
+  requires(::sus::num::Signed<Key>)
+struct KeyBits<Key> {
+  using Bits = std::make_unsigned_t<decltype(Key::primitive_value)>;
+  static constexpr Bits to_bits(const Key& k) noexcept {
+    return static_cast<Bits>(k.primitive_value) ^
+           ::sus::num::__private::high_bit<Bits>();
+  }
+};
+
+template <class Key>
+  requires(::sus::num::PrimitiveInteger<Key> && !std::same_as<Key, bool>)
+struct KeyBits<Key> {
+  using Bits = std::make_unsigned_t<Key>;
+  static constexpr Bits to_bits(const Key& k) noexcept {
+    if constexpr (std::is_signed_v<Key>)
+      return static_cast<Bits>(k) ^ ::sus::num::__private::high_bit<Bits>();
+    else
+      return static_cast<Bits>(k);
+  }
+};
+
+template <class Key>
+  requires(::sus::num::Float<Key>)
+struct KeyBits<Key> {
+  using Bits = decltype(::sus::num::__private::into_unsigned_integer(
+      Key::primitive_value));
+  static constexpr Bits to_bits(const Key& k) noexcept {
+    const Bits bits =
+        ::sus::num::__private::into_unsigned_integer(k.primitive_value);
+    constexpr Bits high = ::sus::num::__private::high_bit<Bits>();
+    // Negative values are ordered in reverse of their magnitude.
+    return (bits & high) != 0u ? static_cast<Bits>(~bits)
+                               : static_cast<Bits>(bits | high);
+  }
+};
+
+/// Key types that can be sorted by a radix sort.
+template <class Key>
+concept RadixKey = requires(const Key& k) {
+  { KeyBits<Key>::to_bits(k) } -> std::unsigned_integral;
+};
+
+/// Element types that `sort_unstable()` sorts with a radix sort. Floats are
+/// excluded as they are not `Ord`, and are sorted with `sort_floats()` instead.
+template <class T>
+concept RadixSortable = RadixKey<T> && !::sus::num::Float<T>;
+
+/// Stable LSD radix sort of `len` trivially copyable elements at `data`, using
+/// `scratch` as a buffer of the same length. `to_bits(const T&)` returns the
+/// unsigned integer key of an element. Only the lowest `num_passes` bytes of
+/// the key are sorted on.
+template <class Bits, class T, class ToBits>
+void lsd_sort(T* data, T* scratch, size_t len, ToBits& to_bits,
+              size_t num_passes = sizeof(Bits)) noexcept {
+  static_assert(std::is_trivially_copyable_v<T>);
+  constexpr size_t kMaxPasses = sizeof(Bits);
+
+  // Build the histograms for every pass up front, in a single scan.
+  size_t counts[kMaxPasses][256u] = {};
+  for (size_t i = 0u; i < len; ++i) {
+    const Bits bits = to_bits(data[i]);
+    for (size_t p = 0u; p < num_passes; ++p)
+      counts[p][static_cast<uint8_t>(bits >> (8u * p))] += 1u;
+  }
+
+  T* src = data;
+  T* dst = scratch;
+  for (size_t p = 0u; p < num_passes; ++p) {
+    const size_t* const c = counts[p];
+    // If every key has the same byte in this position, the pass would not
+    // change the order.
+    if (c[static_cast<uint8_t>(to_bits(src[0u]) >> (8u * p))] == len) continue;
+
+    size_t offsets[256u];
+    size_t sum = 0u;
+    for (size_t d = 0u; d < 256u; ++d) {
+      offsets[d] = sum;
+      sum += c[d];
+    }
+    for (size_t i = 0u; i < len; ++i) {
+      const auto digit = static_cast<uint8_t>(to_bits(src[i]) >> (8u * p));
+      dst[offsets[digit]++] = src[i];
+    }
+    T* const tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+  if (src != data)
+    ::sus::ptr::copy_nonoverlapping(::sus::marker::unsafe_fn, src, data, len);
+}
+
+/// Slices of keys wider than two bytes with at least this many elements are
+/// first split into buckets on their highest byte, so that each bucket is small
+/// enough to be sorted on the remaining bytes while it is in cache.
+inline constexpr size_t kMsdSplitThreshold = 1u << 16u;
+
+/// Stable radix sort of `len` trivially copyable elements at `data`, using
+/// `scratch` as a buffer of the same length.
+template <class Bits, class T, class ToBits>
+void sort(T* data, T* scratch, size_t len, ToBits& to_bits) noexcept {
+  constexpr size_t kPasses = sizeof(Bits);
+  if (kPasses <= 2u || len < kMsdSplitThreshold) {
+    lsd_sort<Bits>(data, scratch, len, to_bits);
+    return;
+  }
+
+  // Scatter into `scratch` by the highest byte.
+  constexpr size_t kShift = 8u * (kPasses - 1u);
+  size_t counts[256u] = {};
+  for (size_t i = 0u; i < len; ++i)
+    counts[static_cast<uint8_t>(to_bits(data[i]) >> kShift)] += 1u;
+  size_t offsets[256u];
+  size_t sum = 0u;
+  for (size_t d = 0u; d < 256u; ++d) {
+    offsets[d] = sum;
+    sum += counts[d];
+  }
+  for (size_t i = 0u; i < len; ++i)
+    scratch[offsets[static_cast<uint8_t>(to_bits(data[i]) >> kShift)]++] =
+        data[i];
+
+  // Sort each bucket on the remaining bytes, leaving the result in `scratch`.
+  size_t start = 0u;
+  for (size_t d = 0u; d < 256u; ++d) {
+    if (counts[d] > 1u) {
+      lsd_sort<Bits>(scratch + start, data + start, counts[d], to_bits,
+                     kPasses - 1u);
+    }
+    start += counts[d];
+  }
+  ::sus::ptr::copy_nonoverlapping(::sus::marker::unsafe_fn, scratch, data,
+                                  len);
+}
+
+/// Reorders the `len` elements at `data` such that the element at position
+/// `index_at(i)` moves to position `i`, where `index_at(i)` returns a mutable
+/// reference to the index. The indices are overwritten, as each position is
+/// marked done by pointing it at itself.
+template <class T, class IndexAt>
+void apply_permutation(T* data, size_t len, IndexAt& index_at) noexcept {
+  using Index = std::remove_cvref_t<decltype(index_at(size_t{0u}))>;
+  for (size_t i = 0u; i < len; ++i) {
+    if (index_at(i) == i) continue;
+    // Walk the cycle that starts at `i`, pulling each element into the hole
+    // left by the one before it.
+    T tmp = ::sus::move(data[i]);
+    size_t j = i;
+    while (true) {
+      const size_t k = index_at(j);
+      index_at(j) = static_cast<Index>(j);
+      if (k == i) {
+        data[j] = ::sus::move(tmp);
+        break;
+      }
+      data[j] = ::sus::move(data[k]);
+      j = k;
+    }
+  }
+}
+
+template <class Bits, class Index = size_t>
+struct KeyIndex {
+  Bits key;
+  Index index;
+};
+
+}  // namespace radix
+
+/// Sorts the `len` elements at `data` by their value with a radix sort.
+template <class T>
+  requires(radix::RadixKey<T> && std::is_trivially_copyable_v<T>)
+void radix_sort(T* data, size_t len) noexcept {
+  if (len < 2u) return;
+  using Bits = typename radix::KeyBits<T>::Bits;
+  auto to_bits = [](const T& t) { return radix::KeyBits<T>::to_bits(t); };
+  std::allocator<T> alloc;
+  T* const scratch = alloc.allocate(len);
+  radix::sort<Bits>(data, scratch, len, to_bits);
+  alloc.deallocate(scratch, len);
+}
+
+/// Sorts the `len` elements at `data` by the key returned from `key_fn`, with a
+/// radix sort. The key function is called once per element. Equal keys keep
+/// their relative order.
+template <class Key, class T, class KeyFn>
+  requires(radix::RadixKey<Key>)
+void radix_sort_by_key(T* data, size_t len, KeyFn& key_fn) noexcept {
+  if (len < 2u) return;
+  using Bits = typename radix::KeyBits<Key>::Bits;
+  using KeyIndex = radix::KeyIndex<Bits>;
+
+  std::allocator<KeyIndex> alloc;
+  KeyIndex* const keys = alloc.allocate(2u * len);
+  for (size_t i = 0u; i < len; ++i) {
+    keys[i] = KeyIndex{radix::KeyBits<Key>::to_bits(key_fn(data[i])), i};
+  }
+  auto to_bits = [](const KeyIndex& k) { return k.key; };
+  radix::sort<Bits>(keys, keys + len, len, to_bits);
+
+  auto index_at = [keys](size_t i) -> size_t& { return keys[i].index; };
+  radix::apply_permutation(data, len, index_at);
+  alloc.deallocate(keys, 2u * len);
+}
+
+}  // namespace sus::collections::__private
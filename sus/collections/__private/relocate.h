@@ -0,0 +1,66 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+#include "sus/marker/unsafe.h"
+#include "sus/mem/move.h"
+#include "sus/mem/relocate.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/ptr/copy.h"
+
+namespace sus::collections::__private {
+
+/// Moves `count` objects from `src` into `dst`, ending the lifetime of the
+/// objects in `src`. The ranges may overlap, as when shifting the elements of
+/// a `Vec` within its storage.
+///
+/// Trivially relocatable objects are moved with a single `memmove`. Other
+/// objects are move-constructed and destroyed one at a time, in an order that
+/// reads each object before it is overwritten.
+///
+/// # Safety
+/// The `count` objects at `src` must be alive, and the memory at `dst` that is
+/// not also in `src` must hold no objects.
+template <class T>
+constexpr void relocate(::sus::marker::UnsafeFnMarker, T* src, T* dst,
+                        ::sus::num::usize count) noexcept {
+  if (src == dst || count == 0u) return;
+  if constexpr (::sus::mem::TriviallyRelocatable<T>) {
+    if (!std::is_constant_evaluated()) {
+      ::sus::ptr::copy(::sus::marker::unsafe_fn, src, dst, count);
+      return;
+    }
+  }
+  if (dst < src) {
+    for (::sus::num::usize i; i < count; i += 1u) {
+      std::construct_at(dst + i, ::sus::move(*(src + i)));
+      if constexpr (!std::is_trivially_destructible_v<T>)
+        std::destroy_at(src + i);
+    }
+  } else {
+    for (::sus::num::usize i = count; i > 0u; i -= 1u) {
+      std::construct_at(dst + i - 1u, ::sus::move(*(src + i - 1u)));
+      if constexpr (!std::is_trivially_destructible_v<T>)
+        std::destroy_at(src + i - 1u);
+    }
+  }
+}
+
+}  // namespace sus::collections::__private
@@ -0,0 +1,431 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <type_traits>
+
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#  define _sus_search_simd 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#  include <emmintrin.h>
+#  define _sus_search_simd 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define _sus_search_simd 1
+#else
+#  define _sus_search_simd 0
+#endif
+
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/marker/unsafe.h"
+#include "sus/num/__private/intrinsics.h"
+#include "sus/num/float_concepts.h"
+#include "sus/num/integer_concepts.h"
+
+// Searching a slice for elements equal to one of a few values.
+//
+// Slices of integers and floats are scanned a vector register at a time, with
+// AVX2 when the compiler targets it, otherwise SSE2 on x86-64 and NEON on
+// aarch64. Each vector of elements is compared against every needle, and the
+// comparison results are reduced to a bitmask whose lowest (or highest) set
+// bit locates the first (or last) match. The main loop handles four vectors
+// per iteration and only inspects them one at a time once any of them has a
+// match. The remainder of the slice is handled by a final, overlapping vector.
+//
+// Other types, short slices and constant evaluation use a scalar loop.
+
+namespace sus::collections::__private {
+
+namespace search {
+
+/// The primitive type of the vector lanes that hold elements of type `T`.
+/// Integers are compared as unsigned integers of the same width, as only
+/// equality matters. Floats are compared as floats, so that `-0.0` matches
+/// `0.0` and `NaN` matches nothing, as with `==`.
+template <class T>
+struct LaneFor;
+
+template <class T>
+  requires(::sus::num::Integer<T>)
+struct LaneFor<T> {
+  using Type = std::make_unsigned_t<decltype(T::primitive_value)>;
+  static constexpr Type to_lane(const T& t) noexcept {
+    return static_cast<Type>(t.primitive_value);
+  }
+};
+
+template <class T>
+  requires(::sus::num::PrimitiveInteger<T> && !std::same_as<T, bool>)
+struct LaneFor<T> {
+  using Type = std::make_unsigned_t<T>;
+  static constexpr Type to_lane(const T& t) noexcept {
+    return static_cast<Type>(t);
+  }
+};
+
+template <class T>
+  requires(::sus::num::Float<T>)
+struct LaneFor<T> {
+  using Type = decltype(T::primitive_value);
+  static constexpr Type to_lane(const T& t) noexcept {
+    return t.primitive_value;
+  }
+};
+
+template <class T>
+  requires(std::same_as<T, float> || std::same_as<T, double>)
+struct LaneFor<T> {
+  using Type = T;
+  static constexpr Type to_lane(const T& t) noexcept { return t; }
+};
+
+template <class T>
+using Lane = typename LaneFor<T>::Type;
+
+#if defined(__AVX2__)
+
+struct Simd {
+  using Vec = __m256i;
+  static constexpr size_t kBytes = 32u;
+  /// The number of bits per byte of the vector in the mask from `bits()`.
+  static constexpr size_t kMaskBitsPerByte = 1u;
+
+  static Vec load(const void* p) noexcept {
+    return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+  }
+  template <class L>
+  static Vec splat(L x) noexcept {
+    if constexpr (std::same_as<L, float>)
+      return _mm256_castps_si256(_mm256_set1_ps(x));
+    else if constexpr (std::same_as<L, double>)
+      return _mm256_castpd_si256(_mm256_set1_pd(x));
+    else if constexpr (sizeof(L) == 1u)
+      return _mm256_set1_epi8(static_cast<char>(x));
+    else if constexpr (sizeof(L) == 2u)
+      return _mm256_set1_epi16(static_cast<short>(x));
+    else if constexpr (sizeof(L) == 4u)
+      return _mm256_set1_epi32(static_cast<int>(x));
+    else
+      return _mm256_set1_epi64x(static_cast<long long>(x));
+  }
+  template <class L>
+  static Vec eq(Vec a, Vec b) noexcept {
+    if constexpr (std::same_as<L, float>)
+      return _mm256_castps_si256(_mm256_cmp_ps(
+          _mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+    else if constexpr (std::same_as<L, double>)
+      return _mm256_castpd_si256(_mm256_cmp_pd(
+          _mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+    else if constexpr (sizeof(L) == 1u)
+      return _mm256_cmpeq_epi8(a, b);
+    else if constexpr (sizeof(L) == 2u)
+      return _mm256_cmpeq_epi16(a, b);
+    else if constexpr (sizeof(L) == 4u)
+      return _mm256_cmpeq_epi32(a, b);
+    else
+      return _mm256_cmpeq_epi64(a, b);
+  }
+  static Vec either(Vec a, Vec b) noexcept { return _mm256_or_si256(a, b); }
+  static uint64_t bits(Vec m) noexcept {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(m));
+  }
+};
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+struct Simd {
+  using Vec = __m128i;
+  static constexpr size_t kBytes = 16u;
+  /// The number of bits per byte of the vector in the mask from `bits()`.
+  static constexpr size_t kMaskBitsPerByte = 1u;
+
+  static Vec load(const void* p) noexcept {
+    return _mm_loadu_si128(static_cast<const __m128i*>(p));
+  }
+  template <class L>
+  static Vec splat(L x) noexcept {
+    if constexpr (std::same_as<L, float>)
+      return _mm_castps_si128(_mm_set1_ps(x));
+    else if constexpr (std::same_as<L, double>)
+      return _mm_castpd_si128(_mm_set1_pd(x));
+    else if constexpr (sizeof(L) == 1u)
+      return _mm_set1_epi8(static_cast<char>(x));
+    else if constexpr (sizeof(L) == 2u)
+      return _mm_set1_epi16(static_cast<short>(x));
+    else if constexpr (sizeof(L) == 4u)
+      return _mm_set1_epi32(static_cast<int>(x));
+    else
+      return _mm_set1_epi64x(static_cast<long long>(x));
+  }
+  template <class L>
+  static Vec eq(Vec a, Vec b) noexcept {
+    if constexpr (std::same_as<L, float>) {
+      return _mm_castps_si128(
+          _mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+    } else if constexpr (std::same_as<L, double>) {
+      return _mm_castpd_si128(
+          _mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+    } else if constexpr (sizeof(L) == 1u) {
+      return _mm_cmpeq_epi8(a, b);
+    } else if constexpr (sizeof(L) == 2u) {
+      return _mm_cmpeq_epi16(a, b);
+    } else if constexpr (sizeof(L) == 4u) {
+      return _mm_cmpeq_epi32(a, b);
+    } else {
+      // SSE2 has no 64-bit compare, so both 32-bit halves must be equal.
+      const __m128i halves = _mm_cmpeq_epi32(a, b);
+      return _mm_and_si128(halves,
+                           _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+  }
+  static Vec either(Vec a, Vec b) noexcept { return _mm_or_si128(a, b); }
+  static uint64_t bits(Vec m) noexcept {
+    return static_cast<uint32_t>(_mm_movemask_epi8(m));
+  }
+};
+
+#elif defined(__aarch64__) || defined(_M_ARM64)
+
+struct Simd {
+  using Vec = uint8x16_t;
+  static constexpr size_t kBytes = 16u;
+  /// The number of bits per byte of the vector in the mask from `bits()`.
+  static constexpr size_t kMaskBitsPerByte = 4u;
+
+  static Vec load(const void* p) noexcept {
+    return vld1q_u8(static_cast<const uint8_t*>(p));
+  }
+  template <class L>
+  static Vec splat(L x) noexcept {
+    if constexpr (std::same_as<L, float>)
+      return vreinterpretq_u8_f32(vdupq_n_f32(x));
+    else if constexpr (std::same_as<L, double>)
+      return vreinterpretq_u8_f64(vdupq_n_f64(x));
+    else if constexpr (sizeof(L) == 1u)
+      return vdupq_n_u8(x);
+    else if constexpr (sizeof(L) == 2u)
+      return vreinterpretq_u8_u16(vdupq_n_u16(x));
+    else if constexpr (sizeof(L) == 4u)
+      return vreinterpretq_u8_u32(vdupq_n_u32(x));
+    else
+      return vreinterpretq_u8_u64(vdupq_n_u64(x));
+  }
+  template <class L>
+  static Vec eq(Vec a, Vec b) noexcept {
+    if constexpr (std::same_as<L, float>)
+      return vreinterpretq_u8_u32(
+          vceqq_f32(vreinterpretq_f32_u8(a), vreinterpretq_f32_u8(b)));
+    else if constexpr (std::same_as<L, double>)
+      return vreinterpretq_u8_u64(
+          vceqq_f64(vreinterpretq_f64_u8(a), vreinterpretq_f64_u8(b)));
+    else if constexpr (sizeof(L) == 1u)
+      return vceqq_u8(a, b);
+    else if constexpr (sizeof(L) == 2u)
+      return vreinterpretq_u8_u16(
+          vceqq_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)));
+    else if constexpr (sizeof(L) == 4u)
+      return vreinterpretq_u8_u32(
+          vceqq_u32(vreinterpretq_u32_u8(a), vreinterpretq_u32_u8(b)));
+    else
+      return vreinterpretq_u8_u64(
+          vceqq_u64(vreinterpretq_u64_u8(a), vreinterpretq_u64_u8(b)));
+  }
+  static Vec either(Vec a, Vec b) noexcept { return vorrq_u8(a, b); }
+  static uint64_t bits(Vec m) noexcept {
+    // NEON has no movemask, but narrowing each 16-bit lane by 4 bits leaves a
+    // nibble per byte.
+    return vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+  }
+};
+
+#endif
+
+#if _sus_search_simd
+
+/// Types whose slices are searched with vector instructions.
+template <class T>
+concept Vectorizable = requires { typename LaneFor<T>::Type; } &&
+                       sizeof(T) == sizeof(Lane<T>) &&
+                       std::is_trivially_copyable_v<T>;
+
+template <class T, size_t N>
+struct Needles {
+  Simd::Vec vecs[N];
+
+  explicit Needles(const T (&needles)[N]) noexcept {
+    for (size_t n = 0u; n < N; ++n)
+      vecs[n] = Simd::splat(LaneFor<T>::to_lane(needles[n]));
+  }
+
+  /// Returns the lanes of the vector at `p` that match any needle.
+  Simd::Vec match(const T* p) const noexcept {
+    const Simd::Vec v = Simd::load(p);
+    Simd::Vec m = Simd::eq<Lane<T>>(v, vecs[0u]);
+    for (size_t n = 1u; n < N; ++n)
+      m = Simd::either(m, Simd::eq<Lane<T>>(v, vecs[n]));
+    return m;
+  }
+};
+
+template <class T>
+inline constexpr size_t kLanes = Simd::kBytes / sizeof(T);
+/// The number of mask bits per element.
+template <class T>
+inline constexpr size_t kMaskBits = Simd::kMaskBitsPerByte * sizeof(T);
+
+template <class T>
+size_t first_in_mask(uint64_t bits) noexcept {
+  return ::sus::num::__private::trailing_zeros_nonzero(::sus::marker::unsafe_fn,
+                                                       bits) /
+         kMaskBits<T>;
+}
+
+template <class T>
+size_t last_in_mask(uint64_t bits) noexcept {
+  return (63u - ::sus::num::__private::leading_zeros_nonzero(
+                    ::sus::marker::unsafe_fn, bits)) /
+         kMaskBits<T>;
+}
+
+/// Returns the index of the first of the `len` elements at `data` that is
+/// equal to any of the needles, or `len` if there is none.
+template <class T, size_t N>
+size_t find_first_vectorized(const T* data, size_t len,
+                             const T (&needles)[N]) noexcept {
+  constexpr size_t kStep = kLanes<T>;
+  const Needles<T, N> n(needles);
+  size_t i = 0u;
+  for (; i + 4u * kStep <= len; i += 4u * kStep) {
+    const Simd::Vec m0 = n.match(data + i);
+    const Simd::Vec m1 = n.match(data + i + kStep);
+    const Simd::Vec m2 = n.match(data + i + 2u * kStep);
+    const Simd::Vec m3 = n.match(data + i + 3u * kStep);
+    if (Simd::bits(Simd::either(Simd::either(m0, m1), Simd::either(m2, m3))) !=
+        0u) {
+      if (const uint64_t b = Simd::bits(m0); b != 0u)
+        return i + first_in_mask<T>(b);
+      if (const uint64_t b = Simd::bits(m1); b != 0u)
+        return i + kStep + first_in_mask<T>(b);
+      if (const uint64_t b = Simd::bits(m2); b != 0u)
+        return i + 2u * kStep + first_in_mask<T>(b);
+      return i + 3u * kStep + first_in_mask<T>(Simd::bits(m3));
+    }
+  }
+  for (; i + kStep <= len; i += kStep) {
+    if (const uint64_t b = Simd::bits(n.match(data + i)); b != 0u)
+      return i + first_in_mask<T>(b);
+  }
+  if (i < len) {
+    // The last vector overlaps with the ones already searched, so ignore its
+    // matches below `i`.
+    const size_t last = len - kStep;
+    const uint64_t b =
+        Simd::bits(n.match(data + last)) >> ((i - last) * kMaskBits<T>);
+    if (b != 0u) return i + first_in_mask<T>(b);
+  }
+  return len;
+}
+
+/// Returns the index of the last of the `len` elements at `data` that is
+/// equal to any of the needles, or `len` if there is none.
+template <class T, size_t N>
+size_t find_last_vectorized(const T* data, size_t len,
+                            const T (&needles)[N]) noexcept {
+  constexpr size_t kStep = kLanes<T>;
+  const Needles<T, N> n(needles);
+  size_t end = len;
+  for (; end >= 4u * kStep; end -= 4u * kStep) {
+    const size_t i = end - 4u * kStep;
+    const Simd::Vec m0 = n.match(data + i);
+    const Simd::Vec m1 = n.match(data + i + kStep);
+    const Simd::Vec m2 = n.match(data + i + 2u * kStep);
+    const Simd::Vec m3 = n.match(data + i + 3u * kStep);
+    if (Simd::bits(Simd::either(Simd::either(m0, m1), Simd::either(m2, m3))) !=
+        0u) {
+      if (const uint64_t b = Simd::bits(m3); b != 0u)
+        return i + 3u * kStep + last_in_mask<T>(b);
+      if (const uint64_t b = Simd::bits(m2); b != 0u)
+        return i + 2u * kStep + last_in_mask<T>(b);
+      if (const uint64_t b = Simd::bits(m1); b != 0u)
+        return i + kStep + last_in_mask<T>(b);
+      return i + last_in_mask<T>(Simd::bits(m0));
+    }
+  }
+  for (; end >= kStep; end -= kStep) {
+    if (const uint64_t b = Simd::bits(n.match(data + end - kStep)); b != 0u)
+      return end - kStep + last_in_mask<T>(b);
+  }
+  if (end > 0u) {
+    // The first vector overlaps with the ones already searched, so ignore its
+    // matches at or above `end`.
+    const uint64_t b = Simd::bits(n.match(data)) &
+                       ((uint64_t{1u} << (end * kMaskBits<T>)) - 1u);
+    if (b != 0u) return last_in_mask<T>(b);
+  }
+  return len;
+}
+
+#endif  // _sus_search_simd
+
+}  // namespace search
+
+/// Returns the index of the first of the `len` elements at `data` that is
+/// equal to any of the `needles`, or `len` if there is none.
+template <class T, class... Needles>
+  requires(sizeof...(Needles) > 0u && (std::same_as<Needles, T> && ...))
+constexpr size_t find_first_of(const T* data, size_t len,
+                               const Needles&... needles) noexcept {
+#if _sus_search_simd
+  if constexpr (search::Vectorizable<T>) {
+    if (!std::is_constant_evaluated() && len >= search::kLanes<T>) {
+      const T array[] = {needles...};
+      return search::find_first_vectorized(data, len, array);
+    }
+  }
+#endif
+  for (size_t i = 0u; i < len; ++i)
+    if (((data[i] == needles) || ...)) return i;
+  return len;
+}
+
+/// Returns the index of the last of the `len` elements at `data` that is
+/// equal to any of the `needles`, or `len` if there is none.
+template <class T, class... Needles>
+  requires(sizeof...(Needles) > 0u && (std::same_as<Needles, T> && ...))
+constexpr size_t find_last_of(const T* data, size_t len,
+                              const Needles&... needles) noexcept {
+#if _sus_search_simd
+  if constexpr (search::Vectorizable<T>) {
+    if (!std::is_constant_evaluated() && len >= search::kLanes<T>) {
+      const T array[] = {needles...};
+      return search::find_last_vectorized(data, len, array);
+    }
+  }
+#endif
+  for (size_t i = len; i > 0u; --i)
+    if (((data[i - 1u] == needles) || ...)) return i - 1u;
+  return len;
+}
+
+}  // namespace sus::collections::__private
+
+#undef _sus_search_simd
@@ -0,0 +1,278 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+
+#include <cmath>
+#include <type_traits>
+
+#include "sus/collections/__private/sort_unstable.h"
+#include "sus/mem/swap.h"
+
+// Selection of the element at a given sorted position, by introselect.
+//
+// Each step partitions the range around a pivot and continues into the side
+// holding the wanted position:
+// * Long ranges choose the pivot with the sampling of Floyd and Rivest: the
+//   element at the wanted position is first selected within a small window
+//   around it, which for random input makes it a pivot very close to the
+//   answer, so that the next range is tiny.
+// * Other ranges choose the median of 3, or Tukey's ninther.
+// * Once the partitions have done more than a constant multiple of the
+//   original length in work, which only happens for adversarial input, pivots
+//   are chosen by the median of medians, which guarantees that each partition
+//   discards a constant fraction of the range. This keeps the worst case O(n).
+//
+// As in pdqsort, when the pivot is equal to the pivot of an earlier partition
+// which bounds the range from below, the elements equal to it are moved to the
+// front and are done, so inputs with many duplicates remain linear.
+
+namespace sus::collections::__private {
+
+namespace selection {
+
+/// Ranges at most this long are finished with insertion sort.
+inline constexpr size_t kInsertionSortThreshold = 16u;
+/// Ranges at least this long choose their pivot by Floyd-Rivest sampling.
+inline constexpr size_t kFloydRivestThreshold = 600u;
+/// The total length of the partitions, as a multiple of the length of the
+/// slice, after which pivots are chosen by the median of medians.
+inline constexpr size_t kWorkFactor = 4u;
+
+/// Partitions [begin, end) around the pivot at `*begin`. Returns the final
+/// position of the pivot, with smaller elements before it and the rest after.
+template <class T, class Less>
+constexpr T* partition(T* begin, T* end, Less& less) noexcept {
+  const T& pivot = *begin;
+  T* l = begin + 1;
+  T* r = end;
+  while (true) {
+    while (l < r && less(*l, pivot)) ++l;
+    while (l < r && !less(*(r - 1), pivot)) --r;
+    if (l == r) break;
+    --r;
+    ::sus::mem::swap(*l, *r);
+    ++l;
+  }
+  T* const pivot_pos = l - 1;
+  ::sus::mem::swap(*begin, *pivot_pos);
+  return pivot_pos;
+}
+
+/// Moves the elements of [begin, end) which are not greater than the pivot at
+/// `*begin` to the front, and returns the end of them.
+template <class T, class Less>
+constexpr T* partition_not_greater(T* begin, T* end, Less& less) noexcept {
+  const T& pivot = *begin;
+  T* l = begin + 1;
+  T* r = end;
+  while (true) {
+    while (l < r && !less(pivot, *l)) ++l;
+    while (l < r && less(pivot, *(r - 1))) --r;
+    if (l == r) break;
+    --r;
+    ::sus::mem::swap(*l, *r);
+    ++l;
+  }
+  return l;
+}
+
+/// Moves the median of 3, or the ninther for long ranges, to `*begin`.
+template <class T, class Less>
+constexpr void median_of_3_pivot(T* begin, T* end, Less& less) noexcept {
+  const size_t len = static_cast<size_t>(end - begin);
+  T* const mid = begin + len / 2u;
+  if (len > pdqsort::kNintherThreshold) {
+    pdqsort::sort3(begin, mid, end - 1, less);
+    pdqsort::sort3(begin + 1, mid - 1, end - 2, less);
+    pdqsort::sort3(begin + 2, mid + 1, end - 3, less);
+    pdqsort::sort3(mid - 1, mid, mid + 1, less);
+    ::sus::mem::swap(*begin, *mid);
+  } else {
+    pdqsort::sort3(mid, begin, end - 1, less);
+  }
+}
+
+template <class T, class Less>
+constexpr void select_loop(T* begin, T* end, T* nth, Less& less) noexcept;
+
+/// Moves the median of the medians of groups of 5 to `*begin`.
+template <class T, class Less>
+constexpr void median_of_medians_pivot(T* begin, T* end, Less& less) noexcept {
+  const size_t groups = static_cast<size_t>(end - begin) / 5u;
+  for (size_t g = 0u; g < groups; ++g) {
+    T* const group = begin + 5u * g;
+    pdqsort::insertion_sort(group, group + 5, less);
+    ::sus::mem::swap(begin[g], group[2u]);
+  }
+  T* const median = begin + groups / 2u;
+  select_loop(begin, begin + groups, median, less);
+  ::sus::mem::swap(*begin, *median);
+}
+
+/// Moves a pivot that is likely very close to the element at `nth` to
+/// `*begin`, by selecting `nth` within a window around it which is small
+/// compared to [begin, end).
+template <class T, class Less>
+void floyd_rivest_pivot(T* begin, T* end, T* nth, Less& less) noexcept {
+  const auto n = static_cast<double>(end - begin);
+  const auto i = static_cast<double>(nth - begin);
+  const double z = std::log(n);
+  const double s = 0.5 * std::exp(2.0 * z / 3.0);
+  const double sd =
+      0.5 * std::sqrt(z * s * (n - s) / n) * (i < n / 2.0 ? -1.0 : 1.0);
+  const double lo = std::fmax(0.0, i - i * s / n + sd);
+  const double hi = std::fmin(n - 1.0, i + (n - i) * s / n + sd);
+  // The window always holds `nth`, even if rounding pushes it out.
+  T* window_begin = begin + static_cast<size_t>(lo);
+  if (window_begin > nth) window_begin = nth;
+  T* window_end = begin + static_cast<size_t>(hi) + 1u;
+  if (window_end <= nth) window_end = nth + 1;
+  select_loop(window_begin, window_end, nth, less);
+  ::sus::mem::swap(*begin, *nth);
+}
+
+/// Moves the smallest element of [begin, end) to `*begin`.
+template <class T, class Less>
+constexpr void select_min(T* begin, T* end, Less& less) noexcept {
+  T* min = begin;
+  for (T* it = begin + 1; it != end; ++it)
+    if (less(*it, *min)) min = it;
+  ::sus::mem::swap(*begin, *min);
+}
+
+/// Moves the largest element of [begin, end) to `*(end - 1)`.
+template <class T, class Less>
+constexpr void select_max(T* begin, T* end, Less& less) noexcept {
+  T* max = begin;
+  for (T* it = begin + 1; it != end; ++it)
+    if (!less(*it, *max)) max = it;
+  ::sus::mem::swap(*(end - 1), *max);
+}
+
+template <class T, class Less>
+constexpr void select_loop(T* begin, T* end, T* nth, Less& less) noexcept {
+  size_t work_left = kWorkFactor * static_cast<size_t>(end - begin);
+  // An element no greater than every element in [begin, end), if known.
+  const T* ancestor = nullptr;
+
+  while (true) {
+    const size_t len = static_cast<size_t>(end - begin);
+    if (len <= kInsertionSortThreshold) {
+      pdqsort::insertion_sort(begin, end, less);
+      return;
+    }
+    if (nth == begin) {
+      select_min(begin, end, less);
+      return;
+    }
+    if (nth == end - 1) {
+      select_max(begin, end, less);
+      return;
+    }
+
+    if (work_left < len) {
+      median_of_medians_pivot(begin, end, less);
+    } else {
+      work_left -= len;
+      if (len >= kFloydRivestThreshold && !std::is_constant_evaluated())
+        floyd_rivest_pivot(begin, end, nth, less);
+      else
+        median_of_3_pivot(begin, end, less);
+    }
+
+    if (ancestor != nullptr && !less(*ancestor, *begin)) {
+      // The pivot is equal to the ancestor, so it's the smallest element in
+      // the range, and everything equal to it is in its final place.
+      T* const equal_end = partition_not_greater(begin, end, less);
+      if (nth < equal_end) return;
+      begin = equal_end;
+      continue;
+    }
+
+    T* const pivot = partition(begin, end, less);
+    if (pivot == nth) return;
+    if (nth < pivot) {
+      end = pivot;
+    } else {
+      ancestor = pivot;
+      begin = pivot + 1;
+    }
+  }
+}
+
+/// Selects each of the sorted indices in [first, last) within [begin, end),
+/// where the indices are offsets from `base`.
+template <class T, class Less, class IndexAt>
+constexpr void select_many(T* base, T* begin, T* end, size_t first, size_t last,
+                           IndexAt& index_at, Less& less) noexcept {
+  while (first != last && end - begin > 1) {
+    if (static_cast<size_t>(end - begin) <= kInsertionSortThreshold) {
+      pdqsort::insertion_sort(begin, end, less);
+      return;
+    }
+    // Select the middle index, which splits the other indices between the
+    // ranges on either side of it.
+    const size_t mid = first + (last - first) / 2u;
+    T* const nth = base + index_at(mid);
+    select_loop(begin, end, nth, less);
+
+    size_t left_last = mid;
+    while (left_last != first && base + index_at(left_last - 1u) == nth)
+      left_last -= 1u;
+    size_t right_first = mid + 1u;
+    while (right_first != last && base + index_at(right_first) == nth)
+      right_first += 1u;
+
+    // Recurse into the side with fewer indices, and loop on the other.
+    if (left_last - first < last - right_first) {
+      select_many(base, begin, nth, first, left_last, index_at, less);
+      begin = nth + 1;
+      first = right_first;
+    } else {
+      select_many(base, nth + 1, end, right_first, last, index_at, less);
+      end = nth;
+      last = left_last;
+    }
+  }
+}
+
+}  // namespace selection
+
+/// Reorders the `len` elements at `data` such that the element at `index` is
+/// the one that would be there if the elements were sorted, with elements that
+/// are not greater before it and elements that are not less after it.
+template <class T, class Less>
+constexpr void select_nth_unstable(T* data, size_t len, size_t index,
+                                   Less& less) noexcept {
+  if (len < 2u) return;
+  selection::select_loop(data, data + len, data + index, less);
+}
+
+/// Like `select_nth_unstable()` for each of `num_indices` indices, where
+/// `index_at(i)` returns the `i`th index. The indices must be sorted. Each
+/// selection partitions the range for the ones after it, so the cost grows
+/// with the logarithm of the number of indices.
+template <class T, class Less, class IndexAt>
+constexpr void select_nth_many(T* data, size_t len, size_t num_indices,
+                               IndexAt& index_at, Less& less) noexcept {
+  selection::select_many(data, data, data + len, 0u, num_indices, index_at,
+                         less);
+}
+
+}  // namespace sus::collections::__private
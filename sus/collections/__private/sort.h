@@ -16,42 +16,174 @@
 // IWYU pragma: friend "sus/.*"
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <type_traits>
+
+#include "sus/collections/__private/par_sort.h"
+#include "sus/collections/__private/radix_sort.h"
+#include "sus/collections/__private/sort_unstable.h"
+#include "sus/collections/__private/thread_pool.h"
 #include "sus/fn/fn_concepts.h"
-#include "sus/iter/iterator_defn.h"
-#include "sus/mem/swap.h"
-#include "sus/num/integer_concepts.h"
-#include "sus/tuple/tuple.h"
-#include "sus/lib/__private/forward_decl.h"
+#include "sus/mem/move.h"
+
+// Sorting by cached keys computes the key of each element once, into an array
+// of keys, and sorts a separate array of indices into it. The indices are as
+// narrow as the length of the slice allows, so that the array being sorted is
+// as dense as possible, and the keys are never moved. The sorted indices are
+// then a permutation which is applied to the slice in place.
+//
+// Integer keys are instead packed with their index and radix sorted, which
+// needs no comparisons at all.
+//
+// Ties between equal keys are broken by index, so the sort is stable.
 
 namespace sus::collections::__private {
 
-// Helper function for indexing our vector by the smallest possible type, to
-// reduce allocation.
-template <class U, class Key, class T, ::sus::fn::FnMut<Key(const T&)> KeyFn>
-void sort_slice_by_cached_key(const ::sus::collections::SliceMut<T>& slice,
-                              KeyFn& f) noexcept {
-  auto indices =
-      slice.iter()
-          .map(f)
-          .enumerate()
-          .map([](::sus::Tuple<usize, Key>&& t) {
-            auto&& [i, k] = ::sus::move(t);
-            return ::sus::Tuple<Key, U>(::sus::forward<Key>(k), i);
-          })
-          .collect_vec();
-  // The elements of `indices` are unique, as they are indexed, so any sort
-  // will be stable with respect to the original slice. We use `sort_unstable`
-  // here because it requires less memory allocation.
-  indices.sort_unstable();
-  const usize length = slice.len();
-  for (usize i; i < length; i += 1u) {
-    auto index = indices[i].template at<1>();
-    while (index < i) {
-      index = indices[index].template at<1>();
+namespace cached_key {
+
+/// How a key is cached: by value, or by pointer when the key function returns
+/// a reference.
+template <class Key>
+using Stored = std::conditional_t<std::is_reference_v<Key>,
+                                  const std::remove_reference_t<Key>*, Key>;
+
+template <class Key>
+constexpr Stored<Key> store(Key&& key) noexcept {
+  if constexpr (std::is_reference_v<Key>)
+    return &key;
+  else
+    return ::sus::move(key);
+}
+
+template <class Key>
+constexpr const std::remove_reference_t<Key>& load(
+    const Stored<Key>& stored) noexcept {
+  if constexpr (std::is_reference_v<Key>)
+    return *stored;
+  else
+    return stored;
+}
+
+/// Key functions are called for this many elements at a time when the keys
+/// are computed in parallel.
+inline constexpr size_t kParallelKeyChunk = 1u << 10u;
+
+/// Sorts the `len` elements at `data` by their keys, where `key_at(i)` computes
+/// the key of `data[i]`. The keys are computed by `for_each(len, body)`, which
+/// calls `body(i)` for each `i` in [0, len), and the indices are sorted by
+/// `sort_indices(indices, len, less)`. The indices are of type `U`, which must
+/// be able to hold `len`.
+template <class U, class Key, class T, class KeyAt, class ForEach,
+          class SortIndices>
+void sort(T* data, size_t len, KeyAt& key_at, ForEach& for_each,
+          SortIndices& sort_indices) noexcept {
+  using KeyValue = std::remove_cvref_t<Key>;
+  if constexpr (radix::RadixKey<KeyValue>) {
+    if (len >= radix::kRadixSortThreshold) {
+      using KeyBits = radix::KeyBits<KeyValue>;
+      using Bits = typename KeyBits::Bits;
+      using KeyIndex = radix::KeyIndex<Bits, U>;
+      std::allocator<KeyIndex> alloc;
+      KeyIndex* const keys = alloc.allocate(2u * len);
+      auto fill = [&](size_t i) {
+        keys[i] = KeyIndex{KeyBits::to_bits(key_at(i)), static_cast<U>(i)};
+      };
+      for_each(len, fill);
+      auto to_bits = [](const KeyIndex& k) { return k.key; };
+      radix::sort<Bits>(keys, keys + len, len, to_bits);
+      auto index_at = [keys](size_t i) -> U& { return keys[i].index; };
+      radix::apply_permutation(data, len, index_at);
+      alloc.deallocate(keys, 2u * len);
+      return;
     }
-    indices[i].template at_mut<1>() = index;
-    slice.swap_unchecked(::sus::marker::unsafe_fn, i, index);
   }
-};
+
+  std::allocator<Stored<Key>> key_alloc;
+  Stored<Key>* const keys = key_alloc.allocate(len);
+  auto fill = [&](size_t i) {
+    std::construct_at(keys + i, store<Key>(key_at(i)));
+  };
+  for_each(len, fill);
+
+  std::allocator<U> index_alloc;
+  U* const indices = index_alloc.allocate(len);
+  for (size_t i = 0u; i < len; ++i) indices[i] = static_cast<U>(i);
+  auto less = [keys](U a, U b) {
+    const auto order = load<Key>(keys[a]) <=> load<Key>(keys[b]);
+    return order < 0 || (order == 0 && a < b);
+  };
+  sort_indices(indices, len, less);
+  std::destroy(keys, keys + len);
+  key_alloc.deallocate(keys, len);
+
+  auto index_at = [indices](size_t i) -> U& { return indices[i]; };
+  radix::apply_permutation(data, len, index_at);
+  index_alloc.deallocate(indices, len);
+}
+
+/// Calls `sort()` with the narrowest index type that can index `len` elements.
+template <class Key, class T, class KeyAt, class ForEach, class SortIndices>
+void sort_with_narrow_indices(T* data, size_t len, KeyAt& key_at,
+                              ForEach& for_each,
+                              SortIndices& sort_indices) noexcept {
+  if (len <= UINT8_MAX)
+    sort<uint8_t, Key>(data, len, key_at, for_each, sort_indices);
+  else if (len <= UINT16_MAX)
+    sort<uint16_t, Key>(data, len, key_at, for_each, sort_indices);
+  else if (len <= UINT32_MAX)
+    sort<uint32_t, Key>(data, len, key_at, for_each, sort_indices);
+  else
+    sort<size_t, Key>(data, len, key_at, for_each, sort_indices);
+}
+
+}  // namespace cached_key
+
+/// Sorts the `len` elements at `data` by the key returned from `key_fn`, which
+/// is called once per element. Equal keys keep their relative order.
+template <class Key, class T, class KeyFn>
+void sort_slice_by_cached_key(T* data, size_t len, KeyFn& key_fn) noexcept {
+  if (len < 2u) return;
+  auto key_at = [&](size_t i) -> Key {
+    return ::sus::fn::call_mut(key_fn, data[i]);
+  };
+  auto for_each = [](size_t n, auto& body) {
+    for (size_t i = 0u; i < n; ++i) body(i);
+  };
+  auto sort_indices = [](auto* indices, size_t n, auto& less) {
+    sort_unstable(indices, n, less);
+  };
+  cached_key::sort_with_narrow_indices<Key>(data, len, key_at, for_each,
+                                            sort_indices);
+}
+
+/// Like `sort_slice_by_cached_key()`, but computes the keys and sorts them
+/// using the shared thread pool. The key function is called from multiple
+/// threads at once.
+template <class Key, class T, class KeyFn>
+void par_sort_slice_by_cached_key(T* data, size_t len,
+                                  const KeyFn& key_fn) noexcept {
+  if (len < 2u) return;
+  ThreadPool& pool = ThreadPool::global();
+  auto key_at = [&](size_t i) -> Key {
+    return ::sus::fn::call(key_fn, data[i]);
+  };
+  auto for_each = [&pool](size_t n, auto& body) {
+    const size_t chunks = (n + cached_key::kParallelKeyChunk - 1u) /
+                          cached_key::kParallelKeyChunk;
+    auto run_chunk = [&](size_t c) {
+      const size_t end = n * (c + 1u) / chunks;
+      for (size_t i = n * c / chunks; i < end; ++i) body(i);
+    };
+    pool.for_each_index(chunks, run_chunk);
+  };
+  auto sort_indices = [](auto* indices, size_t n, auto& less) {
+    par_sort_unstable(indices, n, less);
+  };
+  cached_key::sort_with_narrow_indices<Key>(data, len, key_at, for_each,
+                                            sort_indices);
+}
 
 }  // namespace sus::collections::__private
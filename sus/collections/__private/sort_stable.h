@@ -0,0 +1,292 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+
+#include <memory>
+#include <new>
+
+#include "sus/assertions/debug_check.h"
+#include "sus/mem/move.h"
+#include "sus/mem/swap.h"
+
+// An adaptive, stable merge sort in the style of Timsort.
+//
+// The slice is split into natural runs, which are sequences that are already
+// sorted or strictly sorted in reverse (and are reversed in place). Short runs
+// are extended with insertion sort up to a minimum length. Runs are then merged
+// following the powersort merge policy of Munro and Wild, as used by CPython,
+// which keeps the sort O(n * log(n)) while exploiting existing order: a slice
+// made of k runs is sorted in O(n * log(k)).
+//
+// Merges use a scratch buffer of at most `len / 2` elements, since only the
+// shorter of the two runs is moved out. The buffer is only allocated once a
+// merge actually needs to move elements, so sorted input does not allocate.
+//
+// All functions here receive a `less` function object which returns whether
+// the first argument is strictly less than the second.
+
+namespace sus::collections::__private {
+
+namespace mergesort {
+
+/// The largest number of runs that can be on the merge stack. The powersort
+/// policy keeps the powers on the stack strictly increasing, and a power is at
+/// most the number of bits in `size_t` plus one.
+inline constexpr size_t kMaxRuns = sizeof(size_t) * 8u + 2u;
+
+/// Returns the minimum run length for a slice of length `len`, chosen such that
+/// `len / min_run` is a power of two or close to it, which keeps the merges
+/// balanced. Slices shorter than 64 are sorted by insertion sort alone.
+constexpr size_t min_run_length(size_t len) noexcept {
+  size_t r = 0u;
+  while (len >= 64u) {
+    r |= len & 1u;
+    len >>= 1u;
+  }
+  return len + r;
+}
+
+/// Computes the powersort "power" of the boundary between the runs
+/// [s1, s1 + n1) and [s1 + n1, s1 + n1 + n2) in a slice of length `len`. This
+/// is the depth of the boundary in a nearly-optimal binary merge tree.
+constexpr int node_power(size_t s1, size_t n1, size_t n2, size_t len) noexcept {
+  int power = 0;
+  // Twice the midpoints of the two runs, as fractions of `len`.
+  size_t a = 2u * s1 + n1;
+  size_t b = a + n1 + n2;
+  while (true) {
+    power += 1;
+    if (a >= len) {
+      a -= len;
+      b -= len;
+    } else if (b >= len) {
+      break;
+    }
+    a <<= 1u;
+    b <<= 1u;
+  }
+  return power;
+}
+
+/// Sorts [begin, end) with insertion sort, where [begin, sorted_end) is
+/// already sorted. Equal elements keep their order.
+template <class T, class Less>
+void insertion_sort_tail(T* begin, T* sorted_end, T* end, Less& less) noexcept {
+  for (T* cur = sorted_end; cur != end; ++cur) {
+    T* sift = cur;
+    T* sift_1 = cur - 1;
+    if (less(*sift, *sift_1)) {
+      T tmp = ::sus::move(*sift);
+      do {
+        *sift-- = ::sus::move(*sift_1);
+      } while (sift != begin && less(tmp, *--sift_1));
+      *sift = ::sus::move(tmp);
+    }
+  }
+}
+
+/// Returns the length of the run starting at `begin`. A strictly descending
+/// run is reversed in place so that the returned run is always sorted. Runs
+/// that descend are required to be strict so that reversing them is stable.
+template <class T, class Less>
+size_t find_run(T* begin, T* end, Less& less) noexcept {
+  const size_t len = static_cast<size_t>(end - begin);
+  if (len < 2u) return len;
+  size_t run = 2u;
+  if (less(begin[1u], begin[0u])) {
+    while (run < len && less(begin[run], begin[run - 1u])) run += 1u;
+    T* lo = begin;
+    T* hi = begin + run;
+    while (hi - lo > 1) {
+      --hi;
+      ::sus::mem::swap(*lo, *hi);
+      ++lo;
+    }
+  } else {
+    while (run < len && !less(begin[run], begin[run - 1u])) run += 1u;
+  }
+  return run;
+}
+
+/// Returns the first position in the sorted range [begin, end) whose element
+/// is greater than `value`.
+template <class T, class Less>
+T* upper_bound(T* begin, T* end, const T& value, Less& less) noexcept {
+  size_t len = static_cast<size_t>(end - begin);
+  while (len > 0u) {
+    const size_t half = len / 2u;
+    if (less(value, begin[half])) {
+      len = half;
+    } else {
+      begin += half + 1u;
+      len -= half + 1u;
+    }
+  }
+  return begin;
+}
+
+/// Returns the first position in the sorted range [begin, end) whose element
+/// is not less than `value`.
+template <class T, class Less>
+T* lower_bound(T* begin, T* end, const T& value, Less& less) noexcept {
+  size_t len = static_cast<size_t>(end - begin);
+  while (len > 0u) {
+    const size_t half = len / 2u;
+    if (less(begin[half], value)) {
+      begin += half + 1u;
+      len -= half + 1u;
+    } else {
+      len = half;
+    }
+  }
+  return begin;
+}
+
+/// Uninitialized storage for moving elements out of the slice while merging.
+template <class T>
+class MergeBuffer {
+ public:
+  explicit MergeBuffer(size_t capacity) noexcept : capacity_(capacity) {}
+  ~MergeBuffer() noexcept {
+    if (data_ != nullptr) std::allocator<T>().deallocate(data_, capacity_);
+  }
+
+  MergeBuffer(const MergeBuffer&) = delete;
+  MergeBuffer& operator=(const MergeBuffer&) = delete;
+
+  /// Returns the storage, allocating it on first use.
+  T* get() noexcept {
+    if (data_ == nullptr) data_ = std::allocator<T>().allocate(capacity_);
+    return data_;
+  }
+
+ private:
+  size_t capacity_;
+  T* data_ = nullptr;
+};
+
+/// Merges the adjacent sorted runs [begin, mid) and [mid, end). Equal elements
+/// from the left run are placed before those from the right run.
+template <class T, class Less>
+void merge(T* begin, T* mid, T* end, MergeBuffer<T>& buffer,
+           Less& less) noexcept {
+  // The runs are already in order, which is common for partially sorted input.
+  if (!less(*mid, *(mid - 1))) return;
+  // Elements at the front of the left run that are not greater than the first
+  // element of the right run are already in place, as are elements at the back
+  // of the right run that are not less than the last element of the left run.
+  begin = upper_bound(begin, mid, *mid, less);
+  end = lower_bound(mid, end, *(mid - 1), less);
+
+  const size_t left_len = static_cast<size_t>(mid - begin);
+  const size_t right_len = static_cast<size_t>(end - mid);
+  T* const buf = buffer.get();
+
+  if (left_len <= right_len) {
+    // Move the left run out, then merge forward into the gap it leaves.
+    for (size_t i = 0u; i < left_len; ++i)
+      std::construct_at(buf + i, ::sus::move(begin[i]));
+    T* l = buf;
+    T* const l_end = buf + left_len;
+    T* r = mid;
+    T* out = begin;
+    while (l != l_end && r != end) {
+      if (less(*r, *l))
+        *out++ = ::sus::move(*r++);
+      else
+        *out++ = ::sus::move(*l++);
+    }
+    while (l != l_end) *out++ = ::sus::move(*l++);
+    std::destroy(buf, l_end);
+  } else {
+    // Move the right run out, then merge backward into the gap it leaves.
+    for (size_t i = 0u; i < right_len; ++i)
+      std::construct_at(buf + i, ::sus::move(mid[i]));
+    T* l = mid;
+    T* r = buf + right_len;
+    T* out = end;
+    while (l != begin && r != buf) {
+      if (less(*(r - 1), *(l - 1)))
+        *--out = ::sus::move(*--l);
+      else
+        *--out = ::sus::move(*--r);
+    }
+    while (r != buf) *--out = ::sus::move(*--r);
+    std::destroy(buf, buf + right_len);
+  }
+}
+
+struct Run {
+  size_t start;
+  size_t len;
+  /// The power of the boundary between this run and the one after it.
+  int power;
+};
+
+}  // namespace mergesort
+
+/// Sorts the `len` elements at `data` with `less(a, b)` returning whether `a`
+/// is strictly less than `b`. Equal elements keep their relative order.
+template <class T, class Less>
+void sort_stable(T* data, size_t len, Less& less) noexcept {
+  if (len < 2u) return;
+
+  const size_t min_run = mergesort::min_run_length(len);
+  mergesort::MergeBuffer<T> buffer(len / 2u);
+  mergesort::Run runs[mergesort::kMaxRuns];
+  size_t num_runs = 0u;
+
+  // Merges the two runs at the top of the stack.
+  auto merge_top = [&]() {
+    mergesort::Run& a = runs[num_runs - 2u];
+    const mergesort::Run& b = runs[num_runs - 1u];
+    mergesort::merge(data + a.start, data + b.start, data + b.start + b.len,
+                     buffer, less);
+    a.len += b.len;
+    num_runs -= 1u;
+  };
+
+  size_t start = 0u;
+  while (start < len) {
+    size_t run = mergesort::find_run(data + start, data + len, less);
+    if (run < min_run) {
+      const size_t forced = len - start < min_run ? len - start : min_run;
+      mergesort::insertion_sort_tail(data + start, data + start + run,
+                                     data + start + forced, less);
+      run = forced;
+    }
+
+    if (num_runs > 0u) {
+      mergesort::Run& prev = runs[num_runs - 1u];
+      const int power = mergesort::node_power(prev.start, prev.len, run, len);
+      // Merge runs whose boundary is deeper in the merge tree than the new
+      // boundary, as nothing to their right can be merged before them.
+      while (num_runs > 1u && runs[num_runs - 2u].power > power) merge_top();
+      runs[num_runs - 1u].power = power;
+    }
+    sus_debug_check(num_runs < mergesort::kMaxRuns);
+    runs[num_runs] = mergesort::Run{start, run, 0};
+    num_runs += 1u;
+    start += run;
+  }
+
+  while (num_runs > 1u) merge_top();
+}
+
+}  // namespace sus::collections::__private
@@ -0,0 +1,534 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+
+#include <type_traits>
+
+#include "sus/mem/move.h"
+#include "sus/mem/swap.h"
+
+// An implementation of pattern-defeating quicksort (pdqsort), by Orson Peters.
+// See https://github.com/orlp/pdqsort.
+//
+// The sort is unstable, in-place (it never allocates), and O(n * log(n))
+// worst-case. Inputs that are already sorted, or sorted in reverse, are
+// detected up front and handled in O(n).
+//
+// All functions here receive a `less` function object which returns whether
+// the first argument is strictly less than the second.
+
+namespace sus::collections::__private {
+
+namespace pdqsort {
+
+/// Partitions below this size are sorted with insertion sort.
+inline constexpr size_t kInsertionSortThreshold = 24u;
+/// Partitions above this size use Tukey's ninther to select the pivot.
+inline constexpr size_t kNintherThreshold = 128u;
+/// When partial insertion sort has moved more than this many elements, it
+/// gives up, as the input is not nearly sorted.
+inline constexpr size_t kPartialInsertionSortLimit = 8u;
+/// The number of elements scanned at a time by the branchless partition. Must
+/// fit in an `unsigned char` offset.
+inline constexpr size_t kBlockSize = 64u;
+
+/// Whether to use the branchless block partition for `T`. It avoids branch
+/// mispredictions in exchange for extra work per element, which pays off when
+/// elements are cheap to move and compare.
+template <class T>
+inline constexpr bool kUseBranchless =
+    std::is_trivially_copyable_v<T> && sizeof(T) <= 2u * sizeof(void*);
+
+/// Returns floor(log2(n)) for `n > 0`.
+constexpr int log2(size_t n) noexcept {
+  int log = 0;
+  while (n >>= 1u) log += 1;
+  return log;
+}
+
+/// Sorts [begin, end) with insertion sort.
+template <class T, class Less>
+constexpr void insertion_sort(T* begin, T* end, Less& less) noexcept {
+  if (begin == end) return;
+  for (T* cur = begin + 1; cur != end; ++cur) {
+    T* sift = cur;
+    T* sift_1 = cur - 1;
+    if (less(*sift, *sift_1)) {
+      T tmp = ::sus::move(*sift);
+      do {
+        *sift-- = ::sus::move(*sift_1);
+      } while (sift != begin && less(tmp, *--sift_1));
+      *sift = ::sus::move(tmp);
+    }
+  }
+}
+
+/// Sorts [begin, end) with insertion sort, assuming that `*(begin - 1)` is an
+/// element no greater than any element in the range, which acts as a sentinel
+/// and avoids a bounds check in the inner loop.
+template <class T, class Less>
+constexpr void unguarded_insertion_sort(T* begin, T* end, Less& less) noexcept {
+  if (begin == end) return;
+  for (T* cur = begin + 1; cur != end; ++cur) {
+    T* sift = cur;
+    T* sift_1 = cur - 1;
+    if (less(*sift, *sift_1)) {
+      T tmp = ::sus::move(*sift);
+      do {
+        *sift-- = ::sus::move(*sift_1);
+      } while (less(tmp, *--sift_1));
+      *sift = ::sus::move(tmp);
+    }
+  }
+}
+
+/// Attempts to sort [begin, end) with insertion sort. Gives up and returns
+/// false if more than `kPartialInsertionSortLimit` elements were moved,
+/// otherwise returns true with the range sorted.
+template <class T, class Less>
+constexpr bool partial_insertion_sort(T* begin, T* end, Less& less) noexcept {
+  if (begin == end) return true;
+  size_t limit = 0u;
+  for (T* cur = begin + 1; cur != end; ++cur) {
+    T* sift = cur;
+    T* sift_1 = cur - 1;
+    if (less(*sift, *sift_1)) {
+      T tmp = ::sus::move(*sift);
+      do {
+        *sift-- = ::sus::move(*sift_1);
+      } while (sift != begin && less(tmp, *--sift_1));
+      *sift = ::sus::move(tmp);
+      limit += static_cast<size_t>(cur - sift);
+    }
+    if (limit > kPartialInsertionSortLimit) return false;
+  }
+  return true;
+}
+
+template <class T, class Less>
+constexpr void sort2(T* a, T* b, Less& less) noexcept {
+  if (less(*b, *a)) ::sus::mem::swap(*a, *b);
+}
+
+/// Sorts the elements at `a`, `b` and `c`.
+template <class T, class Less>
+constexpr void sort3(T* a, T* b, T* c, Less& less) noexcept {
+  sort2(a, b, less);
+  sort2(b, c, less);
+  sort2(a, b, less);
+}
+
+/// Sorts [begin, end) with heapsort. This is the fallback when quicksort keeps
+/// choosing bad pivots, which bounds the worst case to O(n * log(n)).
+template <class T, class Less>
+constexpr void heapsort(T* begin, T* end, Less& less) noexcept {
+  const size_t len = static_cast<size_t>(end - begin);
+  if (len < 2u) return;
+  auto sift_down = [&](size_t node, size_t heap_len) {
+    while (true) {
+      size_t child = 2u * node + 1u;
+      if (child >= heap_len) break;
+      if (child + 1u < heap_len && less(begin[child], begin[child + 1u]))
+        child += 1u;
+      if (!less(begin[node], begin[child])) break;
+      ::sus::mem::swap(begin[node], begin[child]);
+      node = child;
+    }
+  };
+  for (size_t i = len / 2u; i > 0u; --i) sift_down(i - 1u, len);
+  for (size_t i = len - 1u; i > 0u; --i) {
+    ::sus::mem::swap(begin[0u], begin[i]);
+    sift_down(0u, i);
+  }
+}
+
+template <class T>
+struct PartitionResult {
+  T* pivot;
+  bool already_partitioned;
+};
+
+/// Partitions [begin, end) around the pivot `*begin`. Elements equal to the
+/// pivot go to the right of it. Returns the final position of the pivot, and
+/// whether the range was already partitioned.
+///
+/// Assumes the pivot is a median of at least 3 elements and that [begin, end)
+/// is at least `kInsertionSortThreshold` long.
+template <class T, class Less>
+constexpr PartitionResult<T> partition_right(T* begin, T* end,
+                                             Less& less) noexcept {
+  T pivot = ::sus::move(*begin);
+  T* first = begin;
+  T* last = end;
+
+  // Find the first element greater than or equal to the pivot (the median of 3
+  // guarantees this exists).
+  while (less(*++first, pivot)) {
+  }
+  // Find the first element strictly smaller than the pivot. We have to guard
+  // this search if there was no element before *first.
+  if (first - 1 == begin) {
+    while (first < last && !less(*--last, pivot)) {
+    }
+  } else {
+    while (!less(*--last, pivot)) {
+    }
+  }
+
+  // If the first pair of elements that should be swapped to partition are the
+  // same element, the passed in sequence already was correctly partitioned.
+  const bool already_partitioned = first >= last;
+
+  // Keep swapping pairs of elements that are on the wrong side of the pivot.
+  // Previously swapped pairs guard the searches, which is why the first
+  // iteration is special-cased above.
+  while (first < last) {
+    ::sus::mem::swap(*first, *last);
+    while (less(*++first, pivot)) {
+    }
+    while (!less(*--last, pivot)) {
+    }
+  }
+
+  T* pivot_pos = first - 1;
+  *begin = ::sus::move(*pivot_pos);
+  *pivot_pos = ::sus::move(pivot);
+  return PartitionResult<T>{pivot_pos, already_partitioned};
+}
+
+/// Moves the elements at the given offsets from `first` and `last` across to
+/// the other side. When `use_swaps` is false, a cyclic permutation is used
+/// instead of swaps, which halves the number of moves.
+template <class T>
+void swap_offsets(T* first, T* last, const unsigned char* offsets_l,
+                  const unsigned char* offsets_r, size_t num,
+                  bool use_swaps) noexcept {
+  if (use_swaps) {
+    // This case is needed for the descending distribution, where we need to
+    // have proper swapping for pdqsort to remain O(n).
+    for (size_t i = 0u; i < num; ++i)
+      ::sus::mem::swap(*(first + offsets_l[i]), *(last - offsets_r[i]));
+  } else if (num > 0u) {
+    T* l = first + offsets_l[0u];
+    T* r = last - offsets_r[0u];
+    T tmp = ::sus::move(*l);
+    *l = ::sus::move(*r);
+    for (size_t i = 1u; i < num; ++i) {
+      l = first + offsets_l[i];
+      *r = ::sus::move(*l);
+      r = last - offsets_r[i];
+      *l = ::sus::move(*r);
+    }
+    *r = ::sus::move(tmp);
+  }
+}
+
+/// Like `partition_right()` but uses BlockQuicksort's technique of recording
+/// the offsets of misplaced elements in a block with branch-free code, then
+/// swapping them in bulk. See "BlockQuicksort: How Branch Mispredictions don't
+/// affect Quicksort" by Edelkamp and Weiß.
+template <class T, class Less>
+PartitionResult<T> partition_right_branchless(T* begin, T* end,
+                                              Less& less) noexcept {
+  T pivot = ::sus::move(*begin);
+  T* first = begin;
+  T* last = end;
+
+  while (less(*++first, pivot)) {
+  }
+  if (first - 1 == begin) {
+    while (first < last && !less(*--last, pivot)) {
+    }
+  } else {
+    while (!less(*--last, pivot)) {
+    }
+  }
+
+  const bool already_partitioned = first >= last;
+  if (!already_partitioned) {
+    ::sus::mem::swap(*first, *last);
+    ++first;
+
+    alignas(64) unsigned char offsets_l_storage[kBlockSize];
+    alignas(64) unsigned char offsets_r_storage[kBlockSize];
+    unsigned char* offsets_l = offsets_l_storage;
+    unsigned char* offsets_r = offsets_r_storage;
+    T* offsets_l_base = first;
+    T* offsets_r_base = last;
+    size_t num_l = 0u, num_r = 0u, start_l = 0u, start_r = 0u;
+
+    while (first < last) {
+      // Fill up offset blocks with elements that are on the wrong side. First
+      // we determine how much elements are considered for each offset block.
+      const size_t num_unknown = static_cast<size_t>(last - first);
+      const size_t left_split =
+          num_l == 0u ? (num_r == 0u ? num_unknown / 2u : num_unknown) : 0u;
+      const size_t right_split = num_r == 0u ? (num_unknown - left_split) : 0u;
+
+      // The `less()` results are added to the counts instead of branched on.
+      if (left_split >= kBlockSize) {
+        for (size_t i = 0u; i < kBlockSize; ++i) {
+          offsets_l[num_l] = static_cast<unsigned char>(i);
+          num_l += !less(*first, pivot);
+          ++first;
+        }
+      } else {
+        for (size_t i = 0u; i < left_split; ++i) {
+          offsets_l[num_l] = static_cast<unsigned char>(i);
+          num_l += !less(*first, pivot);
+          ++first;
+        }
+      }
+      if (right_split >= kBlockSize) {
+        for (size_t i = 0u; i < kBlockSize;) {
+          offsets_r[num_r] = static_cast<unsigned char>(++i);
+          num_r += less(*--last, pivot);
+        }
+      } else {
+        for (size_t i = 0u; i < right_split;) {
+          offsets_r[num_r] = static_cast<unsigned char>(++i);
+          num_r += less(*--last, pivot);
+        }
+      }
+
+      // Swap elements and update block sizes and first/last boundaries.
+      const size_t num = num_l < num_r ? num_l : num_r;
+      swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l,
+                   offsets_r + start_r, num, num_l == num_r);
+      num_l -= num;
+      num_r -= num;
+      start_l += num;
+      start_r += num;
+
+      if (num_l == 0u) {
+        start_l = 0u;
+        offsets_l_base = first;
+      }
+      if (num_r == 0u) {
+        start_r = 0u;
+        offsets_r_base = last;
+      }
+    }
+
+    // We have now fully identified [first, last)'s proper position. Swap the
+    // last elements.
+    if (num_l > 0u) {
+      offsets_l += start_l;
+      while (num_l-- > 0u)
+        ::sus::mem::swap(*(offsets_l_base + offsets_l[num_l]), *--last);
+      first = last;
+    }
+    if (num_r > 0u) {
+      offsets_r += start_r;
+      while (num_r-- > 0u) {
+        ::sus::mem::swap(*(offsets_r_base - offsets_r[num_r]), *first);
+        ++first;
+      }
+      last = first;
+    }
+  }
+
+  T* pivot_pos = first - 1;
+  *begin = ::sus::move(*pivot_pos);
+  *pivot_pos = ::sus::move(pivot);
+  return PartitionResult<T>{pivot_pos, already_partitioned};
+}
+
+/// Partitions [begin, end) around the pivot `*begin`, with elements equal to
+/// the pivot going to the left of it. Returns the final position of the pivot.
+///
+/// This is used when the pivot is equal to the element before `begin`, in
+/// which case all of the elements equal to the pivot end up in their final
+/// position and need not be sorted further. This makes inputs with many
+/// duplicates O(n * log(k)) for k distinct values.
+template <class T, class Less>
+constexpr T* partition_left(T* begin, T* end, Less& less) noexcept {
+  T pivot = ::sus::move(*begin);
+  T* first = begin;
+  T* last = end;
+
+  while (less(pivot, *--last)) {
+  }
+  if (last + 1 == end) {
+    while (first < last && !less(pivot, *++first)) {
+    }
+  } else {
+    while (!less(pivot, *++first)) {
+    }
+  }
+
+  while (first < last) {
+    ::sus::mem::swap(*first, *last);
+    while (less(pivot, *--last)) {
+    }
+    while (!less(pivot, *++first)) {
+    }
+  }
+
+  T* pivot_pos = last;
+  *begin = ::sus::move(*pivot_pos);
+  *pivot_pos = ::sus::move(pivot);
+  return pivot_pos;
+}
+
+template <bool Branchless, class T, class Less>
+constexpr void sort_loop(T* begin, T* end, Less& less, int bad_allowed,
+                         bool leftmost) noexcept {
+  while (true) {
+    const size_t size = static_cast<size_t>(end - begin);
+
+    // Insertion sort is faster for small arrays.
+    if (size < kInsertionSortThreshold) {
+      if (leftmost)
+        insertion_sort(begin, end, less);
+      else
+        unguarded_insertion_sort(begin, end, less);
+      return;
+    }
+
+    // Choose pivot as median of 3 or pseudomedian of 9.
+    const size_t s2 = size / 2u;
+    if (size > kNintherThreshold) {
+      sort3(begin, begin + s2, end - 1, less);
+      sort3(begin + 1, begin + (s2 - 1u), end - 2, less);
+      sort3(begin + 2, begin + (s2 + 1u), end - 3, less);
+      sort3(begin + (s2 - 1u), begin + s2, begin + (s2 + 1u), less);
+      ::sus::mem::swap(*begin, *(begin + s2));
+    } else {
+      sort3(begin + s2, begin, end - 1, less);
+    }
+
+    // If *(begin - 1) is the end of the right partition of a previous
+    // partition operation, there is no element in [begin, end) that is smaller
+    // than *(begin - 1). Then if our pivot compares equal to *(begin - 1) we
+    // change strategy, putting equal elements in the left partition and
+    // greater elements in the right partition. We do not have to recurse on
+    // the left partition, since it's sorted (all equal).
+    if (!leftmost && !less(*(begin - 1), *begin)) {
+      begin = partition_left(begin, end, less) + 1;
+      continue;
+    }
+
+    PartitionResult<T> part = [&]() {
+      if constexpr (Branchless)
+        return partition_right_branchless(begin, end, less);
+      else
+        return partition_right(begin, end, less);
+    }();
+    T* const pivot_pos = part.pivot;
+
+    // Check for a highly unbalanced partition.
+    const size_t l_size = static_cast<size_t>(pivot_pos - begin);
+    const size_t r_size = static_cast<size_t>(end - (pivot_pos + 1));
+    const bool highly_unbalanced = l_size < size / 8u || r_size < size / 8u;
+
+    if (highly_unbalanced) {
+      // If we had too many bad partitions, switch to heapsort to guarantee
+      // O(n * log(n)).
+      if (--bad_allowed == 0) {
+        heapsort(begin, end, less);
+        return;
+      }
+
+      // Otherwise shuffle some elements around to break patterns that the
+      // pivot selection may be stuck on.
+      if (l_size >= kInsertionSortThreshold) {
+        ::sus::mem::swap(*begin, *(begin + l_size / 4u));
+        ::sus::mem::swap(*(pivot_pos - 1), *(pivot_pos - l_size / 4u));
+        if (l_size > kNintherThreshold) {
+          ::sus::mem::swap(*(begin + 1), *(begin + (l_size / 4u + 1u)));
+          ::sus::mem::swap(*(begin + 2), *(begin + (l_size / 4u + 2u)));
+          ::sus::mem::swap(*(pivot_pos - 2), *(pivot_pos - (l_size / 4u + 1u)));
+          ::sus::mem::swap(*(pivot_pos - 3), *(pivot_pos - (l_size / 4u + 2u)));
+        }
+      }
+      if (r_size >= kInsertionSortThreshold) {
+        ::sus::mem::swap(*(pivot_pos + 1), *(pivot_pos + (1u + r_size / 4u)));
+        ::sus::mem::swap(*(end - 1), *(end - r_size / 4u));
+        if (r_size > kNintherThreshold) {
+          ::sus::mem::swap(*(pivot_pos + 2), *(pivot_pos + (2u + r_size / 4u)));
+          ::sus::mem::swap(*(pivot_pos + 3), *(pivot_pos + (3u + r_size / 4u)));
+          ::sus::mem::swap(*(end - 2), *(end - (1u + r_size / 4u)));
+          ::sus::mem::swap(*(end - 3), *(end - (2u + r_size / 4u)));
+        }
+      }
+    } else {
+      // If we were decently balanced and we tried to sort an already
+      // partitioned sequence, try to use insertion sort.
+      if (part.already_partitioned &&
+          partial_insertion_sort(begin, pivot_pos, less) &&
+          partial_insertion_sort(pivot_pos + 1, end, less))
+        return;
+    }
+
+    // Sort the left partition first using recursion and do tail recursion
+    // elimination for the right-hand partition.
+    sort_loop<Branchless>(begin, pivot_pos, less, bad_allowed, leftmost);
+    begin = pivot_pos + 1;
+    leftmost = false;
+  }
+}
+
+/// Reverses [begin, end) in place.
+template <class T>
+constexpr void reverse(T* begin, T* end) noexcept {
+  while (end - begin > 1) {
+    --end;
+    ::sus::mem::swap(*begin, *end);
+    ++begin;
+  }
+}
+
+}  // namespace pdqsort
+
+/// Sorts the `len` elements at `data` in place, with `less(a, b)` returning
+/// whether `a` is strictly less than `b`. Equal elements may be reordered.
+template <class T, class Less>
+constexpr void sort_unstable(T* data, size_t len, Less& less) noexcept {
+  if (len < 2u) return;
+  T* const end = data + len;
+
+  // Find the length of the run at the start of the slice, which is either
+  // non-descending or strictly descending. A strictly descending run can be
+  // reversed without breaking the relative order of equal elements. If the
+  // run covers the whole slice we're done in O(n). Otherwise this typically
+  // stops after a couple of comparisons.
+  const bool descending = less(data[1u], data[0u]);
+  size_t run = 2u;
+  if (descending) {
+    while (run < len && less(data[run], data[run - 1u])) run += 1u;
+  } else {
+    while (run < len && !less(data[run], data[run - 1u])) run += 1u;
+  }
+  if (run == len) {
+    if (descending) pdqsort::reverse(data, end);
+    return;
+  }
+
+  const int bad_allowed = pdqsort::log2(len);
+  if constexpr (pdqsort::kUseBranchless<T>) {
+    if (!std::is_constant_evaluated()) {
+      pdqsort::sort_loop<true>(data, end, less, bad_allowed, true);
+      return;
+    }
+  }
+  pdqsort::sort_loop<false>(data, end, less, bad_allowed, true);
+}
+
+}  // namespace sus::collections::__private
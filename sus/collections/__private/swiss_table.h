@@ -0,0 +1,631 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <bit>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#  include <emmintrin.h>
+#  define _sus_swiss_sse2 1
+#  define _sus_swiss_neon 0
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define _sus_swiss_sse2 0
+#  define _sus_swiss_neon 1
+#else
+#  define _sus_swiss_sse2 0
+#  define _sus_swiss_neon 0
+#endif
+
+#include "sus/assertions/check.h"
+#include "sus/assertions/debug_check.h"
+#include "sus/marker/unsafe.h"
+#include "sus/mem/move.h"
+#include "sus/mem/relocate.h"
+#include "sus/mem/replace.h"
+#include "sus/num/__private/intrinsics.h"
+#include "sus/ptr/copy.h"
+
+// An open-addressing hash table in the style of Abseil's SwissTable and Rust's
+// hashbrown, which backs HashMap and HashSet.
+//
+// The elements live in a flat array of buckets, next to an array with one
+// control byte per bucket. A control byte is either EMPTY, DELETED (a
+// tombstone left by a removal) or holds the top 7 bits of the hash of the
+// element in the bucket (called h2). The rest of the hash (h1) picks where the
+// probe sequence starts.
+//
+// Lookups load a group of control bytes at once, 16 with SSE2 and 8 with NEON
+// or portable 64-bit arithmetic, and compare all of them against h2 to find
+// the few buckets whose element needs to be compared with the key. A group
+// with an EMPTY byte ends the probe. Groups are probed in triangular order,
+// which visits every group when the number of buckets is a power of two.
+//
+// The control bytes are followed by a copy of the first group, so that a
+// group can be loaded starting from any bucket without wrapping around. The
+// table always has at least one group's worth of buckets, and tables that
+// have not allocated point at a static group of EMPTY bytes, so that lookups
+// need no branches for those cases.
+//
+// The table is kept at most 7/8 full. Growing reallocates and reinserts every
+// element, which also clears out the tombstones. When tombstones make up most
+// of the used growth, the table is instead rebuilt into a new allocation of
+// the same size. There is no in-place rehash.
+
+namespace sus::collections::__private::swiss {
+
+/// The control byte for a bucket that has never held an element.
+inline constexpr uint8_t kEmpty = 0b1111'1111u;
+/// The control byte for a bucket whose element was removed.
+inline constexpr uint8_t kDeleted = 0b1000'0000u;
+
+/// Full buckets have a control byte with the high bit clear.
+constexpr inline bool is_full(uint8_t ctrl) noexcept {
+  return (ctrl & 0x80u) == 0u;
+}
+
+/// Spreads the bits of a `size_t` hash value across all 64 bits.
+///
+/// Hash values from `std::hash` are often the identity function for integers
+/// and pointers, which would leave the top bits (used for h2) empty and the
+/// low bits (used to choose a bucket) with little entropy.
+constexpr inline uint64_t mix(size_t hash) noexcept {
+  uint64_t x = hash;
+  x ^= x >> 32u;
+  x *= 0x9e37'79b9'7f4a'7c15u;
+  x ^= x >> 32u;
+  return x;
+}
+
+/// The portion of the hash that is stored in the control byte.
+constexpr inline uint8_t h2(uint64_t hash) noexcept {
+  return static_cast<uint8_t>(hash >> 57u);
+}
+
+/// A set of bytes in a group, as a bitmask with `kStride` bits per byte, of
+/// which only the highest may be set.
+template <class Bits, uint32_t kStride>
+class BitMask {
+ public:
+  explicit constexpr BitMask(Bits bits) noexcept : bits_(bits) {}
+
+  constexpr bool any() const noexcept { return bits_ != 0u; }
+
+  /// The index of the lowest byte in the set.
+  ///
+  /// # Safety
+  /// The set must not be empty.
+  constexpr size_t lowest(::sus::marker::UnsafeFnMarker) const noexcept {
+    return ::sus::num::__private::trailing_zeros_nonzero(
+               ::sus::marker::unsafe_fn, bits_) /
+           kStride;
+  }
+  constexpr void remove_lowest() noexcept {
+    bits_ = static_cast<Bits>(bits_ & (bits_ - 1u));
+  }
+
+  /// The number of bytes below the lowest byte in the set, or the whole group
+  /// if the set is empty.
+  constexpr size_t bytes_below_lowest() const noexcept {
+    return ::sus::num::__private::trailing_zeros(bits_) / kStride;
+  }
+  /// The number of bytes above the highest byte in the set, or the whole group
+  /// if the set is empty.
+  constexpr size_t bytes_above_highest() const noexcept {
+    return ::sus::num::__private::leading_zeros(bits_) / kStride;
+  }
+
+ private:
+  Bits bits_;
+};
+
+#if _sus_swiss_sse2
+
+struct Group {
+  static constexpr size_t kWidth = 16u;
+  using Mask = BitMask<uint16_t, 1u>;
+
+  static Group load(const uint8_t* p) noexcept {
+    return Group(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+  }
+
+  Mask match_byte(uint8_t b) const noexcept {
+    return Mask(static_cast<uint16_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(v_, _mm_set1_epi8(static_cast<char>(b))))));
+  }
+  Mask match_empty() const noexcept { return match_byte(kEmpty); }
+  Mask match_empty_or_deleted() const noexcept {
+    return Mask(static_cast<uint16_t>(_mm_movemask_epi8(v_)));
+  }
+  Mask match_full() const noexcept {
+    return Mask(static_cast<uint16_t>(~_mm_movemask_epi8(v_)));
+  }
+
+ private:
+  explicit Group(__m128i v) noexcept : v_(v) {}
+
+  __m128i v_;
+};
+
+#elif _sus_swiss_neon
+
+struct Group {
+  static constexpr size_t kWidth = 8u;
+  using Mask = BitMask<uint64_t, 8u>;
+
+  static Group load(const uint8_t* p) noexcept { return Group(vld1_u8(p)); }
+
+  Mask match_byte(uint8_t b) const noexcept {
+    return Mask(
+        vget_lane_u64(vreinterpret_u64_u8(vceq_u8(v_, vdup_n_u8(b))), 0) &
+        kMsbs);
+  }
+  Mask match_empty() const noexcept { return match_byte(kEmpty); }
+  Mask match_empty_or_deleted() const noexcept {
+    return Mask(vget_lane_u64(vreinterpret_u64_u8(v_), 0) & kMsbs);
+  }
+  Mask match_full() const noexcept {
+    return Mask(~vget_lane_u64(vreinterpret_u64_u8(v_), 0) & kMsbs);
+  }
+
+ private:
+  static constexpr uint64_t kMsbs = 0x8080'8080'8080'8080u;
+
+  explicit Group(uint8x8_t v) noexcept : v_(v) {}
+
+  uint8x8_t v_;
+};
+
+#else
+
+/// Compares 8 control bytes at a time with 64-bit integer arithmetic.
+struct Group {
+  static constexpr size_t kWidth = 8u;
+  using Mask = BitMask<uint64_t, 8u>;
+
+  static Group load(const uint8_t* p) noexcept {
+    // The first byte goes in the lowest bits regardless of endianness, which
+    // compiles to a single load on little endian machines.
+    uint64_t word = 0u;
+    for (size_t i = 0u; i < kWidth; ++i)
+      word |= uint64_t{p[i]} << (i * 8u);
+    return Group(word);
+  }
+
+  /// This may report bytes above a matching byte as matching when they differ
+  /// from `b` only in the lowest bit. Callers compare the elements in the
+  /// matching buckets, so false positives only cost a comparison.
+  Mask match_byte(uint8_t b) const noexcept {
+    const uint64_t x = word_ ^ (kLsbs * b);
+    return Mask((x - kLsbs) & ~x & kMsbs);
+  }
+  Mask match_empty() const noexcept {
+    // EMPTY is the only control byte with both of its top bits set.
+    return Mask(word_ & (word_ << 1u) & kMsbs);
+  }
+  Mask match_empty_or_deleted() const noexcept { return Mask(word_ & kMsbs); }
+  Mask match_full() const noexcept { return Mask(~word_ & kMsbs); }
+
+ private:
+  static constexpr uint64_t kLsbs = 0x0101'0101'0101'0101u;
+  static constexpr uint64_t kMsbs = 0x8080'8080'8080'8080u;
+
+  explicit Group(uint64_t word) noexcept : word_(word) {}
+
+  uint64_t word_;
+};
+
+#endif
+
+/// The control bytes of a table with no buckets, which make every lookup
+/// finish at the first group.
+alignas(Group::kWidth) inline constexpr uint8_t kEmptyGroup[Group::kWidth] = {
+    kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty,
+#if _sus_swiss_sse2
+    kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty,
+#endif
+};
+
+/// The element type of the table behind a `HashMap`.
+template <class K, class V>
+struct MapSlot {
+  MapSlot(K&& k, V&& v) noexcept
+      : key(::sus::move(k)), value(::sus::move(v)) {}
+
+  K key;
+  V value;
+};
+
+/// Iterates over the full buckets of a `RawTable`.
+template <class T>
+struct RawIter {
+  RawIter(const uint8_t* ctrl, T* slots, size_t items) noexcept
+      : next_ctrl_(ctrl + Group::kWidth),
+        slots_(slots),
+        current_(Group::load(ctrl).match_full()),
+        items_left_(items) {}
+
+  /// An iterator over no buckets.
+  static RawIter empty() noexcept { return RawIter(kEmptyGroup, nullptr, 0u); }
+
+  /// Returns the next full bucket, or nullptr once all the items have been
+  /// visited.
+  T* next() noexcept {
+    if (items_left_ == 0u) return nullptr;
+    // There is a full bucket ahead as `items_left_` is not zero, so this loop
+    // will not read past the end of the control bytes.
+    while (!current_.any()) {
+      current_ = Group::load(next_ctrl_).match_full();
+      next_ctrl_ += Group::kWidth;
+      slots_ += Group::kWidth;
+    }
+    const size_t i = current_.lowest(::sus::marker::unsafe_fn);
+    current_.remove_lowest();
+    items_left_ -= 1u;
+    return slots_ + i;
+  }
+
+  size_t items_left() const noexcept { return items_left_; }
+
+ private:
+  const uint8_t* next_ctrl_;
+  T* slots_;
+  Group::Mask current_;
+  size_t items_left_;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn,
+                                  decltype(next_ctrl_), decltype(slots_),
+                                  decltype(current_), decltype(items_left_));
+};
+
+/// The storage of a Swiss table holding elements of type `T`. The table does
+/// not know how to hash or compare its elements, these are provided by the
+/// caller of each operation.
+template <class T>
+class RawTable {
+ public:
+  RawTable() noexcept = default;
+
+  /// Constructs a table which can hold `capacity` elements without
+  /// reallocating.
+  explicit RawTable(size_t capacity) noexcept {
+    if (capacity > 0u) allocate(capacity_to_buckets(capacity));
+  }
+
+  ~RawTable() noexcept {
+    if (is_allocated()) {
+      destroy_all();
+      deallocate();
+    }
+  }
+
+  RawTable(RawTable&& o) noexcept
+      : ctrl_(::sus::mem::replace(o.ctrl_, empty_ctrl())),
+        slots_(::sus::mem::replace(o.slots_, nullptr)),
+        bucket_mask_(::sus::mem::replace(o.bucket_mask_, 0u)),
+        items_(::sus::mem::replace(o.items_, 0u)),
+        growth_left_(::sus::mem::replace(o.growth_left_, 0u)) {}
+  RawTable& operator=(RawTable&& o) noexcept {
+    if (is_allocated()) {
+      destroy_all();
+      deallocate();
+    }
+    ctrl_ = ::sus::mem::replace(o.ctrl_, empty_ctrl());
+    slots_ = ::sus::mem::replace(o.slots_, nullptr);
+    bucket_mask_ = ::sus::mem::replace(o.bucket_mask_, 0u);
+    items_ = ::sus::mem::replace(o.items_, 0u);
+    growth_left_ = ::sus::mem::replace(o.growth_left_, 0u);
+    return *this;
+  }
+
+  /// Copies the table, using `clone_fn(const T&) -> T` to copy each element
+  /// into the same bucket in the new table.
+  RawTable clone_with(auto&& clone_fn) const noexcept {
+    RawTable t;
+    if (!is_allocated()) return t;
+    t.allocate(buckets());
+    memcpy(t.ctrl_, ctrl_, num_ctrl_bytes());
+    auto it = iter();
+    while (T* slot = it.next()) {
+      std::construct_at(t.slots_ + (slot - slots_), clone_fn(*slot));
+    }
+    t.items_ = items_;
+    t.growth_left_ = growth_left_;
+    return t;
+  }
+
+  size_t len() const noexcept { return items_; }
+  size_t capacity() const noexcept { return items_ + growth_left_; }
+
+  RawIter<T> iter() const noexcept { return RawIter<T>(ctrl_, slots_, items_); }
+  RawIter<const T> iter_const() const noexcept {
+    return RawIter<const T>(ctrl_, slots_, items_);
+  }
+
+  /// Finds the element with the given `hash` for which `eq(const T&)` returns
+  /// true.
+  T* find(uint64_t hash, auto&& eq) const noexcept {
+    const uint8_t tag = h2(hash);
+    size_t pos = static_cast<size_t>(hash) & bucket_mask_;
+    size_t stride = 0u;
+    while (true) {
+      const Group g = Group::load(ctrl_ + pos);
+      for (auto m = g.match_byte(tag); m.any(); m.remove_lowest()) {
+        const size_t i =
+            (pos + m.lowest(::sus::marker::unsafe_fn)) & bucket_mask_;
+        if (eq(static_cast<const T&>(slots_[i]))) [[likely]]
+          return slots_ + i;
+      }
+      if (g.match_empty().any()) [[likely]]
+        return nullptr;
+      stride += Group::kWidth;
+      pos = (pos + stride) & bucket_mask_;
+    }
+  }
+
+  /// Claims a bucket for a new element with the given `hash`, growing the
+  /// table if needed, and returns it. The caller must construct the element
+  /// in the returned bucket before using the table again.
+  ///
+  /// The elements are rehashed with `hasher(const T&) -> uint64_t` if the
+  /// table grows.
+  T* prepare_insert(uint64_t hash, auto&& hasher) noexcept {
+    size_t i = find_insert_slot(hash);
+    // A tombstone can be reused without affecting the load factor, but an
+    // empty bucket needs growth to be left.
+    if (growth_left_ == 0u && ctrl_[i] == kEmpty) [[unlikely]] {
+      reserve_rehash(1u, hasher);
+      i = find_insert_slot(hash);
+    }
+    growth_left_ -= size_t{ctrl_[i] == kEmpty};
+    set_ctrl(i, h2(hash));
+    items_ += 1u;
+    return slots_ + i;
+  }
+
+  /// Destroys the element in `slot` and frees its bucket.
+  void erase(T* slot) noexcept {
+    const size_t i = static_cast<size_t>(slot - slots_);
+    std::destroy_at(slot);
+    // If there is no run of a full group's worth of full buckets through this
+    // bucket, no probe could have passed over it without finding an empty
+    // bucket, so it can be made empty instead of leaving a tombstone.
+    const size_t before = (i - Group::kWidth) & bucket_mask_;
+    const auto empty_before = Group::load(ctrl_ + before).match_empty();
+    const auto empty_after = Group::load(ctrl_ + i).match_empty();
+    if (empty_before.bytes_above_highest() + empty_after.bytes_below_lowest() >=
+        Group::kWidth) {
+      set_ctrl(i, kDeleted);
+    } else {
+      set_ctrl(i, kEmpty);
+      growth_left_ += 1u;
+    }
+    items_ -= 1u;
+  }
+
+  /// Ensures there is room for `additional` more elements, rehashing the
+  /// elements with `hasher(const T&) -> uint64_t` if the table grows.
+  void reserve(size_t additional, auto&& hasher) noexcept {
+    if (additional > growth_left_) [[unlikely]]
+      reserve_rehash(additional, hasher);
+  }
+
+  /// Shrinks the table as much as possible while still holding `min_capacity`
+  /// elements.
+  void shrink_to(size_t min_capacity, auto&& hasher) noexcept {
+    const size_t cap = items_ > min_capacity ? items_ : min_capacity;
+    if (cap == 0u) {
+      if (is_allocated()) {
+        destroy_all();
+        deallocate();
+        reset();
+      }
+      return;
+    }
+    const size_t new_buckets = capacity_to_buckets(cap);
+    if (new_buckets < buckets()) resize(new_buckets, hasher);
+  }
+
+  /// Frees the buckets without destroying the elements in them, which the
+  /// caller has already moved out or destroyed.
+  void free_without_destroying() noexcept {
+    if (is_allocated()) {
+      deallocate();
+      reset();
+    }
+  }
+
+  /// Marks a table that was moved from. It has no buckets but is not empty,
+  /// which is otherwise impossible, so that its owner can detect use after
+  /// move.
+  void mark_moved_from() noexcept {
+    sus_debug_check(!is_allocated());
+    items_ = 1u;
+  }
+  bool is_moved_from() const noexcept {
+    return !is_allocated() && items_ != 0u;
+  }
+
+  /// Destroys all elements, keeping the allocated buckets.
+  void clear() noexcept {
+    if (items_ == 0u) return;
+    destroy_all();
+    memset(ctrl_, kEmpty, num_ctrl_bytes());
+    items_ = 0u;
+    growth_left_ = bucket_mask_to_capacity(bucket_mask_);
+  }
+
+ private:
+  static uint8_t* empty_ctrl() noexcept {
+    // The static group is never written to, as a table with no buckets always
+    // allocates before inserting.
+    return const_cast<uint8_t*>(kEmptyGroup);
+  }
+
+  /// The number of buckets needed to hold `cap` elements, keeping the table
+  /// at most 7/8 full.
+  static size_t capacity_to_buckets(size_t cap) noexcept {
+    sus_check_with_message(cap <= SIZE_MAX / 16u, "capacity overflow");
+    const size_t adjusted = (cap * 8u + 6u) / 7u;
+    return std::bit_ceil(adjusted > Group::kWidth ? adjusted : Group::kWidth);
+  }
+  static size_t bucket_mask_to_capacity(size_t bucket_mask) noexcept {
+    return bucket_mask == 0u ? 0u : (bucket_mask + 1u) / 8u * 7u;
+  }
+
+  bool is_allocated() const noexcept { return bucket_mask_ != 0u; }
+  size_t buckets() const noexcept {
+    return is_allocated() ? bucket_mask_ + 1u : 0u;
+  }
+  size_t num_ctrl_bytes() const noexcept {
+    return bucket_mask_ + 1u + Group::kWidth;
+  }
+
+  static constexpr size_t kAlign =
+      alignof(T) > Group::kWidth ? alignof(T) : Group::kWidth;
+  /// The slots come first in the allocation, followed by the control bytes.
+  static size_t ctrl_offset(size_t buckets) noexcept {
+    return (sizeof(T) * buckets + Group::kWidth - 1u) & ~(Group::kWidth - 1u);
+  }
+  static size_t allocation_size(size_t buckets) noexcept {
+    return ctrl_offset(buckets) + buckets + Group::kWidth;
+  }
+
+  /// Allocates empty storage for `buckets` buckets, without freeing the
+  /// previous storage.
+  void allocate(size_t buckets) noexcept {
+    sus_check_with_message(buckets <= SIZE_MAX / 2u / sizeof(T),
+                           "capacity overflow");
+    void* const p = ::operator new(allocation_size(buckets),
+                                   std::align_val_t(kAlign), std::nothrow);
+    sus_check_with_message(p != nullptr, "HashMap allocation failed");
+    slots_ = static_cast<T*>(p);
+    ctrl_ = static_cast<uint8_t*>(p) + ctrl_offset(buckets);
+    bucket_mask_ = buckets - 1u;
+    memset(ctrl_, kEmpty, num_ctrl_bytes());
+    items_ = 0u;
+    growth_left_ = bucket_mask_to_capacity(bucket_mask_);
+  }
+  void deallocate() noexcept {
+    ::operator delete(static_cast<void*>(slots_), std::align_val_t(kAlign));
+  }
+
+  void destroy_all() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      auto it = iter();
+      while (T* slot = it.next()) std::destroy_at(slot);
+    }
+  }
+
+  /// Sets the control byte for bucket `i`, and its copy after the last bucket
+  /// if `i` is in the first group.
+  void set_ctrl(size_t i, uint8_t c) noexcept {
+    ctrl_[i] = c;
+    ctrl_[((i - Group::kWidth) & bucket_mask_) + Group::kWidth] = c;
+  }
+
+  /// Finds the first empty or deleted bucket in the probe sequence of `hash`.
+  /// There is always one, as the table is never completely full, except when
+  /// it has no buckets and the result is past the end.
+  size_t find_insert_slot(uint64_t hash) const noexcept {
+    size_t pos = static_cast<size_t>(hash) & bucket_mask_;
+    size_t stride = 0u;
+    while (true) {
+      const auto m = Group::load(ctrl_ + pos).match_empty_or_deleted();
+      if (m.any()) [[likely]]
+        return (pos + m.lowest(::sus::marker::unsafe_fn)) & bucket_mask_;
+      stride += Group::kWidth;
+      pos = (pos + stride) & bucket_mask_;
+    }
+  }
+
+  void reserve_rehash(size_t additional, auto& hasher) noexcept {
+    sus_check_with_message(additional <= SIZE_MAX - items_,
+                           "capacity overflow");
+    const size_t new_items = items_ + additional;
+    const size_t full_capacity = bucket_mask_to_capacity(bucket_mask_);
+    if (new_items <= full_capacity / 2u) {
+      // Most of the growth was used up by tombstones, which are cleared by
+      // rebuilding the table at the same size.
+      resize(buckets(), hasher);
+    } else {
+      resize(capacity_to_buckets(new_items > full_capacity + 1u
+                                     ? new_items
+                                     : full_capacity + 1u),
+             hasher);
+    }
+  }
+
+  /// Moves every element into a new allocation of `new_buckets` buckets.
+  void resize(size_t new_buckets, auto& hasher) noexcept {
+    RawTable old = ::sus::move(*this);
+    allocate(new_buckets);
+    auto it = old.iter();
+    while (T* slot = it.next()) {
+      const uint64_t hash = hasher(static_cast<const T&>(*slot));
+      const size_t i = find_insert_slot(hash);
+      set_ctrl(i, h2(hash));
+      // SAFETY: The bucket at `i` was empty in the new allocation, and the
+      // element's bucket in `old` is not visited again.
+      if constexpr (::sus::mem::TriviallyRelocatable<T>) {
+        ::sus::ptr::copy_nonoverlapping(::sus::marker::unsafe_fn, slot,
+                                        slots_ + i, 1u);
+      } else {
+        std::construct_at(slots_ + i, ::sus::move(*slot));
+        std::destroy_at(slot);
+      }
+    }
+    items_ = old.items_;
+    growth_left_ -= items_;
+    // The elements were all moved out of `old`.
+    old.free_without_destroying();
+  }
+
+  /// Returns to the state of a table with no buckets, without freeing them.
+  void reset() noexcept {
+    ctrl_ = empty_ctrl();
+    slots_ = nullptr;
+    bucket_mask_ = 0u;
+    items_ = 0u;
+    growth_left_ = 0u;
+  }
+
+  uint8_t* ctrl_ = empty_ctrl();
+  T* slots_ = nullptr;
+  /// One less than the number of buckets, or zero when nothing is allocated.
+  size_t bucket_mask_ = 0u;
+  size_t items_ = 0u;
+  /// The number of elements that can be inserted into empty buckets before
+  /// the table needs to grow.
+  size_t growth_left_ = 0u;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(ctrl_),
+                                  decltype(slots_), decltype(bucket_mask_),
+                                  decltype(items_), decltype(growth_left_));
+};
+
+}  // namespace sus::collections::__private::swiss
+
+#undef _sus_swiss_sse2
+#undef _sus_swiss_neon
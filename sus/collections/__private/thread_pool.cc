@@ -0,0 +1,107 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/collections/__private/thread_pool.h"
+
+#include <algorithm>
+
+namespace sus::collections::__private {
+
+ThreadPool& ThreadPool::global() noexcept {
+  static ThreadPool pool([]() -> size_t {
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw > 1u ? hw - 1u : 0u;
+  }());
+  return pool;
+}
+
+ThreadPool::ThreadPool(size_t num_workers) noexcept {
+  workers_.reserve(num_workers);
+  for (size_t i = 0u; i < num_workers; ++i)
+    workers_.emplace_back([this]() { worker_loop(); });
+}
+
+ThreadPool::~ThreadPool() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (std::thread& t : workers_) t.join();
+}
+
+void ThreadPool::push(Job* job) noexcept {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(job);
+  }
+  cv_.notify_one();
+}
+
+bool ThreadPool::try_take(Job* job) noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The job is most likely still at the back, where it was pushed.
+  auto it = std::find(queue_.rbegin(), queue_.rend(), job);
+  if (it == queue_.rend()) return false;
+  queue_.erase(std::next(it).base());
+  return true;
+}
+
+void ThreadPool::wait(Job* job) noexcept {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!job->done.load(std::memory_order_acquire)) {
+    if (!queue_.empty()) {
+      // Help with other work instead of sleeping.
+      Job* other = queue_.back();
+      queue_.pop_back();
+      lock.unlock();
+      execute(other);
+      lock.lock();
+    } else {
+      cv_.wait(lock);
+    }
+  }
+}
+
+void ThreadPool::execute(Job* job) noexcept {
+  job->run(job);
+  {
+    // Hold the lock while marking the job done, so that a thread in `wait()`
+    // can not miss the notification between checking `done` and sleeping.
+    std::lock_guard<std::mutex> lock(mutex_);
+    job->done.store(true, std::memory_order_release);
+  }
+  cv_.notify_all();
+}
+
+void ThreadPool::worker_loop() noexcept {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    if (!queue_.empty()) {
+      // Take the oldest job, which is the largest piece of work when jobs are
+      // split recursively.
+      Job* job = queue_.front();
+      queue_.pop_front();
+      lock.unlock();
+      execute(job);
+      lock.lock();
+    } else if (stopping_) {
+      return;
+    } else {
+      cv_.wait(lock);
+    }
+  }
+}
+
+}  // namespace sus::collections::__private
@@ -0,0 +1,126 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sus::collections::__private {
+
+/// A fork-join thread pool which runs the parallel slice algorithms.
+///
+/// Work is submitted with `join()`, which runs two functions, possibly in
+/// parallel, and returns once both have completed. While a thread waits for
+/// the other half of a `join()` to be completed by another thread, it runs
+/// other queued jobs, so nested joins can not deadlock.
+class ThreadPool final {
+ public:
+  /// Returns the pool shared by the parallel algorithms. It is started on first
+  /// use with one worker per hardware thread, less one for the calling thread.
+  static ThreadPool& global() noexcept;
+
+  /// Starts a pool with `num_workers` threads. With no workers, all jobs run on
+  /// the calling thread.
+  explicit ThreadPool(size_t num_workers) noexcept;
+  ~ThreadPool() noexcept;
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// The number of threads that can run jobs, including the calling thread.
+  size_t num_threads() const noexcept { return workers_.size() + 1u; }
+
+  /// Runs `a()` and `b()`, possibly in parallel, and returns when both have
+  /// completed. The functions must be safe to run concurrently.
+  template <class A, class B>
+  void join(A& a, B& b) noexcept {
+    if (workers_.empty()) {
+      a();
+      b();
+      return;
+    }
+    JobFor<B> job(b);
+    push(&job);
+    a();
+    // If no worker picked up `b` while we ran `a`, run it here instead.
+    if (try_take(&job))
+      b();
+    else
+      wait(&job);
+  }
+
+  /// Runs `f(i)` for each `i` in [0, n), possibly in parallel, and returns
+  /// when all have completed.
+  template <class F>
+  void for_each_index(size_t n, F& f) noexcept {
+    for_each_index_in(0u, n, f);
+  }
+
+ private:
+  struct Job {
+    void (*run)(Job*) noexcept;
+    std::atomic<bool> done = false;
+  };
+
+  template <class F>
+  struct JobFor final : Job {
+    explicit JobFor(F& f) noexcept : Job{&JobFor::run_job}, f(f) {}
+    static void run_job(Job* job) noexcept {
+      auto* self = static_cast<JobFor*>(job);
+      self->f();
+    }
+    F& f;
+  };
+
+  template <class F>
+  void for_each_index_in(size_t lo, size_t hi, F& f) noexcept {
+    if (hi - lo == 1u) {
+      f(lo);
+    } else if (hi > lo) {
+      const size_t mid = lo + (hi - lo) / 2u;
+      auto left = [&]() { for_each_index_in(lo, mid, f); };
+      auto right = [&]() { for_each_index_in(mid, hi, f); };
+      join(left, right);
+    }
+  }
+
+  /// Queues a job for the workers.
+  void push(Job* job) noexcept;
+  /// Removes the job from the queue if no thread has started it yet, and
+  /// returns whether it did.
+  bool try_take(Job* job) noexcept;
+  /// Runs other jobs until `job` is completed by another thread.
+  void wait(Job* job) noexcept;
+  /// Runs a job and marks it done.
+  void execute(Job* job) noexcept;
+  void worker_loop() noexcept;
+
+  std::mutex mutex_;
+  /// Signalled when a job is queued or completed.
+  std::condition_variable cv_;
+  std::deque<Job*> queue_;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace sus::collections::__private
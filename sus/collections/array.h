@@ -31,6 +31,7 @@
 #include "sus/collections/slice.h"
 #include "sus/construct/default.h"
 #include "sus/fn/fn_concepts.h"
+#include "sus/hash/hash.h"
 #include "sus/iter/iterator_loop.h"
 #include "sus/macros/__private/compiler_bugs.h"
 #include "sus/macros/lifetimebound.h"
@@ -627,6 +628,19 @@ struct tuple_element<I, ::sus::collections::Array<T, N>> {
 };
 }  // namespace std
 
+// sus::hash::Hash support.
+template <class T, size_t N>
+  requires(::sus::hash::Hash<T>)
+struct sus::hash::HashImpl<::sus::collections::Array<T, N>> {
+  /// An `Array` hashes the same as a [`Slice`]($sus::collections::Slice) of
+  /// its elements.
+  template <::sus::hash::Hasher H>
+  _sus_always_inline static constexpr void hash(
+      const ::sus::collections::Array<T, N>& a, H& state) noexcept {
+    ::sus::hash::hash_into(a.as_slice(), state);
+  }
+};
+
 // fmt support.
 template <class T, size_t N, class Char>
 struct fmt::formatter<::sus::collections::Array<T, N>, Char> {
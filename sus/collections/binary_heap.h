@@ -0,0 +1,607 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <type_traits>
+
+#include "fmt/core.h"
+#include "sus/assertions/check.h"
+#include "sus/assertions/panic.h"
+#include "sus/cmp/ord.h"
+#include "sus/collections/collections.h"
+#include "sus/collections/iterators/binary_heap_iter.h"
+#include "sus/collections/iterators/drain.h"
+#include "sus/collections/iterators/slice_iter.h"
+#include "sus/collections/iterators/vec_iter.h"
+#include "sus/collections/slice.h"
+#include "sus/collections/vec.h"
+#include "sus/iter/from_iterator.h"
+#include "sus/iter/into_iterator.h"
+#include "sus/iter/iterator_ref.h"
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/macros/lifetimebound.h"
+#include "sus/macros/no_unique_address.h"
+#include "sus/macros/pure.h"
+#include "sus/marker/empty.h"
+#include "sus/mem/clone.h"
+#include "sus/mem/move.h"
+#include "sus/mem/relocate.h"
+#include "sus/mem/replace.h"
+#include "sus/mem/swap.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/ops/range.h"
+#include "sus/option/option.h"
+#include "sus/string/__private/any_formatter.h"
+#include "sus/string/__private/format_to_stream.h"
+
+namespace sus::collections {
+
+/// A mutable reference to the greatest element of a `DaryHeap`.
+///
+/// This type is returned from `DaryHeap::peek_mut()`. When it is destroyed,
+/// the element is moved down the heap to restore the heap order, as it may
+/// have been changed through the `PeekMut`.
+///
+/// # Panics
+///
+/// Like [`Drain`]($sus::collections::Drain) for a `Vec`, `PeekMut` points at
+/// the heap it was created from, so it can be move-constructed but it will
+/// panic on move-assignment.
+template <class T, size_t D>
+class [[nodiscard]] PeekMut final {
+ public:
+  constexpr PeekMut(PeekMut&& rhs) noexcept
+      : heap_(::sus::mem::replace(rhs.heap_, nullptr)),
+        ref_(::sus::move(rhs.ref_)) {}
+
+  /// `PeekMut` may be move-constructed in order to be stored as a member of
+  /// other objects, but it can not be assigned-to. See the class
+  /// documentation for more.
+  ///
+  /// # Panics
+  ///
+  /// Calling this function will always panic.
+  constexpr PeekMut& operator=(PeekMut&&) noexcept {
+    ::sus::panic("attempt to assign to PeekMut");
+  }
+
+  constexpr ~PeekMut() noexcept {
+    // The `heap_` is null if the `PeekMut` was moved from or popped.
+    if (heap_ != nullptr) heap_->sift_down_range(0u, heap_->data_.len());
+  }
+
+  /// Returns a reference to the greatest element of the heap.
+  _sus_pure constexpr const T& operator*() const& noexcept {
+    return *heap_->data_.as_ptr();
+  }
+  /// Returns a mutable reference to the greatest element of the heap.
+  _sus_pure constexpr T& operator*() & noexcept {
+    return *heap_->data_.as_mut_ptr();
+  }
+  /// Returns a pointer to the greatest element of the heap.
+  _sus_pure constexpr const T* operator->() const& noexcept {
+    return heap_->data_.as_ptr();
+  }
+  /// Returns a mutable pointer to the greatest element of the heap.
+  _sus_pure constexpr T* operator->() & noexcept {
+    return heap_->data_.as_mut_ptr();
+  }
+
+  /// Removes the peeked element from the heap and returns it.
+  constexpr T pop() && noexcept {
+    DaryHeap<T, D>* const heap = ::sus::mem::replace(heap_, nullptr);
+    // Release the hold on the heap, so it can be used once this returns.
+    ::sus::iter::IterRef released = ::sus::move(ref_);
+    return heap->pop_internal().unwrap_unchecked(::sus::marker::unsafe_fn);
+  }
+
+ private:
+  template <class, size_t>
+  friend class DaryHeap;
+
+  explicit constexpr PeekMut(DaryHeap<T, D>& heap sus_lifetimebound,
+                             ::sus::iter::IterRef ref) noexcept
+      : heap_(&heap), ref_(::sus::move(ref)) {}
+
+  DaryHeap<T, D>* heap_;
+  // Prevents the heap from being mutated while the element is peeked.
+  [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(heap_),
+                                  decltype(ref_));
+};
+
+/// A priority queue implemented with a `D`-ary max-heap stored in a
+/// [`Vec`]($sus::collections::Vec).
+///
+/// The greatest element, as ordered by [`Ord`]($sus::cmp::Ord), is at the
+/// front of the queue. Use [`Reverse`]($sus::cmp::Reverse) to make a min-heap
+/// where the least element is at the front.
+///
+/// Each node of the heap has `D` children. A
+/// [`BinaryHeap`]($sus::collections::BinaryHeap) is a `DaryHeap` with
+/// `D = 2`. A larger `D` makes the heap shallower, so pushing does fewer
+/// comparisons and popping touches fewer cache lines, as the children of a
+/// node are next to each other in memory. A 4-ary heap is often faster than a
+/// binary heap for queues that are popped as much as they are pushed, such as
+/// timer queues.
+///
+/// | Operation | Cost |
+/// | --------- | ---- |
+/// | `push` | O(1) expected, O(log n) worst |
+/// | `pop` | O(log n) |
+/// | `peek` | O(1) |
+/// | `from` a `Vec`, or `collect` | O(n) |
+///
+/// An element must not be changed in a way that changes its ordering relative
+/// to the other elements while it is in the heap, except through
+/// [`PeekMut`]($sus::collections::PeekMut), which restores the heap order.
+///
+/// Like `Vec`, the heap tracks its iterators, and will panic if it is mutated
+/// while any of them are alive.
+template <class T, size_t D>
+class DaryHeap final {
+  static_assert(D >= 2u, "A heap node must have at least 2 children.");
+  static_assert(!std::is_reference_v<T>,
+                "DaryHeap must hold value types. Use pointers instead of "
+                "references.");
+  static_assert(!std::is_const_v<T>,
+                "`DaryHeap<const T>` should be written `const DaryHeap<T>`, "
+                "as const applies transitively.");
+  static_assert(::sus::cmp::Ord<T>, "The element type must satisfy `Ord`.");
+
+ public:
+  /// Constructs an empty heap.
+  ///
+  /// The heap will not allocate until elements are pushed onto it.
+  ///
+  /// This constructor also satisfies `sus::construct::Default`.
+  explicit constexpr DaryHeap() noexcept : DaryHeap(FROM_PARTS, Vec<T>()) {}
+
+  /// Constructs an empty heap.
+  ///
+  /// This constructor is implicit so that using the [`EmptyMarker`](
+  /// $sus::marker::EmptyMarker) allows the caller to avoid spelling out the
+  /// full heap type.
+  /// #[doc.overloads=empty]
+  constexpr DaryHeap(::sus::marker::EmptyMarker) noexcept : DaryHeap() {}
+
+  /// Creates an empty heap which can hold at least `capacity` elements
+  /// without reallocating.
+  ///
+  /// # Panics
+  /// Panics if the capacity exceeds `isize::MAX` bytes.
+  _sus_pure static constexpr DaryHeap with_capacity(usize capacity) noexcept {
+    return DaryHeap(FROM_PARTS, Vec<T>::with_capacity(capacity));
+  }
+
+  /// Converts a `Vec` into a heap, by reordering its elements in place.
+  ///
+  /// This takes O(n) time, which is faster than pushing the elements one at
+  /// a time.
+  ///
+  /// Satisfies the [`From<Vec<T>>`]($sus::construct::From) concept.
+  static constexpr DaryHeap from(Vec<T> vec) noexcept {
+    auto heap = DaryHeap(FROM_PARTS, ::sus::move(vec));
+    heap.rebuild();
+    return heap;
+  }
+
+  /// Satisifes the [`Move`]($sus::mem::Move) concept.
+  /// #[doc.overloads=daryheap.move]
+  constexpr DaryHeap(DaryHeap&& o) noexcept
+      : iter_refs_(o.iter_refs_.take_for_owner()),
+        data_(::sus::move(o.data_)) {
+    sus_check(!has_iterators());
+  }
+  /// Satisifes the [`Move`]($sus::mem::Move) concept.
+  /// #[doc.overloads=daryheap.move]
+  constexpr DaryHeap& operator=(DaryHeap&& o) noexcept {
+    sus_check(!has_iterators());
+    sus_check(!o.has_iterators());
+    iter_refs_ = o.iter_refs_.take_for_owner();
+    data_ = ::sus::move(o.data_);
+    return *this;
+  }
+
+  /// Satisfies the [`Clone`]($sus::mem::Clone) concept.
+  constexpr DaryHeap clone() const& noexcept
+    requires(::sus::mem::Clone<T>)
+  {
+    return DaryHeap(FROM_PARTS, ::sus::clone(data_));
+  }
+
+  constexpr ~DaryHeap() = default;
+
+  /// Returns the number of elements in the heap.
+  _sus_pure constexpr usize len() const& noexcept { return data_.len(); }
+
+  /// Returns `true` if the heap contains no elements.
+  _sus_pure constexpr bool is_empty() const& noexcept {
+    return data_.is_empty();
+  }
+
+  /// Returns the number of elements the heap can hold without reallocating.
+  _sus_pure constexpr usize capacity() const& noexcept {
+    return data_.capacity();
+  }
+
+  /// Reserves capacity for at least `additional` more elements to be pushed
+  /// onto the heap.
+  ///
+  /// # Panics
+  /// Panics if the new capacity exceeds `isize::MAX` bytes.
+  constexpr void reserve(usize additional) noexcept {
+    sus_check(!has_iterators());
+    data_.reserve(additional);
+  }
+
+  /// Reserves the minimum capacity for at least `additional` more elements to
+  /// be pushed onto the heap.
+  ///
+  /// # Panics
+  /// Panics if the new capacity exceeds `isize::MAX` bytes.
+  constexpr void reserve_exact(usize additional) noexcept {
+    sus_check(!has_iterators());
+    data_.reserve_exact(additional);
+  }
+
+  /// Removes all elements from the heap.
+  ///
+  /// Note that this method has no effect on the allocated capacity of the
+  /// heap.
+  constexpr void clear() noexcept {
+    sus_check(!has_iterators());
+    data_.clear();
+  }
+
+  /// Returns a reference to the greatest element in the heap, or `None` if it
+  /// is empty.
+  _sus_pure constexpr Option<const T&> peek() const& noexcept {
+    return data_.first();
+  }
+  constexpr Option<const T&> peek() && = delete;
+
+  /// Returns a mutable reference to the greatest element in the heap, or
+  /// `None` if it is empty.
+  ///
+  /// The element may be changed through the returned
+  /// [`PeekMut`]($sus::collections::PeekMut), and the heap order is restored
+  /// when the `PeekMut` is destroyed. This costs O(log n) in the worst case,
+  /// but is cheaper than popping and pushing the element again. The
+  /// `PeekMut` can also `pop()` the element from the heap.
+  constexpr Option<PeekMut<T, D>> peek_mut() & noexcept sus_lifetimebound {
+    sus_check(!has_iterators());
+    if (data_.is_empty()) return Option<PeekMut<T, D>>();
+    return Option<PeekMut<T, D>>(
+        PeekMut<T, D>(*this, iter_refs_.to_iter_from_owner()));
+  }
+
+  /// Pushes an element onto the heap.
+  ///
+  /// # Panics
+  /// Panics if the new capacity exceeds `isize::MAX` bytes.
+  constexpr void push(T t) noexcept
+    requires(::sus::mem::Move<T>)
+  {
+    sus_check(!has_iterators());
+    data_.push(::sus::move(t));
+    sift_up(data_.len() - 1u);
+  }
+
+  /// Removes the greatest element from the heap and returns it, or `None` if
+  /// it is empty.
+  constexpr Option<T> pop() noexcept {
+    sus_check(!has_iterators());
+    return pop_internal();
+  }
+
+  /// Returns a slice of all the elements in the underlying `Vec`, in an
+  /// arbitrary order.
+  _sus_pure constexpr Slice<T> as_slice() const& noexcept sus_lifetimebound {
+    return data_.as_slice();
+  }
+  constexpr Slice<T> as_slice() && = delete;
+
+  /// Returns an iterator over the elements of the heap, in an arbitrary
+  /// order.
+  constexpr SliceIter<const T&> iter() const& noexcept sus_lifetimebound {
+    return data_.iter();
+  }
+  constexpr SliceIter<const T&> iter() && = delete;
+
+  /// Consumes the heap into an iterator over its elements, in an arbitrary
+  /// order.
+  constexpr VecIntoIter<T> into_iter() && noexcept {
+    sus_check(!has_iterators());
+    return ::sus::move(data_).into_iter();
+  }
+
+  /// Consumes the heap and returns the underlying `Vec`, with the elements in
+  /// an arbitrary order.
+  constexpr Vec<T> into_vec() && noexcept {
+    sus_check(!has_iterators());
+    return ::sus::move(data_);
+  }
+
+  /// Consumes the heap and returns a `Vec` of its elements in ascending
+  /// order.
+  ///
+  /// The elements are sorted in place with a heap sort, which does not
+  /// allocate.
+  constexpr Vec<T> into_sorted_vec() && noexcept {
+    sus_check(!has_iterators());
+    usize end = data_.len();
+    T* const p = data_.as_mut_ptr();
+    while (end > 1u) {
+      end -= 1u;
+      ::sus::mem::swap(*p, *(p + end));
+      sift_down_range(0u, end);
+    }
+    return ::sus::move(data_);
+  }
+
+  /// Removes all the elements from the heap, returning them as an iterator
+  /// in an arbitrary order.
+  ///
+  /// The heap will panic on use while the [`Drain`]($sus::collections::Drain)
+  /// iterator is alive.
+  constexpr Drain<T> drain() noexcept {
+    sus_check(!has_iterators());
+    return data_.drain(::sus::ops::RangeFull<usize>());
+  }
+
+  /// Removes all the elements from the heap, returning them as an iterator
+  /// in heap order, from the greatest element to the least.
+  ///
+  /// Each element is popped as it is visited, so consuming the whole iterator
+  /// costs O(n log n). The elements that are not visited are removed from the
+  /// heap without ordering them when the iterator is destroyed.
+  ///
+  /// The heap will panic if mutated while the
+  /// [`DrainSorted`]($sus::collections::DrainSorted) iterator is alive.
+  constexpr DrainSorted<T, D> drain_sorted() & noexcept sus_lifetimebound {
+    sus_check(!has_iterators());
+    return DrainSorted<T, D>(*this, iter_refs_.to_iter_from_owner());
+  }
+
+  /// Pushes each element from the iterator onto the heap.
+  ///
+  /// When many elements are added relative to the size of the heap, they are
+  /// appended to the end and the whole heap is rebuilt in O(n), instead of
+  /// pushing them one at a time.
+  ///
+  /// Satisfies the [`Extend<T>`]($sus::iter::Extend) concept.
+  constexpr void extend(::sus::iter::IntoIterator<T> auto&& ii) noexcept
+    requires(::sus::mem::IsMoveRef<decltype(ii)>)
+  {
+    sus_check(!has_iterators());
+    const usize start = data_.len();
+    data_.extend(::sus::move(ii));
+    rebuild_tail(start);
+  }
+
+  /// Moves all the elements of `other` into `self`, leaving `other` empty.
+  constexpr void append(DaryHeap& other) noexcept {
+    sus_check(!has_iterators() && !other.has_iterators());
+    // Move the smaller heap's elements into the larger one.
+    if (data_.len() < other.data_.len()) ::sus::mem::swap(data_, other.data_);
+    const usize start = data_.len();
+    data_.append(other.data_);
+    rebuild_tail(start);
+  }
+
+  // Stream support.
+  _sus_format_to_stream(DaryHeap);
+
+ private:
+  template <class, size_t>
+  friend class PeekMut;
+  template <class, size_t>
+  friend struct DrainSorted;
+
+  enum FromParts { FROM_PARTS };
+  explicit constexpr DaryHeap(FromParts, Vec<T> data) noexcept
+      : iter_refs_(::sus::iter::IterRefCounter::for_owner()),
+        data_(::sus::move(data)) {}
+
+  constexpr Option<T> pop_internal() noexcept {
+    Option<T> last = data_.pop();
+    if (last.is_some() && !data_.is_empty()) {
+      ::sus::mem::swap(*data_.as_mut_ptr(), last.as_value_mut());
+      sift_down_to_bottom(0u);
+    }
+    return last;
+  }
+
+  /// Returns whether the node at `pos` has any children among the first `end`
+  /// elements.
+  static constexpr bool has_children(usize pos, usize end) noexcept {
+    // The first child is at `pos * D + 1`, which is written to avoid
+    // overflow.
+    return end > 1u && pos <= (end - 2u) / D;
+  }
+  /// Returns the greatest of the children of the node at `pos`, among the
+  /// first `end` elements. The node must have children.
+  constexpr usize greatest_child(const T* p, usize pos,
+                                 usize end) const noexcept {
+    const usize first = pos * D + 1u;
+    const usize last = end - first < D ? end : first + D;
+    usize best = first;
+    for (usize c = first + 1u; c < last; c += 1u) {
+      if (*(p + best) < *(p + c)) best = c;
+    }
+    return best;
+  }
+
+  /// Moves the element at `pos` toward the root until it is not greater than
+  /// its parent.
+  ///
+  /// The element is held aside while its ancestors are moved down into the
+  /// hole it leaves, which moves each of them once instead of swapping.
+  constexpr void sift_up(usize pos) noexcept {
+    T* const p = data_.as_mut_ptr();
+    if (pos == 0u) return;
+    T elem = ::sus::move(*(p + pos));
+    while (pos > 0u) {
+      const usize parent = (pos - 1u) / D;
+      if (!(*(p + parent) < elem)) break;
+      *(p + pos) = ::sus::move(*(p + parent));
+      pos = parent;
+    }
+    *(p + pos) = ::sus::move(elem);
+  }
+
+  /// Moves the element at `pos` toward the leaves until it is not less than
+  /// any of its children, considering only the first `end` elements.
+  constexpr void sift_down_range(usize pos, usize end) noexcept {
+    if (!has_children(pos, end)) return;
+    T* const p = data_.as_mut_ptr();
+    T elem = ::sus::move(*(p + pos));
+    while (has_children(pos, end)) {
+      const usize best = greatest_child(p, pos, end);
+      if (!(elem < *(p + best))) break;
+      *(p + pos) = ::sus::move(*(p + best));
+      pos = best;
+    }
+    *(p + pos) = ::sus::move(elem);
+  }
+
+  /// Moves the element at `pos` all the way to a leaf, and then up to where
+  /// it belongs.
+  ///
+  /// The element at `pos` came from the bottom of the heap after a pop, so it
+  /// likely belongs near the bottom again. This does about half the
+  /// comparisons of `sift_down_range()` as it does not compare the element
+  /// with the children on the way down.
+  constexpr void sift_down_to_bottom(usize pos) noexcept {
+    const usize end = data_.len();
+    T* const p = data_.as_mut_ptr();
+    T elem = ::sus::move(*(p + pos));
+    while (has_children(pos, end)) {
+      const usize best = greatest_child(p, pos, end);
+      *(p + pos) = ::sus::move(*(p + best));
+      pos = best;
+    }
+    *(p + pos) = ::sus::move(elem);
+    sift_up(pos);
+  }
+
+  /// Restores the heap order of all the elements, in O(n).
+  constexpr void rebuild() noexcept {
+    const usize n = data_.len();
+    if (n <= 1u) return;
+    // Sift down each node that has children, starting from the last one.
+    for (usize i = (n - 2u) / D + 1u; i > 0u; i -= 1u)
+      sift_down_range(i - 1u, n);
+  }
+
+  /// Restores the heap order after elements were appended from `start`,
+  /// either by sifting each of them up or by rebuilding the whole heap,
+  /// whichever is expected to do fewer comparisons.
+  constexpr void rebuild_tail(usize start) noexcept {
+    const usize n = data_.len();
+    if (start == n) return;
+    const usize tail_len = n - start;
+    bool better_to_rebuild;
+    if (start < tail_len) {
+      better_to_rebuild = true;
+    } else if (n <= 2048u) {
+      // Sifting up each element costs about log2(start) comparisons, and a
+      // rebuild costs about 2n.
+      better_to_rebuild = 2u * n < tail_len * usize::from(start.log2());
+    } else {
+      // Beyond this size a rebuild also has more cache misses, which is
+      // accounted for by assuming the heap is about 2^11 elements.
+      better_to_rebuild = 2u * n < tail_len * 11u;
+    }
+    if (better_to_rebuild) {
+      rebuild();
+    } else {
+      for (usize i = start; i < n; i += 1u) sift_up(i);
+    }
+  }
+
+  constexpr bool has_iterators() const noexcept {
+    return iter_refs_.count_from_owner() != 0u;
+  }
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRefCounter iter_refs_;
+  Vec<T> data_;
+
+  sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn,
+                                           decltype(iter_refs_),
+                                           decltype(data_));
+};
+
+/// A priority queue implemented with a binary max-heap stored in a
+/// [`Vec`]($sus::collections::Vec).
+///
+/// This is a [`DaryHeap`]($sus::collections::DaryHeap) where each node has 2
+/// children. See [`DaryHeap`]($sus::collections::DaryHeap) for more.
+template <class T>
+using BinaryHeap = DaryHeap<T, 2u>;
+
+}  // namespace sus::collections
+
+// sus::iter::FromIterator trait for DaryHeap.
+template <class T, size_t D>
+struct sus::iter::FromIteratorImpl<::sus::collections::DaryHeap<T, D>> {
+  /// Collects the elements into a `Vec` and then orders them into a heap in
+  /// O(n).
+  static constexpr ::sus::collections::DaryHeap<T, D> from_iter(
+      ::sus::iter::IntoIterator<T> auto&& ii) noexcept
+    requires(::sus::mem::Move<T> &&  //
+             ::sus::mem::IsMoveRef<decltype(ii)>)
+  {
+    return ::sus::collections::DaryHeap<T, D>::from(
+        ::sus::iter::from_iter<::sus::collections::Vec<T>>(::sus::move(ii)));
+  }
+};
+
+// fmt support.
+template <class T, size_t D, class Char>
+struct fmt::formatter<::sus::collections::DaryHeap<T, D>, Char> {
+  template <class ParseContext>
+  constexpr auto parse(ParseContext& ctx) {
+    return underlying_.parse(ctx);
+  }
+
+  template <class FormatContext>
+  constexpr auto format(const ::sus::collections::DaryHeap<T, D>& heap,
+                        FormatContext& ctx) const {
+    auto out = ctx.out();
+    out = fmt::format_to(out, "[");
+    bool first = true;
+    for (const T& t : heap.iter()) {
+      if (!first) out = fmt::format_to(out, ", ");
+      first = false;
+      ctx.advance_to(out);
+      out = underlying_.format(t, ctx);
+    }
+    return fmt::format_to(out, "]");
+  }
+
+ private:
+  ::sus::string::__private::AnyFormatter<T, Char> underlying_;
+};
+
+// Promote the heaps into the `sus` namespace.
+namespace sus {
+using ::sus::collections::BinaryHeap;
+using ::sus::collections::DaryHeap;
+}  // namespace sus
@@ -0,0 +1,364 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/collections/binary_heap.h"
+
+#include <sstream>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/cmp/reverse.h"
+#include "sus/collections/vec.h"
+#include "sus/iter/iterator.h"
+#include "sus/mem/move.h"
+#include "sus/ops/range.h"
+#include "sus/prelude.h"
+#include "sus/test/counted.h"
+#include "sus/test/ensure_use.h"
+
+namespace {
+
+using sus::collections::BinaryHeap;
+using sus::collections::DaryHeap;
+using sus::test::Counted;
+using sus::test::ensure_use;
+
+static_assert(sus::cmp::Ord<Counted>);
+
+/// A sequence of numbers with many repeats, in no particular order.
+sus::Vec<i32> scrambled(i32 len) {
+  auto v = sus::Vec<i32>::with_capacity(usize::try_from(len).unwrap());
+  for (i32 i : sus::ops::range(0_i32, len)) v.push((i * 7919 + 13) % 101);
+  return v;
+}
+
+/// Pops every element from the heap, returning them in the order popped.
+template <class T, size_t D>
+sus::Vec<T> pop_all(DaryHeap<T, D>& heap) {
+  auto v = sus::Vec<T>();
+  for (Option<T> o = heap.pop(); o.is_some(); o = heap.pop())
+    v.push(sus::move(o).unwrap());
+  return v;
+}
+
+static_assert(sus::construct::Default<BinaryHeap<i32>>);
+static_assert(sus::mem::Move<BinaryHeap<i32>>);
+static_assert(sus::mem::Clone<BinaryHeap<i32>>);
+static_assert(sus::construct::From<BinaryHeap<i32>, sus::Vec<i32>>);
+static_assert(sus::iter::FromIterator<BinaryHeap<i32>, i32>);
+static_assert(sus::iter::Extend<BinaryHeap<i32>, i32>);
+static_assert(std::same_as<BinaryHeap<i32>, DaryHeap<i32, 2u>>);
+static_assert(std::same_as<BinaryHeap<i32>, DaryHeap<i32>>);
+
+TEST(BinaryHeap, Default) {
+  auto h = BinaryHeap<i32>();
+  EXPECT_EQ(h.len(), 0u);
+  EXPECT_TRUE(h.is_empty());
+  EXPECT_EQ(h.capacity(), 0u);
+  EXPECT_EQ(h.peek(), sus::None);
+  EXPECT_EQ(h.pop(), sus::None);
+  EXPECT_EQ(h.peek_mut().is_none(), true);
+
+  BinaryHeap<i32> e = sus::empty;
+  EXPECT_TRUE(e.is_empty());
+
+  auto c = BinaryHeap<i32>::with_capacity(5u);
+  EXPECT_TRUE(c.is_empty());
+  EXPECT_GE(c.capacity(), 5u);
+}
+
+TEST(BinaryHeap, PushPop) {
+  auto h = BinaryHeap<i32>();
+  h.push(3);
+  EXPECT_EQ(h.peek().copied(), sus::some(3));
+  h.push(5);
+  h.push(1);
+  h.push(4);
+  EXPECT_EQ(h.len(), 4u);
+  EXPECT_EQ(h.peek().copied(), sus::some(5));
+  EXPECT_EQ(h.pop(), sus::some(5));
+  EXPECT_EQ(h.pop(), sus::some(4));
+  h.push(2);
+  EXPECT_EQ(h.pop(), sus::some(3));
+  EXPECT_EQ(h.pop(), sus::some(2));
+  EXPECT_EQ(h.pop(), sus::some(1));
+  EXPECT_EQ(h.pop(), sus::None);
+  EXPECT_TRUE(h.is_empty());
+}
+
+TEST(BinaryHeap, PushPopMany) {
+  auto expected = scrambled(500);
+  expected.sort_unstable_by(
+      [](const i32& a, const i32& b) { return b <=> a; });
+
+  auto h = BinaryHeap<i32>();
+  for (i32 i : scrambled(500)) h.push(i);
+  EXPECT_EQ(pop_all(h), expected);
+}
+
+TEST(BinaryHeap, MinHeap) {
+  auto h = BinaryHeap<sus::cmp::Reverse<i32>>();
+  for (i32 i : sus::Vec<i32>(3, 1, 4, 1, 5)) h.push(sus::cmp::Reverse(i));
+  EXPECT_EQ(h.pop().unwrap().value, 1);
+  EXPECT_EQ(h.pop().unwrap().value, 1);
+  EXPECT_EQ(h.pop().unwrap().value, 3);
+  EXPECT_EQ(h.peek().unwrap().value, 4);
+}
+
+TEST(BinaryHeap, PeekMut) {
+  auto h = BinaryHeap<i32>::from(sus::Vec<i32>(1, 5, 2, 4, 3));
+  {
+    auto top = h.peek_mut().unwrap();
+    EXPECT_EQ(*top, 5);
+    // The heap order is restored when `top` is destroyed.
+    *top = 0;
+  }
+  EXPECT_EQ(pop_all(h), sus::Vec<i32>(4, 3, 2, 1, 0));
+
+  h = BinaryHeap<i32>::from(sus::Vec<i32>(1, 5, 2));
+  {
+    auto top = h.peek_mut().unwrap();
+    *top += 10;
+  }
+  EXPECT_EQ(pop_all(h), sus::Vec<i32>(15, 2, 1));
+}
+
+TEST(BinaryHeap, PeekMutPop) {
+  auto h = BinaryHeap<i32>::from(sus::Vec<i32>(1, 5, 2, 4, 3));
+  auto top = h.peek_mut().unwrap();
+  *top = 0;
+  // Popping through the `PeekMut` removes the changed element.
+  EXPECT_EQ(sus::move(top).pop(), 0);
+  EXPECT_EQ(pop_all(h), sus::Vec<i32>(4, 3, 2, 1));
+}
+
+TEST(BinaryHeap, FromVec) {
+  auto expected = scrambled(100);
+  expected.sort_unstable_by(
+      [](const i32& a, const i32& b) { return b <=> a; });
+
+  auto h = BinaryHeap<i32>::from(scrambled(100));
+  EXPECT_EQ(h.len(), 100u);
+  EXPECT_EQ(pop_all(h), expected);
+
+  auto one = BinaryHeap<i32>::from(sus::Vec<i32>(7));
+  EXPECT_EQ(one.peek().copied(), sus::some(7));
+}
+
+TEST(BinaryHeap, FromIterator) {
+  auto h = scrambled(64).into_iter().collect<BinaryHeap<i32>>();
+  auto expected = scrambled(64);
+  expected.sort();
+  EXPECT_EQ(sus::move(h).into_sorted_vec(), expected);
+}
+
+TEST(BinaryHeap, IntoSortedVec) {
+  auto h = BinaryHeap<i32>::from(sus::Vec<i32>(3, 1, 4, 1, 5, 9, 2, 6));
+  EXPECT_EQ(sus::move(h).into_sorted_vec(),
+            sus::Vec<i32>(1, 1, 2, 3, 4, 5, 6, 9));
+  EXPECT_EQ(BinaryHeap<i32>().into_sorted_vec(), sus::Vec<i32>());
+}
+
+TEST(BinaryHeap, IntoVec) {
+  auto h = BinaryHeap<i32>::from(sus::Vec<i32>(1, 2, 3));
+  auto v = sus::move(h).into_vec();
+  v.sort();
+  EXPECT_EQ(v, sus::Vec<i32>(1, 2, 3));
+}
+
+TEST(BinaryHeap, Iter) {
+  auto h = BinaryHeap<i32>::from(sus::Vec<i32>(1, 2, 3));
+  EXPECT_EQ(h.iter().count(), 3u);
+  EXPECT_EQ(h.iter().next().unwrap(), 3);
+  EXPECT_EQ(h.as_slice().len(), 3u);
+  auto v = sus::move(h).into_iter().collect<sus::Vec<i32>>();
+  v.sort();
+  EXPECT_EQ(v, sus::Vec<i32>(1, 2, 3));
+}
+
+TEST(BinaryHeap, Extend) {
+  // Few elements added to a large heap are sifted up one at a time.
+  auto h = BinaryHeap<i32>::from(scrambled(1000));
+  h.extend(sus::Vec<i32>(200, -1, 150));
+  EXPECT_EQ(h.len(), 1003u);
+  EXPECT_EQ(h.pop(), sus::some(200));
+  EXPECT_EQ(h.pop(), sus::some(150));
+  EXPECT_EQ(h.pop(), sus::some(100));
+
+  // Many elements added to a small heap rebuild the whole heap.
+  auto r = BinaryHeap<i32>::from(sus::Vec<i32>(50, 60));
+  r.extend(scrambled(100));
+  auto expected = scrambled(100);
+  expected.push(50);
+  expected.push(60);
+  expected.sort();
+  EXPECT_EQ(sus::move(r).into_sorted_vec(), expected);
+}
+
+TEST(BinaryHeap, Append) {
+  auto a = BinaryHeap<i32>::from(sus::Vec<i32>(1, 8, 3));
+  auto b = BinaryHeap<i32>::from(sus::Vec<i32>(7, 2, 9, 4, 5));
+  a.append(b);
+  EXPECT_TRUE(b.is_empty());
+  EXPECT_EQ(pop_all(a), sus::Vec<i32>(9, 8, 7, 5, 4, 3, 2, 1));
+}
+
+TEST(BinaryHeap, DrainSorted) {
+  auto h = BinaryHeap<i32>::from(sus::Vec<i32>(2, 5, 1, 4, 3));
+  {
+    auto it = h.drain_sorted();
+    EXPECT_EQ(it.exact_size_hint(), 5u);
+    EXPECT_EQ(sus::move(it).collect<sus::Vec<i32>>(),
+              sus::Vec<i32>(5, 4, 3, 2, 1));
+  }
+  EXPECT_TRUE(h.is_empty());
+
+  h.extend(sus::Vec<i32>(2, 5, 1, 4, 3));
+  {
+    auto it = h.drain_sorted();
+    EXPECT_EQ(it.next(), sus::some(5));
+    EXPECT_EQ(it.next(), sus::some(4));
+    EXPECT_EQ(it.size_hint().lower, 3u);
+  }
+  // The rest of the elements are dropped with the iterator.
+  EXPECT_TRUE(h.is_empty());
+  EXPECT_GE(h.capacity(), 5u);
+}
+
+TEST(BinaryHeap, Drain) {
+  auto h = BinaryHeap<i32>::from(sus::Vec<i32>(1, 2, 3));
+  auto v = h.drain().collect<sus::Vec<i32>>();
+  EXPECT_TRUE(h.is_empty());
+  v.sort();
+  EXPECT_EQ(v, sus::Vec<i32>(1, 2, 3));
+}
+
+TEST(BinaryHeap, DaryHeap) {
+  auto expected = scrambled(777);
+  expected.sort();
+
+  auto h4 = DaryHeap<i32, 4u>::from(scrambled(777));
+  EXPECT_EQ(sus::move(h4).into_sorted_vec(), expected);
+
+  auto p4 = DaryHeap<i32, 4u>();
+  for (i32 i : scrambled(777)) p4.push(i);
+  expected.reverse();
+  EXPECT_EQ(pop_all(p4), expected);
+
+  // A node count which leaves the last node with a partial set of children.
+  auto h3 = DaryHeap<i32, 3u>::from(sus::Vec<i32>(4, 8, 1, 9, 2, 7, 3));
+  EXPECT_EQ(pop_all(h3), sus::Vec<i32>(9, 8, 7, 4, 3, 2, 1));
+
+  auto d = DaryHeap<i32, 4u>::from(sus::Vec<i32>(3, 1, 2));
+  EXPECT_EQ(d.drain_sorted().collect<sus::Vec<i32>>(),
+            sus::Vec<i32>(3, 2, 1));
+}
+
+TEST(BinaryHeap, NonTrivial) {
+  Counted::alive = 0;
+  {
+    auto h = DaryHeap<Counted, 4u>();
+    for (i32 i : scrambled(50)) h.push(Counted(i));
+    EXPECT_EQ(Counted::alive, 50);
+    i32 last = 1000;
+    for (i32 i : sus::ops::range(0_i32, 20_i32)) {
+      (void)i;
+      Counted c = h.pop().unwrap();
+      EXPECT_LE(c.v, last);
+      last = c.v;
+    }
+    EXPECT_EQ(Counted::alive, 30);
+    {
+      auto top = h.peek_mut().unwrap();
+      top->v = -1;
+    }
+    EXPECT_LE(h.peek().unwrap().v, last);
+    EXPECT_GE(h.peek().unwrap().v, 0);
+    auto it = h.drain_sorted();
+    EXPECT_LE(it.next().unwrap().v, last);
+    EXPECT_EQ(Counted::alive, 29);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(BinaryHeap, Clone) {
+  auto a = BinaryHeap<i32>::from(sus::Vec<i32>(1, 2, 3));
+  auto b = sus::clone(a);
+  EXPECT_EQ(pop_all(a), sus::Vec<i32>(3, 2, 1));
+  EXPECT_EQ(pop_all(b), sus::Vec<i32>(3, 2, 1));
+}
+
+TEST(BinaryHeap, Move) {
+  auto a = BinaryHeap<i32>::from(sus::Vec<i32>(1, 2, 3));
+  auto b = sus::move(a);
+  EXPECT_EQ(b.peek().copied(), sus::some(3));
+  a = sus::move(b);
+  EXPECT_EQ(a.len(), 3u);
+}
+
+TEST(BinaryHeap, ReserveClear) {
+  auto h = BinaryHeap<i32>();
+  h.reserve(10u);
+  EXPECT_GE(h.capacity(), 10u);
+  h.push(1);
+  h.reserve_exact(20u);
+  EXPECT_GE(h.capacity(), 21u);
+  h.clear();
+  EXPECT_TRUE(h.is_empty());
+}
+
+TEST(BinaryHeapDeathTest, PushWhileDraining) {
+#if !defined(SUS_ITERATOR_INVALIDATION) || SUS_ITERATOR_INVALIDATION
+  auto h = BinaryHeap<i32>::from(sus::Vec<i32>(1));
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(
+      {
+        auto it = h.drain_sorted();
+        h.push(2);
+        ensure_use(&it);
+      },
+      "");
+  EXPECT_DEATH(
+      {
+        auto top = h.peek_mut().unwrap();
+        h.push(2);
+        ensure_use(&top);
+      },
+      "");
+  EXPECT_DEATH(
+      {
+        auto it = h.iter();
+        h.push(2);
+        ensure_use(&it);
+      },
+      "");
+#endif
+#endif
+}
+
+TEST(BinaryHeap, fmt) {
+  auto h = BinaryHeap<i32>();
+  EXPECT_EQ(fmt::format("{}", h), "[]");
+  h.push(1);
+  h.push(2);
+  EXPECT_EQ(fmt::format("{:02}", h), "[02, 01]");
+}
+
+TEST(BinaryHeap, Stream) {
+  std::stringstream ss;
+  auto h = BinaryHeap<i32>::from(sus::Vec<i32>(1, 2));
+  ss << h;
+  EXPECT_EQ(ss.str(), "[2, 1]");
+}
+
+}  // namespace
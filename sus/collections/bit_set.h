@@ -0,0 +1,271 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+
+#include "fmt/core.h"
+#include "sus/assertions/check.h"
+#include "sus/collections/__private/bit_words.h"
+#include "sus/collections/collections.h"
+#include "sus/collections/iterators/bit_iter.h"
+#include "sus/collections/slice.h"
+#include "sus/iter/iterator_ref.h"
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/macros/lifetimebound.h"
+#include "sus/macros/pure.h"
+#include "sus/marker/unsafe.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+#include "sus/string/__private/format_to_stream.h"
+
+namespace sus::collections {
+
+/// A fixed-size array of `N` bits, stored packed into 64-bit words inline in
+/// the object.
+///
+/// A `BitSet` is the fixed-size counterpart to
+/// [`BitVec`]($sus::collections::BitVec), in the way that `Array` is to `Vec`.
+/// It does not allocate, is [`Copy`]($sus::mem::Copy), and can be used in
+/// constant expressions. Like `BitVec`, it works on 64 bits at a time where it
+/// can, counting bits with a population count instruction, visiting only the
+/// set bits with [`iter_ones`]($sus::collections::BitSet::iter_ones), and
+/// combining whole sets with the bitwise operators.
+///
+/// Since a `BitSet` is small, [`rank`]($sus::collections::BitSet::rank) and
+/// [`select`]($sus::collections::BitSet::select) scan its words directly,
+/// rather than keeping an index like
+/// [`RankSelect`]($sus::collections::RankSelect) does for a `BitVec`.
+template <size_t N>
+class BitSet final {
+ public:
+  /// Constructs a `BitSet` with no bits set.
+  ///
+  /// This constructor also satisfies `sus::construct::Default`.
+  explicit constexpr BitSet() noexcept = default;
+
+  /// Constructs a `BitSet` with every bit set.
+  _sus_pure static constexpr BitSet with_all() noexcept {
+    BitSet s;
+    s.fill(true);
+    return s;
+  }
+
+  /// Returns the number of bits in the `BitSet`, which is `N`.
+  _sus_pure static constexpr usize len() noexcept { return N; }
+
+  /// Returns the bit at position `i`, or `None` if `i` is out of bounds.
+  _sus_pure constexpr Option<bool> get(usize i) const& noexcept {
+    if (i >= N) return Option<bool>();
+    return Option<bool>(get_unchecked(i));
+  }
+
+  /// Returns the bit at position `i`.
+  ///
+  /// # Panics
+  /// Panics if `i` is out of bounds.
+  _sus_pure constexpr bool operator[](usize i) const& noexcept {
+    sus_check_with_message(i < N, "index out of bounds");
+    return get_unchecked(i);
+  }
+
+  /// Sets the bit at position `i` to `value`.
+  ///
+  /// # Panics
+  /// Panics if `i` is out of bounds.
+  constexpr void set(usize i, bool value) noexcept {
+    sus_check_with_message(i < N, "index out of bounds");
+    u64& word = words_[size_t{__private::word_index(i)}];
+    if (value)
+      word |= __private::bit_mask(i);
+    else
+      word &= ~__private::bit_mask(i);
+  }
+
+  /// Inverts the bit at position `i`.
+  ///
+  /// # Panics
+  /// Panics if `i` is out of bounds.
+  constexpr void flip(usize i) noexcept {
+    sus_check_with_message(i < N, "index out of bounds");
+    words_[size_t{__private::word_index(i)}] ^= __private::bit_mask(i);
+  }
+
+  /// Sets every bit to `value`.
+  constexpr void fill(bool value) noexcept {
+    const u64 word = value ? u64::MAX : u64(0u);
+    for (u64& w : words_) w = word;
+    words_[kWords - 1u] &= kLastWordMask;
+  }
+
+  /// Inverts every bit.
+  constexpr void flip_all() noexcept {
+    for (u64& w : words_) w = ~w;
+    words_[kWords - 1u] &= kLastWordMask;
+  }
+
+  /// Returns the number of bits which are set.
+  _sus_pure constexpr usize count_ones() const& noexcept {
+    return __private::count_ones_words(words_, kWords);
+  }
+
+  /// Returns the number of bits which are not set.
+  _sus_pure constexpr usize count_zeros() const& noexcept {
+    return N - count_ones();
+  }
+
+  /// Returns `true` if any bit is set.
+  _sus_pure constexpr bool any() const& noexcept {
+    return __private::any_words(words_, kWords);
+  }
+
+  /// Returns `true` if every bit is set.
+  _sus_pure constexpr bool all() const& noexcept { return count_ones() == N; }
+
+  /// Returns `true` if no bit is set.
+  _sus_pure constexpr bool none() const& noexcept { return !any(); }
+
+  /// Returns the number of set bits before position `i`.
+  ///
+  /// # Panics
+  /// Panics if `i` is greater than `N`.
+  _sus_pure constexpr usize rank(usize i) const& noexcept {
+    sus_check_with_message(i <= N, "index out of bounds");
+    return __private::rank_words(words_, i);
+  }
+
+  /// Returns the position of the set bit which has `k` set bits before it, or
+  /// `None` if there are not more than `k` set bits.
+  _sus_pure constexpr Option<usize> select(usize k) const& noexcept {
+    return __private::select_words(words_, kWords, k);
+  }
+
+  /// Returns an iterator over the positions of the set bits, in increasing
+  /// order.
+  constexpr BitIter iter_ones() const& noexcept sus_lifetimebound {
+    return BitIter(
+        ::sus::iter::IterRefCounter::empty_for_view().to_iter_from_view(),
+        words_, kWords);
+  }
+  constexpr BitIter iter_ones() && = delete;
+
+  /// Returns the words that hold the bits.
+  ///
+  /// Bit `i` is held in word `i / 64` at bit `i % 64`, counting from the least
+  /// significant bit. The bits in the last word past `N` are not set.
+  _sus_pure constexpr Slice<u64> as_words() const& noexcept sus_lifetimebound {
+    return Slice<u64>::from_raw_parts(::sus::marker::unsafe_fn, words_,
+                                      __private::words_for_bits(N));
+  }
+  constexpr Slice<u64> as_words() && = delete;
+
+  /// Sets each bit to the logical and of it and the bit at the same position
+  /// in `rhs`.
+  constexpr void operator&=(const BitSet& rhs) & noexcept {
+    __private::and_words(words_, rhs.words_, kWords);
+  }
+  /// Sets each bit to the logical or of it and the bit at the same position
+  /// in `rhs`.
+  constexpr void operator|=(const BitSet& rhs) & noexcept {
+    __private::or_words(words_, rhs.words_, kWords);
+  }
+  /// Sets each bit to the logical xor of it and the bit at the same position
+  /// in `rhs`.
+  constexpr void operator^=(const BitSet& rhs) & noexcept {
+    __private::xor_words(words_, rhs.words_, kWords);
+  }
+  /// Unsets each bit which is set at the same position in `rhs`.
+  constexpr void difference_with(const BitSet& rhs) & noexcept {
+    __private::and_not_words(words_, rhs.words_, kWords);
+  }
+
+  /// Returns the logical and of each pair of bits in `l` and `r`.
+  _sus_pure friend constexpr BitSet operator&(BitSet l,
+                                             const BitSet& r) noexcept {
+    l &= r;
+    return l;
+  }
+  /// Returns the logical or of each pair of bits in `l` and `r`.
+  _sus_pure friend constexpr BitSet operator|(BitSet l,
+                                             const BitSet& r) noexcept {
+    l |= r;
+    return l;
+  }
+  /// Returns the logical xor of each pair of bits in `l` and `r`.
+  _sus_pure friend constexpr BitSet operator^(BitSet l,
+                                             const BitSet& r) noexcept {
+    l ^= r;
+    return l;
+  }
+  /// Returns the bits inverted.
+  _sus_pure constexpr BitSet operator~() const& noexcept {
+    BitSet s = *this;
+    s.flip_all();
+    return s;
+  }
+
+  /// Satisfies the [`Eq<BitSet>`]($sus::cmp::Eq) concept.
+  friend constexpr bool operator==(const BitSet& l, const BitSet& r) noexcept {
+    for (size_t i = 0u; i < kWords; ++i)
+      if (l.words_[i] != r.words_[i]) return false;
+    return true;
+  }
+
+  // Stream support.
+  _sus_format_to_stream(BitSet);
+
+ private:
+  /// A `BitSet` of no bits still holds a word, which is always zero, so that
+  /// there is always a last word.
+  static constexpr size_t kWords =
+      N == 0u ? 1u : size_t{__private::words_for_bits(N)};
+  /// The bits of the last word which are part of the `BitSet`.
+  static constexpr u64 kLastWordMask =
+      N == 0u ? u64(0u) : __private::last_word_mask(N);
+
+  constexpr bool get_unchecked(usize i) const noexcept {
+    return (words_[size_t{__private::word_index(i)}] &
+            __private::bit_mask(i)) != 0u;
+  }
+
+  u64 words_[kWords] = {};
+};
+
+}  // namespace sus::collections
+
+// fmt support.
+template <size_t N, class Char>
+struct fmt::formatter<::sus::collections::BitSet<N>, Char> {
+  template <class ParseContext>
+  constexpr auto parse(ParseContext& ctx) {
+    return ctx.begin();
+  }
+
+  /// Writes the bits as `0` and `1` characters, from the first bit to the
+  /// last.
+  template <class FormatContext>
+  constexpr auto format(const ::sus::collections::BitSet<N>& s,
+                        FormatContext& ctx) const {
+    auto out = ctx.out();
+    for (::sus::num::usize i = 0u; i < N; i += 1u)
+      *out++ = static_cast<Char>(s[i] ? '1' : '0');
+    return out;
+  }
+};
+
+// Promote BitSet into the `sus` namespace.
+namespace sus {
+using ::sus::collections::BitSet;
+}  // namespace sus
@@ -0,0 +1,179 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/collections/bit_set.h"
+
+#include <sstream>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/collections/vec.h"
+#include "sus/iter/iterator.h"
+#include "sus/ops/range.h"
+#include "sus/prelude.h"
+#include "sus/test/ensure_use.h"
+
+namespace {
+
+using sus::collections::BitSet;
+using sus::test::ensure_use;
+
+static_assert(sus::construct::Default<BitSet<10>>);
+static_assert(sus::mem::Copy<BitSet<10>>);
+static_assert(sus::mem::TriviallyRelocatable<BitSet<10>>);
+static_assert(sus::cmp::Eq<BitSet<10>>);
+static_assert(sizeof(BitSet<64>) == 8u);
+static_assert(sizeof(BitSet<65>) == 16u);
+
+// A BitSet can be used in constant expressions.
+static_assert([] {
+  auto s = BitSet<100>();
+  s.set(3u, true);
+  s.set(99u, true);
+  return s.count_ones() == 2u && s[99u] && !s[98u];
+}());
+static_assert(BitSet<70>::with_all().count_ones() == 70u);
+
+TEST(BitSet, Default) {
+  auto s = BitSet<130>();
+  EXPECT_EQ(s.len(), 130u);
+  EXPECT_EQ(s.count_ones(), 0u);
+  EXPECT_EQ(s.count_zeros(), 130u);
+  EXPECT_TRUE(s.none());
+  EXPECT_FALSE(s.any());
+  EXPECT_FALSE(s.all());
+  EXPECT_EQ(s.as_words().len(), 3u);
+}
+
+TEST(BitSet, SetGetFlip) {
+  auto s = BitSet<130>();
+  s.set(0u, true);
+  s.set(64u, true);
+  s.set(129u, true);
+  EXPECT_EQ(s.get(64u), sus::some(true));
+  EXPECT_EQ(s.get(65u), sus::some(false));
+  EXPECT_EQ(s.get(130u), sus::None);
+  EXPECT_EQ(s.count_ones(), 3u);
+  s.set(64u, false);
+  s.flip(1u);
+  EXPECT_FALSE(s[64u]);
+  EXPECT_TRUE(s[1u]);
+  EXPECT_EQ(s.iter_ones().collect<sus::Vec<usize>>(),
+            sus::Vec<usize>(0u, 1u, 129u));
+}
+
+TEST(BitSet, FillFlipAll) {
+  auto s = BitSet<70>::with_all();
+  EXPECT_TRUE(s.all());
+  // The bits past the end of the last word are not set.
+  EXPECT_EQ(s.as_words()[1u], (1_u64 << 6u) - 1u);
+  s.flip(5u);
+  s.flip_all();
+  EXPECT_EQ(s.iter_ones().collect<sus::Vec<usize>>(), sus::Vec<usize>(5u));
+  EXPECT_EQ(s.as_words()[1u], 0u);
+  s.fill(false);
+  EXPECT_TRUE(s.none());
+}
+
+TEST(BitSet, BulkOps) {
+  auto a = BitSet<200>();
+  auto b = BitSet<200>();
+  for (usize i : sus::ops::range(0_usize, 200_usize)) {
+    a.set(i, i % 2u == 0u);
+    b.set(i, i % 3u == 0u);
+  }
+  const auto and_ = a & b;
+  const auto or_ = a | b;
+  const auto xor_ = a ^ b;
+  const auto not_ = ~a;
+  auto diff = a;
+  diff.difference_with(b);
+  for (usize i : sus::ops::range(0_usize, 200_usize)) {
+    EXPECT_EQ(and_[i], a[i] && b[i]);
+    EXPECT_EQ(or_[i], a[i] || b[i]);
+    EXPECT_EQ(xor_[i], a[i] != b[i]);
+    EXPECT_EQ(not_[i], !a[i]);
+    EXPECT_EQ(diff[i], a[i] && !b[i]);
+  }
+  EXPECT_EQ(not_.count_ones(), 100u);
+
+  auto c = a;
+  c &= b;
+  EXPECT_EQ(c, and_);
+  c |= a;
+  EXPECT_EQ(c, a);
+  c ^= a;
+  EXPECT_TRUE(c.none());
+}
+
+TEST(BitSet, RankSelect) {
+  auto s = BitSet<300>();
+  auto expected = sus::Vec<usize>();
+  for (usize i : sus::ops::range(0_usize, 300_usize)) {
+    if (i % 7u == 1u || i == 299u) {
+      s.set(i, true);
+      expected.push(i);
+    }
+  }
+  usize ones = 0u;
+  for (usize i : sus::ops::range(0_usize, 301_usize)) {
+    EXPECT_EQ(s.rank(i), ones);
+    if (i < 300u && s[i]) ones += 1u;
+  }
+  for (usize k : sus::ops::range(0_usize, expected.len()))
+    EXPECT_EQ(s.select(k), sus::some(expected[k]));
+  EXPECT_EQ(s.select(expected.len()), sus::None);
+}
+
+TEST(BitSet, Empty) {
+  auto s = BitSet<0>();
+  EXPECT_EQ(s.len(), 0u);
+  EXPECT_TRUE(s.all());
+  EXPECT_TRUE(s.none());
+  EXPECT_EQ(s.as_words().len(), 0u);
+  s.flip_all();
+  EXPECT_TRUE(s.none());
+  EXPECT_EQ(s.iter_ones().next(), sus::None);
+  EXPECT_EQ(s.rank(0u), 0u);
+  EXPECT_EQ(s.select(0u), sus::None);
+}
+
+TEST(BitSetDeathTest, OutOfBounds) {
+  auto s = BitSet<3>();
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(
+      {
+        bool b = s[3u];
+        ensure_use(&b);
+      },
+      "");
+  EXPECT_DEATH(s.set(3u, true), "");
+  EXPECT_DEATH(s.flip(3u), "");
+#endif
+}
+
+TEST(BitSet, fmt) {
+  auto s = BitSet<5>();
+  s.set(1u, true);
+  s.set(4u, true);
+  EXPECT_EQ(fmt::format("{}", s), "01001");
+  EXPECT_EQ(fmt::format("{}", BitSet<0>()), "");
+}
+
+TEST(BitSet, Stream) {
+  std::stringstream ss;
+  ss << BitSet<3>::with_all();
+  EXPECT_EQ(ss.str(), "111");
+}
+
+}  // namespace
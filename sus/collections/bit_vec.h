@@ -0,0 +1,543 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "fmt/core.h"
+#include "sus/assertions/check.h"
+#include "sus/collections/__private/bit_words.h"
+#include "sus/collections/collections.h"
+#include "sus/collections/iterators/bit_iter.h"
+#include "sus/collections/slice.h"
+#include "sus/collections/vec.h"
+#include "sus/iter/from_iterator.h"
+#include "sus/iter/into_iterator.h"
+#include "sus/iter/iterator_ref.h"
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/macros/lifetimebound.h"
+#include "sus/macros/no_unique_address.h"
+#include "sus/macros/pure.h"
+#include "sus/marker/empty.h"
+#include "sus/mem/clone.h"
+#include "sus/mem/move.h"
+#include "sus/mem/relocate.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+#include "sus/string/__private/format_to_stream.h"
+
+namespace sus::collections {
+
+/// A growable array of bits, stored packed into 64-bit words.
+///
+/// A `BitVec` uses one bit of memory per element where a `Vec<bool>` uses a
+/// byte, and operates on 64 elements at a time where it can:
+/// * [`count_ones`]($sus::collections::BitVec::count_ones) counts the set
+///   bits with a population count instruction on each word.
+/// * [`iter_ones`]($sus::collections::BitVec::iter_ones) visits only the set
+///   bits, skipping over empty words.
+/// * The `&=`, `|=` and `^=` operators and
+///   [`flip_all`]($sus::collections::BitVec::flip_all) work on whole words,
+///   in loops that the compiler can vectorize.
+///
+/// To answer many rank and select queries over bits that no longer change,
+/// move them into a [`RankSelect`]($sus::collections::RankSelect) index.
+///
+/// Like `Vec`, the `BitVec` tracks its iterators, and will panic if it is
+/// resized while any of them are alive.
+class BitVec final {
+ public:
+  /// Constructs an empty `BitVec`.
+  ///
+  /// The `BitVec` will not allocate until bits are pushed onto it.
+  ///
+  /// This constructor also satisfies `sus::construct::Default`.
+  explicit constexpr BitVec() noexcept : BitVec(FROM_PARTS, Vec<u64>(), 0u) {}
+
+  /// Constructs an empty `BitVec`.
+  ///
+  /// This constructor is implicit so that using the [`EmptyMarker`](
+  /// $sus::marker::EmptyMarker) allows the caller to avoid spelling out the
+  /// full type.
+  /// #[doc.overloads=empty]
+  constexpr BitVec(::sus::marker::EmptyMarker) noexcept : BitVec() {}
+
+  /// Creates an empty `BitVec` which can hold at least `capacity` bits
+  /// without reallocating.
+  ///
+  /// # Panics
+  /// Panics if the capacity exceeds `isize::MAX` bytes.
+  _sus_pure static constexpr BitVec with_capacity(usize capacity) noexcept {
+    return BitVec(FROM_PARTS,
+                  Vec<u64>::with_capacity(__private::words_for_bits(capacity)),
+                  0u);
+  }
+
+  /// Creates a `BitVec` holding `len` bits which are all set to `value`.
+  _sus_pure static constexpr BitVec from_elem(usize len, bool value) noexcept {
+    auto v = BitVec::with_capacity(len);
+    v.resize(len, value);
+    return v;
+  }
+
+  /// Satisifes the [`Move`]($sus::mem::Move) concept.
+  /// #[doc.overloads=bitvec.move]
+  constexpr BitVec(BitVec&& o) noexcept
+      : iter_refs_(o.iter_refs_.take_for_owner()),
+        words_(::sus::move(o.words_)),
+        len_(::sus::mem::replace(o.len_, 0u)) {
+    sus_check(!has_iterators());
+  }
+  /// Satisifes the [`Move`]($sus::mem::Move) concept.
+  /// #[doc.overloads=bitvec.move]
+  constexpr BitVec& operator=(BitVec&& o) noexcept {
+    sus_check(!has_iterators());
+    sus_check(!o.has_iterators());
+    iter_refs_ = o.iter_refs_.take_for_owner();
+    words_ = ::sus::move(o.words_);
+    len_ = ::sus::mem::replace(o.len_, 0u);
+    return *this;
+  }
+
+  /// Satisfies the [`Clone`]($sus::mem::Clone) concept.
+  constexpr BitVec clone() const& noexcept {
+    return BitVec(FROM_PARTS, ::sus::clone(words_), len_);
+  }
+
+  constexpr ~BitVec() = default;
+
+  /// Returns the number of bits in the `BitVec`.
+  _sus_pure constexpr usize len() const& noexcept { return len_; }
+
+  /// Returns `true` if the `BitVec` holds no bits.
+  _sus_pure constexpr bool is_empty() const& noexcept { return len_ == 0u; }
+
+  /// Returns the number of bits the `BitVec` can hold without reallocating.
+  _sus_pure constexpr usize capacity() const& noexcept {
+    return words_.capacity() * __private::kBitsPerWord;
+  }
+
+  /// Reserves capacity for at least `additional` more bits to be pushed onto
+  /// the `BitVec`.
+  ///
+  /// # Panics
+  /// Panics if the new capacity exceeds `isize::MAX` bytes.
+  constexpr void reserve(usize additional) noexcept {
+    sus_check(!has_iterators());
+    const usize words = __private::words_for_bits(len_ + additional);
+    words_.reserve(words - words_.len());
+  }
+
+  /// Returns the bit at position `i`, or `None` if `i` is out of bounds.
+  _sus_pure constexpr Option<bool> get(usize i) const& noexcept {
+    if (i >= len_) return Option<bool>();
+    return Option<bool>(get_unchecked(i));
+  }
+
+  /// Returns the bit at position `i`.
+  ///
+  /// # Panics
+  /// Panics if `i` is out of bounds.
+  _sus_pure constexpr bool operator[](usize i) const& noexcept {
+    sus_check_with_message(i < len_, "index out of bounds");
+    return get_unchecked(i);
+  }
+
+  /// Sets the bit at position `i` to `value`.
+  ///
+  /// # Panics
+  /// Panics if `i` is out of bounds.
+  constexpr void set(usize i, bool value) noexcept {
+    sus_check_with_message(i < len_, "index out of bounds");
+    u64& word = words_[__private::word_index(i)];
+    if (value)
+      word |= __private::bit_mask(i);
+    else
+      word &= ~__private::bit_mask(i);
+  }
+
+  /// Inverts the bit at position `i`.
+  ///
+  /// # Panics
+  /// Panics if `i` is out of bounds.
+  constexpr void flip(usize i) noexcept {
+    sus_check_with_message(i < len_, "index out of bounds");
+    words_[__private::word_index(i)] ^= __private::bit_mask(i);
+  }
+
+  /// Sets every bit to `value`.
+  constexpr void fill(bool value) noexcept {
+    const u64 word = value ? u64::MAX : u64(0u);
+    for (u64& w : words_.iter_mut()) w = word;
+    mask_last_word();
+  }
+
+  /// Inverts every bit.
+  constexpr void flip_all() noexcept {
+    __private::not_words(words_.as_mut_ptr(), words_.len(), len_);
+  }
+
+  /// Appends a bit to the end of the `BitVec`.
+  ///
+  /// # Panics
+  /// Panics if the new capacity exceeds `isize::MAX` bytes.
+  constexpr void push(bool value) noexcept {
+    sus_check(!has_iterators());
+    if (len_ % __private::kBitsPerWord == 0u) words_.push(0u);
+    if (value) words_[__private::word_index(len_)] |= __private::bit_mask(len_);
+    len_ += 1u;
+  }
+
+  /// Removes the last bit and returns it, or `None` if the `BitVec` is
+  /// empty.
+  constexpr Option<bool> pop() noexcept {
+    sus_check(!has_iterators());
+    if (len_ == 0u) return Option<bool>();
+    len_ -= 1u;
+    const bool value = get_unchecked(len_);
+    if (len_ % __private::kBitsPerWord == 0u) {
+      words_.pop();
+    } else {
+      words_[__private::word_index(len_)] &= ~__private::bit_mask(len_);
+    }
+    return Option<bool>(value);
+  }
+
+  /// Shortens the `BitVec` to `len` bits. Has no effect if `len` is not less
+  /// than the current length.
+  constexpr void truncate(usize len) noexcept {
+    sus_check(!has_iterators());
+    if (len >= len_) return;
+    words_.truncate(__private::words_for_bits(len));
+    len_ = len;
+    mask_last_word();
+  }
+
+  /// Resizes the `BitVec` to hold `new_len` bits. Any bits added at the end
+  /// are set to `value`.
+  ///
+  /// # Panics
+  /// Panics if the new capacity exceeds `isize::MAX` bytes.
+  constexpr void resize(usize new_len, bool value) noexcept {
+    sus_check(!has_iterators());
+    if (new_len <= len_) {
+      truncate(new_len);
+      return;
+    }
+    const usize old_words = words_.len();
+    const usize new_words = __private::words_for_bits(new_len);
+    if (value && len_ % __private::kBitsPerWord != 0u) {
+      // Set the unused bits at the end of the last word.
+      words_[old_words - 1u] |= ~__private::last_word_mask(len_);
+    }
+    words_.reserve(new_words - old_words);
+    const u64 word = value ? u64::MAX : u64(0u);
+    for (usize i = old_words; i < new_words; i += 1u) words_.push(word);
+    len_ = new_len;
+    mask_last_word();
+  }
+
+  /// Removes all bits from the `BitVec`.
+  ///
+  /// Note that this method has no effect on the allocated capacity.
+  constexpr void clear() noexcept {
+    sus_check(!has_iterators());
+    words_.clear();
+    len_ = 0u;
+  }
+
+  /// Returns the number of bits which are set.
+  _sus_pure constexpr usize count_ones() const& noexcept {
+    return __private::count_ones_words(words_.as_ptr(), words_.len());
+  }
+
+  /// Returns the number of bits which are not set.
+  _sus_pure constexpr usize count_zeros() const& noexcept {
+    return len_ - count_ones();
+  }
+
+  /// Returns `true` if any bit is set.
+  _sus_pure constexpr bool any() const& noexcept {
+    return __private::any_words(words_.as_ptr(), words_.len());
+  }
+
+  /// Returns `true` if every bit is set, which includes when the `BitVec` is
+  /// empty.
+  _sus_pure constexpr bool all() const& noexcept {
+    return count_ones() == len_;
+  }
+
+  /// Returns `true` if no bit is set.
+  _sus_pure constexpr bool none() const& noexcept { return !any(); }
+
+  /// Returns an iterator over the positions of the set bits, in increasing
+  /// order.
+  constexpr BitIter iter_ones() const& noexcept sus_lifetimebound {
+    return BitIter(iter_refs_.to_iter_from_owner(), words_.as_ptr(),
+                   words_.len());
+  }
+  constexpr BitIter iter_ones() && = delete;
+
+  /// Returns the words that hold the bits.
+  ///
+  /// Bit `i` is held in word `i / 64` at bit `i % 64`, counting from the least
+  /// significant bit. The bits in the last word past `len()` are not set.
+  _sus_pure constexpr Slice<u64> as_words() const& noexcept sus_lifetimebound {
+    return words_.as_slice();
+  }
+  constexpr Slice<u64> as_words() && = delete;
+
+  /// Sets each bit to the logical and of it and the bit at the same position
+  /// in `rhs`.
+  ///
+  /// # Panics
+  /// Panics if the `BitVec`s are not the same length.
+  constexpr void operator&=(const BitVec& rhs) & noexcept {
+    sus_check_with_message(len_ == rhs.len_, "BitVec lengths differ");
+    __private::and_words(words_.as_mut_ptr(), rhs.words_.as_ptr(),
+                         words_.len());
+  }
+  /// Sets each bit to the logical or of it and the bit at the same position
+  /// in `rhs`.
+  ///
+  /// # Panics
+  /// Panics if the `BitVec`s are not the same length.
+  constexpr void operator|=(const BitVec& rhs) & noexcept {
+    sus_check_with_message(len_ == rhs.len_, "BitVec lengths differ");
+    __private::or_words(words_.as_mut_ptr(), rhs.words_.as_ptr(),
+                        words_.len());
+  }
+  /// Sets each bit to the logical xor of it and the bit at the same position
+  /// in `rhs`.
+  ///
+  /// # Panics
+  /// Panics if the `BitVec`s are not the same length.
+  constexpr void operator^=(const BitVec& rhs) & noexcept {
+    sus_check_with_message(len_ == rhs.len_, "BitVec lengths differ");
+    __private::xor_words(words_.as_mut_ptr(), rhs.words_.as_ptr(),
+                         words_.len());
+  }
+  /// Unsets each bit which is set at the same position in `rhs`.
+  ///
+  /// # Panics
+  /// Panics if the `BitVec`s are not the same length.
+  constexpr void difference_with(const BitVec& rhs) & noexcept {
+    sus_check_with_message(len_ == rhs.len_, "BitVec lengths differ");
+    __private::and_not_words(words_.as_mut_ptr(), rhs.words_.as_ptr(),
+                             words_.len());
+  }
+
+  /// Appends each bit from the iterator.
+  ///
+  /// Satisfies the [`Extend<bool>`]($sus::iter::Extend) concept.
+  template <::sus::iter::IntoIterator<bool> I>
+    requires(::sus::mem::IsMoveRef<I &&>)
+  constexpr void extend(I&& ii) noexcept {
+    auto it = ::sus::move(ii).into_iter();
+    reserve(it.size_hint().lower);
+    for (bool b : ::sus::move(it)) push(b);
+  }
+
+  /// Satisfies the [`Eq<BitVec>`]($sus::cmp::Eq) concept.
+  friend constexpr bool operator==(const BitVec& l, const BitVec& r) noexcept {
+    return l.len_ == r.len_ && l.words_ == r.words_;
+  }
+
+  // Stream support.
+  _sus_format_to_stream(BitVec);
+
+ private:
+  friend class RankSelect;
+
+  enum FromParts { FROM_PARTS };
+  explicit constexpr BitVec(FromParts, Vec<u64> words, usize len) noexcept
+      : iter_refs_(::sus::iter::IterRefCounter::for_owner()),
+        words_(::sus::move(words)),
+        len_(len) {}
+
+  constexpr bool get_unchecked(usize i) const noexcept {
+    return (words_[__private::word_index(i)] & __private::bit_mask(i)) != 0u;
+  }
+
+  /// Unsets the bits in the last word which are past the end.
+  constexpr void mask_last_word() noexcept {
+    if (!words_.is_empty())
+      words_[words_.len() - 1u] &= __private::last_word_mask(len_);
+  }
+
+  constexpr bool has_iterators() const noexcept {
+    return iter_refs_.count_from_owner() != 0u;
+  }
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRefCounter iter_refs_;
+  Vec<u64> words_;
+  usize len_;
+
+  sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn,
+                                           decltype(iter_refs_),
+                                           decltype(words_), decltype(len_));
+};
+
+/// An index over a [`BitVec`]($sus::collections::BitVec) which answers rank
+/// and select queries quickly.
+///
+/// * `rank(i)` counts the set bits before position `i`, in constant time.
+/// * `select(k)` finds the position of the set bit with `k` set bits before
+///   it, in logarithmic time.
+///
+/// The index holds the count of set bits before each block of 512 bits, so it
+/// uses one `usize` of memory for each 8 words of bits. A query looks up its
+/// block, and then counts the bits in at most 8 words.
+///
+/// The `RankSelect` takes ownership of the bits so that they can not change
+/// and make the index stale. Use
+/// [`into_bits`]($sus::collections::RankSelect::into_bits) to get them back.
+class RankSelect final {
+ public:
+  /// Builds the index over `bits`, in time linear to the number of words.
+  static constexpr RankSelect from(BitVec bits) noexcept {
+    const usize words = bits.words_.len();
+    auto blocks = Vec<usize>::with_capacity(words / kWordsPerBlock + 2u);
+    const u64* const p = bits.words_.as_ptr();
+    usize count = 0u;
+    for (usize w = 0u; w < words; w += kWordsPerBlock) {
+      blocks.push(count);
+      const usize in_block = words - w < kWordsPerBlock ? words - w
+                                                        : kWordsPerBlock;
+      count += __private::count_ones_words(p + size_t{w}, in_block);
+    }
+    // The last entry is the total, so a block's count of set bits is always
+    // the difference from the next entry.
+    blocks.push(count);
+    return RankSelect(::sus::move(bits), ::sus::move(blocks));
+  }
+
+  /// Satisfies the [`Clone`]($sus::mem::Clone) concept.
+  constexpr RankSelect clone() const& noexcept {
+    return RankSelect(::sus::clone(bits_), ::sus::clone(blocks_));
+  }
+
+  /// Returns the bits which are indexed.
+  _sus_pure constexpr const BitVec& bits() const& noexcept sus_lifetimebound {
+    return bits_;
+  }
+  constexpr const BitVec& bits() && = delete;
+
+  /// Consumes the index and returns the bits which were indexed.
+  constexpr BitVec into_bits() && noexcept { return ::sus::move(bits_); }
+
+  /// Returns the number of bits which are indexed.
+  _sus_pure constexpr usize len() const& noexcept { return bits_.len(); }
+
+  /// Returns the number of set bits.
+  _sus_pure constexpr usize count_ones() const& noexcept {
+    return blocks_[blocks_.len() - 1u];
+  }
+
+  /// Returns the number of set bits before position `i`.
+  ///
+  /// # Panics
+  /// Panics if `i` is greater than `len()`.
+  _sus_pure constexpr usize rank(usize i) const& noexcept {
+    sus_check_with_message(i <= bits_.len(), "index out of bounds");
+    const usize word = __private::word_index(i);
+    const usize block = word / kWordsPerBlock;
+    const usize block_start = block * kWordsPerBlock;
+    const u64* const p = bits_.words_.as_ptr() + size_t{block_start};
+    return blocks_[block] +
+           __private::rank_words(p, i - block_start * __private::kBitsPerWord);
+  }
+
+  /// Returns the position of the set bit which has `k` set bits before it, or
+  /// `None` if there are not more than `k` set bits.
+  ///
+  /// This is the inverse of `rank`: `rank(select(k).unwrap()) == k`.
+  _sus_pure constexpr Option<usize> select(usize k) const& noexcept {
+    if (k >= count_ones()) return Option<usize>();
+    // Binary search for the last block whose count of earlier set bits is not
+    // more than `k`. The first entry is 0 so there is always such a block.
+    usize lo = 0u;
+    usize hi = blocks_.len() - 1u;
+    while (hi - lo > 1u) {
+      const usize mid = lo + (hi - lo) / 2u;
+      if (blocks_[mid] <= k)
+        lo = mid;
+      else
+        hi = mid;
+    }
+    const usize block = lo;
+    const usize block_start = block * kWordsPerBlock;
+    const usize words = bits_.words_.len();
+    const usize in_block = words - block_start < kWordsPerBlock
+                               ? words - block_start
+                               : kWordsPerBlock;
+    const u64* const p = bits_.words_.as_ptr() + size_t{block_start};
+    return __private::select_words(p, in_block, k - blocks_[block])
+        .map([block_start](usize pos) {
+          return block_start * __private::kBitsPerWord + pos;
+        });
+  }
+
+ private:
+  static constexpr usize kWordsPerBlock = 8u;
+
+  constexpr RankSelect(BitVec bits, Vec<usize> blocks) noexcept
+      : bits_(::sus::move(bits)), blocks_(::sus::move(blocks)) {}
+
+  BitVec bits_;
+  /// The number of set bits before each block, followed by the total.
+  Vec<usize> blocks_;
+
+  sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn,
+                                           decltype(bits_), decltype(blocks_));
+};
+
+}  // namespace sus::collections
+
+// sus::iter::FromIterator trait for BitVec.
+template <>
+struct sus::iter::FromIteratorImpl<::sus::collections::BitVec> {
+  template <::sus::iter::IntoIterator<bool> I>
+    requires(::sus::mem::IsMoveRef<I &&>)
+  static constexpr ::sus::collections::BitVec from_iter(I&& ii) noexcept {
+    auto v = ::sus::collections::BitVec();
+    v.extend(::sus::move(ii));
+    return v;
+  }
+};
+
+// fmt support.
+template <class Char>
+struct fmt::formatter<::sus::collections::BitVec, Char> {
+  template <class ParseContext>
+  constexpr auto parse(ParseContext& ctx) {
+    return ctx.begin();
+  }
+
+  /// Writes the bits as `0` and `1` characters, from the first bit to the
+  /// last.
+  template <class FormatContext>
+  constexpr auto format(const ::sus::collections::BitVec& v,
+                        FormatContext& ctx) const {
+    auto out = ctx.out();
+    for (::sus::num::usize i = 0u; i < v.len(); i += 1u)
+      *out++ = static_cast<Char>(v[i] ? '1' : '0');
+    return out;
+  }
+};
+
+// Promote BitVec and RankSelect into the `sus` namespace.
+namespace sus {
+using ::sus::collections::BitVec;
+using ::sus::collections::RankSelect;
+}  // namespace sus
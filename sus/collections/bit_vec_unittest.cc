@@ -0,0 +1,325 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/collections/bit_vec.h"
+
+#include <sstream>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/collections/vec.h"
+#include "sus/iter/iterator.h"
+#include "sus/mem/move.h"
+#include "sus/ops/range.h"
+#include "sus/prelude.h"
+#include "sus/test/ensure_use.h"
+
+namespace {
+
+using sus::collections::BitVec;
+using sus::collections::RankSelect;
+using sus::test::ensure_use;
+
+static_assert(sus::construct::Default<BitVec>);
+static_assert(sus::mem::Move<BitVec>);
+static_assert(sus::mem::Clone<BitVec>);
+static_assert(sus::cmp::Eq<BitVec>);
+static_assert(sus::iter::FromIterator<BitVec, bool>);
+static_assert(sus::iter::Extend<BitVec, bool>);
+static_assert(sus::mem::Clone<RankSelect>);
+
+/// Builds a `BitVec` of `len` bits where bit `i` is set when `i % step == 0`.
+BitVec every(usize len, usize step) {
+  auto v = BitVec::with_capacity(len);
+  for (usize i : sus::ops::range(0_usize, len)) v.push(i % step == 0u);
+  return v;
+}
+
+/// Collects the positions of the set bits, checking them one at a time.
+sus::Vec<usize> ones_slow(const BitVec& v) {
+  auto out = sus::Vec<usize>();
+  for (usize i : sus::ops::range(0_usize, v.len()))
+    if (v[i]) out.push(i);
+  return out;
+}
+
+TEST(BitVec, Default) {
+  auto v = BitVec();
+  EXPECT_EQ(v.len(), 0u);
+  EXPECT_TRUE(v.is_empty());
+  EXPECT_EQ(v.capacity(), 0u);
+  EXPECT_EQ(v.get(0u), sus::None);
+  EXPECT_EQ(v.count_ones(), 0u);
+  EXPECT_TRUE(v.all());
+  EXPECT_TRUE(v.none());
+
+  BitVec e = sus::empty;
+  EXPECT_TRUE(e.is_empty());
+
+  auto c = BitVec::with_capacity(65u);
+  EXPECT_TRUE(c.is_empty());
+  EXPECT_GE(c.capacity(), 65u);
+}
+
+TEST(BitVec, PushPop) {
+  auto v = BitVec();
+  v.push(true);
+  v.push(false);
+  v.push(true);
+  EXPECT_EQ(v.len(), 3u);
+  EXPECT_EQ(v[0u], true);
+  EXPECT_EQ(v[1u], false);
+  EXPECT_EQ(v.get(2u), sus::some(true));
+  EXPECT_EQ(v.get(3u), sus::None);
+  EXPECT_EQ(v.pop(), sus::some(true));
+  EXPECT_EQ(v.pop(), sus::some(false));
+  EXPECT_EQ(v.pop(), sus::some(true));
+  EXPECT_EQ(v.pop(), sus::None);
+
+  // Across word boundaries.
+  for (usize i : sus::ops::range(0_usize, 130_usize)) v.push(i % 3u == 0u);
+  EXPECT_EQ(v.len(), 130u);
+  EXPECT_EQ(v.as_words().len(), 3u);
+  EXPECT_EQ(v.count_ones(), 44u);
+  for (usize i : sus::ops::range(0_usize, 66_usize)) {
+    (void)i;
+    EXPECT_TRUE(v.pop().is_some());
+  }
+  EXPECT_EQ(v.len(), 64u);
+  EXPECT_EQ(v.as_words().len(), 1u);
+  EXPECT_EQ(v.count_ones(), 22u);
+}
+
+TEST(BitVec, SetFlip) {
+  auto v = BitVec::from_elem(100u, false);
+  v.set(3u, true);
+  v.set(64u, true);
+  v.set(99u, true);
+  EXPECT_EQ(v.count_ones(), 3u);
+  v.set(3u, false);
+  EXPECT_FALSE(v[3u]);
+  v.flip(3u);
+  v.flip(64u);
+  EXPECT_TRUE(v[3u]);
+  EXPECT_FALSE(v[64u]);
+  EXPECT_EQ(v.count_ones(), 2u);
+  EXPECT_EQ(v.count_zeros(), 98u);
+}
+
+TEST(BitVec, FromElem) {
+  auto ones = BitVec::from_elem(70u, true);
+  EXPECT_EQ(ones.len(), 70u);
+  EXPECT_EQ(ones.count_ones(), 70u);
+  EXPECT_TRUE(ones.all());
+  // The bits past the end of the last word are not set.
+  EXPECT_EQ(ones.as_words()[1u], (1_u64 << 6u) - 1u);
+
+  auto zeros = BitVec::from_elem(70u, false);
+  EXPECT_EQ(zeros.count_ones(), 0u);
+  EXPECT_TRUE(zeros.none());
+  EXPECT_FALSE(zeros.any());
+}
+
+TEST(BitVec, Resize) {
+  auto v = BitVec();
+  v.resize(10u, true);
+  EXPECT_EQ(v.count_ones(), 10u);
+  v.resize(100u, false);
+  EXPECT_EQ(v.len(), 100u);
+  EXPECT_EQ(v.count_ones(), 10u);
+  v.resize(140u, true);
+  EXPECT_EQ(v.count_ones(), 50u);
+  EXPECT_TRUE(v[100u]);
+  EXPECT_FALSE(v[99u]);
+  v.resize(5u, true);
+  EXPECT_EQ(v.len(), 5u);
+  EXPECT_EQ(v.count_ones(), 5u);
+  v.truncate(2u);
+  EXPECT_EQ(v.len(), 2u);
+  EXPECT_EQ(v.as_words()[0u], 3u);
+  v.truncate(10u);
+  EXPECT_EQ(v.len(), 2u);
+  v.clear();
+  EXPECT_TRUE(v.is_empty());
+  EXPECT_EQ(v.as_words().len(), 0u);
+}
+
+TEST(BitVec, FillFlipAll) {
+  auto v = every(130u, 2u);
+  v.flip_all();
+  EXPECT_EQ(v.count_ones(), 65u);
+  EXPECT_FALSE(v[0u]);
+  EXPECT_TRUE(v[1u]);
+  EXPECT_EQ(v.as_words()[2u], 2u);
+  v.fill(true);
+  EXPECT_TRUE(v.all());
+  v.flip_all();
+  EXPECT_TRUE(v.none());
+}
+
+TEST(BitVec, IterOnes) {
+  auto v = every(300u, 7u);
+  EXPECT_EQ(v.iter_ones().collect<sus::Vec<usize>>(), ones_slow(v));
+
+  auto sparse = BitVec::from_elem(1000u, false);
+  sparse.set(0u, true);
+  sparse.set(63u, true);
+  sparse.set(64u, true);
+  sparse.set(999u, true);
+  auto it = sparse.iter_ones();
+  EXPECT_EQ(it.size_hint().lower, 0u);
+  EXPECT_EQ(sus::move(it).collect<sus::Vec<usize>>(),
+            sus::Vec<usize>(0u, 63u, 64u, 999u));
+
+  const auto empty = BitVec();
+  EXPECT_EQ(empty.iter_ones().next(), sus::None);
+}
+
+TEST(BitVec, BulkOps) {
+  auto a = every(200u, 2u);
+  auto b = every(200u, 3u);
+
+  auto and_ = sus::clone(a);
+  and_ &= b;
+  EXPECT_EQ(and_, every(200u, 6u));
+
+  auto or_ = sus::clone(a);
+  or_ |= b;
+  auto xor_ = sus::clone(a);
+  xor_ ^= b;
+  auto diff = sus::clone(a);
+  diff.difference_with(b);
+  for (usize i : sus::ops::range(0_usize, 200_usize)) {
+    EXPECT_EQ(or_[i], a[i] || b[i]);
+    EXPECT_EQ(xor_[i], a[i] != b[i]);
+    EXPECT_EQ(diff[i], a[i] && !b[i]);
+  }
+  EXPECT_EQ(or_.count_ones() + and_.count_ones(),
+            a.count_ones() + b.count_ones());
+
+  // An operand may be the `BitVec` itself.
+  xor_ ^= xor_;
+  EXPECT_TRUE(xor_.none());
+}
+
+TEST(BitVec, RankSelect) {
+  auto v = every(2000u, 3u);
+  v.set(1999u, true);
+  const auto expected = ones_slow(v);
+  const auto rs = RankSelect::from(sus::clone(v));
+  EXPECT_EQ(rs.len(), 2000u);
+  EXPECT_EQ(rs.count_ones(), expected.len());
+
+  usize ones = 0u;
+  for (usize i : sus::ops::range(0_usize, 2001_usize)) {
+    EXPECT_EQ(rs.rank(i), ones);
+    if (i < 2000u && v[i]) ones += 1u;
+  }
+  for (usize k : sus::ops::range(0_usize, expected.len())) {
+    EXPECT_EQ(rs.select(k), sus::some(expected[k]));
+    EXPECT_EQ(rs.rank(rs.select(k).unwrap()), k);
+  }
+  EXPECT_EQ(rs.select(expected.len()), sus::None);
+  EXPECT_EQ(sus::clone(rs).into_bits(), v);
+
+  // Bit counts on block boundaries.
+  const auto full = RankSelect::from(BitVec::from_elem(1024u, true));
+  EXPECT_EQ(full.rank(512u), 512u);
+  EXPECT_EQ(full.rank(1024u), 1024u);
+  EXPECT_EQ(full.select(511u), sus::some(511u));
+  EXPECT_EQ(full.select(512u), sus::some(512u));
+  EXPECT_EQ(full.select(1023u), sus::some(1023u));
+  EXPECT_EQ(full.select(1024u), sus::None);
+
+  const auto empty = RankSelect::from(BitVec());
+  EXPECT_EQ(empty.rank(0u), 0u);
+  EXPECT_EQ(empty.select(0u), sus::None);
+}
+
+TEST(BitVec, CloneEq) {
+  auto a = every(70u, 5u);
+  auto b = sus::clone(a);
+  EXPECT_EQ(a, b);
+  b.flip(69u);
+  EXPECT_NE(a, b);
+  EXPECT_NE(a, every(71u, 5u));
+}
+
+TEST(BitVec, FromIterator) {
+  auto v = sus::Vec<bool>(true, false, true, true)
+               .into_iter()
+               .collect<BitVec>();
+  EXPECT_EQ(v.len(), 4u);
+  EXPECT_EQ(v.iter_ones().collect<sus::Vec<usize>>(),
+            sus::Vec<usize>(0u, 2u, 3u));
+  v.extend(sus::Vec<bool>(false, true));
+  EXPECT_EQ(v.len(), 6u);
+  EXPECT_TRUE(v[5u]);
+}
+
+TEST(BitVec, Move) {
+  auto a = every(10u, 2u);
+  auto b = sus::move(a);
+  EXPECT_EQ(b.count_ones(), 5u);
+  a = sus::move(b);
+  EXPECT_EQ(a.count_ones(), 5u);
+}
+
+TEST(BitVecDeathTest, PushWhileIterating) {
+#if !defined(SUS_ITERATOR_INVALIDATION) || SUS_ITERATOR_INVALIDATION
+  auto v = BitVec::from_elem(3u, true);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(
+      {
+        auto it = v.iter_ones();
+        v.push(true);
+        ensure_use(&it);
+      },
+      "");
+#endif
+#endif
+}
+
+TEST(BitVecDeathTest, OutOfBounds) {
+  auto v = BitVec::from_elem(3u, true);
+  auto w = BitVec::from_elem(4u, true);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(
+      {
+        bool b = v[3u];
+        ensure_use(&b);
+      },
+      "");
+  EXPECT_DEATH(v.set(3u, true), "");
+  EXPECT_DEATH(v &= w, "");
+  EXPECT_DEATH(
+      {
+        usize r = RankSelect::from(sus::clone(v)).rank(4u);
+        ensure_use(&r);
+      },
+      "");
+#endif
+}
+
+TEST(BitVec, fmt) {
+  EXPECT_EQ(fmt::format("{}", BitVec()), "");
+  EXPECT_EQ(fmt::format("{}", every(5u, 2u)), "10101");
+}
+
+TEST(BitVec, Stream) {
+  std::stringstream ss;
+  ss << every(4u, 3u);
+  EXPECT_EQ(ss.str(), "1001");
+}
+
+}  // namespace
@@ -58,12 +58,17 @@ namespace sus {
 ///   still exists, the collection will panic and terminate the program.
 ///
 /// Subspace's collections can be grouped into four major categories:
-/// * Sequences: [`Vec`]($sus::collections::Vec), [`Array`]($sus::collections::Array)
-///   (TODO: VecDeque, LinkedList,
+/// * Sequences: [`Vec`]($sus::collections::Vec), [`Array`]($sus::collections::Array),
+///   [`VecDeque`]($sus::collections::VecDeque) (TODO: LinkedList,
 ///   [Hive](https://www.open-std.org/jtc1/sc22/wg21/docs/papers/2021/p0447r16.html))
-/// * Maps: (TODO: HashMap, BTreeMap, FlatMap)
-/// * Sets: (TODO: HashSet, BTreeSet, FlatSet)
-/// * Misc: (TODO: BinaryHeap)
+/// * Maps: [`HashMap`]($sus::collections::HashMap),
+///   [`SlotMap`]($sus::collections::SlotMap) (and TODO: BTreeMap, FlatMap)
+/// * Sets: [`HashSet`]($sus::collections::HashSet) (and TODO: BTreeSet,
+///   FlatSet)
+/// * Misc: [`BinaryHeap`]($sus::collections::BinaryHeap),
+///   [`DaryHeap`]($sus::collections::DaryHeap),
+///   [`BitVec`]($sus::collections::BitVec),
+///   [`BitSet`]($sus::collections::BitSet)
 ///
 /// # When Should You Use Which Collection
 /// These are fairly high-level and quick break-downs of when each collection
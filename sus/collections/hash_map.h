@@ -0,0 +1,657 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+#include "fmt/core.h"
+#include "sus/assertions/check.h"
+#include "sus/cmp/eq.h"
+#include "sus/collections/__private/swiss_table.h"
+#include "sus/collections/collections.h"
+#include "sus/collections/iterators/hash_map_iter.h"
+#include "sus/construct/default.h"
+#include "sus/fn/fn_concepts.h"
+#include "sus/hash/default_hasher.h"
+#include "sus/hash/hash.h"
+#include "sus/iter/from_iterator.h"
+#include "sus/iter/into_iterator.h"
+#include "sus/iter/iterator_loop.h"
+#include "sus/iter/iterator_ref.h"
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/macros/lifetimebound.h"
+#include "sus/marker/empty.h"
+#include "sus/mem/clone.h"
+#include "sus/mem/move.h"
+#include "sus/mem/relocate.h"
+#include "sus/mem/replace.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+#include "sus/string/__private/any_formatter.h"
+#include "sus/string/__private/format_to_stream.h"
+#include "sus/tuple/tuple.h"
+
+namespace sus::collections {
+
+/// A hash map from keys of type `K` to values of type `V`, implemented as an
+/// open-addressing Swiss table.
+///
+/// The entries are stored in a single flat allocation, next to one control
+/// byte per bucket holding 7 bits of the key's hash. Lookups compare a whole
+/// group of control bytes at once with vector instructions (SSE2 on x86-64
+/// and NEON on aarch64), and only compare keys in the buckets whose control
+/// byte matches. Unlike the node-based `std::unordered_map`, finding a key
+/// usually costs a single cache miss for the control bytes and one for the
+/// entry.
+///
+/// Keys are compared with `operator==` and hashed with `S`, which is called
+/// as `size_t(const K&)`. By default `S` hashes keys that satisfy
+/// [`Hash`]($sus::hash::Hash) with the [`DefaultHasher`](
+/// $sus::hash::DefaultHasher). Another function such as `std::hash<K>` can be
+/// used instead; the hash value is mixed further by the table, so a hasher
+/// that returns its input, as `std::hash` does for integers, works well. A key
+/// must not be changed in a way that changes its hash or equality while it is
+/// in the map.
+///
+/// Lookups return an [`Option`]($sus::option::Option) holding a reference to
+/// the value, and [`entry`]($sus::collections::HashMap::entry) gives in-place
+/// access to a value that may or may not be present, for inserting or updating
+/// it with a single lookup.
+///
+/// Iterators visit the entries in an arbitrary order, which may differ
+/// between two maps with the same entries. Like `Vec`, the map tracks its
+/// iterators, and will panic if it is mutated while any of them are alive.
+///
+/// Inserting may move entries to a new allocation, which invalidates any
+/// references to keys or values in the map. Entries are moved with `memcpy`
+/// when the key and value types are
+/// [`TriviallyRelocatable`]($sus::mem::TriviallyRelocatable).
+///
+/// The map is not usable in constant expressions.
+template <class K, class V, class S>
+class HashMap final {
+  static_assert(!std::is_reference_v<K> && !std::is_reference_v<V>,
+                "HashMap must hold value types. Use pointers instead of "
+                "references.");
+  static_assert(!std::is_const_v<K> && !std::is_const_v<V>,
+                "`HashMap<const K, const V>` should be written "
+                "`const HashMap<K, V>`, as const applies transitively.");
+  static_assert(::sus::cmp::Eq<K>, "The key type must satisfy `Eq`.");
+  static_assert(std::is_invocable_r_v<size_t, const S&, const K&>,
+                "The hasher `S` must be callable as `size_t(const K&)`.");
+
+  using Slot = __private::swiss::MapSlot<K, V>;
+  using Table = __private::swiss::RawTable<Slot>;
+
+ public:
+  /// Constructs an empty `HashMap`.
+  ///
+  /// The map will not allocate until entries are inserted into it.
+  ///
+  /// This constructor also satisfies `sus::construct::Default`.
+  explicit HashMap() noexcept
+    requires(std::default_initializable<S>)
+      : HashMap(FROM_PARTS, S(), Table()) {}
+
+  /// Constructs an empty `HashMap`.
+  ///
+  /// This constructor is implicit so that using the [`EmptyMarker`](
+  /// $sus::marker::EmptyMarker) allows the caller to avoid spelling out the
+  /// full `HashMap` type.
+  /// #[doc.overloads=empty]
+  HashMap(::sus::marker::EmptyMarker) noexcept
+    requires(std::default_initializable<S>)
+      : HashMap() {}
+
+  /// Creates an empty `HashMap` which can hold at least `capacity` entries
+  /// without reallocating.
+  ///
+  /// # Panics
+  /// Panics if the capacity overflows the size of the address space.
+  _sus_pure static HashMap with_capacity(usize capacity) noexcept
+    requires(std::default_initializable<S>)
+  {
+    return HashMap(FROM_PARTS, S(), Table(capacity));
+  }
+
+  /// Creates an empty `HashMap` which will use `hasher` to hash keys.
+  _sus_pure static HashMap with_hasher(S hasher) noexcept {
+    return HashMap(FROM_PARTS, ::sus::move(hasher), Table());
+  }
+
+  /// Creates an empty `HashMap` which can hold at least `capacity` entries
+  /// without reallocating, and which will use `hasher` to hash keys.
+  ///
+  /// # Panics
+  /// Panics if the capacity overflows the size of the address space.
+  _sus_pure static HashMap with_capacity_and_hasher(usize capacity,
+                                                    S hasher) noexcept {
+    return HashMap(FROM_PARTS, ::sus::move(hasher), Table(capacity));
+  }
+
+  /// Satisifes the [`Move`]($sus::mem::Move) concept.
+  /// #[doc.overloads=hashmap.move]
+  HashMap(HashMap&& o) noexcept
+      : iter_refs_(o.iter_refs_.take_for_owner()),
+        hasher_(::sus::move(o.hasher_)),
+        table_(::sus::move(o.table_)) {
+    sus_check(!is_moved_from() && !has_iterators());
+    o.table_.mark_moved_from();
+  }
+  /// Satisifes the [`Move`]($sus::mem::Move) concept.
+  /// #[doc.overloads=hashmap.move]
+  HashMap& operator=(HashMap&& o) noexcept {
+    sus_check(!o.is_moved_from());
+    sus_check(!has_iterators());
+    sus_check(!o.has_iterators());
+    iter_refs_ = o.iter_refs_.take_for_owner();
+    hasher_ = ::sus::move(o.hasher_);
+    table_ = ::sus::move(o.table_);
+    o.table_.mark_moved_from();
+    return *this;
+  }
+
+  /// Satisfies the [`Clone`]($sus::mem::Clone) concept.
+  ///
+  /// The entries are cloned into the same buckets, without hashing any keys.
+  HashMap clone() const& noexcept
+    requires(::sus::mem::Clone<K> && ::sus::mem::Clone<V> &&
+             ::sus::mem::Clone<S>)
+  {
+    sus_check(!is_moved_from());
+    return HashMap(FROM_PARTS, ::sus::clone(hasher_),
+                   table_.clone_with([](const Slot& s) {
+                     return Slot(::sus::clone(s.key), ::sus::clone(s.value));
+                   }));
+  }
+
+  ~HashMap() = default;
+
+  /// Returns the number of entries in the map.
+  _sus_pure usize len() const& noexcept {
+    sus_check(!is_moved_from());
+    return table_.len();
+  }
+
+  /// Returns `true` if the map contains no entries.
+  _sus_pure bool is_empty() const& noexcept {
+    sus_check(!is_moved_from());
+    return table_.len() == 0u;
+  }
+
+  /// Returns the number of entries the map can hold without reallocating.
+  _sus_pure usize capacity() const& noexcept {
+    sus_check(!is_moved_from());
+    return table_.capacity();
+  }
+
+  /// Returns a reference to the map's hasher.
+  _sus_pure const S& hasher() const& noexcept sus_lifetimebound {
+    return hasher_;
+  }
+
+  /// Clears the map, removing all entries.
+  ///
+  /// Note that this method has no effect on the allocated capacity of the
+  /// map.
+  void clear() noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    table_.clear();
+  }
+
+  /// Reserves capacity for at least `additional` more entries to be inserted
+  /// in the map. The map may reserve more space to avoid frequent
+  /// reallocations.
+  ///
+  /// # Panics
+  /// Panics if the new capacity overflows the size of the address space.
+  void reserve(usize additional) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    table_.reserve(additional, slot_hasher());
+  }
+
+  /// Shrinks the capacity of the map as much as possible, while keeping room
+  /// for its entries.
+  void shrink_to_fit() noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    table_.shrink_to(0u, slot_hasher());
+  }
+
+  /// Shrinks the capacity of the map, while keeping room for at least
+  /// `min_capacity` entries.
+  void shrink_to(usize min_capacity) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    table_.shrink_to(min_capacity, slot_hasher());
+  }
+
+  /// Returns `true` if the map contains a value for the given key.
+  _sus_pure bool contains_key(const K& key) const& noexcept {
+    return find(key) != nullptr;
+  }
+
+  /// Returns a const reference to the value for the given key, or `None` if
+  /// the map does not contain the key.
+  _sus_pure Option<const V&> get(const K& key) const& noexcept {
+    if (const Slot* s = find(key)) return Option<const V&>(s->value);
+    return Option<const V&>();
+  }
+  Option<const V&> get(const K& key) && = delete;
+
+  /// Returns a mutable reference to the value for the given key, or `None` if
+  /// the map does not contain the key.
+  _sus_pure Option<V&> get_mut(const K& key) & noexcept {
+    if (Slot* s = find(key)) return Option<V&>(s->value);
+    return Option<V&>();
+  }
+
+  /// Returns const references to the key and value stored in the map for the
+  /// given key, or `None` if the map does not contain the key.
+  _sus_pure Option<::sus::Tuple<const K&, const V&>> get_key_value(
+      const K& key) const& noexcept {
+    using Pair = ::sus::Tuple<const K&, const V&>;
+    if (const Slot* s = find(key)) return Option<Pair>(Pair(s->key, s->value));
+    return Option<Pair>();
+  }
+  Option<::sus::Tuple<const K&, const V&>> get_key_value(const K& key) && =
+      delete;
+
+  /// Inserts a key-value pair into the map.
+  ///
+  /// If the map did not have the key present, `None` is returned.
+  ///
+  /// If the map did have the key present, the value is updated, and the old
+  /// value is returned. The key is not updated, which matters for types that
+  /// can be `==` without being identical.
+  ///
+  /// # Panics
+  /// Panics if the new capacity overflows the size of the address space.
+  Option<V> insert(K key, V value) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    const uint64_t hash = hash_key(key);
+    if (Slot* s = table_.find(hash, key_eq(key))) {
+      return Option<V>(::sus::mem::replace(s->value, ::sus::move(value)));
+    }
+    insert_new(hash, ::sus::move(key), ::sus::move(value));
+    return Option<V>();
+  }
+
+  /// Removes a key from the map, returning the value at the key if the key was
+  /// previously in the map.
+  Option<V> remove(const K& key) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    Slot* const s = table_.find(hash_key(key), key_eq(key));
+    if (s == nullptr) return Option<V>();
+    auto out = Option<V>(::sus::move(s->value));
+    table_.erase(s);
+    return out;
+  }
+
+  /// Removes a key from the map, returning the stored key and value if the key
+  /// was previously in the map.
+  Option<::sus::Tuple<K, V>> remove_entry(const K& key) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    Slot* const s = table_.find(hash_key(key), key_eq(key));
+    if (s == nullptr) return Option<::sus::Tuple<K, V>>();
+    auto out = Option<::sus::Tuple<K, V>>(
+        ::sus::Tuple<K, V>(::sus::move(s->key), ::sus::move(s->value)));
+    table_.erase(s);
+    return out;
+  }
+
+  /// Retains only the entries specified by the predicate.
+  ///
+  /// In other words, removes all entries `(k, v)` for which `f(k, v)` returns
+  /// `false`. The entries are visited in an arbitrary order.
+  void retain(::sus::fn::FnMut<bool(const K&, V&)> auto f) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    // Prevent mutation from inside `f`.
+    ::sus::iter::IterRef ref = iter_refs_.to_iter_from_owner();
+    auto it = table_.iter();
+    while (Slot* const s = it.next()) {
+      if (!::sus::fn::call_mut(f, static_cast<const K&>(s->key), s->value))
+        table_.erase(s);
+    }
+  }
+
+  /// Gets the given key's entry in the map for in-place manipulation.
+  ///
+  /// The map can not be mutated except through the
+  /// [`HashMapEntry`]($sus::collections::HashMapEntry) while it exists.
+  ///
+  /// # Examples
+  /// Counting the occurrences of each value, with a single lookup each:
+  /// ```
+  /// auto counts = sus::collections::HashMap<i32, usize>();
+  /// for (i32 i : sus::Vec<i32>(1, 2, 1)) counts.entry(i).or_insert(0u) += 1u;
+  /// sus_check(counts[1] == 2u);
+  /// ```
+  HashMapEntry<K, V, S> entry(K key) & noexcept sus_lifetimebound {
+    sus_check(!is_moved_from() && !has_iterators());
+    const uint64_t hash = hash_key(key);
+    Slot* const s = table_.find(hash, key_eq(key));
+    return HashMapEntry<K, V, S>(*this, hash, ::sus::move(key), s);
+  }
+
+  /// Returns a const reference to the value for the given key.
+  ///
+  /// # Panics
+  /// Panics if the map does not contain the key.
+  _sus_pure const V& operator[](const K& key) const& noexcept {
+    const Slot* const s = find(key);
+    sus_check_with_message(s != nullptr, "key not found in HashMap");
+    return s->value;
+  }
+  const V& operator[](const K& key) && = delete;
+
+  /// Returns an iterator over all the entries in the map, as
+  /// `Tuple<const K&, const V&>`, in an arbitrary order.
+  HashMapIter<K, V> iter() const& noexcept sus_lifetimebound {
+    sus_check(!is_moved_from());
+    return HashMapIter<K, V>(iter_refs_.to_iter_from_owner(),
+                             table_.iter_const());
+  }
+  HashMapIter<K, V> iter() && = delete;
+
+  /// Returns an iterator over all the entries in the map, with mutable
+  /// references to the values, as `Tuple<const K&, V&>`, in an arbitrary
+  /// order.
+  HashMapIterMut<K, V> iter_mut() & noexcept sus_lifetimebound {
+    sus_check(!is_moved_from());
+    return HashMapIterMut<K, V>(iter_refs_.to_iter_from_owner(),
+                                table_.iter());
+  }
+
+  /// Consumes the map into an iterator over its entries, as `Tuple<K, V>`, in
+  /// an arbitrary order.
+  HashMapIntoIter<K, V> into_iter() && noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    auto it = HashMapIntoIter<K, V>(::sus::move(table_));
+    table_.mark_moved_from();
+    return it;
+  }
+
+  /// Returns an iterator over the keys of the map, in an arbitrary order.
+  HashMapKeys<K, V> keys() const& noexcept sus_lifetimebound {
+    sus_check(!is_moved_from());
+    return HashMapKeys<K, V>(iter_refs_.to_iter_from_owner(),
+                             table_.iter_const());
+  }
+  HashMapKeys<K, V> keys() && = delete;
+
+  /// Returns an iterator over the values of the map, in an arbitrary order.
+  HashMapValues<K, V, const V&> values() const& noexcept sus_lifetimebound {
+    sus_check(!is_moved_from());
+    return HashMapValues<K, V, const V&>(iter_refs_.to_iter_from_owner(),
+                                         table_.iter_const());
+  }
+  HashMapValues<K, V, const V&> values() && = delete;
+
+  /// Returns an iterator over mutable references to the values of the map, in
+  /// an arbitrary order.
+  HashMapValues<K, V, V&> values_mut() & noexcept sus_lifetimebound {
+    sus_check(!is_moved_from());
+    return HashMapValues<K, V, V&>(iter_refs_.to_iter_from_owner(),
+                                   table_.iter());
+  }
+
+  /// Inserts each key-value pair from the iterator into the map, replacing
+  /// the values of keys that are already present.
+  ///
+  /// Space is reserved for the iterator's lower size hint before inserting.
+  ///
+  /// Satisfies the [`Extend<Tuple<K, V>>`]($sus::iter::Extend) concept.
+  void extend(::sus::iter::IntoIterator<::sus::Tuple<K, V>> auto&& ii) noexcept
+    requires(::sus::mem::IsMoveRef<decltype(ii)>)
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+    auto&& it = ::sus::move(ii).into_iter();
+    // If the map is not empty, some of the keys may already be present, so
+    // only reserve for half of them as hashbrown does.
+    const usize lower = it.size_hint().lower;
+    table_.reserve(table_.len() == 0u ? lower : (lower + 1u) / 2u,
+                   slot_hasher());
+    for (::sus::Tuple<K, V>&& kv : it) {
+      auto&& [key, value] = ::sus::move(kv);
+      insert(::sus::move(key), ::sus::move(value));
+    }
+  }
+
+  /// Satisfies the [`Eq<HashMap<K, V, S>>`]($sus::cmp::Eq) concept.
+  ///
+  /// Maps are equal if they have the same keys, each mapped to equal values.
+  friend bool operator==(const HashMap& l, const HashMap& r) noexcept
+    requires(::sus::cmp::Eq<V>)
+  {
+    if (l.len() != r.len()) return false;
+    auto it = l.table_.iter_const();
+    while (const Slot* const s = it.next()) {
+      const Slot* const o = r.find(s->key);
+      if (o == nullptr || !(s->value == o->value)) return false;
+    }
+    return true;
+  }
+
+  // Stream support.
+  _sus_format_to_stream(HashMap);
+
+ private:
+  friend class HashMapEntry<K, V, S>;
+
+  enum FromParts { FROM_PARTS };
+  explicit HashMap(FromParts, S hasher, Table table) noexcept
+      : iter_refs_(::sus::iter::IterRefCounter::for_owner()),
+        hasher_(::sus::move(hasher)),
+        table_(::sus::move(table)) {}
+
+  uint64_t hash_key(const K& key) const noexcept {
+    return __private::swiss::mix(std::invoke(hasher_, key));
+  }
+  auto slot_hasher() const noexcept {
+    return [this](const Slot& s) { return hash_key(s.key); };
+  }
+  static auto key_eq(const K& key) noexcept {
+    return [&key](const Slot& s) { return s.key == key; };
+  }
+
+  const Slot* find(const K& key) const noexcept {
+    sus_check(!is_moved_from());
+    return table_.find(hash_key(key), key_eq(key));
+  }
+  Slot* find(const K& key) noexcept {
+    sus_check(!is_moved_from());
+    return table_.find(hash_key(key), key_eq(key));
+  }
+
+  /// Inserts an entry whose key is not in the map.
+  Slot* insert_new(uint64_t hash, K&& key, V&& value) noexcept {
+    Slot* const s = table_.prepare_insert(hash, slot_hasher());
+    std::construct_at(s, ::sus::move(key), ::sus::move(value));
+    return s;
+  }
+
+  bool is_moved_from() const noexcept { return table_.is_moved_from(); }
+  bool has_iterators() const noexcept {
+    return iter_refs_.count_from_owner() != 0u;
+  }
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRefCounter iter_refs_;
+  [[_sus_no_unique_address]] S hasher_;
+  Table table_;
+
+  sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn,
+                                           decltype(iter_refs_),
+                                           decltype(hasher_),
+                                           decltype(table_));
+};
+
+/// A view into a single entry in a [`HashMap`]($sus::collections::HashMap),
+/// which may be occupied or vacant.
+///
+/// This type is returned from
+/// [`HashMap::entry`]($sus::collections::HashMap::entry). The key has already
+/// been looked up, so inserting or modifying the value does not repeat the
+/// lookup.
+///
+/// The map can not be mutated except through the entry while the entry
+/// exists.
+template <class K, class V, class S>
+class [[nodiscard]] HashMapEntry final {
+  using Map = HashMap<K, V, S>;
+  using Slot = __private::swiss::MapSlot<K, V>;
+
+ public:
+  /// Returns `true` if the map contains a value for the entry's key.
+  _sus_pure bool is_occupied() const& noexcept { return slot_ != nullptr; }
+  /// Returns `true` if the map does not contain a value for the entry's key.
+  _sus_pure bool is_vacant() const& noexcept { return slot_ == nullptr; }
+
+  /// Returns a reference to this entry's key.
+  _sus_pure const K& key() const& noexcept sus_lifetimebound {
+    return slot_ != nullptr ? slot_->key : key_;
+  }
+
+  /// Provides in-place mutable access to an occupied entry before any
+  /// potential inserts into the map.
+  HashMapEntry and_modify(::sus::fn::FnOnce<void(V&)> auto f) && noexcept {
+    if (slot_ != nullptr) ::sus::fn::call_once(::sus::move(f), slot_->value);
+    return ::sus::move(*this);
+  }
+
+  /// Ensures a value is in the entry by inserting `value` if it is vacant,
+  /// and returns a mutable reference to the value in the entry.
+  V& or_insert(V value) && noexcept {
+    if (slot_ != nullptr) return slot_->value;
+    return insert_vacant(::sus::move(value));
+  }
+
+  /// Ensures a value is in the entry by inserting the result of `f()` if it is
+  /// vacant, and returns a mutable reference to the value in the entry.
+  V& or_insert_with(::sus::fn::FnOnce<V()> auto f) && noexcept {
+    if (slot_ != nullptr) return slot_->value;
+    return insert_vacant(::sus::fn::call_once(::sus::move(f)));
+  }
+
+  /// Ensures a value is in the entry by inserting the result of `f(key)` if it
+  /// is vacant, and returns a mutable reference to the value in the entry.
+  V& or_insert_with_key(::sus::fn::FnOnce<V(const K&)> auto f) && noexcept {
+    if (slot_ != nullptr) return slot_->value;
+    return insert_vacant(
+        ::sus::fn::call_once(::sus::move(f), static_cast<const K&>(key_)));
+  }
+
+  /// Ensures a value is in the entry by inserting the default value if it is
+  /// vacant, and returns a mutable reference to the value in the entry.
+  V& or_default() && noexcept
+    requires(::sus::construct::Default<V>)
+  {
+    if (slot_ != nullptr) return slot_->value;
+    return insert_vacant(V());
+  }
+
+  /// Sets the value of the entry, and returns the old value if the entry was
+  /// occupied.
+  Option<V> insert(V value) && noexcept {
+    if (slot_ != nullptr)
+      return Option<V>(::sus::mem::replace(slot_->value, ::sus::move(value)));
+    insert_vacant(::sus::move(value));
+    return Option<V>();
+  }
+
+ private:
+  friend Map;
+
+  explicit HashMapEntry(Map& map sus_lifetimebound, uint64_t hash, K key,
+                        Slot* slot) noexcept
+      : ref_(map.iter_refs_.to_iter_from_owner()),
+        map_(map),
+        hash_(hash),
+        key_(::sus::move(key)),
+        slot_(slot) {}
+
+  V& insert_vacant(V&& value) noexcept {
+    // The entry holds an IterRef to keep others from mutating the map, so it
+    // inserts without going through the map's checks.
+    slot_ = map_.insert_new(hash_, ::sus::move(key_), ::sus::move(value));
+    return slot_->value;
+  }
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
+  Map& map_;
+  uint64_t hash_;
+  K key_;
+  /// The entry's slot in the map, or null if the entry is vacant.
+  Slot* slot_;
+};
+
+}  // namespace sus::collections
+
+// sus::iter::FromIterator trait for HashMap.
+template <class K, class V, class S>
+  requires(std::default_initializable<S>)
+struct sus::iter::FromIteratorImpl<::sus::collections::HashMap<K, V, S>> {
+  /// Constructs a map from the key-value pairs in the iterator. Later values
+  /// replace earlier ones with the same key.
+  static ::sus::collections::HashMap<K, V, S> from_iter(
+      ::sus::iter::IntoIterator<::sus::Tuple<K, V>> auto&& ii) noexcept
+    requires(::sus::mem::IsMoveRef<decltype(ii)>)
+  {
+    auto m = ::sus::collections::HashMap<K, V, S>();
+    m.extend(::sus::move(ii));
+    return m;
+  }
+};
+
+// fmt support.
+template <class K, class V, class S, class Char>
+struct fmt::formatter<::sus::collections::HashMap<K, V, S>, Char> {
+  template <class ParseContext>
+  constexpr auto parse(ParseContext& ctx) {
+    // The format spec applies to the values, as with the `Ok` value of a
+    // `Result`.
+    return underlying_value_.parse(ctx);
+  }
+
+  template <class FormatContext>
+  constexpr auto format(const ::sus::collections::HashMap<K, V, S>& map,
+                        FormatContext& ctx) const {
+    auto out = ctx.out();
+    out = fmt::format_to(out, "{{");
+    bool first = true;
+    for (auto&& [key, value] : map.iter()) {
+      if (!first) out = fmt::format_to(out, ", ");
+      first = false;
+      ctx.advance_to(out);
+      out = underlying_key_.format(key, ctx);
+      out = fmt::format_to(out, ": ");
+      ctx.advance_to(out);
+      out = underlying_value_.format(value, ctx);
+    }
+    return fmt::format_to(out, "}}");
+  }
+
+ private:
+  ::sus::string::__private::AnyFormatter<K, Char> underlying_key_;
+  ::sus::string::__private::AnyFormatter<V, Char> underlying_value_;
+};
+
+// Promote HashMap into the `sus` namespace.
+namespace sus {
+using ::sus::collections::HashMap;
+}  // namespace sus
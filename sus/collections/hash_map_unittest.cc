@@ -0,0 +1,423 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/collections/hash_map.h"
+
+#include <sstream>
+#include <string>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/collections/vec.h"
+#include "sus/iter/iterator.h"
+#include "sus/mem/move.h"
+#include "sus/ops/range.h"
+#include "sus/prelude.h"
+#include "sus/test/counted.h"
+#include "sus/test/ensure_use.h"
+
+namespace {
+
+using sus::collections::HashMap;
+using sus::test::Counted;
+using sus::test::ensure_use;
+
+/// Sends every key to the same bucket, so each lookup has to probe past all
+/// the other keys.
+struct CollidingHash {
+  size_t operator()(const i32&) const noexcept { return 7u; }
+};
+
+TEST(HashMap, Default) {
+  auto m = HashMap<i32, i32>();
+  EXPECT_EQ(m.len(), 0u);
+  EXPECT_EQ(m.is_empty(), true);
+  EXPECT_EQ(m.capacity(), 0u);
+  EXPECT_EQ(m.get(1).is_none(), true);
+}
+
+TEST(HashMap, EmptyTypeDeduction) {
+  HashMap<i32, i32> m = sus::empty;
+  EXPECT_EQ(m.len(), 0u);
+}
+
+TEST(HashMap, WithCapacity) {
+  auto m = HashMap<i32, i32>::with_capacity(100u);
+  EXPECT_GE(m.capacity(), 100u);
+  usize cap = m.capacity();
+  for (i32 i : sus::ops::range(0_i32, 100_i32)) m.insert(i, i);
+  EXPECT_EQ(m.capacity(), cap);
+}
+
+TEST(HashMap, InsertGet) {
+  auto m = HashMap<i32, i32>();
+  EXPECT_EQ(m.insert(1, 10).is_none(), true);
+  EXPECT_EQ(m.insert(2, 20).is_none(), true);
+  EXPECT_EQ(m.len(), 2u);
+  EXPECT_EQ(m.get(1).copied().unwrap(), 10);
+  EXPECT_EQ(m.get(2).copied().unwrap(), 20);
+  EXPECT_EQ(m.get(3).is_none(), true);
+  EXPECT_EQ(m[2], 20);
+
+  // Inserting an existing key replaces the value and returns the old one.
+  EXPECT_EQ(m.insert(1, 11).unwrap(), 10);
+  EXPECT_EQ(m.len(), 2u);
+  EXPECT_EQ(m[1], 11);
+
+  m.get_mut(2).unwrap() += 1;
+  EXPECT_EQ(m[2], 21);
+
+  auto [k, v] = m.get_key_value(1).unwrap();
+  EXPECT_EQ(k, 1);
+  EXPECT_EQ(v, 11);
+  EXPECT_EQ(m.contains_key(1), true);
+  EXPECT_EQ(m.contains_key(5), false);
+}
+
+TEST(HashMap, Grow) {
+  auto m = HashMap<i32, i32>();
+  for (i32 i : sus::ops::range(0_i32, 10000_i32)) {
+    EXPECT_EQ(m.insert(i, i * 2).is_none(), true);
+  }
+  EXPECT_EQ(m.len(), 10000u);
+  EXPECT_GE(m.capacity(), 10000u);
+  for (i32 i : sus::ops::range(0_i32, 10000_i32)) EXPECT_EQ(m[i], i * 2);
+  EXPECT_EQ(m.get(10000).is_none(), true);
+  EXPECT_EQ(m.get(-1).is_none(), true);
+}
+
+TEST(HashMap, StringKeys) {
+  auto m = HashMap<std::string, i32>();
+  for (i32 i : sus::ops::range(0_i32, 100_i32)) {
+    m.insert(std::to_string(i.primitive_value), i);
+  }
+  EXPECT_EQ(m.len(), 100u);
+  EXPECT_EQ(m[std::string("42")], 42);
+  EXPECT_EQ(m.remove(std::string("42")).unwrap(), 42);
+  EXPECT_EQ(m.contains_key(std::string("42")), false);
+  EXPECT_EQ(m.len(), 99u);
+}
+
+TEST(HashMap, Collisions) {
+  auto m = HashMap<i32, i32, CollidingHash>();
+  for (i32 i : sus::ops::range(0_i32, 100_i32)) m.insert(i, i);
+  EXPECT_EQ(m.len(), 100u);
+  for (i32 i : sus::ops::range(0_i32, 100_i32)) EXPECT_EQ(m[i], i);
+  for (i32 i : sus::ops::range(0_i32, 100_i32).step_by(2u)) {
+    EXPECT_EQ(m.remove(i).unwrap(), i);
+  }
+  EXPECT_EQ(m.len(), 50u);
+  for (i32 i : sus::ops::range(0_i32, 100_i32)) {
+    EXPECT_EQ(m.contains_key(i), i % 2 == 1);
+  }
+}
+
+TEST(HashMap, Remove) {
+  auto m = HashMap<i32, i32>();
+  m.insert(1, 10);
+  m.insert(2, 20);
+  EXPECT_EQ(m.remove(1).unwrap(), 10);
+  EXPECT_EQ(m.remove(1).is_none(), true);
+  EXPECT_EQ(m.len(), 1u);
+
+  auto [k, v] = m.remove_entry(2).unwrap();
+  EXPECT_EQ(k, 2);
+  EXPECT_EQ(v, 20);
+  EXPECT_EQ(m.is_empty(), true);
+  EXPECT_EQ(m.remove_entry(2).is_none(), true);
+}
+
+TEST(HashMap, RemoveAndReinsert) {
+  // Removing and inserting different keys over and over leaves tombstones
+  // behind, which must be reused or cleaned up without growing the table.
+  auto m = HashMap<i32, i32>::with_capacity(64u);
+  const usize cap = m.capacity();
+  for (i32 i : sus::ops::range(0_i32, 100000_i32)) {
+    m.insert(i, i);
+    if (i >= 32) EXPECT_EQ(m.remove(i - 32).unwrap(), i - 32);
+  }
+  EXPECT_EQ(m.len(), 32u);
+  EXPECT_EQ(m.capacity(), cap);
+  for (i32 i : sus::ops::range(100000_i32 - 32, 100000_i32)) {
+    EXPECT_EQ(m[i], i);
+  }
+}
+
+TEST(HashMap, Retain) {
+  auto m = HashMap<i32, i32>();
+  for (i32 i : sus::ops::range(0_i32, 100_i32)) m.insert(i, i);
+  m.retain([](const i32& k, i32& v) {
+    v += 1;
+    return k % 3 == 0;
+  });
+  EXPECT_EQ(m.len(), 34u);
+  for (i32 i : sus::ops::range(0_i32, 100_i32)) {
+    if (i % 3 == 0)
+      EXPECT_EQ(m[i], i + 1);
+    else
+      EXPECT_EQ(m.contains_key(i), false);
+  }
+}
+
+TEST(HashMap, ClearAndShrink) {
+  auto m = HashMap<i32, i32>();
+  for (i32 i : sus::ops::range(0_i32, 1000_i32)) m.insert(i, i);
+  const usize cap = m.capacity();
+  m.clear();
+  EXPECT_EQ(m.len(), 0u);
+  EXPECT_EQ(m.capacity(), cap);
+  m.insert(3, 3);
+  m.shrink_to_fit();
+  EXPECT_LT(m.capacity(), cap);
+  EXPECT_EQ(m[3], 3);
+  m.reserve(500u);
+  EXPECT_GE(m.capacity(), 501u);
+  EXPECT_EQ(m[3], 3);
+}
+
+TEST(HashMap, Entry) {
+  auto m = HashMap<i32, i32>();
+  {
+    auto e = m.entry(1);
+    EXPECT_EQ(e.is_vacant(), true);
+    EXPECT_EQ(e.key(), 1);
+    EXPECT_EQ(sus::move(e).or_insert(10), 10);
+  }
+  EXPECT_EQ(m[1], 10);
+
+  m.entry(1).or_insert(20) += 1;
+  EXPECT_EQ(m[1], 11);
+
+  EXPECT_EQ(m.entry(2).or_insert_with([] { return 20_i32; }), 20);
+  EXPECT_EQ(m.entry(3).or_insert_with_key([](const i32& k) { return k * 10; }),
+            30);
+  EXPECT_EQ(m.entry(4).or_default(), 0);
+
+  m.entry(2).and_modify([](i32& v) { v += 5; }).or_insert(0);
+  EXPECT_EQ(m[2], 25);
+  m.entry(5).and_modify([](i32& v) { v += 5; }).or_insert(50);
+  EXPECT_EQ(m[5], 50);
+
+  EXPECT_EQ(m.entry(5).is_occupied(), true);
+  EXPECT_EQ(m.entry(5).insert(51).unwrap(), 50);
+  EXPECT_EQ(m.entry(6).insert(60).is_none(), true);
+  EXPECT_EQ(m.len(), 6u);
+  EXPECT_EQ(m[6], 60);
+}
+
+TEST(HashMap, EntryCount) {
+  auto counts = HashMap<i32, usize>();
+  for (i32 i : sus::Vec<i32>(1, 2, 1, 3, 1, 2)) {
+    counts.entry(i).or_insert(0u) += 1u;
+  }
+  EXPECT_EQ(counts.len(), 3u);
+  EXPECT_EQ(counts[1], 3u);
+  EXPECT_EQ(counts[2], 2u);
+  EXPECT_EQ(counts[3], 1u);
+}
+
+TEST(HashMap, Iter) {
+  auto m = HashMap<i32, i32>();
+  for (i32 i : sus::ops::range(0_i32, 100_i32)) m.insert(i, i * 2);
+
+  auto it = m.iter();
+  EXPECT_EQ(it.exact_size_hint(), 100u);
+  EXPECT_EQ(it.size_hint().lower, 100u);
+  EXPECT_EQ(it.size_hint().upper.unwrap(), 100u);
+  it.next();
+  EXPECT_EQ(it.exact_size_hint(), 99u);
+
+  i32 key_sum = 0;
+  i32 value_sum = 0;
+  usize count = 0u;
+  for (auto [k, v] : m.iter()) {
+    static_assert(std::same_as<decltype(k), const i32&>);
+    static_assert(std::same_as<decltype(v), const i32&>);
+    key_sum += k;
+    value_sum += v;
+    count += 1u;
+  }
+  EXPECT_EQ(count, 100u);
+  EXPECT_EQ(key_sum, 4950);
+  EXPECT_EQ(value_sum, 9900);
+
+  key_sum = 0;
+  for (const i32& k : m.keys()) key_sum += k;
+  EXPECT_EQ(key_sum, 4950);
+  value_sum = 0;
+  for (const i32& v : m.values()) value_sum += v;
+  EXPECT_EQ(value_sum, 9900);
+}
+
+TEST(HashMap, IterMut) {
+  auto m = HashMap<i32, i32>();
+  for (i32 i : sus::ops::range(0_i32, 10_i32)) m.insert(i, i);
+  for (auto [k, v] : m.iter_mut()) {
+    static_assert(std::same_as<decltype(k), const i32&>);
+    static_assert(std::same_as<decltype(v), i32&>);
+    v += k;
+  }
+  for (i32& v : m.values_mut()) v += 1;
+  for (i32 i : sus::ops::range(0_i32, 10_i32)) EXPECT_EQ(m[i], i * 2 + 1);
+}
+
+TEST(HashMap, IntoIter) {
+  Counted::alive = 0;
+  auto m = HashMap<i32, Counted>();
+  for (i32 i : sus::ops::range(0_i32, 10_i32)) m.insert(i, Counted(i));
+  EXPECT_EQ(Counted::alive, 10);
+
+  auto it = sus::move(m).into_iter();
+  EXPECT_EQ(it.exact_size_hint(), 10u);
+  i32 sum = 0;
+  for (usize i : sus::ops::range(0_usize, 4_usize)) {
+    auto [k, v] = it.next().unwrap();
+    EXPECT_EQ(k, v.v);
+    sum += k;
+    ensure_use(&i);
+  }
+  EXPECT_EQ(it.exact_size_hint(), 6u);
+  EXPECT_EQ(Counted::alive, 6);
+  {
+    // The entries that were not visited are destroyed with the iterator.
+    auto moved = sus::move(it);
+    EXPECT_EQ(moved.exact_size_hint(), 6u);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+  EXPECT_GE(sum, 0 + 1 + 2 + 3);
+}
+
+TEST(HashMap, Drop) {
+  Counted::alive = 0;
+  {
+    auto m = HashMap<i32, Counted>();
+    for (i32 i : sus::ops::range(0_i32, 100_i32)) m.insert(i, Counted(i));
+    m.remove(5);
+    m.insert(5, Counted(5));
+    EXPECT_EQ(m.insert(6, Counted(6)).unwrap().v, 6);
+    EXPECT_EQ(Counted::alive, 100);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(HashMap, Move) {
+  auto m = HashMap<i32, i32>();
+  m.insert(1, 1);
+  auto n = sus::move(m);
+  EXPECT_EQ(n.len(), 1u);
+  m = sus::move(n);
+  EXPECT_EQ(m[1], 1);
+}
+
+TEST(HashMap, CloneEq) {
+  auto m = HashMap<i32, i32>();
+  for (i32 i : sus::ops::range(0_i32, 100_i32)) m.insert(i, i);
+  auto c = sus::clone(m);
+  EXPECT_EQ(c.len(), 100u);
+  EXPECT_EQ(c, m);
+  c.insert(3, 4);
+  EXPECT_NE(c, m);
+  c.insert(3, 3);
+  EXPECT_EQ(c, m);
+  c.remove(3);
+  EXPECT_NE(c, m);
+
+  // Equality does not depend on insertion order.
+  auto a = HashMap<i32, i32>();
+  auto b = HashMap<i32, i32>();
+  for (i32 i : sus::ops::range(0_i32, 50_i32)) a.insert(i, i);
+  for (i32 i : sus::ops::range(0_i32, 50_i32).rev()) b.insert(i, i);
+  EXPECT_EQ(a, b);
+}
+
+TEST(HashMap, FromIterator) {
+  auto m = sus::Vec<sus::Tuple<i32, i32>>(sus::tuple(1, 10), sus::tuple(2, 20),
+                                          sus::tuple(1, 11))
+               .into_iter()
+               .collect<HashMap<i32, i32>>();
+  EXPECT_EQ(m.len(), 2u);
+  EXPECT_EQ(m[1], 11);
+  EXPECT_EQ(m[2], 20);
+
+  m.extend(sus::Vec<sus::Tuple<i32, i32>>(sus::tuple(3, 30)));
+  EXPECT_EQ(m[3], 30);
+}
+
+TEST(HashMapDeathTest, IndexMissing) {
+  auto m = HashMap<i32, i32>();
+  m.insert(1, 1);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(
+      {
+        i32 v = m[2];
+        ensure_use(&v);
+      },
+      "");
+#endif
+}
+
+TEST(HashMapDeathTest, ReserveOverflow) {
+  auto empty = HashMap<i32, i32>();
+  auto m = HashMap<i32, i32>();
+  m.insert(1, 1);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(empty.reserve(usize::MAX), "");
+  // The new item count wraps around when added to the items present.
+  EXPECT_DEATH(m.reserve(usize::MAX), "");
+#endif
+}
+
+TEST(HashMapDeathTest, InsertWhileIterating) {
+#if !defined(SUS_ITERATOR_INVALIDATION) || SUS_ITERATOR_INVALIDATION
+  auto m = HashMap<i32, i32>();
+  m.insert(1, 1);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(
+      {
+        auto it = m.iter();
+        m.insert(2, 2);
+        ensure_use(&it);
+      },
+      "");
+  EXPECT_DEATH(
+      {
+        auto e = m.entry(2);
+        m.insert(2, 2);
+        ensure_use(&e);
+      },
+      "");
+#endif
+#endif
+}
+
+TEST(HashMap, fmt) {
+  auto m = HashMap<i32, i32>();
+  EXPECT_EQ(fmt::format("{}", m), "{}");
+  m.insert(1, 2);
+  EXPECT_EQ(fmt::format("{}", m), "{1: 2}");
+  // The format spec applies to the values.
+  EXPECT_EQ(fmt::format("{:02}", m), "{1: 02}");
+  m.insert(3, 4);
+  const std::string s = fmt::format("{}", m);
+  EXPECT_TRUE(s == "{1: 2, 3: 4}" || s == "{3: 4, 1: 2}");
+}
+
+TEST(HashMap, Stream) {
+  std::stringstream s;
+  auto m = HashMap<i32, i32>();
+  m.insert(1, 2);
+  s << m;
+  EXPECT_EQ(s.str(), "{1: 2}");
+}
+
+}  // namespace
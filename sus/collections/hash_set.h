@@ -0,0 +1,444 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+#include "fmt/core.h"
+#include "sus/assertions/check.h"
+#include "sus/cmp/eq.h"
+#include "sus/collections/__private/swiss_table.h"
+#include "sus/collections/collections.h"
+#include "sus/collections/iterators/hash_set_iter.h"
+#include "sus/fn/fn_concepts.h"
+#include "sus/hash/default_hasher.h"
+#include "sus/hash/hash.h"
+#include "sus/iter/from_iterator.h"
+#include "sus/iter/into_iterator.h"
+#include "sus/iter/iterator_loop.h"
+#include "sus/iter/iterator_ref.h"
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/macros/lifetimebound.h"
+#include "sus/marker/empty.h"
+#include "sus/mem/clone.h"
+#include "sus/mem/move.h"
+#include "sus/mem/relocate.h"
+#include "sus/mem/replace.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+#include "sus/string/__private/any_formatter.h"
+#include "sus/string/__private/format_to_stream.h"
+
+namespace sus::collections {
+
+/// A hash set of values of type `T`, implemented as an open-addressing Swiss
+/// table.
+///
+/// A `HashSet` is stored the same way as a
+/// [`HashMap`]($sus::collections::HashMap), with the elements in a single flat
+/// allocation and lookups that compare a group of control bytes at once with
+/// vector instructions. See [`HashMap`]($sus::collections::HashMap) for more.
+///
+/// Elements are compared with `operator==` and hashed with `S`, which is
+/// called as `size_t(const T&)`. By default `S` hashes elements that satisfy
+/// [`Hash`]($sus::hash::Hash) with the [`DefaultHasher`](
+/// $sus::hash::DefaultHasher). An element must not be changed in a way that
+/// changes its hash or equality while it is in the set.
+///
+/// Iterators visit the elements in an arbitrary order. Like `Vec`, the set
+/// tracks its iterators, and will panic if it is mutated while any of them
+/// are alive.
+///
+/// The set is not usable in constant expressions.
+template <class T, class S>
+class HashSet final {
+  static_assert(!std::is_reference_v<T>,
+                "HashSet must hold value types. Use pointers instead of "
+                "references.");
+  static_assert(!std::is_const_v<T>,
+                "`HashSet<const T>` should be written `const HashSet<T>`, as "
+                "const applies transitively.");
+  static_assert(::sus::cmp::Eq<T>, "The element type must satisfy `Eq`.");
+  static_assert(std::is_invocable_r_v<size_t, const S&, const T&>,
+                "The hasher `S` must be callable as `size_t(const T&)`.");
+
+  using Table = __private::swiss::RawTable<T>;
+
+ public:
+  /// Constructs an empty `HashSet`.
+  ///
+  /// The set will not allocate until elements are inserted into it.
+  ///
+  /// This constructor also satisfies `sus::construct::Default`.
+  explicit HashSet() noexcept
+    requires(std::default_initializable<S>)
+      : HashSet(FROM_PARTS, S(), Table()) {}
+
+  /// Constructs an empty `HashSet`.
+  ///
+  /// This constructor is implicit so that using the [`EmptyMarker`](
+  /// $sus::marker::EmptyMarker) allows the caller to avoid spelling out the
+  /// full `HashSet` type.
+  /// #[doc.overloads=empty]
+  HashSet(::sus::marker::EmptyMarker) noexcept
+    requires(std::default_initializable<S>)
+      : HashSet() {}
+
+  /// Creates an empty `HashSet` which can hold at least `capacity` elements
+  /// without reallocating.
+  ///
+  /// # Panics
+  /// Panics if the capacity overflows the size of the address space.
+  _sus_pure static HashSet with_capacity(usize capacity) noexcept
+    requires(std::default_initializable<S>)
+  {
+    return HashSet(FROM_PARTS, S(), Table(capacity));
+  }
+
+  /// Creates an empty `HashSet` which will use `hasher` to hash elements.
+  _sus_pure static HashSet with_hasher(S hasher) noexcept {
+    return HashSet(FROM_PARTS, ::sus::move(hasher), Table());
+  }
+
+  /// Creates an empty `HashSet` which can hold at least `capacity` elements
+  /// without reallocating, and which will use `hasher` to hash elements.
+  ///
+  /// # Panics
+  /// Panics if the capacity overflows the size of the address space.
+  _sus_pure static HashSet with_capacity_and_hasher(usize capacity,
+                                                    S hasher) noexcept {
+    return HashSet(FROM_PARTS, ::sus::move(hasher), Table(capacity));
+  }
+
+  /// Satisifes the [`Move`]($sus::mem::Move) concept.
+  /// #[doc.overloads=hashset.move]
+  HashSet(HashSet&& o) noexcept
+      : iter_refs_(o.iter_refs_.take_for_owner()),
+        hasher_(::sus::move(o.hasher_)),
+        table_(::sus::move(o.table_)) {
+    sus_check(!is_moved_from() && !has_iterators());
+    o.table_.mark_moved_from();
+  }
+  /// Satisifes the [`Move`]($sus::mem::Move) concept.
+  /// #[doc.overloads=hashset.move]
+  HashSet& operator=(HashSet&& o) noexcept {
+    sus_check(!o.is_moved_from());
+    sus_check(!has_iterators());
+    sus_check(!o.has_iterators());
+    iter_refs_ = o.iter_refs_.take_for_owner();
+    hasher_ = ::sus::move(o.hasher_);
+    table_ = ::sus::move(o.table_);
+    o.table_.mark_moved_from();
+    return *this;
+  }
+
+  /// Satisfies the [`Clone`]($sus::mem::Clone) concept.
+  ///
+  /// The elements are cloned into the same buckets, without hashing them.
+  HashSet clone() const& noexcept
+    requires(::sus::mem::Clone<T> && ::sus::mem::Clone<S>)
+  {
+    sus_check(!is_moved_from());
+    return HashSet(
+        FROM_PARTS, ::sus::clone(hasher_),
+        table_.clone_with([](const T& t) { return ::sus::clone(t); }));
+  }
+
+  ~HashSet() = default;
+
+  /// Returns the number of elements in the set.
+  _sus_pure usize len() const& noexcept {
+    sus_check(!is_moved_from());
+    return table_.len();
+  }
+
+  /// Returns `true` if the set contains no elements.
+  _sus_pure bool is_empty() const& noexcept {
+    sus_check(!is_moved_from());
+    return table_.len() == 0u;
+  }
+
+  /// Returns the number of elements the set can hold without reallocating.
+  _sus_pure usize capacity() const& noexcept {
+    sus_check(!is_moved_from());
+    return table_.capacity();
+  }
+
+  /// Returns a reference to the set's hasher.
+  _sus_pure const S& hasher() const& noexcept sus_lifetimebound {
+    return hasher_;
+  }
+
+  /// Clears the set, removing all elements.
+  ///
+  /// Note that this method has no effect on the allocated capacity of the
+  /// set.
+  void clear() noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    table_.clear();
+  }
+
+  /// Reserves capacity for at least `additional` more elements to be inserted
+  /// in the set. The set may reserve more space to avoid frequent
+  /// reallocations.
+  ///
+  /// # Panics
+  /// Panics if the new capacity overflows the size of the address space.
+  void reserve(usize additional) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    table_.reserve(additional, elem_hasher());
+  }
+
+  /// Shrinks the capacity of the set as much as possible, while keeping room
+  /// for its elements.
+  void shrink_to_fit() noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    table_.shrink_to(0u, elem_hasher());
+  }
+
+  /// Returns `true` if the set contains a value equal to `value`.
+  _sus_pure bool contains(const T& value) const& noexcept {
+    return find(value) != nullptr;
+  }
+
+  /// Returns a reference to the value in the set that is equal to `value`, or
+  /// `None` if there is none.
+  _sus_pure Option<const T&> get(const T& value) const& noexcept {
+    if (const T* t = find(value)) return Option<const T&>(*t);
+    return Option<const T&>();
+  }
+  Option<const T&> get(const T& value) && = delete;
+
+  /// Adds a value to the set.
+  ///
+  /// Returns whether the value was newly inserted. If the set already
+  /// contained an equal value, the set is not modified and `value` is
+  /// dropped.
+  ///
+  /// # Panics
+  /// Panics if the new capacity overflows the size of the address space.
+  bool insert(T value) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    const uint64_t hash = hash_elem(value);
+    if (table_.find(hash, elem_eq(value)) != nullptr) return false;
+    std::construct_at(table_.prepare_insert(hash, elem_hasher()),
+                      ::sus::move(value));
+    return true;
+  }
+
+  /// Adds a value to the set, replacing the existing value, if any, that is
+  /// equal to the given one. Returns the replaced value.
+  Option<T> replace(T value) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    const uint64_t hash = hash_elem(value);
+    if (T* t = table_.find(hash, elem_eq(value)))
+      return Option<T>(::sus::mem::replace(*t, ::sus::move(value)));
+    std::construct_at(table_.prepare_insert(hash, elem_hasher()),
+                      ::sus::move(value));
+    return Option<T>();
+  }
+
+  /// Removes a value from the set. Returns whether the value was present in
+  /// the set.
+  bool remove(const T& value) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    T* const t = table_.find(hash_elem(value), elem_eq(value));
+    if (t == nullptr) return false;
+    table_.erase(t);
+    return true;
+  }
+
+  /// Removes and returns the value in the set, if any, that is equal to the
+  /// given one.
+  Option<T> take(const T& value) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    T* const t = table_.find(hash_elem(value), elem_eq(value));
+    if (t == nullptr) return Option<T>();
+    auto out = Option<T>(::sus::move(*t));
+    table_.erase(t);
+    return out;
+  }
+
+  /// Retains only the elements specified by the predicate.
+  ///
+  /// In other words, removes all elements `e` for which `f(e)` returns
+  /// `false`. The elements are visited in an arbitrary order.
+  void retain(::sus::fn::FnMut<bool(const T&)> auto f) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    // Prevent mutation from inside `f`.
+    ::sus::iter::IterRef ref = iter_refs_.to_iter_from_owner();
+    auto it = table_.iter();
+    while (T* const t = it.next()) {
+      if (!::sus::fn::call_mut(f, static_cast<const T&>(*t))) table_.erase(t);
+    }
+  }
+
+  /// Returns `true` if every element of `self` is also in `other`.
+  _sus_pure bool is_subset(const HashSet& other) const& noexcept {
+    if (len() > other.len()) return false;
+    auto it = table_.iter_const();
+    while (const T* const t = it.next()) {
+      if (other.find(*t) == nullptr) return false;
+    }
+    return true;
+  }
+
+  /// Returns `true` if `self` has no elements in common with `other`.
+  _sus_pure bool is_disjoint(const HashSet& other) const& noexcept {
+    // Look up the elements of the smaller set in the larger one.
+    const HashSet& small = len() <= other.len() ? *this : other;
+    const HashSet& large = len() <= other.len() ? other : *this;
+    auto it = small.table_.iter_const();
+    while (const T* const t = it.next()) {
+      if (large.find(*t) != nullptr) return false;
+    }
+    return true;
+  }
+
+  /// Returns an iterator over the elements of the set, in an arbitrary order.
+  HashSetIter<T> iter() const& noexcept sus_lifetimebound {
+    sus_check(!is_moved_from());
+    return HashSetIter<T>(iter_refs_.to_iter_from_owner(),
+                          table_.iter_const());
+  }
+  HashSetIter<T> iter() && = delete;
+
+  /// Consumes the set into an iterator over its elements, in an arbitrary
+  /// order.
+  HashSetIntoIter<T> into_iter() && noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    auto it = HashSetIntoIter<T>(::sus::move(table_));
+    table_.mark_moved_from();
+    return it;
+  }
+
+  /// Inserts each value from the iterator into the set.
+  ///
+  /// Space is reserved for the iterator's lower size hint before inserting.
+  ///
+  /// Satisfies the [`Extend<T>`]($sus::iter::Extend) concept.
+  void extend(::sus::iter::IntoIterator<T> auto&& ii) noexcept
+    requires(::sus::mem::IsMoveRef<decltype(ii)>)
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+    auto&& it = ::sus::move(ii).into_iter();
+    // If the set is not empty, some of the values may already be present, so
+    // only reserve for half of them.
+    const usize lower = it.size_hint().lower;
+    table_.reserve(table_.len() == 0u ? lower : (lower + 1u) / 2u,
+                   elem_hasher());
+    for (T&& t : it) insert(::sus::move(t));
+  }
+
+  /// Satisfies the [`Eq<HashSet<T, S>>`]($sus::cmp::Eq) concept.
+  ///
+  /// Sets are equal if they contain equal elements.
+  friend bool operator==(const HashSet& l, const HashSet& r) noexcept {
+    return l.len() == r.len() && l.is_subset(r);
+  }
+
+  // Stream support.
+  _sus_format_to_stream(HashSet);
+
+ private:
+  enum FromParts { FROM_PARTS };
+  explicit HashSet(FromParts, S hasher, Table table) noexcept
+      : iter_refs_(::sus::iter::IterRefCounter::for_owner()),
+        hasher_(::sus::move(hasher)),
+        table_(::sus::move(table)) {}
+
+  uint64_t hash_elem(const T& t) const noexcept {
+    return __private::swiss::mix(std::invoke(hasher_, t));
+  }
+  auto elem_hasher() const noexcept {
+    return [this](const T& t) { return hash_elem(t); };
+  }
+  static auto elem_eq(const T& value) noexcept {
+    return [&value](const T& t) { return t == value; };
+  }
+
+  const T* find(const T& value) const noexcept {
+    sus_check(!is_moved_from());
+    return table_.find(hash_elem(value), elem_eq(value));
+  }
+
+  bool is_moved_from() const noexcept { return table_.is_moved_from(); }
+  bool has_iterators() const noexcept {
+    return iter_refs_.count_from_owner() != 0u;
+  }
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRefCounter iter_refs_;
+  [[_sus_no_unique_address]] S hasher_;
+  Table table_;
+
+  sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn,
+                                           decltype(iter_refs_),
+                                           decltype(hasher_),
+                                           decltype(table_));
+};
+
+}  // namespace sus::collections
+
+// sus::iter::FromIterator trait for HashSet.
+template <class T, class S>
+  requires(std::default_initializable<S>)
+struct sus::iter::FromIteratorImpl<::sus::collections::HashSet<T, S>> {
+  /// Constructs a set from the values in the iterator, dropping duplicates.
+  static ::sus::collections::HashSet<T, S> from_iter(
+      ::sus::iter::IntoIterator<T> auto&& ii) noexcept
+    requires(::sus::mem::IsMoveRef<decltype(ii)>)
+  {
+    auto s = ::sus::collections::HashSet<T, S>();
+    s.extend(::sus::move(ii));
+    return s;
+  }
+};
+
+// fmt support.
+template <class T, class S, class Char>
+struct fmt::formatter<::sus::collections::HashSet<T, S>, Char> {
+  template <class ParseContext>
+  constexpr auto parse(ParseContext& ctx) {
+    return underlying_.parse(ctx);
+  }
+
+  template <class FormatContext>
+  constexpr auto format(const ::sus::collections::HashSet<T, S>& set,
+                        FormatContext& ctx) const {
+    auto out = ctx.out();
+    out = fmt::format_to(out, "{{");
+    bool first = true;
+    for (const T& t : set.iter()) {
+      if (!first) out = fmt::format_to(out, ", ");
+      first = false;
+      ctx.advance_to(out);
+      out = underlying_.format(t, ctx);
+    }
+    return fmt::format_to(out, "}}");
+  }
+
+ private:
+  ::sus::string::__private::AnyFormatter<T, Char> underlying_;
+};
+
+// Promote HashSet into the `sus` namespace.
+namespace sus {
+using ::sus::collections::HashSet;
+}  // namespace sus
@@ -0,0 +1,202 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/collections/hash_set.h"
+
+#include <sstream>
+#include <string>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/collections/vec.h"
+#include "sus/iter/iterator.h"
+#include "sus/mem/move.h"
+#include "sus/ops/range.h"
+#include "sus/prelude.h"
+#include "sus/test/ensure_use.h"
+
+namespace {
+
+using sus::collections::HashSet;
+using sus::test::ensure_use;
+
+TEST(HashSet, Default) {
+  auto s = HashSet<i32>();
+  EXPECT_EQ(s.len(), 0u);
+  EXPECT_EQ(s.is_empty(), true);
+  EXPECT_EQ(s.capacity(), 0u);
+  EXPECT_EQ(s.contains(1), false);
+
+  HashSet<i32> e = sus::empty;
+  EXPECT_EQ(e.len(), 0u);
+}
+
+TEST(HashSet, InsertContains) {
+  auto s = HashSet<i32>();
+  EXPECT_EQ(s.insert(1), true);
+  EXPECT_EQ(s.insert(2), true);
+  EXPECT_EQ(s.insert(1), false);
+  EXPECT_EQ(s.len(), 2u);
+  EXPECT_EQ(s.contains(1), true);
+  EXPECT_EQ(s.contains(2), true);
+  EXPECT_EQ(s.contains(3), false);
+  EXPECT_EQ(s.get(2).copied().unwrap(), 2);
+  EXPECT_EQ(s.get(3).is_none(), true);
+}
+
+TEST(HashSet, Grow) {
+  auto s = HashSet<i32>();
+  for (i32 i : sus::ops::range(0_i32, 10000_i32)) EXPECT_EQ(s.insert(i), true);
+  EXPECT_EQ(s.len(), 10000u);
+  for (i32 i : sus::ops::range(0_i32, 10000_i32)) {
+    EXPECT_EQ(s.contains(i), true);
+  }
+  EXPECT_EQ(s.contains(10000), false);
+}
+
+TEST(HashSet, RemoveTake) {
+  auto s = HashSet<std::string>();
+  s.insert("a");
+  s.insert("b");
+  EXPECT_EQ(s.remove("a"), true);
+  EXPECT_EQ(s.remove("a"), false);
+  EXPECT_EQ(s.take("b").unwrap(), "b");
+  EXPECT_EQ(s.take("b").is_none(), true);
+  EXPECT_EQ(s.is_empty(), true);
+}
+
+TEST(HashSet, Replace) {
+  auto s = HashSet<i32>();
+  EXPECT_EQ(s.replace(1).is_none(), true);
+  EXPECT_EQ(s.replace(1).unwrap(), 1);
+  EXPECT_EQ(s.len(), 1u);
+}
+
+TEST(HashSet, Retain) {
+  auto s = HashSet<i32>();
+  for (i32 i : sus::ops::range(0_i32, 100_i32)) s.insert(i);
+  s.retain([](const i32& i) { return i % 2 == 0; });
+  EXPECT_EQ(s.len(), 50u);
+  for (i32 i : sus::ops::range(0_i32, 100_i32)) {
+    EXPECT_EQ(s.contains(i), i % 2 == 0);
+  }
+}
+
+TEST(HashSet, ClearAndShrink) {
+  auto s = HashSet<i32>();
+  for (i32 i : sus::ops::range(0_i32, 1000_i32)) s.insert(i);
+  const usize cap = s.capacity();
+  s.clear();
+  EXPECT_EQ(s.len(), 0u);
+  EXPECT_EQ(s.capacity(), cap);
+  s.insert(3);
+  s.shrink_to_fit();
+  EXPECT_LT(s.capacity(), cap);
+  EXPECT_EQ(s.contains(3), true);
+  s.reserve(100u);
+  EXPECT_GE(s.capacity(), 101u);
+}
+
+TEST(HashSet, SubsetDisjoint) {
+  auto a = HashSet<i32>();
+  auto b = HashSet<i32>();
+  for (i32 i : sus::ops::range(0_i32, 10_i32)) a.insert(i);
+  for (i32 i : sus::ops::range(0_i32, 5_i32)) b.insert(i);
+  EXPECT_EQ(b.is_subset(a), true);
+  EXPECT_EQ(a.is_subset(b), false);
+  EXPECT_EQ(a.is_disjoint(b), false);
+
+  auto c = HashSet<i32>();
+  c.insert(20);
+  EXPECT_EQ(a.is_disjoint(c), true);
+  EXPECT_EQ(c.is_disjoint(a), true);
+}
+
+TEST(HashSet, Iter) {
+  auto s = HashSet<i32>();
+  for (i32 i : sus::ops::range(0_i32, 100_i32)) s.insert(i);
+  auto it = s.iter();
+  EXPECT_EQ(it.exact_size_hint(), 100u);
+  EXPECT_EQ(it.size_hint().upper.unwrap(), 100u);
+  i32 sum = 0;
+  for (const i32& i : s.iter()) sum += i;
+  EXPECT_EQ(sum, 4950);
+}
+
+TEST(HashSet, IntoIter) {
+  auto s = HashSet<std::string>();
+  for (i32 i : sus::ops::range(0_i32, 10_i32)) {
+    s.insert(std::to_string(i.primitive_value));
+  }
+  auto it = sus::move(s).into_iter();
+  EXPECT_EQ(it.exact_size_hint(), 10u);
+  std::string first = it.next().unwrap();
+  EXPECT_EQ(first.size(), 1u);
+  EXPECT_EQ(it.exact_size_hint(), 9u);
+  // The remaining elements are destroyed with the iterator.
+}
+
+TEST(HashSet, CloneEq) {
+  auto a = HashSet<i32>();
+  auto b = HashSet<i32>();
+  for (i32 i : sus::ops::range(0_i32, 50_i32)) a.insert(i);
+  for (i32 i : sus::ops::range(0_i32, 50_i32).rev()) b.insert(i);
+  EXPECT_EQ(a, b);
+  auto c = sus::clone(a);
+  EXPECT_EQ(c, a);
+  c.remove(3);
+  EXPECT_NE(c, a);
+  c.insert(51);
+  EXPECT_NE(c, a);
+}
+
+TEST(HashSet, FromIterator) {
+  auto s = sus::Vec<i32>(1, 2, 3, 2, 1).into_iter().collect<HashSet<i32>>();
+  EXPECT_EQ(s.len(), 3u);
+  EXPECT_EQ(s.contains(3), true);
+  s.extend(sus::Vec<i32>(3, 4));
+  EXPECT_EQ(s.len(), 4u);
+}
+
+TEST(HashSetDeathTest, InsertWhileIterating) {
+#if !defined(SUS_ITERATOR_INVALIDATION) || SUS_ITERATOR_INVALIDATION
+  auto s = HashSet<i32>();
+  s.insert(1);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(
+      {
+        auto it = s.iter();
+        s.insert(2);
+        ensure_use(&it);
+      },
+      "");
+#endif
+#endif
+}
+
+TEST(HashSet, fmt) {
+  auto s = HashSet<i32>();
+  EXPECT_EQ(fmt::format("{}", s), "{}");
+  s.insert(1);
+  EXPECT_EQ(fmt::format("{:02}", s), "{01}");
+}
+
+TEST(HashSet, Stream) {
+  std::stringstream ss;
+  auto s = HashSet<i32>();
+  s.insert(1);
+  ss << s;
+  EXPECT_EQ(ss.str(), "{1}");
+}
+
+}  // namespace
@@ -102,6 +102,35 @@ struct [[nodiscard]] ArrayIntoIter final
     return {};
   }
 
+  /// sus::iter::__private::ContiguousIterator trait.
+  /// #[doc.hidden]
+  constexpr const Item* contiguous_data() const noexcept
+    requires(N > 0u)
+  {
+    return array_.as_ptr() + front_index_;
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr Item get_unchecked(::sus::marker::UnsafeFnMarker,
+                               ::sus::num::usize i) noexcept
+    requires(N > 0u)
+  {
+    // SAFETY: The caller ensures `i` is less than `exact_size_hint()`, so the
+    // index is within the length of the Array.
+    return move(array_.get_unchecked_mut(::sus::marker::unsafe_fn,
+                                         front_index_ + i));
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr void advance_unchecked(::sus::marker::UnsafeFnMarker,
+                                   ::sus::num::usize n) noexcept
+    requires(N > 0u)
+  {
+    front_index_ += n;
+  }
+
  private:
   constexpr ArrayIntoIter(Array<Item, N>&& array, usize front,
                           usize back) noexcept
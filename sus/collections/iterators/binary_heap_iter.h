@@ -0,0 +1,113 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private, include "sus/collections/binary_heap.h"
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+
+#include "sus/assertions/panic.h"
+#include "sus/iter/iterator_defn.h"
+#include "sus/iter/iterator_ref.h"
+#include "sus/iter/size_hint.h"
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/macros/lifetimebound.h"
+#include "sus/macros/no_unique_address.h"
+#include "sus/mem/move.h"
+#include "sus/mem/relocate.h"
+#include "sus/mem/replace.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+
+namespace sus::collections {
+
+/// A draining iterator over the elements of a `DaryHeap` in heap order, from
+/// the greatest element to the least.
+///
+/// This type is returned from `DaryHeap::drain_sorted()`. Each element is
+/// popped from the heap as it is visited, and any elements that are not
+/// visited are removed from the heap, in an arbitrary order, when the
+/// iterator is destroyed.
+///
+/// # Panics
+///
+/// Like [`Drain`]($sus::collections::Drain) for a `Vec`, `DrainSorted` points
+/// at the heap it was created from, so it can be move-constructed but it will
+/// panic on move-assignment.
+template <class T, size_t D>
+struct [[nodiscard]] DrainSorted final
+    : public ::sus::iter::IteratorBase<DrainSorted<T, D>, T> {
+ public:
+  using Item = T;
+
+  constexpr DrainSorted(DrainSorted&& rhs) noexcept
+      : heap_(::sus::mem::replace(rhs.heap_, nullptr)),
+        ref_(::sus::move(rhs.ref_)) {}
+
+  /// `DrainSorted` may be move-constructed in order to be stored as a member
+  /// of other objects, but it can not be assigned-to. See the class
+  /// documentation for more.
+  ///
+  /// # Panics
+  ///
+  /// Calling this function will always panic.
+  constexpr DrainSorted& operator=(DrainSorted&&) noexcept {
+    ::sus::panic("attempt to assign to DrainSorted iterator");
+  }
+
+  constexpr ~DrainSorted() noexcept {
+    // The `heap_` is null if the iterator was moved from.
+    if (heap_ != nullptr) heap_->data_.clear();
+  }
+
+  /// sus::iter::Iterator trait.
+  constexpr Option<Item> next() noexcept { return heap_->pop_internal(); }
+
+  /// sus::iter::Iterator trait.
+  constexpr ::sus::iter::SizeHint size_hint() const noexcept {
+    const auto remaining = exact_size_hint();
+    return ::sus::iter::SizeHint(remaining,
+                                 ::sus::Option<::sus::num::usize>(remaining));
+  }
+
+  /// sus::iter::ExactSizeIterator trait.
+  constexpr ::sus::num::usize exact_size_hint() const noexcept {
+    return heap_->data_.len();
+  }
+
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+ private:
+  template <class, size_t>
+  friend class DaryHeap;
+
+  explicit constexpr DrainSorted(DaryHeap<T, D>& heap sus_lifetimebound,
+                                 ::sus::iter::IterRef ref) noexcept
+      : heap_(&heap), ref_(::sus::move(ref)) {}
+
+  DaryHeap<T, D>* heap_;
+  // Prevents the heap from being mutated while it is being drained.
+  [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(heap_),
+                                  decltype(ref_));
+};
+
+}  // namespace sus::collections
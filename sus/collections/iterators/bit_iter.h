@@ -0,0 +1,92 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private, include "sus/collections/bit_vec.h"
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+
+#include "sus/collections/__private/bit_words.h"
+#include "sus/iter/iterator_defn.h"
+#include "sus/iter/iterator_ref.h"
+#include "sus/iter/size_hint.h"
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/macros/no_unique_address.h"
+#include "sus/mem/move.h"
+#include "sus/mem/relocate.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+
+namespace sus::collections {
+
+/// An iterator over the positions of the set bits in a `BitVec` or `BitSet`,
+/// in increasing order.
+///
+/// This type is returned from `BitVec::iter_ones()` and
+/// `BitSet::iter_ones()`. Each step finds the next set bit with
+/// `trailing_zeros()`, and words with no set bits are skipped whole, so
+/// iterating costs time in proportion to the number of words and set bits
+/// rather than the number of bits.
+struct [[nodiscard]] BitIter final
+    : public ::sus::iter::IteratorBase<BitIter, ::sus::num::usize> {
+ public:
+  using Item = ::sus::num::usize;
+
+  /// sus::iter::Iterator trait.
+  constexpr Option<Item> next() noexcept {
+    while (word_ == 0u) {
+      if (next_index_ == word_count_) return Option<Item>();
+      word_ = words_[size_t{next_index_}];
+      next_index_ += 1u;
+    }
+    const u32 zeros = word_.trailing_zeros();
+    // Clear the lowest set bit.
+    word_ &= word_ - 1u;
+    return Option<Item>((next_index_ - 1u) * __private::kBitsPerWord +
+                        usize::from(zeros));
+  }
+
+  /// sus::iter::Iterator trait.
+  constexpr ::sus::iter::SizeHint size_hint() const noexcept {
+    const usize in_word = usize::from(word_.count_ones());
+    const usize words_left = word_count_ - next_index_;
+    return ::sus::iter::SizeHint(
+        in_word, ::sus::Option<::sus::num::usize>(
+                     in_word + words_left * __private::kBitsPerWord));
+  }
+
+ private:
+  friend class BitVec;
+  template <size_t>
+  friend class BitSet;
+
+  explicit constexpr BitIter(::sus::iter::IterRef ref, const u64* words,
+                             usize word_count) noexcept
+      : ref_(::sus::move(ref)), words_(words), word_count_(word_count) {}
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
+  const u64* words_;
+  usize word_count_;
+  /// The index of the word after the one held in `word_`.
+  usize next_index_ = 0u;
+  /// The bits of the current word which have not been visited yet.
+  u64 word_ = 0u;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(ref_),
+                                  decltype(words_), decltype(word_count_),
+                                  decltype(next_index_), decltype(word_));
+};
+
+}  // namespace sus::collections
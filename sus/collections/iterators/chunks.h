@@ -21,6 +21,7 @@
 #include "sus/lib/__private/forward_decl.h"
 #include "sus/macros/no_unique_address.h"
 #include "sus/num/unsigned_integer.h"
+#include "sus/ops/range.h"
 
 namespace sus::collections {
 
@@ -104,9 +105,12 @@ struct [[nodiscard]] [[_sus_trivial_abi]] Chunks final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by Slice, Vec, Array.
+  // Constructed by Slice, Vec, SmallVec, Array.
   friend class Slice<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -206,9 +210,12 @@ struct [[nodiscard]] [[_sus_trivial_abi]] ChunksMut final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by SliceMut, Vec, Array.
+  // Constructed by SliceMut, Vec, SmallVec, Array.
   friend class SliceMut<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -300,12 +307,46 @@ struct [[nodiscard]] [[_sus_trivial_abi]] ChunksExact final
     return v_.len() / chunk_size_;
   }
 
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr Item get_unchecked(::sus::marker::UnsafeFnMarker,
+                               ::sus::num::usize i) noexcept {
+    // SAFETY: The caller ensures `i` is less than `exact_size_hint()`, so the
+    // chunk at `i` is inside `v_` and its bounds can not overflow.
+    const auto start = i.unchecked_mul(::sus::marker::unsafe_fn, chunk_size_);
+    return v_.get_range_unchecked(
+        ::sus::marker::unsafe_fn,
+        ::sus::ops::range(
+            start, start.unchecked_add(::sus::marker::unsafe_fn, chunk_size_)));
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr void advance_unchecked(::sus::marker::UnsafeFnMarker,
+                                   ::sus::num::usize n) noexcept {
+    // SAFETY: The caller ensures there are at least `n` chunks left in `v_`.
+    v_ = v_.get_range_unchecked(
+        ::sus::marker::unsafe_fn,
+        ::sus::ops::range_from(
+            n.unchecked_mul(::sus::marker::unsafe_fn, chunk_size_)));
+  }
+
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by Slice, Vec, Array.
+  // Constructed by Slice, Vec, SmallVec, Array.
   friend class Slice<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -414,12 +455,46 @@ struct [[nodiscard]] [[_sus_trivial_abi]] ChunksExactMut final
     return v_.len() / chunk_size_;
   }
 
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr Item get_unchecked(::sus::marker::UnsafeFnMarker,
+                               ::sus::num::usize i) noexcept {
+    // SAFETY: The caller ensures `i` is less than `exact_size_hint()`, so the
+    // chunk at `i` is inside `v_` and its bounds can not overflow.
+    const auto start = i.unchecked_mul(::sus::marker::unsafe_fn, chunk_size_);
+    return v_.get_range_mut_unchecked(
+        ::sus::marker::unsafe_fn,
+        ::sus::ops::range(
+            start, start.unchecked_add(::sus::marker::unsafe_fn, chunk_size_)));
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr void advance_unchecked(::sus::marker::UnsafeFnMarker,
+                                   ::sus::num::usize n) noexcept {
+    // SAFETY: The caller ensures there are at least `n` chunks left in `v_`.
+    v_ = v_.get_range_mut_unchecked(
+        ::sus::marker::unsafe_fn,
+        ::sus::ops::range_from(
+            n.unchecked_mul(::sus::marker::unsafe_fn, chunk_size_)));
+  }
+
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by SliceMut, Vec, Array.
+  // Constructed by SliceMut, Vec, SmallVec, Array.
   friend class SliceMut<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -541,9 +616,12 @@ struct [[nodiscard]] [[_sus_trivial_abi]] RChunks final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by Slice, Vec, Array.
+  // Constructed by Slice, Vec, SmallVec, Array.
   friend class Slice<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -637,9 +715,12 @@ struct [[nodiscard]] [[_sus_trivial_abi]] RChunksMut final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by SliceMut, Vec, Array.
+  // Constructed by SliceMut, Vec, SmallVec, Array.
   friend class SliceMut<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -731,9 +812,12 @@ struct [[nodiscard]] [[_sus_trivial_abi]] RChunksExact final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by Slice, Vec, Array.
+  // Constructed by Slice, Vec, SmallVec, Array.
   friend class Slice<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -837,9 +921,12 @@ struct [[nodiscard]] [[_sus_trivial_abi]] RChunksExactMut final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by SliceMut, Vec, Array.
+  // Constructed by SliceMut, Vec, SmallVec, Array.
   friend class SliceMut<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
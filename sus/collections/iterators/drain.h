@@ -16,6 +16,8 @@
 // IWYU pragma: friend "sus/.*"
 #pragma once
 
+#include <memory>
+
 #include "sus/collections/iterators/slice_iter.h"
 #include "sus/iter/iterator_defn.h"
 #include "sus/lib/__private/forward_decl.h"
@@ -49,9 +51,9 @@ namespace sus::collections {
 ///
 /// While Drain is satisfies [`Move`]($sus::mem::Move) in order to be
 /// move-constructed, it will panic on move-assignment.
-template <class ItemT>
+template <class ItemT, class A = std::allocator<ItemT>>
 struct [[nodiscard]] Drain final
-    : public ::sus::iter::IteratorBase<Drain<ItemT>, ItemT> {
+    : public ::sus::iter::IteratorBase<Drain<ItemT, A>, ItemT> {
  public:
   using Item = ItemT;
 
@@ -142,7 +144,7 @@ struct [[nodiscard]] Drain final
 
  private:
   // Constructed by Vec.
-  template <class VecT>
+  template <class VecT, class VecA>
   friend class Vec;
 
   void restore_vec(usize kept) {
@@ -176,7 +178,7 @@ struct [[nodiscard]] Drain final
     original_vec_.as_mut() = ::sus::move(vec_);
   }
 
-  explicit constexpr Drain(Vec<Item>&& vec sus_lifetimebound,
+  explicit constexpr Drain(Vec<Item, A>&& vec sus_lifetimebound,
                            ::sus::ops::Range<usize> range) noexcept
       : tail_start_(range.finish),
         tail_len_(vec.len() - range.finish),
@@ -206,11 +208,11 @@ struct [[nodiscard]] Drain final
   usize tail_len_;
   /// The original moved-from Vec which is restored when the iterator is
   /// destroyed.
-  sus::ptr::NonNull<Vec<Item>> original_vec_;
+  sus::ptr::NonNull<Vec<Item, A>> original_vec_;
   /// The elements from the original_vec_, held locally for safe keeping so
   /// that mutation of the original Vec during drain will be flagged as
   /// use-after-move.
-  Vec<Item> vec_;
+  Vec<Item, A> vec_;
   /// Current remaining range to remove.
   Option<SliceIterMut<Item&>> iter_;
 
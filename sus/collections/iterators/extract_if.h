@@ -0,0 +1,156 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private, include "sus/collections/vec.h"
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <memory>
+
+#include "sus/assertions/panic.h"
+#include "sus/collections/__private/relocate.h"
+#include "sus/fn/fn_concepts.h"
+#include "sus/iter/iterator_defn.h"
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/macros/lifetimebound.h"
+#include "sus/mem/move.h"
+#include "sus/mem/replace.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+#include "sus/ptr/nonnull.h"
+
+namespace sus::collections {
+
+/// An iterator which uses a closure to determine if an element should be
+/// removed from a `Vec<T>`.
+///
+/// This struct is created by Vec::extract_if. See its documentation for more.
+///
+/// Elements that are kept are moved down over the removed ones as the iterator
+/// advances, and the elements that were not visited are moved down together
+/// when the iterator is destroyed.
+///
+/// # Panics
+///
+/// Like [`Drain`]($sus::collections::Drain), ExtractIf holds a reference to
+/// the Vec it was created from, so it will panic on move-assignment.
+template <class ItemT, class A, class Pred>
+struct [[nodiscard]] ExtractIf final
+    : public ::sus::iter::IteratorBase<ExtractIf<ItemT, A, Pred>, ItemT> {
+ public:
+  using Item = ItemT;
+
+ public:
+  constexpr ExtractIf(ExtractIf&& rhs) noexcept
+      : pred_(::sus::move(rhs.pred_)),
+        idx_(rhs.idx_),
+        del_(rhs.del_),
+        old_len_(rhs.old_len_),
+        original_vec_(::sus::move(rhs.original_vec_)),
+        vec_(::sus::move(rhs.vec_)),
+        // Use replace() to ensure rhs is marked as moved-from for ~ExtractIf.
+        moved_from_(::sus::mem::replace(rhs.moved_from_, true)) {}
+
+  /// ExtractIf may be move-constructed in order to be stored as a member of
+  /// other objects, but it can not be assigned-to. See the class
+  /// documentation for more.
+  ///
+  /// # Panics
+  ///
+  /// Calling this function will always panic.
+  constexpr ExtractIf& operator=(ExtractIf&&) noexcept {
+    ::sus::panic("attempt to assign to ExtractIf iterator");
+  }
+
+  constexpr ~ExtractIf() noexcept {
+    if (!moved_from_) restore_vec();
+  }
+
+  // sus::iter::Iterator trait.
+  constexpr Option<Item> next() noexcept {
+    Item* const data = vec_.as_mut_ptr();
+    while (idx_ < old_len_) {
+      Item* const cur = data + idx_;
+      const bool extract = ::sus::fn::call_mut(pred_, *cur);
+      idx_ += 1u;
+      if (extract) {
+        del_ += 1u;
+        auto out = Option<Item>(::sus::move(*cur));
+        if constexpr (!std::is_trivially_destructible_v<Item>)
+          std::destroy_at(cur);
+        return out;
+      }
+      // SAFETY: The `del_` elements before `cur` have been extracted, so
+      // there is no object where `cur` is moved to.
+      __private::relocate(::sus::marker::unsafe_fn, cur, cur - del_, 1_usize);
+    }
+    return Option<Item>();
+  }
+
+  // Replace the default impl in sus::iter::IteratorBase.
+  constexpr ::sus::iter::SizeHint size_hint() const noexcept {
+    const auto remaining = old_len_ - idx_;
+    return {0u, ::sus::Option<::sus::num::usize>(remaining)};
+  }
+
+ private:
+  // Constructed by Vec.
+  template <class VecT, class VecA>
+  friend class Vec;
+
+  explicit constexpr ExtractIf(Vec<Item, A>&& vec sus_lifetimebound,
+                               Pred pred) noexcept
+      : pred_(::sus::move(pred)),
+        old_len_(vec.len()),
+        original_vec_(vec),
+        vec_(::sus::move(vec)) {
+    // The elements are tracked by `idx_`, `del_` and `old_len_` while
+    // iterating, as there is a gap of removed elements in the middle.
+    vec_.set_len(::sus::marker::unsafe_fn, 0u);
+  }
+
+  constexpr void restore_vec() noexcept {
+    Item* const data = vec_.as_mut_ptr();
+    // SAFETY: The `del_` elements before `idx_` have been extracted, so the
+    // unvisited elements can be moved down over them.
+    __private::relocate(::sus::marker::unsafe_fn, data + idx_,
+                        data + idx_ - del_, old_len_ - idx_);
+    vec_.set_len(::sus::marker::unsafe_fn, old_len_ - del_);
+    original_vec_.as_mut() = ::sus::move(vec_);
+  }
+
+  Pred pred_;
+  /// Index of the next element to visit.
+  usize idx_;
+  /// The number of elements that have been extracted.
+  usize del_;
+  /// The length of the Vec when the iterator was created.
+  usize old_len_;
+  /// The original moved-from Vec which is restored when the iterator is
+  /// destroyed.
+  sus::ptr::NonNull<Vec<Item, A>> original_vec_;
+  /// The elements from the original_vec_, held locally for safe keeping so
+  /// that mutation of the original Vec during iteration will be flagged as
+  /// use-after-move.
+  Vec<Item, A> vec_;
+  /// Set when the iterator is moved from, and has nothing to restore.
+  bool moved_from_ = false;
+
+  sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn,
+                                           decltype(pred_), decltype(idx_),
+                                           decltype(vec_),
+                                           decltype(original_vec_));
+};
+
+}  // namespace sus::collections
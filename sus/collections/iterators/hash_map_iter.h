@@ -0,0 +1,328 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private, include "sus/collections/hash_map.h"
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+#include "sus/collections/__private/swiss_table.h"
+#include "sus/iter/iterator_defn.h"
+#include "sus/iter/iterator_ref.h"
+#include "sus/macros/no_unique_address.h"
+#include "sus/mem/move.h"
+#include "sus/mem/relocate.h"
+#include "sus/mem/replace.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+#include "sus/tuple/tuple.h"
+
+namespace sus::collections {
+
+/// An iterator over the entries of a `HashMap`, with const access to them.
+///
+/// This type is returned from `HashMap::iter()`. The entries are visited in an
+/// arbitrary order.
+template <class K, class V>
+struct [[nodiscard]] HashMapIter final
+    : public ::sus::iter::IteratorBase<HashMapIter<K, V>,
+                                       ::sus::Tuple<const K&, const V&>> {
+ public:
+  using Item = ::sus::Tuple<const K&, const V&>;
+
+  // sus::iter::Iterator trait.
+  Option<Item> next() noexcept {
+    const Slot* const slot = raw_.next();
+    if (slot == nullptr) return Option<Item>();
+    return Option<Item>(Item(slot->key, slot->value));
+  }
+
+  /// sus::iter::Iterator trait.
+  ::sus::iter::SizeHint size_hint() const noexcept {
+    const auto remaining = exact_size_hint();
+    return {remaining, ::sus::Option<::sus::num::usize>(remaining)};
+  }
+
+  /// sus::iter::ExactSizeIterator trait.
+  ::sus::num::usize exact_size_hint() const noexcept {
+    return raw_.items_left();
+  }
+
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+ private:
+  using Slot = __private::swiss::MapSlot<K, V>;
+
+  template <class, class, class>
+  friend class HashMap;
+
+  explicit HashMapIter(::sus::iter::IterRef ref,
+                       __private::swiss::RawIter<const Slot> raw) noexcept
+      : ref_(::sus::move(ref)), raw_(raw) {}
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
+  __private::swiss::RawIter<const Slot> raw_;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(ref_),
+                                  decltype(raw_));
+};
+
+/// An iterator over the entries of a `HashMap`, with mutable access to the
+/// values.
+///
+/// This type is returned from `HashMap::iter_mut()`. The entries are visited
+/// in an arbitrary order.
+template <class K, class V>
+struct [[nodiscard]] HashMapIterMut final
+    : public ::sus::iter::IteratorBase<HashMapIterMut<K, V>,
+                                       ::sus::Tuple<const K&, V&>> {
+ public:
+  using Item = ::sus::Tuple<const K&, V&>;
+
+  // sus::iter::Iterator trait.
+  Option<Item> next() noexcept {
+    Slot* const slot = raw_.next();
+    if (slot == nullptr) return Option<Item>();
+    return Option<Item>(Item(slot->key, slot->value));
+  }
+
+  /// sus::iter::Iterator trait.
+  ::sus::iter::SizeHint size_hint() const noexcept {
+    const auto remaining = exact_size_hint();
+    return {remaining, ::sus::Option<::sus::num::usize>(remaining)};
+  }
+
+  /// sus::iter::ExactSizeIterator trait.
+  ::sus::num::usize exact_size_hint() const noexcept {
+    return raw_.items_left();
+  }
+
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+ private:
+  using Slot = __private::swiss::MapSlot<K, V>;
+
+  template <class, class, class>
+  friend class HashMap;
+
+  explicit HashMapIterMut(::sus::iter::IterRef ref,
+                          __private::swiss::RawIter<Slot> raw) noexcept
+      : ref_(::sus::move(ref)), raw_(raw) {}
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
+  __private::swiss::RawIter<Slot> raw_;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(ref_),
+                                  decltype(raw_));
+};
+
+/// An iterator over the keys of a `HashMap`.
+///
+/// This type is returned from `HashMap::keys()`. The keys are visited in an
+/// arbitrary order.
+template <class K, class V>
+struct [[nodiscard]] HashMapKeys final
+    : public ::sus::iter::IteratorBase<HashMapKeys<K, V>, const K&> {
+ public:
+  using Item = const K&;
+
+  // sus::iter::Iterator trait.
+  Option<Item> next() noexcept {
+    const Slot* const slot = raw_.next();
+    if (slot == nullptr) return Option<Item>();
+    return Option<Item>(slot->key);
+  }
+
+  /// sus::iter::Iterator trait.
+  ::sus::iter::SizeHint size_hint() const noexcept {
+    const auto remaining = exact_size_hint();
+    return {remaining, ::sus::Option<::sus::num::usize>(remaining)};
+  }
+
+  /// sus::iter::ExactSizeIterator trait.
+  ::sus::num::usize exact_size_hint() const noexcept {
+    return raw_.items_left();
+  }
+
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+ private:
+  using Slot = __private::swiss::MapSlot<K, V>;
+
+  template <class, class, class>
+  friend class HashMap;
+
+  explicit HashMapKeys(::sus::iter::IterRef ref,
+                       __private::swiss::RawIter<const Slot> raw) noexcept
+      : ref_(::sus::move(ref)), raw_(raw) {}
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
+  __private::swiss::RawIter<const Slot> raw_;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(ref_),
+                                  decltype(raw_));
+};
+
+/// An iterator over the values of a `HashMap`, with const or mutable access
+/// to them depending on `ValueRef`.
+///
+/// This type is returned from `HashMap::values()` and `HashMap::values_mut()`.
+/// The values are visited in an arbitrary order.
+template <class K, class V, class ValueRef>
+struct [[nodiscard]] HashMapValues final
+    : public ::sus::iter::IteratorBase<HashMapValues<K, V, ValueRef>,
+                                       ValueRef> {
+ public:
+  using Item = ValueRef;
+
+  // sus::iter::Iterator trait.
+  Option<Item> next() noexcept {
+    Slot* const slot = raw_.next();
+    if (slot == nullptr) return Option<Item>();
+    return Option<Item>(slot->value);
+  }
+
+  /// sus::iter::Iterator trait.
+  ::sus::iter::SizeHint size_hint() const noexcept {
+    const auto remaining = exact_size_hint();
+    return {remaining, ::sus::Option<::sus::num::usize>(remaining)};
+  }
+
+  /// sus::iter::ExactSizeIterator trait.
+  ::sus::num::usize exact_size_hint() const noexcept {
+    return raw_.items_left();
+  }
+
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+ private:
+  static_assert(std::is_reference_v<ValueRef>);
+  using Slot = std::conditional_t<
+      std::is_const_v<std::remove_reference_t<ValueRef>>,
+      const __private::swiss::MapSlot<K, V>, __private::swiss::MapSlot<K, V>>;
+
+  template <class, class, class>
+  friend class HashMap;
+
+  explicit HashMapValues(::sus::iter::IterRef ref,
+                         __private::swiss::RawIter<Slot> raw) noexcept
+      : ref_(::sus::move(ref)), raw_(raw) {}
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
+  __private::swiss::RawIter<Slot> raw_;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(ref_),
+                                  decltype(raw_));
+};
+
+/// An iterator that moves the entries out of a `HashMap`.
+///
+/// This type is returned from `HashMap::into_iter()`. The entries are visited
+/// in an arbitrary order, and any entries that are not visited are destroyed
+/// along with the iterator.
+template <class K, class V>
+struct [[nodiscard]] HashMapIntoIter final
+    : public ::sus::iter::IteratorBase<HashMapIntoIter<K, V>,
+                                       ::sus::Tuple<K, V>> {
+ private:
+  using Slot = __private::swiss::MapSlot<K, V>;
+  using RawIter = __private::swiss::RawIter<Slot>;
+
+ public:
+  using Item = ::sus::Tuple<K, V>;
+
+  HashMapIntoIter(HashMapIntoIter&& o) noexcept
+      : table_(::sus::move(o.table_)),
+        raw_(::sus::mem::replace(o.raw_, RawIter::empty())) {}
+  HashMapIntoIter& operator=(HashMapIntoIter&& o) noexcept {
+    destroy_remaining();
+    table_ = ::sus::move(o.table_);
+    raw_ = ::sus::mem::replace(o.raw_, RawIter::empty());
+    return *this;
+  }
+
+  ~HashMapIntoIter() noexcept { destroy_remaining(); }
+
+  // sus::iter::Iterator trait.
+  Option<Item> next() noexcept {
+    Slot* const slot = raw_.next();
+    if (slot == nullptr) return Option<Item>();
+    auto out = Option<Item>(
+        Item(::sus::move(slot->key), ::sus::move(slot->value)));
+    std::destroy_at(slot);
+    return out;
+  }
+
+  /// sus::iter::Iterator trait.
+  ::sus::iter::SizeHint size_hint() const noexcept {
+    const auto remaining = exact_size_hint();
+    return {remaining, ::sus::Option<::sus::num::usize>(remaining)};
+  }
+
+  /// sus::iter::ExactSizeIterator trait.
+  ::sus::num::usize exact_size_hint() const noexcept {
+    return raw_.items_left();
+  }
+
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+ private:
+  template <class, class, class>
+  friend class HashMap;
+
+  explicit HashMapIntoIter(__private::swiss::RawTable<Slot>&& table) noexcept
+      : table_(::sus::move(table)), raw_(table_.iter()) {}
+
+  /// Destroys the entries that were not visited, and frees the table, whose
+  /// entries have all been moved out or destroyed.
+  void destroy_remaining() noexcept {
+    while (Slot* const slot = raw_.next()) std::destroy_at(slot);
+    table_.free_without_destroying();
+  }
+
+  __private::swiss::RawTable<Slot> table_;
+  RawIter raw_;
+
+  sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn,
+                                           decltype(table_), decltype(raw_));
+};
+
+}  // namespace sus::collections
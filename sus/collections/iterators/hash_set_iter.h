@@ -0,0 +1,157 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private, include "sus/collections/hash_set.h"
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <memory>
+
+#include "sus/collections/__private/swiss_table.h"
+#include "sus/iter/iterator_defn.h"
+#include "sus/iter/iterator_ref.h"
+#include "sus/macros/no_unique_address.h"
+#include "sus/mem/move.h"
+#include "sus/mem/relocate.h"
+#include "sus/mem/replace.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+
+namespace sus::collections {
+
+/// An iterator over the elements of a `HashSet`.
+///
+/// This type is returned from `HashSet::iter()`. The elements are visited in
+/// an arbitrary order.
+template <class T>
+struct [[nodiscard]] HashSetIter final
+    : public ::sus::iter::IteratorBase<HashSetIter<T>, const T&> {
+ public:
+  using Item = const T&;
+
+  // sus::iter::Iterator trait.
+  Option<Item> next() noexcept {
+    const T* const slot = raw_.next();
+    if (slot == nullptr) return Option<Item>();
+    return Option<Item>(*slot);
+  }
+
+  /// sus::iter::Iterator trait.
+  ::sus::iter::SizeHint size_hint() const noexcept {
+    const auto remaining = exact_size_hint();
+    return {remaining, ::sus::Option<::sus::num::usize>(remaining)};
+  }
+
+  /// sus::iter::ExactSizeIterator trait.
+  ::sus::num::usize exact_size_hint() const noexcept {
+    return raw_.items_left();
+  }
+
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+ private:
+  template <class, class>
+  friend class HashSet;
+
+  explicit HashSetIter(::sus::iter::IterRef ref,
+                       __private::swiss::RawIter<const T> raw) noexcept
+      : ref_(::sus::move(ref)), raw_(raw) {}
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
+  __private::swiss::RawIter<const T> raw_;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(ref_),
+                                  decltype(raw_));
+};
+
+/// An iterator that moves the elements out of a `HashSet`.
+///
+/// This type is returned from `HashSet::into_iter()`. The elements are visited
+/// in an arbitrary order, and any elements that are not visited are destroyed
+/// along with the iterator.
+template <class T>
+struct [[nodiscard]] HashSetIntoIter final
+    : public ::sus::iter::IteratorBase<HashSetIntoIter<T>, T> {
+ private:
+  using RawIter = __private::swiss::RawIter<T>;
+
+ public:
+  using Item = T;
+
+  HashSetIntoIter(HashSetIntoIter&& o) noexcept
+      : table_(::sus::move(o.table_)),
+        raw_(::sus::mem::replace(o.raw_, RawIter::empty())) {}
+  HashSetIntoIter& operator=(HashSetIntoIter&& o) noexcept {
+    destroy_remaining();
+    table_ = ::sus::move(o.table_);
+    raw_ = ::sus::mem::replace(o.raw_, RawIter::empty());
+    return *this;
+  }
+
+  ~HashSetIntoIter() noexcept { destroy_remaining(); }
+
+  // sus::iter::Iterator trait.
+  Option<Item> next() noexcept {
+    T* const slot = raw_.next();
+    if (slot == nullptr) return Option<Item>();
+    auto out = Option<Item>(::sus::move(*slot));
+    std::destroy_at(slot);
+    return out;
+  }
+
+  /// sus::iter::Iterator trait.
+  ::sus::iter::SizeHint size_hint() const noexcept {
+    const auto remaining = exact_size_hint();
+    return {remaining, ::sus::Option<::sus::num::usize>(remaining)};
+  }
+
+  /// sus::iter::ExactSizeIterator trait.
+  ::sus::num::usize exact_size_hint() const noexcept {
+    return raw_.items_left();
+  }
+
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+ private:
+  template <class, class>
+  friend class HashSet;
+
+  explicit HashSetIntoIter(__private::swiss::RawTable<T>&& table) noexcept
+      : table_(::sus::move(table)), raw_(table_.iter()) {}
+
+  /// Destroys the elements that were not visited, and frees the table, whose
+  /// elements have all been moved out or destroyed.
+  void destroy_remaining() noexcept {
+    while (T* const slot = raw_.next()) std::destroy_at(slot);
+    table_.free_without_destroying();
+  }
+
+  __private::swiss::RawTable<T> table_;
+  RawIter raw_;
+
+  sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn,
+                                           decltype(table_), decltype(raw_));
+};
+
+}  // namespace sus::collections
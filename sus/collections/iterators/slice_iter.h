@@ -105,6 +105,24 @@ struct [[nodiscard]] [[_sus_trivial_abi]] SliceIter final
     return {};
   }
 
+  /// sus::iter::__private::ContiguousIterator trait.
+  /// #[doc.hidden]
+  constexpr const RawItem* contiguous_data() const noexcept { return ptr_; }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr Item get_unchecked(::sus::marker::UnsafeFnMarker,
+                               ::sus::num::usize i) noexcept {
+    return *(ptr_ + i);
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr void advance_unchecked(::sus::marker::UnsafeFnMarker,
+                                   ::sus::num::usize n) noexcept {
+    ptr_ = ptr_ + n;
+  }
+
  private:
   [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
   const RawItem* ptr_;
@@ -196,6 +214,24 @@ struct [[_sus_trivial_abi]] SliceIterMut final
     return {};
   }
 
+  /// sus::iter::__private::ContiguousIterator trait.
+  /// #[doc.hidden]
+  constexpr const RawItem* contiguous_data() const noexcept { return ptr_; }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr Item get_unchecked(::sus::marker::UnsafeFnMarker,
+                               ::sus::num::usize i) noexcept {
+    return *(ptr_ + i);
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr void advance_unchecked(::sus::marker::UnsafeFnMarker,
+                                   ::sus::num::usize n) noexcept {
+    ptr_ = ptr_ + n;
+  }
+
  private:
   [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
   RawItem* ptr_;
@@ -0,0 +1,212 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private, include "sus/collections/slot_map.h"
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <type_traits>
+
+#include "fmt/core.h"
+#include "sus/hash/hash.h"
+#include "sus/iter/iterator_defn.h"
+#include "sus/iter/iterator_ref.h"
+#include "sus/iter/size_hint.h"
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/macros/no_unique_address.h"
+#include "sus/macros/pure.h"
+#include "sus/mem/move.h"
+#include "sus/mem/relocate.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+#include "sus/string/__private/format_to_stream.h"
+#include "sus/tuple/tuple.h"
+
+namespace sus::collections {
+
+/// A handle to a value in a [`SlotMap`]($sus::collections::SlotMap).
+///
+/// A `SlotKey` names a slot in the `SlotMap` along with the generation of the
+/// slot when the value was inserted. Removing the value moves the slot to a
+/// new generation, so the key will no longer find a value, even after the
+/// slot is reused for another value.
+///
+/// A default-constructed `SlotKey` is a null key, which never refers to a
+/// value in any `SlotMap`.
+class SlotKey final {
+ public:
+  /// Constructs a null key, which never refers to a value.
+  ///
+  /// This constructor also satisfies `sus::construct::Default`.
+  explicit constexpr SlotKey() noexcept = default;
+
+  /// Returns whether the key is a null key.
+  _sus_pure constexpr bool is_null() const& noexcept {
+    return generation_ == 0u;
+  }
+
+  /// Returns the index of the slot which the key refers to.
+  _sus_pure constexpr u32 index() const& noexcept { return index_; }
+
+  /// Returns the generation of the slot which the key refers to.
+  _sus_pure constexpr u32 generation() const& noexcept { return generation_; }
+
+  /// Satisfies the [`Eq<SlotKey>`]($sus::cmp::Eq) concept.
+  friend constexpr bool operator==(const SlotKey& l,
+                                   const SlotKey& r) noexcept = default;
+
+  /// Satisfies the [`Hash`]($sus::hash::Hash) concept.
+  template <::sus::hash::Hasher H>
+  constexpr void hash(H& state) const& noexcept {
+    ::sus::hash::hash_into(index_, state);
+    ::sus::hash::hash_into(generation_, state);
+  }
+
+  // Stream support.
+  _sus_format_to_stream(SlotKey);
+
+ private:
+  template <class>
+  friend class SlotMap;
+  template <class>
+  friend struct SlotMapIter;
+
+  explicit constexpr SlotKey(u32 index, u32 generation) noexcept
+      : index_(index), generation_(generation) {}
+
+  u32 index_ = u32::MAX;
+  u32 generation_ = 0u;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(index_),
+                                  decltype(generation_));
+};
+
+namespace __private {
+
+/// A slot in a `SlotMap`.
+///
+/// The generation is odd while the slot holds a value and even while it is
+/// vacant, and is incremented on each change. A key is only ever given an odd
+/// generation, so comparing generations also checks that the slot is in use.
+struct SlotMapSlot {
+  u32 generation;
+  /// While occupied, the position of the value in the dense array of values.
+  /// While vacant, the index of the next vacant slot in the free list.
+  u32 index;
+};
+
+}  // namespace __private
+
+/// An iterator over the keys and values of a `SlotMap`.
+///
+/// This type is returned from `SlotMap::iter()` and `SlotMap::iter_mut()`.
+/// The values are visited in the order of the dense array they are stored in,
+/// which is not the order they were inserted in once values have been
+/// removed.
+template <class ItemT>
+struct [[nodiscard]] SlotMapIter final
+    : public ::sus::iter::IteratorBase<SlotMapIter<ItemT>,
+                                       ::sus::Tuple<SlotKey, ItemT>> {
+ public:
+  using Item = ::sus::Tuple<SlotKey, ItemT>;
+
+ private:
+  using Value = std::remove_reference_t<ItemT>;
+
+ public:
+  /// sus::iter::Iterator trait.
+  constexpr Option<Item> next() noexcept {
+    if (front_ == back_) return Option<Item>();
+    const usize i = front_;
+    front_ += 1u;
+    return Option<Item>(item_at(i));
+  }
+
+  /// sus::iter::DoubleEndedIterator trait.
+  constexpr Option<Item> next_back() noexcept {
+    if (front_ == back_) return Option<Item>();
+    back_ -= 1u;
+    return Option<Item>(item_at(back_));
+  }
+
+  /// sus::iter::Iterator trait.
+  constexpr ::sus::iter::SizeHint size_hint() const noexcept {
+    const auto remaining = exact_size_hint();
+    return ::sus::iter::SizeHint(remaining,
+                                 ::sus::Option<::sus::num::usize>(remaining));
+  }
+
+  /// sus::iter::ExactSizeIterator trait.
+  constexpr ::sus::num::usize exact_size_hint() const noexcept {
+    return back_ - front_;
+  }
+
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+ private:
+  template <class>
+  friend class SlotMap;
+
+  explicit constexpr SlotMapIter(::sus::iter::IterRef ref, Value* values,
+                                 const u32* value_slots,
+                                 const __private::SlotMapSlot* slots,
+                                 usize len) noexcept
+      : ref_(::sus::move(ref)),
+        values_(values),
+        value_slots_(value_slots),
+        slots_(slots),
+        back_(len) {}
+
+  constexpr Item item_at(usize i) const noexcept {
+    const u32 slot = value_slots_[size_t{i}];
+    return Item(SlotKey(slot, slots_[size_t{slot}].generation),
+                values_[size_t{i}]);
+  }
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
+  Value* values_;
+  const u32* value_slots_;
+  const __private::SlotMapSlot* slots_;
+  usize front_ = 0u;
+  usize back_;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(ref_),
+                                  decltype(values_), decltype(value_slots_),
+                                  decltype(slots_), decltype(front_),
+                                  decltype(back_));
+};
+
+}  // namespace sus::collections
+
+// fmt support.
+template <class Char>
+struct fmt::formatter<::sus::collections::SlotKey, Char> {
+  template <class ParseContext>
+  constexpr auto parse(ParseContext& ctx) {
+    return ctx.begin();
+  }
+
+  /// Writes the key as its index and generation, as in `3v1`, or `null`.
+  template <class FormatContext>
+  constexpr auto format(const ::sus::collections::SlotKey& key,
+                        FormatContext& ctx) const {
+    if (key.is_null()) return fmt::format_to(ctx.out(), "null");
+    return fmt::format_to(ctx.out(), "{}v{}", key.index(), key.generation());
+  }
+};
@@ -150,9 +150,12 @@ class [[nodiscard]] Split final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by Slice, Vec, Array.
+  // Constructed by Slice, Vec, SmallVec, Array.
   friend class Slice<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -265,9 +268,12 @@ class [[nodiscard]] SplitMut final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by SliceMut, Vec, Array.
+  // Constructed by SliceMut, Vec, SmallVec, Array.
   friend class SliceMut<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -388,9 +394,12 @@ class [[nodiscard]] SplitInclusive final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by Slice, Vec, Array.
+  // Constructed by Slice, Vec, SmallVec, Array.
   friend class Slice<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -499,9 +508,12 @@ class [[nodiscard]] SplitInclusiveMut final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by SliceMut, Vec, Array.
+  // Constructed by SliceMut, Vec, SmallVec, Array.
   friend class SliceMut<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -549,9 +561,12 @@ class [[nodiscard]] RSplit final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by Slice, Vec, Array.
+  // Constructed by Slice, Vec, SmallVec, Array.
   friend class Slice<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -595,9 +610,12 @@ class [[nodiscard]] RSplitMut final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by SliceMut, Vec, Array.
+  // Constructed by SliceMut, Vec, SmallVec, Array.
   friend class SliceMut<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -638,9 +656,12 @@ class [[nodiscard]] SplitN final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by Slice, Vec, Array.
+  // Constructed by Slice, Vec, SmallVec, Array.
   friend class Slice<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -675,9 +696,12 @@ class [[nodiscard]] SplitNMut final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by SliceMut, Vec, Array.
+  // Constructed by SliceMut, Vec, SmallVec, Array.
   friend class SliceMut<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -713,9 +737,12 @@ class [[nodiscard]] RSplitN final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by Slice, Vec, Array.
+  // Constructed by Slice, Vec, SmallVec, Array.
   friend class Slice<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
@@ -752,9 +779,12 @@ class [[nodiscard]] RSplitNMut final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by SliceMut, Vec, Array.
+  // Constructed by SliceMut, Vec, SmallVec, Array.
   friend class SliceMut<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
   friend class Array;
 
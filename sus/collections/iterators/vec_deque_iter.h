@@ -0,0 +1,400 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private, include "sus/collections/vec_deque.h"
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+#include "sus/assertions/panic.h"
+#include "sus/iter/iterator_defn.h"
+#include "sus/iter/iterator_ref.h"
+#include "sus/iter/size_hint.h"
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/macros/lifetimebound.h"
+#include "sus/macros/no_unique_address.h"
+#include "sus/marker/unsafe.h"
+#include "sus/mem/move.h"
+#include "sus/mem/relocate.h"
+#include "sus/mem/replace.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+
+namespace sus::collections {
+
+/// An iterator over the elements of a `VecDeque` with const access to them.
+///
+/// This type is returned from `VecDeque::iter()`. The elements are visited
+/// from the front of the deque to the back.
+template <class ItemT>
+struct [[nodiscard]] [[_sus_trivial_abi]] VecDequeIter final
+    : public ::sus::iter::IteratorBase<VecDequeIter<ItemT>, ItemT> {
+ public:
+  using Item = ItemT;
+
+ private:
+  // `Item` is a `const T&`.
+  static_assert(std::is_reference_v<Item>);
+  static_assert(std::is_const_v<std::remove_reference_t<Item>>);
+  // `RawItem` is a `T`.
+  using RawItem = std::remove_const_t<std::remove_reference_t<Item>>;
+
+ public:
+  /// sus::iter::Iterator trait.
+  constexpr Option<Item> next() noexcept {
+    if (front_ == back_) [[unlikely]]
+      return Option<Item>();
+    return Option<Item>(
+        *(buf_ + (::sus::mem::replace(front_, front_ + 1u) & mask_)));
+  }
+
+  /// sus::iter::DoubleEndedIterator trait.
+  constexpr Option<Item> next_back() noexcept {
+    if (front_ == back_) [[unlikely]]
+      return Option<Item>();
+    back_ -= 1u;
+    return Option<Item>(*(buf_ + (back_ & mask_)));
+  }
+
+  /// sus::iter::Iterator trait.
+  constexpr ::sus::iter::SizeHint size_hint() const noexcept {
+    const auto remaining = exact_size_hint();
+    return ::sus::iter::SizeHint(remaining,
+                                 ::sus::Option<::sus::num::usize>(remaining));
+  }
+
+  /// sus::iter::ExactSizeIterator trait.
+  constexpr ::sus::num::usize exact_size_hint() const noexcept {
+    return back_ - front_;
+  }
+
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr Item get_unchecked(::sus::marker::UnsafeFnMarker,
+                               ::sus::num::usize i) noexcept {
+    return *(buf_ + ((front_ + i) & mask_));
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr void advance_unchecked(::sus::marker::UnsafeFnMarker,
+                                   ::sus::num::usize n) noexcept {
+    front_ += n;
+  }
+
+ private:
+  template <class>
+  friend class VecDeque;
+
+  /// The `front` and `back` positions are not wrapped to the capacity of the
+  /// buffer, so that `back` is always at least `front`. They are wrapped with
+  /// `mask` when the buffer is indexed.
+  explicit constexpr VecDequeIter(::sus::iter::IterRef ref, const RawItem* buf,
+                                  ::sus::num::usize mask,
+                                  ::sus::num::usize front,
+                                  ::sus::num::usize back) noexcept
+      : ref_(::sus::move(ref)),
+        buf_(buf),
+        mask_(mask),
+        front_(front),
+        back_(back) {}
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
+  const RawItem* buf_;
+  ::sus::num::usize mask_;
+  ::sus::num::usize front_;
+  ::sus::num::usize back_;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(ref_),
+                                  decltype(buf_), decltype(mask_),
+                                  decltype(front_), decltype(back_));
+};
+
+/// An iterator over the elements of a `VecDeque` with mutable access to them.
+///
+/// This type is returned from `VecDeque::iter_mut()`. The elements are visited
+/// from the front of the deque to the back.
+template <class ItemT>
+struct [[nodiscard]] [[_sus_trivial_abi]] VecDequeIterMut final
+    : public ::sus::iter::IteratorBase<VecDequeIterMut<ItemT>, ItemT> {
+ public:
+  using Item = ItemT;
+
+ private:
+  // `Item` is a `T&`.
+  static_assert(std::is_reference_v<Item>);
+  static_assert(!std::is_const_v<std::remove_reference_t<Item>>);
+  // `RawItem` is a `T`.
+  using RawItem = std::remove_reference_t<Item>;
+
+ public:
+  /// sus::iter::Iterator trait.
+  constexpr Option<Item> next() noexcept {
+    if (front_ == back_) [[unlikely]]
+      return Option<Item>();
+    return Option<Item>(
+        *(buf_ + (::sus::mem::replace(front_, front_ + 1u) & mask_)));
+  }
+
+  /// sus::iter::DoubleEndedIterator trait.
+  constexpr Option<Item> next_back() noexcept {
+    if (front_ == back_) [[unlikely]]
+      return Option<Item>();
+    back_ -= 1u;
+    return Option<Item>(*(buf_ + (back_ & mask_)));
+  }
+
+  /// sus::iter::Iterator trait.
+  constexpr ::sus::iter::SizeHint size_hint() const noexcept {
+    const auto remaining = exact_size_hint();
+    return ::sus::iter::SizeHint(remaining,
+                                 ::sus::Option<::sus::num::usize>(remaining));
+  }
+
+  /// sus::iter::ExactSizeIterator trait.
+  constexpr ::sus::num::usize exact_size_hint() const noexcept {
+    return back_ - front_;
+  }
+
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr Item get_unchecked(::sus::marker::UnsafeFnMarker,
+                               ::sus::num::usize i) noexcept {
+    return *(buf_ + ((front_ + i) & mask_));
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr void advance_unchecked(::sus::marker::UnsafeFnMarker,
+                                   ::sus::num::usize n) noexcept {
+    front_ += n;
+  }
+
+ private:
+  template <class>
+  friend class VecDeque;
+
+  /// The `front` and `back` positions are not wrapped to the capacity of the
+  /// buffer, so that `back` is always at least `front`. They are wrapped with
+  /// `mask` when the buffer is indexed.
+  explicit constexpr VecDequeIterMut(::sus::iter::IterRef ref, RawItem* buf,
+                                     ::sus::num::usize mask,
+                                     ::sus::num::usize front,
+                                     ::sus::num::usize back) noexcept
+      : ref_(::sus::move(ref)),
+        buf_(buf),
+        mask_(mask),
+        front_(front),
+        back_(back) {}
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
+  RawItem* buf_;
+  ::sus::num::usize mask_;
+  ::sus::num::usize front_;
+  ::sus::num::usize back_;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(ref_),
+                                  decltype(buf_), decltype(mask_),
+                                  decltype(front_), decltype(back_));
+};
+
+/// An iterator that moves the elements out of a `VecDeque`.
+///
+/// This type is returned from `VecDeque::into_iter()`. The elements are
+/// visited from the front of the deque to the back, and any elements that are
+/// not visited are destroyed along with the iterator.
+template <class T>
+struct [[nodiscard]] VecDequeIntoIter final
+    : public ::sus::iter::IteratorBase<VecDequeIntoIter<T>, T> {
+ public:
+  using Item = T;
+
+  /// sus::iter::Iterator trait.
+  Option<Item> next() noexcept { return deque_.pop_front(); }
+
+  /// sus::iter::DoubleEndedIterator trait.
+  Option<Item> next_back() noexcept { return deque_.pop_back(); }
+
+  /// sus::iter::Iterator trait.
+  ::sus::iter::SizeHint size_hint() const noexcept {
+    const auto remaining = exact_size_hint();
+    return ::sus::iter::SizeHint(remaining,
+                                 ::sus::Option<::sus::num::usize>(remaining));
+  }
+
+  /// sus::iter::ExactSizeIterator trait.
+  ::sus::num::usize exact_size_hint() const noexcept { return deque_.len(); }
+
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+ private:
+  template <class>
+  friend class VecDeque;
+
+  explicit VecDequeIntoIter(VecDeque<T>&& deque) noexcept
+      : deque_(::sus::move(deque)) {}
+
+  VecDeque<T> deque_;
+
+  sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn,
+                                           decltype(deque_));
+};
+
+/// A draining iterator for `VecDeque<T>`.
+///
+/// This type is returned from `VecDeque::drain()`. The drained elements are
+/// moved out of the deque as they are visited, and those that are not visited
+/// are destroyed along with the iterator. The elements after the drained range
+/// are then moved back together with the elements before it, moving whichever
+/// side is shorter.
+///
+/// # Panics
+///
+/// Like [`Drain`]($sus::collections::Drain) for a `Vec`, `VecDequeDrain`
+/// points at the deque it was created from, so it can be move-constructed but
+/// it will panic on move-assignment.
+template <class T>
+struct [[nodiscard]] VecDequeDrain final
+    : public ::sus::iter::IteratorBase<VecDequeDrain<T>, T> {
+ public:
+  using Item = T;
+
+  VecDequeDrain(VecDequeDrain&& rhs) noexcept
+      : deque_(::sus::mem::replace(rhs.deque_, nullptr)),
+        ref_(::sus::move(rhs.ref_)),
+        start_(rhs.start_),
+        drain_len_(rhs.drain_len_),
+        tail_len_(rhs.tail_len_),
+        front_(rhs.front_),
+        back_(rhs.back_) {}
+
+  /// `VecDequeDrain` may be move-constructed in order to be stored as a member
+  /// of other objects, but it can not be assigned-to. See the class
+  /// documentation for more.
+  ///
+  /// # Panics
+  ///
+  /// Calling this function will always panic.
+  VecDequeDrain& operator=(VecDequeDrain&&) noexcept {
+    ::sus::panic("attempt to assign to VecDequeDrain iterator");
+  }
+
+  ~VecDequeDrain() noexcept {
+    // The `deque_` is null if the iterator was moved from.
+    if (deque_ == nullptr) return;
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (; front_ != back_; front_ += 1u)
+        std::destroy_at(deque_->slot(front_));
+    }
+    deque_->finish_drain(start_, drain_len_, tail_len_);
+  }
+
+  /// sus::iter::Iterator trait.
+  Option<Item> next() noexcept {
+    if (front_ == back_) [[unlikely]]
+      return Option<Item>();
+    return take_slot(::sus::mem::replace(front_, front_ + 1u));
+  }
+
+  /// sus::iter::DoubleEndedIterator trait.
+  Option<Item> next_back() noexcept {
+    if (front_ == back_) [[unlikely]]
+      return Option<Item>();
+    back_ -= 1u;
+    return take_slot(back_);
+  }
+
+  /// sus::iter::Iterator trait.
+  ::sus::iter::SizeHint size_hint() const noexcept {
+    const auto remaining = exact_size_hint();
+    return ::sus::iter::SizeHint(remaining,
+                                 ::sus::Option<::sus::num::usize>(remaining));
+  }
+
+  /// sus::iter::ExactSizeIterator trait.
+  ::sus::num::usize exact_size_hint() const noexcept { return back_ - front_; }
+
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+ private:
+  template <class>
+  friend class VecDeque;
+
+  /// The deque's length has been cut to `start`, so the `drain_len` elements
+  /// after it and the `tail_len` elements after those are hidden from it
+  /// until the iterator is destroyed.
+  explicit VecDequeDrain(VecDeque<T>& deque sus_lifetimebound,
+                         ::sus::iter::IterRef ref, ::sus::num::usize start,
+                         ::sus::num::usize drain_len,
+                         ::sus::num::usize tail_len) noexcept
+      : deque_(&deque),
+        ref_(::sus::move(ref)),
+        start_(start),
+        drain_len_(drain_len),
+        tail_len_(tail_len),
+        front_(start),
+        back_(start + drain_len) {}
+
+  /// Moves the element at logical index `i` out of the deque, and destroys
+  /// what is left in its slot.
+  Option<Item> take_slot(::sus::num::usize i) noexcept {
+    T* const p = deque_->slot(i);
+    auto out = Option<Item>(::sus::move(*p));
+    if constexpr (!std::is_trivially_destructible_v<T>) std::destroy_at(p);
+    return out;
+  }
+
+  VecDeque<T>* deque_;
+  // Prevents the deque from being mutated while it is being drained.
+  [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
+  ::sus::num::usize start_;
+  ::sus::num::usize drain_len_;
+  ::sus::num::usize tail_len_;
+  // The logical indices of the elements left to be drained.
+  ::sus::num::usize front_;
+  ::sus::num::usize back_;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(deque_),
+                                  decltype(ref_), decltype(start_),
+                                  decltype(drain_len_), decltype(tail_len_),
+                                  decltype(front_), decltype(back_));
+};
+
+}  // namespace sus::collections
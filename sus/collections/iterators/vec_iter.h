@@ -33,13 +33,13 @@ namespace sus::collections {
 /// An iterator that consumes a `Vec` and returns the items from it.
 ///
 /// This type is returned from `Vec::into_iter()`.
-template <class ItemT>
+template <class ItemT, class A>
 struct [[nodiscard]] VecIntoIter final
-    : public ::sus::iter::IteratorBase<VecIntoIter<ItemT>, ItemT> {
+    : public ::sus::iter::IteratorBase<VecIntoIter<ItemT, A>, ItemT> {
  public:
   using Item = ItemT;
 
-  constexpr VecIntoIter(Vec<Item>&& vec) noexcept : vec_(::sus::move(vec)) {}
+  constexpr VecIntoIter(Vec<Item, A>&& vec) noexcept : vec_(::sus::move(vec)) {}
 
   // sus::mem::Clone implementation.
   constexpr VecIntoIter clone() const noexcept
@@ -92,12 +92,35 @@ struct [[nodiscard]] VecIntoIter final
     return {};
   }
 
+  /// sus::iter::__private::ContiguousIterator trait.
+  /// #[doc.hidden]
+  constexpr const Item* contiguous_data() const noexcept {
+    return vec_.as_ptr() + front_index_;
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr Item get_unchecked(::sus::marker::UnsafeFnMarker,
+                               ::sus::num::usize i) noexcept {
+    // SAFETY: The caller ensures `i` is less than `exact_size_hint()`, so the
+    // index is within the length of the Vec.
+    return move(
+        vec_.get_unchecked_mut(::sus::marker::unsafe_fn, front_index_ + i));
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr void advance_unchecked(::sus::marker::UnsafeFnMarker,
+                                   ::sus::num::usize n) noexcept {
+    front_index_ += n;
+  }
+
  private:
   // Ctor for Clone.
-  constexpr VecIntoIter(Vec<Item>&& vec, usize front, usize back) noexcept
+  constexpr VecIntoIter(Vec<Item, A>&& vec, usize front, usize back) noexcept
       : vec_(::sus::move(vec)), front_index_(front), back_index_(back) {}
 
-  Vec<Item> vec_;
+  Vec<Item, A> vec_;
   usize front_index_ = 0_usize;
   usize back_index_ = vec_.len();
 
@@ -86,9 +86,12 @@ class [[nodiscard]] [[_sus_trivial_abi]] Windows final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by Slice, Vec, Array.
+  // Constructed by Slice, Vec, SmallVec, Array.
   friend class Slice<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
     friend class Array;
 
@@ -168,9 +171,12 @@ class [[nodiscard]] [[_sus_trivial_abi]] WindowsMut final
   // TODO: Impl count(), nth(), last(), nth_back().
 
  private:
-  // Constructed by SliceMut, Vec, Array.
+  // Constructed by SliceMut, Vec, SmallVec, Array.
   friend class SliceMut<ItemT>;
-  friend class Vec<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
   template <class ArrayItemT, size_t N>
     friend class Array;
 
@@ -186,4 +192,95 @@ class [[nodiscard]] [[_sus_trivial_abi]] WindowsMut final
                                   decltype(v_), decltype(size_));
 };
 
+/// An iterator over overlapping windows of `N` elements, as references to
+/// arrays of `N` elements.
+///
+/// This struct is created by the `array_windows()` method on slices.
+template <class ItemT, size_t N>
+class [[nodiscard]] [[_sus_trivial_abi]] ArrayWindows final
+    : public ::sus::iter::IteratorBase<ArrayWindows<ItemT, N>,
+                                       const ItemT (&)[N]> {
+  static_assert(N > 0u);
+
+ public:
+  // `Item` is a `const T(&)[N]`.
+  using Item = const ItemT (&)[N];
+
+  // sus::iter::Iterator trait.
+  Option<Item> next() noexcept {
+    if (exact_size_hint() == 0u) return Option<Item>();
+    Option<Item> ret(*reinterpret_cast<const ItemT(*)[N]>(v_.as_ptr()));
+    v_ = v_[::sus::ops::RangeFrom<usize>(1u)];
+    return ret;
+  }
+
+  // sus::iter::DoubleEndedIterator trait.
+  Option<Item> next_back() noexcept {
+    if (exact_size_hint() == 0u) return Option<Item>();
+    Option<Item> ret(*reinterpret_cast<const ItemT(*)[N]>(
+        v_.as_ptr() + (v_.len() - N)));
+    v_ = v_[::sus::ops::RangeTo<usize>(v_.len() - 1u)];
+    return ret;
+  }
+
+  // Replace the default impl in sus::iter::IteratorBase.
+  constexpr ::sus::iter::SizeHint size_hint() const noexcept {
+    const auto remaining = exact_size_hint();
+    return {remaining, ::sus::Option<::sus::num::usize>(remaining)};
+  }
+
+  /// sus::iter::ExactSizeIterator trait.
+  constexpr ::sus::num::usize exact_size_hint() const noexcept {
+    if (N > v_.len()) {
+      return 0u;
+    } else {
+      return v_.len() - N + 1u;
+    }
+  }
+
+  /// sus::iter::TrustedLen trait.
+  /// #[doc.hidden]
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept {
+    return {};
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  Item get_unchecked(::sus::marker::UnsafeFnMarker,
+                     ::sus::num::usize i) noexcept {
+    return *reinterpret_cast<const ItemT(*)[N]>(v_.as_ptr() + i);
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr void advance_unchecked(::sus::marker::UnsafeFnMarker,
+                                   ::sus::num::usize n) noexcept {
+    // SAFETY: The caller ensures there are at least `n` windows left, so the
+    // slice is at least `n + N - 1` elements long.
+    v_ = v_.get_range_unchecked(::sus::marker::unsafe_fn,
+                                ::sus::ops::range_from(n));
+  }
+
+ private:
+  // Constructed by Slice, Vec, SmallVec, Array.
+  friend class Slice<ItemT>;
+  template <class VecT, class VecA>
+  friend class Vec;
+  template <class SmallVecT, size_t SmallVecN>
+  friend class SmallVec;
+  template <class ArrayItemT, size_t ArrayN>
+    friend class Array;
+
+  constexpr ArrayWindows(::sus::iter::IterRef ref,
+                         const Slice<ItemT>& values) noexcept
+      : ref_(::sus::move(ref)), v_(values) {}
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRef ref_;
+  Slice<ItemT> v_;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(ref_),
+                                  decltype(v_));
+};
+
 }  // namespace sus::collections
@@ -14,14 +14,19 @@
 
 #pragma once
 
-#include <algorithm>  // Replace std::sort.
-
 #include "fmt/core.h"
 #include "sus/assertions/check.h"
 #include "sus/assertions/debug_check.h"
 #include "sus/cmp/eq.h"
 #include "sus/cmp/ord.h"
+#include "sus/collections/__private/compare.h"
+#include "sus/collections/__private/par_sort.h"
+#include "sus/collections/__private/radix_sort.h"
+#include "sus/collections/__private/search.h"
+#include "sus/collections/__private/select.h"
 #include "sus/collections/__private/sort.h"
+#include "sus/collections/__private/sort_stable.h"
+#include "sus/collections/__private/sort_unstable.h"
 #include "sus/collections/concat.h"
 #include "sus/collections/iterators/chunks.h"
 #include "sus/collections/iterators/slice_iter.h"
@@ -30,6 +35,7 @@
 #include "sus/collections/join.h"
 #include "sus/construct/default.h"
 #include "sus/fn/fn_concepts.h"
+#include "sus/hash/hash.h"
 #include "sus/iter/iterator_defn.h"
 #include "sus/iter/iterator_ref.h"
 #include "sus/lib/__private/forward_decl.h"
@@ -43,6 +49,7 @@
 #include "sus/mem/move.h"
 #include "sus/mem/swap.h"
 #include "sus/num/cast.h"
+#include "sus/num/integer_concepts.h"
 #include "sus/num/signed_integer.h"
 #include "sus/num/unsigned_integer.h"
 #include "sus/ops/range.h"
@@ -187,11 +194,8 @@ class [[_sus_trivial_abi]] Slice final {
     requires(::sus::cmp::Eq<T, U>)
   friend constexpr bool operator==(const Slice<T>& l,
                                    const Slice<U>& r) noexcept {
-    if (l.len() != r.len()) return false;
-    for (usize i = l.len(); i > 0u; i -= 1u) {
-      if (!(l[i - 1u] == r[i - 1u])) return false;
-    }
-    return true;
+    return l.len() == r.len() &&
+           __private::slice_eq(l.as_ptr(), r.as_ptr(), l.len().primitive_value);
   }
 
   template <class U>
@@ -199,6 +203,44 @@ class [[_sus_trivial_abi]] Slice final {
   friend constexpr bool operator==(const Slice<T>& l,
                                    const Slice<U>& r) = delete;
 
+  /// Compares two Slices lexicographically.
+  ///
+  /// The first pair of elements that are not equivalent determines the order.
+  /// If one slice is a prefix of the other, the shorter slice is less.
+  ///
+  /// Satisfies sus::cmp::StrongOrd<Slice<T>> if sus::cmp::StrongOrd<T>.
+  ///
+  /// Satisfies sus::cmp::Ord<Slice<T>> if sus::cmp::Ord<T>.
+  ///
+  /// Satisfies sus::cmp::PartialOrd<Slice<T>> if sus::cmp::PartialOrd<T>.
+  /// #[doc.overloads=slice.cmp]
+  template <class U>
+    requires(::sus::cmp::ExclusiveStrongOrd<T, U>)
+  friend constexpr std::strong_ordering operator<=>(
+      const Slice<T>& l, const Slice<U>& r) noexcept {
+    return __private::slice_cmp<std::strong_ordering>(
+        l.as_ptr(), l.len().primitive_value, r.as_ptr(),
+        r.len().primitive_value);
+  }
+  /// #[doc.overloads=slice.cmp]
+  template <class U>
+    requires(::sus::cmp::ExclusiveOrd<T, U>)
+  friend constexpr std::weak_ordering operator<=>(const Slice<T>& l,
+                                                  const Slice<U>& r) noexcept {
+    return __private::slice_cmp<std::weak_ordering>(
+        l.as_ptr(), l.len().primitive_value, r.as_ptr(),
+        r.len().primitive_value);
+  }
+  /// #[doc.overloads=slice.cmp]
+  template <class U>
+    requires(::sus::cmp::ExclusivePartialOrd<T, U>)
+  friend constexpr std::partial_ordering operator<=>(
+      const Slice<T>& l, const Slice<U>& r) noexcept {
+    return __private::slice_cmp<std::partial_ordering>(
+        l.as_ptr(), l.len().primitive_value, r.as_ptr(),
+        r.len().primitive_value);
+  }
+
   /// Returns a reference to the element at position `i` in the Slice.
   ///
   /// # Panics
@@ -264,7 +306,7 @@ class [[_sus_trivial_abi]] Slice final {
       : iter_refs_(::sus::move(refs)), data_(data), len_(len) {}
 
   friend class SliceMut<T>;
-  template <class VecT>
+  template <class VecT, class VecA>
   friend class Vec;
 
   [[_sus_no_unique_address]] ::sus::iter::IterRefCounter iter_refs_;
@@ -413,6 +455,21 @@ class [[_sus_trivial_abi]] SliceMut final {
   friend constexpr bool operator==(const SliceMut<T>& l,
                                    const SliceMut<U>& r) = delete;
 
+  /// Compares two SliceMuts lexicographically, as with `Slice`.
+  ///
+  /// Satisfies sus::cmp::StrongOrd<SliceMut<T>> if sus::cmp::StrongOrd<T>.
+  ///
+  /// Satisfies sus::cmp::Ord<SliceMut<T>> if sus::cmp::Ord<T>.
+  ///
+  /// Satisfies sus::cmp::PartialOrd<SliceMut<T>> if sus::cmp::PartialOrd<T>.
+  /// #[doc.overloads=slicemut.cmp]
+  template <class U>
+    requires(::sus::cmp::PartialOrd<T, U>)
+  friend constexpr auto operator<=>(const SliceMut<T>& l,
+                                    const SliceMut<U>& r) noexcept {
+    return l.as_slice() <=> r.as_slice();
+  }
+
   /// Returns a reference to the element at position `i` in the Slice.
   ///
   /// # Panics
@@ -494,7 +551,7 @@ class [[_sus_trivial_abi]] SliceMut final {
   constexpr SliceMut(sus::iter::IterRefCounter refs, T* data, usize len)
       : slice_(::sus::move(refs), data, len) {}
 
-  template <class VecT>
+  template <class VecT, class VecA>
   friend class Vec;
 
   Slice<T> slice_;
@@ -519,8 +576,72 @@ using ::sus::iter::begin;
 // Documented in vec.h
 using ::sus::iter::end;
 
+namespace __private {
+
+/// Integers and enums have no padding bytes, and equal values have equal
+/// bytes, so a slice of them is hashed as a single run of bytes.
+template <class T>
+concept HashAsBytes = std::is_integral_v<T> || std::is_enum_v<T> ||
+                      ::sus::num::IntegerNumeric<T>;
+
+}  // namespace __private
+
 }  // namespace sus::collections
 
+// sus::hash::Hash support.
+template <class T>
+  requires(::sus::hash::Hash<T>)
+struct sus::hash::HashImpl<::sus::collections::Slice<T>> {
+  /// Hashes the length of the slice followed by its elements. Collections
+  /// that hold a contiguous sequence of elements hash the same as a `Slice`
+  /// of their elements.
+  template <::sus::hash::Hasher H>
+  static constexpr void hash(const ::sus::collections::Slice<T>& s,
+                             H& state) noexcept {
+    ::sus::hash::hash_into(s.len(), state);
+    if constexpr (::sus::collections::__private::HashAsBytes<T>) {
+      const size_t len = s.len().primitive_value;
+      if constexpr (std::same_as<T, ::sus::num::u8>) {
+        state.write(s);
+      } else if (std::is_constant_evaluated()) {
+        // The bytes can't be reinterpreted in a constant expression, so they
+        // are copied out, giving the same hash value as at runtime.
+        struct Bytes {
+          ::sus::num::u8 b[sizeof(T)];
+        };
+        auto* const bytes = new ::sus::num::u8[len * sizeof(T)];
+        for (size_t i = 0u; i < len; i += 1u) {
+          const auto e = std::bit_cast<Bytes>(
+              s.get_unchecked(::sus::marker::unsafe_fn, i));
+          for (size_t j = 0u; j < sizeof(T); j += 1u)
+            bytes[i * sizeof(T) + j] = e.b[j];
+        }
+        state.write(::sus::collections::Slice<::sus::num::u8>::from_raw_parts(
+            ::sus::marker::unsafe_fn, bytes, len * sizeof(T)));
+        delete[] bytes;
+      } else {
+        state.write(::sus::collections::Slice<::sus::num::u8>::from_raw_parts(
+            ::sus::marker::unsafe_fn,
+            reinterpret_cast<const ::sus::num::u8*>(s.as_ptr()),
+            len * sizeof(T)));
+      }
+    } else {
+      for (const T& e : s) ::sus::hash::hash_into(e, state);
+    }
+  }
+};
+
+// sus::hash::Hash support.
+template <class T>
+  requires(::sus::hash::Hash<T>)
+struct sus::hash::HashImpl<::sus::collections::SliceMut<T>> {
+  template <::sus::hash::Hasher H>
+  _sus_always_inline static constexpr void hash(
+      const ::sus::collections::SliceMut<T>& s, H& state) noexcept {
+    ::sus::hash::hash_into(s.as_slice(), state);
+  }
+};
+
 // fmt support.
 template <class T, class Char>
 struct fmt::formatter<::sus::collections::Slice<T>, Char> {
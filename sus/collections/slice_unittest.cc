@@ -14,7 +14,9 @@
 
 #include "sus/collections/slice.h"
 
+#include <algorithm>
 #include <sstream>
+#include <string>
 
 #include "googletest/include/gtest/gtest.h"
 #include "sus/collections/array.h"
@@ -625,6 +627,45 @@ TEST(SliceMut, SortByKey) {
   }
 }
 
+TEST(SliceMut, SortPatterns) {
+  // Sorts by the first value only, so the second value tracks stability.
+  auto check = [](sus::Vec<sus::Tuple<i32, i32>> v) {
+    auto expected = v.clone();
+    auto by_first = [](const sus::Tuple<i32, i32>& a,
+                       const sus::Tuple<i32, i32>& b) {
+      return a.at<0>() < b.at<0>();
+    };
+    std::stable_sort(expected.as_mut_ptr(),
+                     expected.as_mut_ptr() + expected.len(), by_first);
+    v.sort_by_key([](const sus::Tuple<i32, i32>& t) { return t.at<0>(); });
+    EXPECT_EQ(v, expected);
+  };
+
+  constexpr i32 kLen = 5000;
+  auto random = sus::Vec<sus::Tuple<i32, i32>>();
+  auto few_unique = sus::Vec<sus::Tuple<i32, i32>>();
+  auto descending = sus::Vec<sus::Tuple<i32, i32>>();
+  auto nearly_sorted = sus::Vec<sus::Tuple<i32, i32>>();
+  auto runs = sus::Vec<sus::Tuple<i32, i32>>();
+  u32 state = 12345u;
+  for (i32 i = 0; i < kLen; i += 1) {
+    state = state.wrapping_mul(1103515245u).wrapping_add(12345u);
+    random.push(sus::tuple(i32::try_from(state >> 8u).unwrap(), i));
+    few_unique.push(sus::tuple(i32::try_from(state % 4u).unwrap(), i));
+    // Equal elements in a descending sequence must not be reversed.
+    descending.push(sus::tuple(kLen / 2 - i / 2, i));
+    nearly_sorted.push(
+        sus::tuple(state % 100u == 0u ? i32::try_from(state % 7u).unwrap() : i,
+                   i));
+    runs.push(sus::tuple(i % 700, i));
+  }
+  check(sus::move(random));
+  check(sus::move(few_unique));
+  check(sus::move(descending));
+  check(sus::move(nearly_sorted));
+  check(sus::move(runs));
+}
+
 TEST(SliceMut, SortByCachedKey) {
   struct Unsortable {
     Sortable sortable;
@@ -667,6 +708,47 @@ TEST(SliceMut, SortByCachedKey) {
   }
 }
 
+TEST(SliceMut, SortByCachedKeyPaths) {
+  auto v = sus::Vec<sus::Tuple<i32, i32>>();
+  u32 state = 12345u;
+  for (i32 i = 0; i < 70000; i += 1) {
+    state = state.wrapping_mul(1103515245u).wrapping_add(12345u);
+    v.push(sus::tuple(i32::try_from(state % 1000u).unwrap() - 500, i));
+  }
+  auto first = [](const sus::Tuple<i32, i32>& t) { return t.at<0>(); };
+
+  // Every index width, for both integer keys which are radix sorted and string
+  // keys which are compared.
+  for (usize len : {10_usize, 300_usize, 70000_usize}) {
+    auto expected = v[sus::ops::range(0_usize, len)].to_vec();
+    expected.sort_by_key(first);
+
+    auto by_int = v[sus::ops::range(0_usize, len)].to_vec();
+    by_int.sort_by_cached_key(first);
+    EXPECT_EQ(by_int, expected);
+
+    usize calls;
+    auto by_string = v[sus::ops::range(0_usize, len)].to_vec();
+    by_string.sort_by_cached_key([&](const sus::Tuple<i32, i32>& t) {
+      calls += 1u;
+      // Zero-padded so that the strings order like the numbers.
+      return std::to_string(t.at<0>().primitive_value + 5000);
+    });
+    EXPECT_EQ(calls, len);
+    EXPECT_EQ(by_string, expected);
+
+    auto par = v[sus::ops::range(0_usize, len)].to_vec();
+    par.par_sort_by_cached_key([](const sus::Tuple<i32, i32>& t) {
+      return std::to_string(t.at<0>().primitive_value + 5000);
+    });
+    EXPECT_EQ(par, expected);
+
+    auto par_int = v[sus::ops::range(0_usize, len)].to_vec();
+    par_int.par_sort_by_cached_key(first);
+    EXPECT_EQ(par_int, expected);
+  }
+}
+
 TEST(SliceMut, SortUnstable) {
   {
     auto unsorted = sus::Array<i32, 6>(3, 4, 2, 1, 6, 5);
@@ -745,6 +827,309 @@ TEST(SliceMut, SortUnstableByKey) {
   }
 }
 
+TEST(SliceMut, SortUnstablePatterns) {
+  // Exercises the insertion sort and partitioning paths on inputs large enough
+  // to need them. The heapsort fallback is covered by SortUnstableAdversary.
+  auto check = [](sus::Vec<i32> v) {
+    auto expected = v.clone();
+    std::sort(expected.as_mut_ptr(), expected.as_mut_ptr() + expected.len());
+    v.sort_unstable();
+    EXPECT_EQ(v, expected);
+
+    // Non-trivial types take the branching partition.
+    auto strings = sus::Vec<std::string>();
+    for (i32 i : v.iter()) strings.push(std::to_string(i.primitive_value));
+    auto expected_strings = strings.clone();
+    std::sort(expected_strings.as_mut_ptr(),
+              expected_strings.as_mut_ptr() + expected_strings.len());
+    strings.sort_unstable_by([](const std::string& a, const std::string& b) {
+      return b <=> a;
+    });
+    std::reverse(strings.as_mut_ptr(), strings.as_mut_ptr() + strings.len());
+    EXPECT_EQ(strings, expected_strings);
+  };
+
+  constexpr i32 kLen = 5000;
+  auto ascending = sus::Vec<i32>();
+  auto descending = sus::Vec<i32>();
+  auto random = sus::Vec<i32>();
+  auto few_unique = sus::Vec<i32>();
+  auto organ_pipe = sus::Vec<i32>();
+  auto sawtooth = sus::Vec<i32>();
+  u32 state = 12345u;
+  for (i32 i = 0; i < kLen; i += 1) {
+    state = state.wrapping_mul(1103515245u).wrapping_add(12345u);
+    ascending.push(i);
+    descending.push(kLen - i);
+    random.push(i32::try_from(state >> 8u).unwrap());
+    few_unique.push(i32::try_from(state % 4u).unwrap());
+    organ_pipe.push(i < kLen / 2 ? i : kLen - i);
+    sawtooth.push(i % 64);
+  }
+  check(sus::move(ascending));
+  check(sus::move(descending));
+  check(sus::move(random));
+  check(sus::move(few_unique));
+  check(sus::move(organ_pipe));
+  check(sus::move(sawtooth));
+}
+
+TEST(SliceMut, SortUnstableAdversary) {
+  // McIlroy's adversary for quicksort: each element's value is left undecided
+  // ("gas", greater than every decided value) until a comparison needs it,
+  // and it then picks values that make every pivot as bad as possible. That
+  // uses up the budget of unbalanced partitions, so the sort has to fall back
+  // to heapsort to stay O(n * log(n)). Without the fallback this input takes
+  // over 2 million comparisons.
+  constexpr usize kLen = 5000u;
+  constexpr usize kGas = kLen;
+  // Well over n * log2(n), but far below the quadratic count.
+  constexpr usize kMaxComparisons = kLen * 64u;
+
+  auto values = sus::Vec<usize>::with_capacity(kLen);
+  auto items = sus::Vec<usize>::with_capacity(kLen);
+  for (usize i = 0u; i < kLen; i += 1u) {
+    values.push(kGas);
+    items.push(i);
+  }
+  // Start with a descending pair so the scan for a presorted run stops there.
+  values[0u] = 1u;
+  values[1u] = 0u;
+  usize solid = 2u;
+  usize candidate = 0u;
+  usize comparisons = 0u;
+  items.sort_unstable_by([&](const usize& a, const usize& b) {
+    comparisons += 1u;
+    if (values[a] == kGas && values[b] == kGas) {
+      values[a == candidate ? a : b] = solid;
+      solid += 1u;
+    }
+    if (values[a] == kGas)
+      candidate = a;
+    else if (values[b] == kGas)
+      candidate = b;
+    return values[a] <=> values[b];
+  });
+  EXPECT_LT(comparisons, kMaxComparisons);
+  for (usize i = 1u; i < kLen; i += 1u)
+    EXPECT_LE(values[items[i - 1u]], values[items[i]]);
+
+  // The values the adversary chose are now a fixed input that hits the same
+  // bad partitions.
+  usize replay_comparisons = 0u;
+  values.sort_unstable_by([&](const usize& a, const usize& b) {
+    replay_comparisons += 1u;
+    return a <=> b;
+  });
+  EXPECT_LT(replay_comparisons, kMaxComparisons);
+  for (usize i = 1u; i < kLen; i += 1u) EXPECT_LE(values[i - 1u], values[i]);
+}
+
+TEST(SliceMut, SortUnstableRadix) {
+  // Long slices of integers are sorted by radix sort, which needs to handle
+  // the sign of signed integers.
+  auto check = [](auto v) {
+    auto expected = v.clone();
+    std::sort(expected.as_mut_ptr(), expected.as_mut_ptr() + expected.len());
+    v.sort_unstable();
+    EXPECT_EQ(v, expected);
+  };
+
+  auto v_i32 = sus::Vec<i32>();
+  auto v_i8 = sus::Vec<i8>();
+  auto v_u64 = sus::Vec<u64>();
+  auto v_usize = sus::Vec<usize>();
+  auto v_int = sus::Vec<int>();
+  u64 state = 12345u;
+  // Long enough to split into buckets on the highest byte first.
+  for (usize i; i < 70000u; i += 1u) {
+    state = state.wrapping_mul(6364136223846793005u).wrapping_add(1u);
+    v_i32.push(i32(static_cast<int32_t>(state.primitive_value >> 32u)));
+    v_i8.push(i8(static_cast<int8_t>(state.primitive_value >> 56u)));
+    v_u64.push(state);
+    // Only the low bytes vary, so the high passes are skipped.
+    v_usize.push(usize::try_from(state % 1000u).unwrap());
+    v_int.push(static_cast<int>(state.primitive_value >> 33u) - (1 << 30));
+  }
+  check(sus::move(v_i32));
+  check(sus::move(v_i8));
+  check(sus::move(v_u64));
+  check(sus::move(v_usize));
+  check(sus::move(v_int));
+}
+
+TEST(SliceMut, SortFloats) {
+  const f32 nan = f32::NaN;
+  auto check = [&](usize len) {
+    auto v = sus::Vec<f32>();
+    for (usize i; i < len; i += 1u) {
+      const f32 values[] = {1.5_f32,  -0.0_f32, 0.0_f32, -2.5_f32,
+                            f32::INF, nan,      -nan,    f32::NEG_INF};
+      v.push(values[(i % 8u).primitive_value]);
+    }
+    v.sort_floats();
+    for (usize i = 1u; i < v.len(); i += 1u) {
+      EXPECT_TRUE(v[i - 1u].total_cmp(v[i]) <= 0);
+    }
+    EXPECT_TRUE(v[0u].is_nan() && v[0u].is_sign_negative());
+    EXPECT_TRUE(v[len - 1u].is_nan() && v[len - 1u].is_sign_positive());
+  };
+  check(8u);     // Comparison sort.
+  check(1000u);  // Radix sort.
+}
+
+TEST(SliceMut, RadixSortByKey) {
+  struct Event {
+    i64 time;
+    i32 id;
+  };
+  auto events = sus::Vec<Event>();
+  u32 state = 12345u;
+  for (i32 i = 0; i < 2000; i += 1) {
+    state = state.wrapping_mul(1103515245u).wrapping_add(12345u);
+    events.push(Event(i64::from(state % 50u) - 25, i));
+  }
+  events.radix_sort_by_key([](const Event& e) { return e.time; });
+  for (usize i = 1u; i < events.len(); i += 1u) {
+    EXPECT_LE(events[i - 1u].time, events[i].time);
+    // The sort is stable.
+    if (events[i - 1u].time == events[i].time) {
+      EXPECT_LT(events[i - 1u].id, events[i].id);
+    }
+  }
+
+  // Keys can be floats, and the elements need not be trivially copyable.
+  auto strings = sus::Vec<std::string>(std::string("3.5"), std::string("-1"),
+                                       std::string("2"));
+  strings.radix_sort_by_key(
+      [](const std::string& s) { return f64(std::stod(s)); });
+  EXPECT_EQ(strings, sus::Vec<std::string>(std::string("-1"), std::string("2"),
+                                           std::string("3.5")));
+}
+
+TEST(SliceMut, SelectNthUnstable) {
+  // Random values with few and many duplicates, then sorted, reversed and
+  // all-equal input.
+  for (i32 pattern = 0; pattern < 5; pattern += 1) {
+    auto v = sus::Vec<i32>();
+    u32 state = 12345u;
+    for (i32 i = 0; i < 20000; i += 1) {
+      state = state.wrapping_mul(1103515245u).wrapping_add(12345u);
+      switch (pattern.primitive_value) {
+        case 0: v.push(i32::try_from(state % 1000000u).unwrap()); break;
+        case 1: v.push(i32::try_from(state % 4u).unwrap()); break;
+        case 2: v.push(i); break;
+        case 3: v.push(-i); break;
+        case 4: v.push(7); break;
+      }
+    }
+    auto sorted = v.clone();
+    sorted.sort_unstable();
+
+    for (usize index : {0u, 1u, 500u, 10000u, 18000u, 19800u, 19999u}) {
+      auto [before, nth, after] = v.select_nth_unstable(index);
+      EXPECT_EQ(nth, sorted[index]);
+      EXPECT_EQ(before.len(), index);
+      EXPECT_EQ(after.len(), 20000u - index - 1u);
+      EXPECT_TRUE(before.iter().all([&](const i32& i) { return i <= nth; }));
+      EXPECT_TRUE(after.iter().all([&](const i32& i) { return i >= nth; }));
+    }
+  }
+
+  auto v = sus::Vec<i32>(3, 1, 2, 5, 4);
+  auto [before, nth, after] = v.select_nth_unstable_by(
+      1u, [](const i32& a, const i32& b) { return b <=> a; });
+  EXPECT_EQ(nth, 4);
+  auto [before2, nth2, after2] =
+      v.select_nth_unstable_by_key(4u, [](const i32& a) { return -a; });
+  EXPECT_EQ(nth2, 1);
+}
+
+TEST(SliceMut, SelectNthMany) {
+  auto v = sus::Vec<i32>();
+  u32 state = 12345u;
+  for (i32 i = 0; i < 100000; i += 1) {
+    state = state.wrapping_mul(1103515245u).wrapping_add(12345u);
+    v.push(i32::try_from(state % 50000u).unwrap());
+  }
+  auto sorted = v.clone();
+  sorted.sort_unstable();
+
+  // Duplicate indices are allowed.
+  auto quantiles = sus::Vec<usize>(0u, 50000u, 90000u, 99000u, 99900u, 99900u,
+                                   99999u);
+  v.select_nth_many(quantiles);
+  for (usize q : quantiles) {
+    EXPECT_EQ(v[q], sorted[q]);
+    if (q > 0u) EXPECT_LE(v[q - 1u], v[q]);
+    if (q < 99999u) EXPECT_GE(v[q + 1u], v[q]);
+  }
+  // Each index partitions the slice.
+  for (usize i = 50000u; i < 90000u; i += 1u) {
+    EXPECT_TRUE(v[i] >= v[50000u] && v[i] <= v[90000u]);
+  }
+
+  v.select_nth_many_by(quantiles,
+                       [](const i32& a, const i32& b) { return b <=> a; });
+  for (usize q : quantiles) {
+    EXPECT_EQ(v[q], sorted[99999u - q]);
+  }
+
+  auto empty = sus::Vec<i32>();
+  empty.select_nth_many(Slice<usize>());
+}
+
+TEST(SliceMut, ParSort) {
+  auto v = sus::Vec<sus::Tuple<i32, i32>>();
+  u32 state = 12345u;
+  for (i32 i = 0; i < 100000; i += 1) {
+    state = state.wrapping_mul(1103515245u).wrapping_add(12345u);
+    v.push(sus::tuple(i32::try_from(state % 1000u).unwrap(), i));
+  }
+  auto expected = v.clone();
+  expected.sort_by_key([](const sus::Tuple<i32, i32>& t) { return t.at<0>(); });
+
+  auto stable = v.clone();
+  stable.par_sort_by_key(
+      [](const sus::Tuple<i32, i32>& t) { return t.at<0>(); });
+  EXPECT_EQ(stable, expected);
+
+  auto unstable = v.clone();
+  unstable.par_sort_unstable_by_key(
+      [](const sus::Tuple<i32, i32>& t) { return t.at<0>(); });
+  for (usize i = 1u; i < unstable.len(); i += 1u) {
+    EXPECT_LE(unstable[i - 1u].at<0>(), unstable[i].at<0>());
+  }
+  unstable.par_sort();
+  expected.sort();
+  EXPECT_EQ(unstable, expected);
+
+  auto short_slice = sus::Vec<i32>(3, 1, 2);
+  short_slice.par_sort_unstable();
+  EXPECT_EQ(short_slice, sus::Vec<i32>(1, 2, 3));
+  short_slice.par_sort_by([](const i32& a, const i32& b) { return b <=> a; });
+  EXPECT_EQ(short_slice, sus::Vec<i32>(3, 2, 1));
+}
+
+TEST(SliceMut, ParSelectNthUnstable) {
+  auto v = sus::Vec<i32>();
+  u32 state = 12345u;
+  for (i32 i = 0; i < 100000; i += 1) {
+    state = state.wrapping_mul(1103515245u).wrapping_add(12345u);
+    v.push(i32::try_from(state % 50000u).unwrap());
+  }
+  auto sorted = v.clone();
+  sorted.sort_unstable();
+
+  for (usize index : {0u, 500u, 50000u, 99999u}) {
+    auto [before, nth, after] = v.par_select_nth_unstable(index);
+    EXPECT_EQ(nth, sorted[index]);
+    EXPECT_EQ(before.len(), index);
+    EXPECT_TRUE(before.iter().all([&](const i32& i) { return i <= nth; }));
+    EXPECT_TRUE(after.iter().all([&](const i32& i) { return i >= nth; }));
+  }
+}
+
 static_assert(sus::construct::Default<Slice<i32>>);
 static_assert(sus::construct::Default<SliceMut<i32>>);
 
@@ -2513,6 +2898,131 @@ TEST(Slice, Eq) {
   EXPECT_NE(v1["1.."_r], v2["1.."_r]);
 }
 
+/// An enum whose `operator==` ignores the low bit, so slices of it can not be
+/// compared by their bytes.
+enum class HighBits : uint8_t { A0, A1, B0, B1 };
+constexpr bool operator==(HighBits l, HighBits r) noexcept {
+  return (static_cast<uint8_t>(l) >> 1u) == (static_cast<uint8_t>(r) >> 1u);
+}
+
+/// An enum whose `operator<=>` reverses the order of its values.
+enum class Reversed : uint8_t { A, B, C };
+constexpr std::strong_ordering operator<=>(Reversed l, Reversed r) noexcept {
+  return static_cast<uint8_t>(r) <=> static_cast<uint8_t>(l);
+}
+
+TEST(Slice, EqBitwise) {
+  // Long enough to cover whole vectors and tails, with a difference at each
+  // position in turn.
+  auto a = Vec<u64>();
+  for (u64 i = 0u; i < 100u; i += 1u) a.push(i * 0x0101010101010101_u64);
+  auto b = a.clone();
+  EXPECT_EQ(a.as_slice(), b.as_slice());
+  for (usize i; i < a.len(); i += 1u) {
+    b[i] += 1u;
+    EXPECT_NE(a.as_slice(), b.as_slice());
+    EXPECT_EQ(a[sus::ops::range(0_usize, i)], b[sus::ops::range(0_usize, i)]);
+    EXPECT_EQ(a[sus::ops::range_from(i + 1u)], b[sus::ops::range_from(i + 1u)]);
+    b[i] -= 1u;
+  }
+
+  // Primitive and enum types.
+  enum class E : uint16_t { A, B };
+  auto e1 = Vec<E>(E::A, E::B, E::A);
+  auto e2 = Vec<E>(E::A, E::B, E::B);
+  EXPECT_EQ(e1.as_slice(), e1.as_slice());
+  EXPECT_NE(e1.as_slice(), e2.as_slice());
+  // An enum's own comparison operators are used when it has them.
+  auto h1 = Vec<HighBits>(HighBits::A0, HighBits::B1);
+  auto h2 = Vec<HighBits>(HighBits::A1, HighBits::B0);
+  auto h3 = Vec<HighBits>(HighBits::A1, HighBits::A0);
+  EXPECT_EQ(h1.as_slice(), h2.as_slice());
+  EXPECT_NE(h1.as_slice(), h3.as_slice());
+  auto r1 = Vec<Reversed>(Reversed::A, Reversed::C);
+  auto r2 = Vec<Reversed>(Reversed::A, Reversed::B);
+  EXPECT_LT(r1.as_slice(), r2.as_slice());
+  auto c1 = Vec<char>('a', 'b', 'c');
+  auto c2 = Vec<char>('a', 'b', 'c');
+  EXPECT_EQ(c1.as_slice(), c2.as_slice());
+
+  // Floats are not compared by their bits.
+  auto f1 = Vec<f32>(0_f32, 1_f32);
+  auto f2 = Vec<f32>(-0_f32, 1_f32);
+  EXPECT_EQ(f1.as_slice(), f2.as_slice());
+  auto nan = Vec<f32>(f32::NaN);
+  EXPECT_NE(nan.as_slice(), nan.as_slice());
+
+  // Empty slices have no data pointer.
+  EXPECT_EQ(Slice<i32>(), Slice<i32>());
+  EXPECT_TRUE(a.as_slice().starts_with(Slice<u64>()));
+  EXPECT_TRUE(a.as_slice().ends_with(Slice<u64>()));
+  EXPECT_TRUE(Slice<u64>().starts_with(Slice<u64>()));
+
+  // Constant evaluation compares the elements one by one.
+  static_assert([]() {
+    auto x = Vec<i32>(1, 2, 3);
+    auto y = Vec<i32>(1, 2, 4);
+    return x.as_slice() != y.as_slice() &&
+           x.as_slice().starts_with(y["..2"_r]) &&
+           !x.as_slice().ends_with(y["1.."_r]);
+  }());
+}
+
+TEST(Slice, Cmp) {
+  struct NotCmp {};
+  static_assert(sus::cmp::StrongOrd<Slice<i32>>);
+  static_assert(sus::cmp::StrongOrd<SliceMut<i32>>);
+  static_assert(sus::cmp::PartialOrd<Slice<f32>>);
+  static_assert(!sus::cmp::Ord<Slice<f32>>);
+  static_assert(!sus::cmp::PartialOrd<Slice<NotCmp>>);
+
+  auto v = Vec<i32>(1, 2, 3);
+  auto w = Vec<i32>(1, 2, 4);
+  EXPECT_LT(v.as_slice(), w.as_slice());
+  EXPECT_GT(w.as_slice(), v.as_slice());
+  EXPECT_EQ(v.as_slice() <=> v.as_slice(), std::strong_ordering::equal);
+  // A prefix is less, regardless of the elements after it.
+  EXPECT_LT(w["..2"_r], v[".."_r]);
+  EXPECT_GT(v[".."_r], w["..2"_r]);
+  EXPECT_LT(Slice<i32>(), v.as_slice());
+
+  // Bytes are ordered as unsigned.
+  auto b1 = Vec<u8>(1_u8, 200_u8, 3_u8);
+  auto b2 = Vec<u8>(1_u8, 20_u8, 255_u8);
+  EXPECT_GT(b1.as_slice(), b2.as_slice());
+  EXPECT_LT(b1["..1"_r], b2.as_slice());
+  EXPECT_EQ(b1["..1"_r] <=> b2["..1"_r], std::strong_ordering::equal);
+  auto p1 = Vec<uint8_t>(uint8_t{0x10}, uint8_t{0xf0});
+  auto p2 = Vec<uint8_t>(uint8_t{0x10}, uint8_t{0x0f});
+  EXPECT_GT(p1.as_slice(), p2.as_slice());
+
+  // Signed bytes are not ordered by their bits.
+  auto s1 = Vec<i8>(-1_i8, 5_i8);
+  auto s2 = Vec<i8>(1_i8, 5_i8);
+  EXPECT_LT(s1.as_slice(), s2.as_slice());
+
+  // Wide integers, with the first difference in a later block.
+  auto x = Vec<u32>();
+  for (u32 i = 0u; i < 100u; i += 1u) x.push(i);
+  auto y = x.clone();
+  y[70u] = 0u;
+  y[80u] = 1000u;
+  EXPECT_GT(x.as_slice(), y.as_slice());
+  EXPECT_LT(x["..70"_r], y.as_slice());
+
+  // Floats give a partial order.
+  auto f1 = Vec<f32>(1_f32, f32::NaN);
+  auto f2 = Vec<f32>(1_f32, 2_f32);
+  EXPECT_EQ(f1.as_slice() <=> f2.as_slice(), std::partial_ordering::unordered);
+  EXPECT_EQ(f1["..1"_r] <=> f2.as_slice(), std::partial_ordering::less);
+
+  static_assert([]() {
+    auto a = Vec<u8>(1_u8, 200_u8);
+    auto b = Vec<u8>(1_u8, 20_u8, 3_u8);
+    return a.as_slice() > b.as_slice();
+  }());
+}
+
 TEST(SliceMut, Fill) {
   auto v1 = Vec<i32>(1, 2, 3, 4);
   v1["0..2"_r].fill(5);
@@ -2644,6 +3154,103 @@ TEST(SliceMut, LastMut) {
   static_assert(std::same_as<sus::Option<NoCopyMove&>, decltype(s.last_mut())>);
 }
 
+TEST(Slice, PositionOf) {
+  // Every length and needle position around the vector widths, so that the
+  // unrolled, single-vector and overlapping tail loops are all covered.
+  for (usize len = 0u; len < 300u; len += 1u) {
+    auto bytes = Vec<u8>::with_capacity(len);
+    for (usize i; i < len; i += 1u) bytes.push(u8::try_from(i % 7u).unwrap());
+    for (usize at; at < len; at += 1u) {
+      bytes[at] = 200_u8;
+      EXPECT_EQ(bytes.position_of(200_u8), sus::some(at));
+      EXPECT_EQ(bytes.rposition_of(200_u8), sus::some(at));
+      EXPECT_TRUE(bytes.contains(200_u8));
+      bytes[at] = u8::try_from(at % 7u).unwrap();
+    }
+    EXPECT_EQ(bytes.position_of(200_u8), sus::None);
+    EXPECT_EQ(bytes.rposition_of(200_u8), sus::None);
+    EXPECT_FALSE(bytes.contains(200_u8));
+  }
+
+  // Each element width, with matches in the middle.
+  {
+    auto v = Vec<u16>();
+    for (u16 i; i < 1000_u16; i += 1_u16) v.push(i % 100_u16);
+    EXPECT_EQ(v.position_of(42_u16), sus::some(42u));
+    EXPECT_EQ(v.rposition_of(42_u16), sus::some(942u));
+  }
+  {
+    auto v = Vec<i32>();
+    for (i32 i; i < 1000; i += 1) v.push(-(i % 100));
+    EXPECT_EQ(v.position_of(-42), sus::some(42u));
+    EXPECT_EQ(v.rposition_of(-42), sus::some(942u));
+    EXPECT_EQ(v.position_of(42), sus::None);
+  }
+  {
+    auto v = Vec<u64>();
+    for (u64 i; i < 1000u; i += 1u) v.push((i % 100u) << 40u);
+    EXPECT_EQ(v.position_of(42_u64 << 40u), sus::some(42u));
+    EXPECT_EQ(v.rposition_of(42_u64 << 40u), sus::some(942u));
+    // Only the high half matches.
+    EXPECT_EQ(v.position_of((42_u64 << 40u) | 1u), sus::None);
+  }
+  {
+    auto v = Vec<char>();
+    for (usize i; i < 1000u; i += 1u) v.push(i % 80u == 79u ? '\n' : 'a');
+    EXPECT_EQ(v.position_of('\n'), sus::some(79u));
+    EXPECT_EQ(v.rposition_of('\n'), sus::some(959u));
+  }
+  // Floats compare with `==`, so -0 matches 0 and NaN matches nothing.
+  {
+    auto v = Vec<f32>();
+    for (usize i; i < 100u; i += 1u) v.push(f32::NaN);
+    v.push(-0_f32);
+    v.push(1_f32);
+    EXPECT_EQ(v.position_of(0_f32), sus::some(100u));
+    EXPECT_EQ(v.position_of(f32::NaN), sus::None);
+    EXPECT_TRUE(v.contains(1_f32));
+  }
+  {
+    auto v = Vec<f64>();
+    for (f64 x; x < 100_f64; x += 1_f64) v.push(x);
+    EXPECT_EQ(v.position_of(57_f64), sus::some(57u));
+    EXPECT_EQ(v.position_of(0.5_f64), sus::None);
+  }
+  // Types that are not searched with vector instructions.
+  {
+    auto v = Vec<Vec<i32>>();
+    for (i32 i; i < 100; i += 1) v.push(Vec<i32>(i));
+    EXPECT_EQ(v.position_of(Vec<i32>(57)), sus::some(57u));
+    EXPECT_EQ(v.rposition_of(Vec<i32>(57)), sus::some(57u));
+    EXPECT_EQ(v.position_of(Vec<i32>(100)), sus::None);
+  }
+}
+
+TEST(Slice, PositionOfAny) {
+  auto text = Vec<u8>();
+  for (usize i; i < 500u; i += 1u) {
+    text.push(u8::try_from(i % 26u + 97u).unwrap());
+  }
+  text[100u] = u8::try_from(',').unwrap();
+  text[300u] = u8::try_from(';').unwrap();
+  text[400u] = u8::try_from('\n').unwrap();
+  const u8 comma = u8::try_from(',').unwrap();
+  const u8 semi = u8::try_from(';').unwrap();
+  const u8 newline = u8::try_from('\n').unwrap();
+
+  EXPECT_EQ(text.position_of_any(semi, newline), sus::some(300u));
+  EXPECT_EQ(text.position_of_any(newline, comma), sus::some(100u));
+  EXPECT_EQ(text.position_of_any(comma, semi, newline), sus::some(100u));
+  EXPECT_EQ(text.rposition_of_any(comma, semi), sus::some(300u));
+  EXPECT_EQ(text.rposition_of_any(comma, semi, newline), sus::some(400u));
+  EXPECT_EQ(text.position_of_any(0_u8, 1_u8), sus::None);
+  EXPECT_EQ(text.rposition_of_any(0_u8, 1_u8, 2_u8), sus::None);
+
+  auto short_slice = Vec<i32>(1, 2, 3);
+  EXPECT_EQ(short_slice.position_of_any(3, 2), sus::some(1u));
+  EXPECT_EQ(short_slice.rposition_of_any(1, 2), sus::some(1u));
+}
+
 TEST(Slice, Repeat) {
   {
     auto v1 = Vec<i32>(1, 2);
@@ -5836,6 +6443,101 @@ TEST(SliceMut, StripSuffixMut) {
   EXPECT_EQ(s.strip_suffix_mut(v[".."_r]).unwrap(), sus::empty);
 }
 
+TEST(Slice, AsChunks) {
+  auto v = sus::Vec<i32>(0, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+  sus::Slice<i32> s = v.as_slice();
+
+  auto [chunks, remainder] = s.as_chunks<3u>();
+  static_assert(std::same_as<decltype(chunks), sus::Slice<i32[3]>>);
+  EXPECT_EQ(chunks.len(), 3u);
+  EXPECT_EQ(static_cast<const void*>(chunks.as_ptr()), s.as_ptr());
+  EXPECT_EQ(chunks[0u][0u], 0);
+  EXPECT_EQ(chunks[1u][2u], 5);
+  EXPECT_EQ(chunks[2u][1u], 7);
+  EXPECT_EQ(remainder, sus::Vec<i32>(9));
+
+  // Evenly divided.
+  {
+    auto [chunks, remainder] = s.as_chunks<5u>();
+    EXPECT_EQ(chunks.len(), 2u);
+    EXPECT_EQ(remainder.len(), 0u);
+  }
+  // Larger than the slice.
+  {
+    auto [chunks, remainder] = s.as_chunks<11u>();
+    EXPECT_EQ(chunks.len(), 0u);
+    EXPECT_EQ(remainder, s);
+  }
+
+  // Chunks are arrays with a compile-time length.
+  i32 sum;
+  for (const i32(&chunk)[3] : s.array_chunks<3u>()) {
+    for (i32 x : chunk) sum += x;
+  }
+  EXPECT_EQ(sum, 0 + 1 + 2 + 3 + 4 + 5 + 6 + 7 + 8);
+
+  auto it = s.array_chunks<4u>();
+  static_assert(sus::iter::Iterator<decltype(it), const i32(&)[4]>);
+  static_assert(
+      sus::iter::DoubleEndedIterator<decltype(it), const i32(&)[4]>);
+  static_assert(sus::iter::ExactSizeIterator<decltype(it), const i32(&)[4]>);
+  EXPECT_EQ(it.exact_size_hint(), 2u);
+  EXPECT_EQ(&it.next_back().unwrap()[0u], &v[4u]);
+  EXPECT_EQ(&it.next().unwrap()[0u], &v[0u]);
+  EXPECT_TRUE(it.next().is_none());
+}
+
+TEST(SliceMut, AsChunksMut) {
+  auto v = sus::Vec<i32>(0, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+  sus::SliceMut<i32> s = v.as_mut_slice();
+
+  auto [chunks, remainder] = s.as_chunks_mut<4u>();
+  static_assert(std::same_as<decltype(chunks), sus::SliceMut<i32[4]>>);
+  EXPECT_EQ(chunks.len(), 2u);
+  chunks[1u][3u] = 70;
+  remainder[0u] = 80;
+  EXPECT_EQ(v, sus::Vec<i32>(0, 1, 2, 3, 4, 5, 6, 70, 80, 9));
+
+  for (i32(&chunk)[2] : v.array_chunks_mut<2u>()) {
+    for (i32& x : chunk) x += 1;
+  }
+  EXPECT_EQ(v, sus::Vec<i32>(1, 2, 3, 4, 5, 6, 7, 71, 81, 10));
+}
+
+TEST(Slice, ArrayWindows) {
+  auto v = sus::Vec<i32>(0, 1, 2, 3, 4);
+  sus::Slice<i32> s = v.as_slice();
+
+  // Larger than the slice size.
+  EXPECT_TRUE(s.array_windows<6u>().next().is_none());
+  EXPECT_EQ(s.array_windows<6u>().exact_size_hint(), 0u);
+
+  auto it = s.array_windows<2u>();
+  static_assert(sus::iter::Iterator<decltype(it), const i32(&)[2]>);
+  static_assert(
+      sus::iter::DoubleEndedIterator<decltype(it), const i32(&)[2]>);
+  static_assert(sus::iter::ExactSizeIterator<decltype(it), const i32(&)[2]>);
+  static_assert(sus::iter::TrustedLen<decltype(it)>);
+  EXPECT_EQ(it.exact_size_hint(), 4u);
+  {
+    const i32(&w)[2] = it.next().unwrap();
+    EXPECT_EQ(&w[0u], &v[0u]);
+    EXPECT_EQ(w[1u], 1);
+  }
+  {
+    const i32(&w)[2] = it.next_back().unwrap();
+    EXPECT_EQ(&w[0u], &v[3u]);
+    EXPECT_EQ(w[1u], 4);
+  }
+  EXPECT_EQ(it.exact_size_hint(), 2u);
+
+  // Differences between neighbours.
+  auto diffs = s.array_windows<2u>()
+                   .map([](const i32(&w)[2]) { return w[1u] - w[0u]; })
+                   .collect_vec();
+  EXPECT_EQ(diffs, sus::Vec<i32>(1, 1, 1, 1));
+}
+
 TEST(Slice, Windows) {
   auto v = sus::Vec<i32>(0, 1, 2, 3, 4, 5, 6, 7);
   sus::Slice<i32> s = v.as_slice();
@@ -0,0 +1,437 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <type_traits>
+
+#include "fmt/core.h"
+#include "sus/assertions/check.h"
+#include "sus/collections/collections.h"
+#include "sus/collections/iterators/slice_iter.h"
+#include "sus/collections/iterators/slot_map_iter.h"
+#include "sus/collections/iterators/vec_iter.h"
+#include "sus/collections/vec.h"
+#include "sus/construct/cast.h"
+#include "sus/fn/fn_concepts.h"
+#include "sus/iter/iterator_ref.h"
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/macros/lifetimebound.h"
+#include "sus/macros/no_unique_address.h"
+#include "sus/macros/pure.h"
+#include "sus/marker/empty.h"
+#include "sus/mem/clone.h"
+#include "sus/mem/move.h"
+#include "sus/mem/relocate.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+#include "sus/string/__private/any_formatter.h"
+#include "sus/string/__private/format_to_stream.h"
+
+namespace sus::collections {
+
+/// A collection of values which are each named by a
+/// [`SlotKey`]($sus::collections::SlotKey) handle, that is made when the value
+/// is inserted.
+///
+/// Looking up a value by its key is an index into an array, with no hashing
+/// and no pointer chasing, and inserting and removing values are constant
+/// time. This makes a `SlotMap` a good fit for tables of objects which refer
+/// to each other, such as entities or connections, in place of a
+/// `HashMap<u64, Box<T>>`.
+///
+/// The values are kept together in a dense array, in no particular order, so
+/// iterating over them visits contiguous memory. Removing a value moves the
+/// last value in the array into its place. The keys refer to a separate array
+/// of slots, which holds the position of each value in the dense array, and
+/// vacant slots form a free list that is reused by later insertions.
+///
+/// Each slot has a generation, which changes whenever its value is removed.
+/// A key holds the generation of its slot, so a key to a removed value does not
+/// find the value which later reuses the slot. A slot's generation is a `u32`,
+/// which wraps around after a slot has been reused 2^31 times.
+///
+/// References to the values are invalidated by inserting or removing values,
+/// but the keys remain valid until their own value is removed.
+///
+/// Like `Vec`, the `SlotMap` tracks its iterators, and will panic if values
+/// are inserted or removed while any of them are alive.
+template <class T>
+class SlotMap final {
+  static_assert(!std::is_reference_v<T>,
+                "SlotMap must hold value types. Use pointers instead of "
+                "references.");
+  static_assert(!std::is_const_v<T>,
+                "`SlotMap<const T>` should be written `const SlotMap<T>`, as "
+                "const applies transitively.");
+
+ public:
+  /// Constructs an empty `SlotMap`.
+  ///
+  /// The `SlotMap` will not allocate until values are inserted.
+  ///
+  /// This constructor also satisfies `sus::construct::Default`.
+  explicit constexpr SlotMap() noexcept
+      : iter_refs_(::sus::iter::IterRefCounter::for_owner()) {}
+
+  /// Constructs an empty `SlotMap`.
+  ///
+  /// This constructor is implicit so that using the [`EmptyMarker`](
+  /// $sus::marker::EmptyMarker) allows the caller to avoid spelling out the
+  /// full type.
+  /// #[doc.overloads=empty]
+  constexpr SlotMap(::sus::marker::EmptyMarker) noexcept : SlotMap() {}
+
+  /// Creates an empty `SlotMap` which can hold at least `capacity` values
+  /// without reallocating.
+  ///
+  /// # Panics
+  /// Panics if the capacity exceeds `isize::MAX` bytes.
+  _sus_pure static constexpr SlotMap with_capacity(usize capacity) noexcept {
+    auto m = SlotMap();
+    m.reserve(capacity);
+    return m;
+  }
+
+  /// Satisifes the [`Move`]($sus::mem::Move) concept.
+  /// #[doc.overloads=slotmap.move]
+  constexpr SlotMap(SlotMap&& o) noexcept
+      : iter_refs_(o.iter_refs_.take_for_owner()),
+        values_(::sus::move(o.values_)),
+        value_slots_(::sus::move(o.value_slots_)),
+        slots_(::sus::move(o.slots_)),
+        free_head_(::sus::mem::replace(o.free_head_, kNoFreeSlot)) {
+    sus_check(!has_iterators());
+  }
+  /// Satisifes the [`Move`]($sus::mem::Move) concept.
+  /// #[doc.overloads=slotmap.move]
+  constexpr SlotMap& operator=(SlotMap&& o) noexcept {
+    sus_check(!has_iterators());
+    sus_check(!o.has_iterators());
+    iter_refs_ = o.iter_refs_.take_for_owner();
+    values_ = ::sus::move(o.values_);
+    value_slots_ = ::sus::move(o.value_slots_);
+    slots_ = ::sus::move(o.slots_);
+    free_head_ = ::sus::mem::replace(o.free_head_, kNoFreeSlot);
+    return *this;
+  }
+
+  /// Satisfies the [`Clone`]($sus::mem::Clone) concept.
+  ///
+  /// The keys of the `SlotMap` also refer to the same values in the clone.
+  constexpr SlotMap clone() const& noexcept
+    requires(::sus::mem::Clone<T>)
+  {
+    auto m = SlotMap();
+    m.values_ = ::sus::clone(values_);
+    m.value_slots_ = ::sus::clone(value_slots_);
+    m.slots_ = ::sus::clone(slots_);
+    m.free_head_ = free_head_;
+    return m;
+  }
+
+  constexpr ~SlotMap() = default;
+
+  /// Returns the number of values in the `SlotMap`.
+  _sus_pure constexpr usize len() const& noexcept { return values_.len(); }
+
+  /// Returns `true` if the `SlotMap` holds no values.
+  _sus_pure constexpr bool is_empty() const& noexcept {
+    return values_.is_empty();
+  }
+
+  /// Returns the number of values the `SlotMap` can hold without
+  /// reallocating.
+  _sus_pure constexpr usize capacity() const& noexcept {
+    return values_.capacity();
+  }
+
+  /// Reserves capacity for at least `additional` more values to be inserted.
+  ///
+  /// # Panics
+  /// Panics if the new capacity exceeds `isize::MAX` bytes.
+  constexpr void reserve(usize additional) noexcept {
+    sus_check(!has_iterators());
+    values_.reserve(additional);
+    value_slots_.reserve(additional);
+    // Vacant slots are reused before new slots are added.
+    const usize vacant = slots_.len() - values_.len();
+    if (additional > vacant) slots_.reserve(additional - vacant);
+  }
+
+  /// Inserts a value, and returns the key which refers to it.
+  ///
+  /// # Panics
+  /// Panics if the `SlotMap` would hold more than `u32::MAX - 1` slots, or if
+  /// the new capacity exceeds `isize::MAX` bytes.
+  constexpr SlotKey insert(T value) noexcept
+    requires(::sus::mem::Move<T>)
+  {
+    sus_check(!has_iterators());
+    const SlotKey key = claim_slot();
+    values_.push(::sus::move(value));
+    value_slots_.push(key.index_);
+    return key;
+  }
+
+  /// Inserts a value made by calling `f` with the key which will refer to it,
+  /// and returns the key.
+  ///
+  /// This allows a value to hold its own key.
+  ///
+  /// # Panics
+  /// Panics if the `SlotMap` would hold more than `u32::MAX - 1` slots, or if
+  /// the new capacity exceeds `isize::MAX` bytes.
+  constexpr SlotKey insert_with_key(
+      ::sus::fn::FnOnce<T(SlotKey)> auto f) noexcept
+    requires(::sus::mem::Move<T>)
+  {
+    sus_check(!has_iterators());
+    const SlotKey key = claim_slot();
+    values_.push(::sus::fn::call_once(::sus::move(f), key));
+    value_slots_.push(key.index_);
+    return key;
+  }
+
+  /// Removes the value referred to by `key` and returns it, or returns `None`
+  /// if there is no such value.
+  constexpr Option<T> remove(SlotKey key) noexcept {
+    sus_check(!has_iterators());
+    if (!contains_key(key)) return Option<T>();
+    __private::SlotMapSlot& slot = slots_[usize::from(key.index_)];
+    const usize dense = usize::from(slot.index);
+    slot.generation = slot.generation.wrapping_add(1u);
+    slot.index = free_head_;
+    free_head_ = key.index_;
+    // Move the last value into the hole, and point its slot at it.
+    auto o = Option<T>(values_.swap_remove(dense));
+    value_slots_.swap_remove(dense);
+    if (dense < values_.len()) {
+      slots_[usize::from(value_slots_[dense])].index = ::sus::cast<u32>(dense);
+    }
+    return o;
+  }
+
+  /// Removes every value for which `pred` returns `false`.
+  ///
+  /// The predicate is called with the key and a mutable reference to each
+  /// value.
+  constexpr void retain(
+      ::sus::fn::FnMut<bool(SlotKey, T&)> auto pred) noexcept {
+    sus_check(!has_iterators());
+    usize i = 0u;
+    while (i < values_.len()) {
+      const SlotKey key = key_at(i);
+      if (::sus::fn::call_mut(pred, key, values_[i])) {
+        i += 1u;
+      } else {
+        // This moves the last value to `i`, which is visited next.
+        (void)remove(key);
+      }
+    }
+  }
+
+  /// Removes all values from the `SlotMap`.
+  ///
+  /// All keys are invalidated. Note that this method has no effect on the
+  /// allocated capacity.
+  constexpr void clear() noexcept {
+    sus_check(!has_iterators());
+    for (const u32& slot_index : value_slots_.iter()) {
+      __private::SlotMapSlot& slot = slots_[usize::from(slot_index)];
+      slot.generation = slot.generation.wrapping_add(1u);
+      slot.index = free_head_;
+      free_head_ = slot_index;
+    }
+    values_.clear();
+    value_slots_.clear();
+  }
+
+  /// Returns whether `key` refers to a value in the `SlotMap`.
+  _sus_pure constexpr bool contains_key(SlotKey key) const& noexcept {
+    // A key's generation is always odd, which is only true of a slot while it
+    // holds a value.
+    return usize::from(key.index_) < slots_.len() &&
+           slots_[usize::from(key.index_)].generation == key.generation_;
+  }
+
+  /// Returns a const reference to the value referred to by `key`, or `None` if
+  /// there is no such value.
+  _sus_pure constexpr Option<const T&> get(SlotKey key) const& noexcept {
+    if (!contains_key(key)) return Option<const T&>();
+    return Option<const T&>(values_[dense_index(key)]);
+  }
+  constexpr Option<const T&> get(SlotKey key) && = delete;
+
+  /// Returns a mutable reference to the value referred to by `key`, or `None`
+  /// if there is no such value.
+  _sus_pure constexpr Option<T&> get_mut(SlotKey key) & noexcept {
+    if (!contains_key(key)) return Option<T&>();
+    return Option<T&>(values_[dense_index(key)]);
+  }
+
+  /// Returns a const reference to the value referred to by `key`.
+  ///
+  /// # Panics
+  /// Panics if there is no value referred to by `key`.
+  _sus_pure constexpr const T& operator[](SlotKey key) const& noexcept {
+    sus_check_with_message(contains_key(key), "invalid SlotKey");
+    return values_[dense_index(key)];
+  }
+  constexpr const T& operator[](SlotKey key) && = delete;
+
+  /// Returns a mutable reference to the value referred to by `key`.
+  ///
+  /// # Panics
+  /// Panics if there is no value referred to by `key`.
+  _sus_pure constexpr T& operator[](SlotKey key) & noexcept {
+    sus_check_with_message(contains_key(key), "invalid SlotKey");
+    return values_[dense_index(key)];
+  }
+
+  /// Returns an iterator over the keys and const references to the values.
+  ///
+  /// The values are visited in the order they are stored in memory.
+  constexpr SlotMapIter<const T&> iter() const& noexcept sus_lifetimebound {
+    return SlotMapIter<const T&>(iter_refs_.to_iter_from_owner(),
+                                 values_.as_ptr(), value_slots_.as_ptr(),
+                                 slots_.as_ptr(), values_.len());
+  }
+  constexpr SlotMapIter<const T&> iter() && = delete;
+
+  /// Returns an iterator over the keys and mutable references to the values.
+  ///
+  /// The values are visited in the order they are stored in memory.
+  constexpr SlotMapIter<T&> iter_mut() & noexcept sus_lifetimebound {
+    return SlotMapIter<T&>(iter_refs_.to_iter_from_owner(),
+                           values_.as_mut_ptr(), value_slots_.as_ptr(),
+                           slots_.as_ptr(), values_.len());
+  }
+
+  /// Returns an iterator over const references to the values, without their
+  /// keys.
+  ///
+  /// The values are visited in the order they are stored in memory.
+  constexpr SliceIter<const T&> values() const& noexcept sus_lifetimebound {
+    return values_.iter();
+  }
+  constexpr SliceIter<const T&> values() && = delete;
+
+  /// Returns an iterator over mutable references to the values, without
+  /// their keys.
+  ///
+  /// The values are visited in the order they are stored in memory.
+  constexpr SliceIterMut<T&> values_mut() & noexcept sus_lifetimebound {
+    return values_.iter_mut();
+  }
+
+  /// Consumes the `SlotMap` into an iterator over its values.
+  constexpr VecIntoIter<T> into_values() && noexcept {
+    sus_check(!has_iterators());
+    return ::sus::move(values_).into_iter();
+  }
+
+  // Stream support.
+  _sus_format_to_stream(SlotMap);
+
+ private:
+  /// The end of the free list.
+  static constexpr u32 kNoFreeSlot = u32::MAX;
+
+  /// Takes a slot from the free list, or adds a new slot, and points it at the
+  /// end of the dense array where the new value will be pushed.
+  constexpr SlotKey claim_slot() noexcept {
+    const u32 dense = ::sus::cast<u32>(values_.len());
+    if (free_head_ != kNoFreeSlot) {
+      const u32 index = free_head_;
+      __private::SlotMapSlot& slot = slots_[usize::from(index)];
+      free_head_ = slot.index;
+      slot.generation = slot.generation.wrapping_add(1u);
+      slot.index = dense;
+      return SlotKey(index, slot.generation);
+    }
+    // The last index is kept free so that a null key never refers to a slot.
+    sus_check_with_message(slots_.len() < usize::from(kNoFreeSlot),
+                           "SlotMap capacity overflow");
+    const u32 index = ::sus::cast<u32>(slots_.len());
+    slots_.push(__private::SlotMapSlot(1u, dense));
+    return SlotKey(index, 1u);
+  }
+
+  /// The position in the dense array of the value referred to by `key`, which
+  /// must be valid.
+  constexpr usize dense_index(SlotKey key) const noexcept {
+    return usize::from(slots_[usize::from(key.index_)].index);
+  }
+
+  /// The key for the value at position `i` in the dense array.
+  constexpr SlotKey key_at(usize i) const noexcept {
+    const u32 index = value_slots_[i];
+    return SlotKey(index, slots_[usize::from(index)].generation);
+  }
+
+  constexpr bool has_iterators() const noexcept {
+    return iter_refs_.count_from_owner() != 0u;
+  }
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRefCounter iter_refs_;
+  /// The values, in no particular order.
+  Vec<T> values_;
+  /// The index of the slot for each value in `values_`.
+  Vec<u32> value_slots_;
+  Vec<__private::SlotMapSlot> slots_;
+  /// The first vacant slot, which holds the index of the next one.
+  u32 free_head_ = kNoFreeSlot;
+
+  sus_class_trivially_relocatable_if_types(
+      ::sus::marker::unsafe_fn, decltype(iter_refs_), decltype(values_),
+      decltype(value_slots_), decltype(slots_), decltype(free_head_));
+};
+
+}  // namespace sus::collections
+
+// fmt support.
+template <class T, class Char>
+struct fmt::formatter<::sus::collections::SlotMap<T>, Char> {
+  template <class ParseContext>
+  constexpr auto parse(ParseContext& ctx) {
+    // The format spec applies to the values, as with a `HashMap`.
+    return underlying_value_.parse(ctx);
+  }
+
+  template <class FormatContext>
+  constexpr auto format(const ::sus::collections::SlotMap<T>& map,
+                        FormatContext& ctx) const {
+    auto out = ctx.out();
+    out = fmt::format_to(out, "{{");
+    bool first = true;
+    for (auto&& [key, value] : map.iter()) {
+      if (!first) out = fmt::format_to(out, ", ");
+      first = false;
+      out = fmt::format_to(out, "{}: ", key);
+      ctx.advance_to(out);
+      out = underlying_value_.format(value, ctx);
+    }
+    return fmt::format_to(out, "}}");
+  }
+
+ private:
+  ::sus::string::__private::AnyFormatter<T, Char> underlying_value_;
+};
+
+// Promote SlotMap and SlotKey into the `sus` namespace.
+namespace sus {
+using ::sus::collections::SlotKey;
+using ::sus::collections::SlotMap;
+}  // namespace sus
@@ -0,0 +1,367 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/collections/slot_map.h"
+
+#include <sstream>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/collections/hash_map.h"
+#include "sus/collections/vec.h"
+#include "sus/iter/iterator.h"
+#include "sus/mem/move.h"
+#include "sus/ops/range.h"
+#include "sus/prelude.h"
+#include "sus/test/counted.h"
+#include "sus/test/ensure_use.h"
+
+namespace {
+
+using sus::collections::SlotKey;
+using sus::collections::SlotMap;
+using sus::test::Counted;
+using sus::test::ensure_use;
+
+static_assert(sus::construct::Default<SlotMap<i32>>);
+static_assert(sus::mem::Move<SlotMap<i32>>);
+static_assert(sus::mem::Clone<SlotMap<i32>>);
+static_assert(sus::construct::Default<SlotKey>);
+static_assert(sus::mem::Copy<SlotKey>);
+static_assert(sus::mem::TriviallyRelocatable<SlotKey>);
+static_assert(sus::cmp::Eq<SlotKey>);
+static_assert(sus::hash::Hash<SlotKey>);
+static_assert(sizeof(SlotKey) == 8u);
+
+/// Collects the values of the map, sorted, to compare without depending on
+/// the order they are stored in.
+sus::Vec<i32> sorted_values(const SlotMap<i32>& m) {
+  auto v = m.values().cloned().collect<sus::Vec<i32>>();
+  v.sort();
+  return v;
+}
+
+TEST(SlotMap, Default) {
+  auto m = SlotMap<i32>();
+  EXPECT_EQ(m.len(), 0u);
+  EXPECT_TRUE(m.is_empty());
+  EXPECT_EQ(m.capacity(), 0u);
+  EXPECT_EQ(m.get(SlotKey()), sus::None);
+
+  SlotMap<i32> e = sus::empty;
+  EXPECT_TRUE(e.is_empty());
+
+  auto c = SlotMap<i32>::with_capacity(5u);
+  EXPECT_TRUE(c.is_empty());
+  EXPECT_GE(c.capacity(), 5u);
+}
+
+TEST(SlotMap, InsertGet) {
+  auto m = SlotMap<i32>();
+  const SlotKey a = m.insert(1);
+  const SlotKey b = m.insert(2);
+  const SlotKey c = m.insert(3);
+  EXPECT_EQ(m.len(), 3u);
+  EXPECT_NE(a, b);
+  EXPECT_NE(b, c);
+  EXPECT_EQ(m.get(a).copied(), sus::some(1));
+  EXPECT_EQ(m.get(b).copied(), sus::some(2));
+  EXPECT_EQ(m[c], 3);
+  EXPECT_TRUE(m.contains_key(a));
+
+  m.get_mut(b).unwrap() = 20;
+  m[c] += 10;
+  EXPECT_EQ(m[b], 20);
+  EXPECT_EQ(m[c], 13);
+}
+
+TEST(SlotMap, NullKey) {
+  const auto null = SlotKey();
+  EXPECT_TRUE(null.is_null());
+  auto m = SlotMap<i32>();
+  const SlotKey k = m.insert(1);
+  EXPECT_FALSE(k.is_null());
+  EXPECT_FALSE(m.contains_key(null));
+  EXPECT_EQ(m.get(null), sus::None);
+  EXPECT_EQ(m.get_mut(null), sus::None);
+  EXPECT_EQ(m.remove(null), sus::None);
+}
+
+TEST(SlotMap, Remove) {
+  auto m = SlotMap<i32>();
+  const SlotKey a = m.insert(1);
+  const SlotKey b = m.insert(2);
+  const SlotKey c = m.insert(3);
+
+  // Removing from the front moves the last value into its place.
+  EXPECT_EQ(m.remove(a), sus::some(1));
+  EXPECT_EQ(m.len(), 2u);
+  EXPECT_FALSE(m.contains_key(a));
+  EXPECT_EQ(m.get(a), sus::None);
+  EXPECT_EQ(m.remove(a), sus::None);
+  EXPECT_EQ(m[b], 2);
+  EXPECT_EQ(m[c], 3);
+  EXPECT_EQ(m.values().cloned().collect<sus::Vec<i32>>(),
+            sus::Vec<i32>(3, 2));
+
+  EXPECT_EQ(m.remove(c), sus::some(3));
+  EXPECT_EQ(m.remove(b), sus::some(2));
+  EXPECT_TRUE(m.is_empty());
+}
+
+TEST(SlotMap, StaleKeyAfterReuse) {
+  auto m = SlotMap<i32>();
+  const SlotKey a = m.insert(1);
+  EXPECT_EQ(m.remove(a), sus::some(1));
+  // The slot is reused, under a new generation.
+  const SlotKey b = m.insert(2);
+  EXPECT_EQ(b.index(), a.index());
+  EXPECT_NE(b.generation(), a.generation());
+  EXPECT_NE(a, b);
+  EXPECT_EQ(m.get(a), sus::None);
+  EXPECT_EQ(m.remove(a), sus::None);
+  EXPECT_EQ(m.get(b).copied(), sus::some(2));
+}
+
+TEST(SlotMap, FreeListOrder) {
+  auto m = SlotMap<i32>();
+  auto keys = sus::Vec<SlotKey>();
+  for (i32 i : sus::ops::range(0_i32, 5_i32)) keys.push(m.insert(i));
+  EXPECT_EQ(m.remove(keys[1u]), sus::some(1));
+  EXPECT_EQ(m.remove(keys[3u]), sus::some(3));
+  // The most recently freed slot is reused first, and no new slots are made
+  // while there are vacant ones.
+  EXPECT_EQ(m.insert(10).index(), keys[3u].index());
+  EXPECT_EQ(m.insert(11).index(), keys[1u].index());
+  EXPECT_EQ(m.insert(12).index(), 5u);
+  EXPECT_EQ(sorted_values(m), sus::Vec<i32>(0, 2, 4, 10, 11, 12));
+}
+
+TEST(SlotMap, ManyInsertRemove) {
+  auto m = SlotMap<i32>();
+  auto keys = sus::Vec<SlotKey>();
+  for (i32 i : sus::ops::range(0_i32, 100_i32)) keys.push(m.insert(i));
+  for (usize i : sus::ops::range(0_usize, 100_usize)) {
+    if (i % 3u != 0u) {
+      EXPECT_TRUE(m.remove(keys[i]).is_some());
+    }
+  }
+  EXPECT_EQ(m.len(), 34u);
+  for (usize i : sus::ops::range(0_usize, 100_usize)) {
+    if (i % 3u == 0u)
+      EXPECT_EQ(m.get(keys[i]).copied(), sus::some(sus::cast<i32>(i)));
+    else
+      EXPECT_EQ(m.get(keys[i]), sus::None);
+  }
+  // Every key found by iteration refers to its own value.
+  for (auto&& [key, value] : m.iter()) EXPECT_EQ(m[key], value);
+}
+
+TEST(SlotMap, InsertWithKey) {
+  struct Node {
+    SlotKey self;
+    i32 value;
+  };
+  auto m = SlotMap<Node>();
+  const SlotKey a = m.insert_with_key([](SlotKey k) { return Node(k, 1); });
+  const SlotKey b = m.insert_with_key([](SlotKey k) { return Node(k, 2); });
+  EXPECT_EQ(m[a].self, a);
+  EXPECT_EQ(m[b].self, b);
+  EXPECT_EQ(m[b].value, 2);
+}
+
+TEST(SlotMap, Iter) {
+  auto m = SlotMap<i32>();
+  const SlotKey a = m.insert(1);
+  const SlotKey b = m.insert(2);
+  const SlotKey c = m.insert(3);
+  (void)m.remove(a);
+
+  auto it = m.iter();
+  EXPECT_EQ(it.exact_size_hint(), 2u);
+  auto first = it.next().unwrap();
+  EXPECT_EQ(first.at<0>(), c);
+  EXPECT_EQ(first.at<1>(), 3);
+  auto last = it.next_back().unwrap();
+  EXPECT_EQ(last.at<0>(), b);
+  EXPECT_EQ(last.at<1>(), 2);
+  EXPECT_EQ(it.next(), sus::None);
+
+  for (auto&& [key, value] : m.iter_mut()) value *= 10;
+  EXPECT_EQ(m[b], 20);
+  EXPECT_EQ(m[c], 30);
+  for (i32& v : m.values_mut()) v += 1;
+  EXPECT_EQ(sorted_values(m), sus::Vec<i32>(21, 31));
+
+  const auto empty = SlotMap<i32>();
+  EXPECT_EQ(empty.iter().next(), sus::None);
+}
+
+TEST(SlotMap, Retain) {
+  auto m = SlotMap<i32>();
+  auto keys = sus::Vec<SlotKey>();
+  for (i32 i : sus::ops::range(0_i32, 10_i32)) keys.push(m.insert(i));
+  usize calls = 0u;
+  m.retain([&](SlotKey k, i32& v) {
+    calls += 1u;
+    EXPECT_EQ(k, keys[sus::cast<usize>(v)]);
+    return v % 2 == 0;
+  });
+  EXPECT_EQ(calls, 10u);
+  EXPECT_EQ(sorted_values(m), sus::Vec<i32>(0, 2, 4, 6, 8));
+  EXPECT_EQ(m.get(keys[1u]), sus::None);
+  EXPECT_EQ(m.get(keys[8u]).copied(), sus::some(8));
+}
+
+TEST(SlotMap, Clear) {
+  auto m = SlotMap<i32>();
+  const SlotKey a = m.insert(1);
+  const SlotKey b = m.insert(2);
+  m.clear();
+  EXPECT_TRUE(m.is_empty());
+  EXPECT_EQ(m.get(a), sus::None);
+  EXPECT_EQ(m.get(b), sus::None);
+  // The vacant slots are reused.
+  const SlotKey c = m.insert(3);
+  const SlotKey d = m.insert(4);
+  const SlotKey e = m.insert(5);
+  EXPECT_LT(c.index(), 2u);
+  EXPECT_LT(d.index(), 2u);
+  EXPECT_EQ(e.index(), 2u);
+  EXPECT_EQ(m.get(a), sus::None);
+  EXPECT_EQ(m[c], 3);
+}
+
+TEST(SlotMap, CloneMove) {
+  auto m = SlotMap<i32>();
+  const SlotKey a = m.insert(1);
+  const SlotKey b = m.insert(2);
+  (void)m.remove(a);
+
+  auto c = sus::clone(m);
+  EXPECT_EQ(c[b], 2);
+  EXPECT_EQ(c.get(a), sus::None);
+  // The clone reuses the same free slots.
+  EXPECT_EQ(c.insert(3).index(), a.index());
+
+  auto d = sus::move(m);
+  EXPECT_EQ(d[b], 2);
+  m = sus::move(d);
+  EXPECT_EQ(m[b], 2);
+  EXPECT_EQ(m.insert(3).index(), a.index());
+}
+
+TEST(SlotMap, IntoValues) {
+  auto m = SlotMap<i32>();
+  (void)m.insert(1);
+  (void)m.remove(m.insert(2));
+  (void)m.insert(3);
+  EXPECT_EQ(sus::move(m).into_values().collect<sus::Vec<i32>>(),
+            sus::Vec<i32>(1, 3));
+}
+
+TEST(SlotMap, Drops) {
+  Counted::alive = 0;
+  {
+    auto m = SlotMap<Counted>();
+    auto keys = sus::Vec<SlotKey>();
+    for (i32 i : sus::ops::range(0_i32, 10_i32))
+      keys.push(m.insert(Counted(i)));
+    EXPECT_EQ(Counted::alive, 10);
+    EXPECT_EQ(m.remove(keys[0u]).unwrap().v, 0);
+    EXPECT_EQ(Counted::alive, 9);
+    m.retain([](SlotKey, Counted& c) { return c.v < 5; });
+    EXPECT_EQ(Counted::alive, 4);
+    EXPECT_EQ(m[keys[4u]].v, 4);
+    m.clear();
+    EXPECT_EQ(Counted::alive, 0);
+    (void)m.insert(Counted(1));
+    (void)m.insert(Counted(2));
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(SlotMap, KeyInHashMap) {
+  auto m = SlotMap<i32>();
+  auto names = sus::HashMap<SlotKey, i32>();
+  const SlotKey a = m.insert(1);
+  const SlotKey b = m.insert(2);
+  names.insert(a, 10);
+  names.insert(b, 20);
+  EXPECT_EQ(names.get(a).copied(), sus::some(10));
+  EXPECT_EQ(names.get(b).copied(), sus::some(20));
+}
+
+TEST(SlotMapDeathTest, InvalidKey) {
+  auto m = SlotMap<i32>();
+  const SlotKey a = m.insert(1);
+  (void)m.remove(a);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(
+      {
+        i32 v = m[a];
+        ensure_use(&v);
+      },
+      "");
+  EXPECT_DEATH(
+      {
+        i32 v = m[SlotKey()];
+        ensure_use(&v);
+      },
+      "");
+#endif
+}
+
+TEST(SlotMapDeathTest, InsertWhileIterating) {
+#if !defined(SUS_ITERATOR_INVALIDATION) || SUS_ITERATOR_INVALIDATION
+  auto m = SlotMap<i32>();
+  const SlotKey a = m.insert(1);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(
+      {
+        auto it = m.iter();
+        (void)m.insert(2);
+        ensure_use(&it);
+      },
+      "");
+  EXPECT_DEATH(
+      {
+        auto it = m.iter();
+        (void)m.remove(a);
+        ensure_use(&it);
+      },
+      "");
+#endif
+#endif
+}
+
+TEST(SlotMap, fmt) {
+  auto m = SlotMap<i32>();
+  EXPECT_EQ(fmt::format("{}", m), "{}");
+  (void)m.insert(1);
+  const SlotKey b = m.insert(2);
+  EXPECT_EQ(fmt::format("{}", m), "{0v1: 1, 1v1: 2}");
+  EXPECT_EQ(fmt::format("{:02}", m), "{0v1: 01, 1v1: 02}");
+  EXPECT_EQ(fmt::format("{}", b), "1v1");
+  EXPECT_EQ(fmt::format("{}", SlotKey()), "null");
+}
+
+TEST(SlotMap, Stream) {
+  auto m = SlotMap<i32>();
+  const SlotKey a = m.insert(7);
+  std::stringstream ss;
+  ss << m << " " << a;
+  EXPECT_EQ(ss.str(), "{0v1: 7} 0v1");
+}
+
+}  // namespace
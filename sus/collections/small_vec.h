@@ -0,0 +1,774 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <concepts>
+#include <memory>
+
+#include "fmt/core.h"
+#include "sus/assertions/check.h"
+#include "sus/assertions/debug_check.h"
+#include "sus/cmp/ord.h"
+#include "sus/collections/collections.h"
+#include "sus/collections/concat.h"
+#include "sus/collections/iterators/chunks.h"
+#include "sus/collections/iterators/slice_iter.h"
+#include "sus/collections/slice.h"
+#include "sus/collections/vec.h"
+#include "sus/fn/fn_concepts.h"
+#include "sus/iter/adaptors/by_ref.h"
+#include "sus/iter/adaptors/enumerate.h"
+#include "sus/iter/adaptors/take.h"
+#include "sus/iter/from_iterator.h"
+#include "sus/iter/into_iterator.h"
+#include "sus/iter/iterator_loop.h"
+#include "sus/iter/iterator_ref.h"
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/macros/lifetimebound.h"
+#include "sus/marker/empty.h"
+#include "sus/marker/unsafe.h"
+#include "sus/mem/clone.h"
+#include "sus/mem/move.h"
+#include "sus/mem/relocate.h"
+#include "sus/mem/replace.h"
+#include "sus/mem/size_of.h"
+#include "sus/num/cast.h"
+#include "sus/num/integer_concepts.h"
+#include "sus/num/signed_integer.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/ops/range.h"
+#include "sus/option/option.h"
+#include "sus/ptr/copy.h"
+#include "sus/string/__private/any_formatter.h"
+#include "sus/string/__private/format_to_stream.h"
+
+namespace sus::collections {
+
+/// A resizeable contiguous buffer of type `T` which stores up to `N` elements
+/// inline, without a heap allocation.
+///
+/// A `SmallVec` behaves like a [`Vec`]($sus::collections::Vec), and provides
+/// the same methods as a [`SliceMut`]($sus::collections::SliceMut) over its
+/// elements. Its first `N` elements are stored inside the `SmallVec` object
+/// itself, and only when it grows beyond `N` elements does it move them to a
+/// heap allocation. This avoids allocating for collections that are usually
+/// small, at the cost of a larger object.
+///
+/// Once a `SmallVec` has moved its elements to the heap, it is said to have
+/// "spilled", and it stays on the heap until it is destroyed.
+///
+/// Moving a `SmallVec` that has not spilled moves each of its elements, much
+/// like moving an [`Array`]($sus::collections::Array), rather than moving a
+/// single pointer. For the same reason, a `SmallVec` is not trivially
+/// relocatable.
+///
+/// SmallVec requires items that are not references or const, for the same
+/// reasons as [`Vec`]($sus::collections::Vec).
+///
+/// # Examples
+/// ```
+/// auto v = sus::SmallVec<i32, 4>(1, 2, 3);
+/// sus_check(!v.spilled());
+/// v.push(4);
+/// v.push(5);
+/// sus_check(v.spilled());
+/// sus_check(v.len() == 5u);
+/// ```
+template <class T, size_t N>
+class SmallVec final {
+  static_assert(!std::is_reference_v<T>,
+                "SmallVec<T&, N> is invalid as SmallVec must hold value types. "
+                "Use SmallVec<T*, N> instead.");
+  static_assert(!std::is_const_v<T>,
+                "`SmallVec<const T, N>` should be written `const "
+                "SmallVec<T, N>`, as const applies transitively.");
+  static_assert(N > 0u,
+                "SmallVec must have inline capacity, use Vec<T> instead.");
+
+ public:
+  /// Constructs an empty `SmallVec`.
+  ///
+  /// This constructor is implicit so that using the [`EmptyMarker`](
+  /// $sus::marker::EmptyMarker) allows the caller to avoid spelling out the
+  /// full `SmallVec` type.
+  /// #[doc.overloads=empty]
+  constexpr SmallVec(::sus::marker::EmptyMarker) noexcept : SmallVec() {}
+
+  /// Constructs a `SmallVec`, which constructs objects of type `T` from the
+  /// given values.
+  ///
+  /// This constructor also satisfies `sus::construct::Default` by accepting no
+  /// arguments to create an empty `SmallVec`.
+  ///
+  /// If more than `N` values are given, the `SmallVec` allocates storage on
+  /// the heap for them.
+  template <std::convertible_to<T>... Ts>
+  explicit constexpr SmallVec(Ts&&... values) noexcept
+      : capacity_(N),
+        iter_refs_(::sus::iter::IterRefCounter::for_owner()),
+        data_(inline_),
+        len_(0u) {
+    if constexpr (sizeof...(values) > N) {
+      data_ = alloc_heap(sizeof...(values));
+      capacity_ = sizeof...(values);
+    }
+    (..., push_with_capacity_internal(::sus::forward<Ts>(values)));
+  }
+
+  /// Creates a `SmallVec` with at least the specified capacity.
+  ///
+  /// The `SmallVec` will be able to hold at least `capacity` elements without
+  /// reallocating. If `capacity` is at most `N`, it will not allocate.
+  ///
+  /// # Panics
+  /// Panics if the capacity exceeds `isize::MAX` bytes.
+  _sus_pure static constexpr SmallVec with_capacity(usize capacity) noexcept {
+    auto v = SmallVec();
+    v.reserve_exact(capacity);
+    return v;
+  }
+
+  /// Constructs a `SmallVec` by cloning elements out of a slice.
+  ///
+  /// Satisfies `sus::construct::From<Slice<T>>`
+  /// and `sus::construct::From<SliceMut<T>>`.
+  ///
+  /// #[doc.overloads=from.slice]
+  static constexpr SmallVec from(::sus::Slice<T> slice) noexcept
+    requires(sus::mem::Clone<T>)
+  {
+    auto v = SmallVec::with_capacity(slice.len());
+    for (const T& t : slice) v.push_with_capacity_internal(::sus::clone(t));
+    return v;
+  }
+  /// #[doc.overloads=from.slice]
+  static constexpr SmallVec from(::sus::SliceMut<T> slice) noexcept
+    requires(sus::mem::Clone<T>)
+  {
+    return from(slice.as_slice());
+  }
+
+  constexpr ~SmallVec() noexcept {
+    if (!is_moved_from()) free_storage();
+  }
+
+  /// Satisifes the [`Move`]($sus::mem::Move) concept.
+  ///
+  /// If `o` has not spilled to the heap, its elements are moved into the new
+  /// `SmallVec` one by one.
+  /// #[doc.overloads=smallvec.move]
+  constexpr SmallVec(SmallVec&& o) noexcept
+      : capacity_(o.capacity_),
+        iter_refs_(o.iter_refs_.take_for_owner()),
+        data_(inline_),
+        len_(o.len_) {
+    sus_check(!is_moved_from() && !has_iterators());
+    take_storage_from(o);
+  }
+  /// Satisifes the [`Move`]($sus::mem::Move) concept.
+  /// #[doc.overloads=smallvec.move]
+  constexpr SmallVec& operator=(SmallVec&& o) noexcept {
+    sus_check(!o.is_moved_from());
+    sus_check(!has_iterators());
+    sus_check(!o.has_iterators());
+    if (!is_moved_from()) free_storage();
+    capacity_ = o.capacity_;
+    iter_refs_ = o.iter_refs_.take_for_owner();
+    data_ = inline_;
+    len_ = o.len_;
+    take_storage_from(o);
+    return *this;
+  }
+
+  /// Satisfies the [`Clone`]($sus::mem::Clone) concept.
+  constexpr SmallVec clone() const& noexcept
+    requires(::sus::mem::Clone<T>)
+  {
+    sus_check(!is_moved_from());
+    return from(as_slice());
+  }
+
+  /// Returns true if the elements have been moved to the heap, because the
+  /// `SmallVec` grew beyond its inline capacity of `N` elements.
+  _sus_pure constexpr bool spilled() const& noexcept {
+    sus_check(!is_moved_from());
+    return is_spilled();
+  }
+
+  /// The number of elements that can be stored without a heap allocation.
+  _sus_pure static constexpr usize inline_capacity() noexcept { return N; }
+
+  /// Returns the number of elements there is space for without reallocating.
+  ///
+  /// This is `N` until the `SmallVec` has spilled to the heap.
+  _sus_pure constexpr usize capacity() const& noexcept {
+    sus_check(!is_moved_from());
+    return capacity_;
+  }
+
+  /// Clears the `SmallVec`, removing all values.
+  ///
+  /// Note that this method has no effect on the capacity, and a `SmallVec`
+  /// that has spilled stays on the heap.
+  constexpr void clear() noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    destroy_storage_objects();
+    len_ = 0u;
+  }
+
+  /// Extends the `SmallVec` with the contents of an iterator, copying from the
+  /// elements.
+  ///
+  /// Satisfies the [`Extend<const T&>`]($sus::iter::Extend) concept for
+  /// `SmallVec<T, N>`.
+  ///
+  /// #[doc.overloads=smallvec.extend.const]
+  constexpr void extend(sus::iter::IntoIterator<const T&> auto&& ii) noexcept
+    requires(sus::mem::Copy<T> &&  //
+             ::sus::mem::IsMoveRef<decltype(ii)>)
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+    // Prevent mutation from other callers inside this method.
+    sus::iter::IterRef ref = iter_refs_.to_iter_from_owner();
+
+    auto&& it = sus::move(ii).into_iter();
+    if constexpr (sus::iter::__private::ContiguousIterator<decltype(it)> &&
+                  sus::mem::TrivialCopy<T>) {
+      // The elements are copied out of the iterator's memory all at once.
+      extend_trivial_internal(it.contiguous_data(), it.exact_size_hint());
+      return;
+    }
+    reserve_internal(it.size_hint().lower);
+    for (const T& t : it) {
+      reserve_internal(1u);
+      push_with_capacity_internal(t);
+    }
+  }
+
+  /// Extends the `SmallVec` with the contents of an iterator.
+  ///
+  /// Satisfies the [`Extend<T>`]($sus::iter::Extend) concept for
+  /// `SmallVec<T, N>`.
+  ///
+  /// #[doc.overloads=smallvec.extend.val]
+  constexpr void extend(sus::iter::IntoIterator<T> auto&& ii) noexcept
+    requires(::sus::mem::IsMoveRef<decltype(ii)>)
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+    // Prevent mutation from other callers inside this method.
+    sus::iter::IterRef ref = iter_refs_.to_iter_from_owner();
+
+    auto&& it = sus::move(ii).into_iter();
+    if constexpr (sus::iter::__private::ContiguousIterator<decltype(it)> &&
+                  sus::mem::TrivialCopy<T>) {
+      // The elements are copied out of the iterator's memory all at once.
+      extend_trivial_internal(it.contiguous_data(), it.exact_size_hint());
+      return;
+    }
+    reserve_internal(it.size_hint().lower);
+    for (T&& t : it) {
+      reserve_internal(1u);
+      push_with_capacity_internal(::sus::move(t));
+    }
+  }
+
+  /// Extends the `SmallVec` by cloning the contents of a slice.
+  ///
+  /// If `T` is [`TrivialCopy`]($sus::mem::TrivialCopy), then the copy is done
+  /// by `memcpy`.
+  ///
+  /// # Panics
+  /// If the Slice is non-empty and points into the `SmallVec`, the function
+  /// will panic, as resizing the `SmallVec` would invalidate the Slice.
+  constexpr void extend_from_slice(::sus::collections::Slice<T> s) noexcept
+    requires(sus::mem::Clone<T>)
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+    if (s.is_empty()) return;
+    if constexpr (sus::mem::TrivialCopy<T>) {
+      extend_trivial_internal(s.as_ptr(), s.len());
+    } else {
+      const T* slice_ptr = s.as_ptr();
+      sus_check(!(slice_ptr >= data_ && slice_ptr <= data_ + len_));
+      reserve_internal(s.len());
+      for (const T& t : s) push_with_capacity_internal(::sus::clone(t));
+    }
+  }
+
+  /// Removes the last element from the `SmallVec` and returns it, or None if
+  /// it is empty.
+  constexpr Option<T> pop() noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    if (len_ > 0u) {
+      len_ -= 1u;
+      auto o = Option<T>(::sus::move(*(data_ + len_)));
+      if constexpr (!std::is_trivially_destructible_v<T>)
+        std::destroy_at(data_ + len_);
+      return o;
+    } else {
+      return Option<T>();
+    }
+  }
+
+  /// Appends an element to the back of the `SmallVec`.
+  ///
+  /// # Panics
+  ///
+  /// Panics if the new capacity exceeds [`isize::MAX`]($sus::num::isize::MAX)
+  /// bytes.
+  constexpr void push(T t) noexcept
+    requires(::sus::mem::Move<T>)
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+    reserve_internal(1_usize);
+    push_with_capacity_internal(::sus::move(t));
+  }
+
+  /// Constructs and appends an element to the back of the `SmallVec`.
+  ///
+  /// The parameters to `emplace()` are used to construct the element. Prefer
+  /// to use `push()` for most cases.
+  ///
+  /// # Panics
+  ///
+  /// Panics if the new capacity exceeds `isize::MAX` bytes.
+  template <class... Us>
+  constexpr void emplace(Us&&... args) noexcept
+    requires(::sus::mem::Move<T> &&
+             !(sizeof...(Us) == 1u &&
+               (... && std::same_as<std::decay_t<T>, std::decay_t<Us>>)))
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+    reserve_internal(1_usize);
+    std::construct_at(data_ + len_, ::sus::forward<Us>(args)...);
+    len_ += 1u;
+  }
+
+  /// Reserves capacity for at least `additional` more elements to be inserted
+  /// in the `SmallVec`. The collection may reserve more space to speculatively
+  /// avoid frequent reallocations.
+  ///
+  /// If the elements do not fit in the inline capacity, the `SmallVec` spills
+  /// to the heap.
+  ///
+  /// # Panics
+  /// Panics if the new capacity exceeds `isize::MAX` bytes.
+  constexpr void reserve(usize additional) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    reserve_internal(additional);
+  }
+
+  /// Reserves the minimum capacity for at least `additional` more elements to
+  /// be inserted in the `SmallVec`.
+  ///
+  /// # Panics
+  /// Panics if the new capacity exceeds `isize::MAX` bytes.
+  constexpr void reserve_exact(usize additional) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    const usize cap = len_ + additional;
+    if (cap > capacity_) grow_to_internal(cap);
+  }
+
+  /// Forces the length of the `SmallVec` to `new_len`.
+  ///
+  /// # Safety
+  /// * `new_len` must be less than or equal to `capacity()`.
+  /// * The elements at `old_len..new_len` must be constructed before or after
+  ///   the call.
+  /// * The elements at `new_len..old_len` must be destructed before or after
+  ///   the call.
+  constexpr void set_len(::sus::marker::UnsafeFnMarker,
+                         usize new_len) noexcept {
+    sus_check(!is_moved_from());
+    sus_debug_check(new_len <= capacity_);
+    len_ = new_len;
+  }
+
+  /// Shortens the `SmallVec`, keeping the first `len` elements and dropping
+  /// the rest.
+  ///
+  /// If `len` is greater than the current length, this has no effect.
+  constexpr void truncate(usize len) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    if (len > len_) return;
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (usize i = len_; i > len; i -= 1u) std::destroy_at(data_ + i - 1u);
+    }
+    len_ = len;
+  }
+
+  /// Consumes the `SmallVec` into a [`Vec`]($sus::collections::Vec) holding
+  /// the same elements.
+  constexpr Vec<T> into_vec() && noexcept
+    requires(::sus::mem::Move<T>)
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+    auto v = Vec<T>::with_capacity(len_);
+    // An empty `Vec` may not have an allocation to relocate into.
+    if (len_ > 0u) {
+      relocate_elements(data_, v.as_mut_ptr(), len_);
+      // SAFETY: The `len_` elements were just constructed in the `Vec`'s
+      // storage, which has capacity for them.
+      v.set_len(::sus::marker::unsafe_fn, len_);
+    }
+    // The elements were relocated out, so there is nothing left to destroy.
+    if (is_spilled()) free_heap(data_, capacity_);
+    capacity_ = kMovedFromCapacity;
+    len_ = kMovedFromLen;
+    return v;
+  }
+
+  /// Returns a [`Slice`]($sus::collections::Slice) that references all the
+  /// elements of the `SmallVec` as const references.
+  _sus_pure constexpr Slice<T> as_slice() const& noexcept sus_lifetimebound {
+    return *this;
+  }
+  constexpr Slice<T> as_slice() && = delete;
+
+  /// Returns a [`SliceMut`]($sus::collections::SliceMut) that references all
+  /// the elements of the `SmallVec` as mutable references.
+  _sus_pure constexpr SliceMut<T> as_mut_slice() & noexcept sus_lifetimebound {
+    return *this;
+  }
+
+  /// Satisfies the [`Eq<SmallVec<T, N>, SmallVec<U, M>>`]($sus::cmp::Eq)
+  /// concept.
+  ///
+  /// #[doc.overloads=smallvec.eq.smallvec]
+  template <class U, size_t M>
+    requires(::sus::cmp::Eq<T, U>)
+  friend constexpr bool operator==(const SmallVec& l,
+                                   const SmallVec<U, M>& r) noexcept {
+    return l.as_slice() == r.as_slice();
+  }
+
+  template <class U, size_t M>
+    requires(!::sus::cmp::Eq<T, U>)
+  friend constexpr bool operator==(const SmallVec& l,
+                                   const SmallVec<U, M>& r) = delete;
+
+  /// Satisfies the [`Eq<SmallVec<T, N>, Slice<U>>`]($sus::cmp::Eq) concept.
+  ///
+  /// #[doc.overloads=smallvec.eq.slice]
+  template <class U>
+    requires(::sus::cmp::Eq<T, U>)
+  friend constexpr bool operator==(const SmallVec& l,
+                                   const Slice<U>& r) noexcept {
+    return l.as_slice() == r;
+  }
+
+  /// Satisfies the [`Eq<SmallVec<T, N>, SliceMut<U>>`]($sus::cmp::Eq)
+  /// concept.
+  ///
+  /// #[doc.overloads=smallvec.eq.slicemut]
+  template <class U>
+    requires(::sus::cmp::Eq<T, U>)
+  friend constexpr bool operator==(const SmallVec& l,
+                                   const SliceMut<U>& r) noexcept {
+    return l.as_slice() == r.as_slice();
+  }
+
+  /// Returns a reference to the element at position `i` in the `SmallVec`.
+  ///
+  /// # Panics
+  /// If the index `i` is beyond the end of the `SmallVec`, the function will
+  /// panic.
+  /// #[doc.overloads=smallvec.index.usize]
+  _sus_pure constexpr const T& operator[](::sus::num::usize i) const& noexcept {
+    sus_check(i < len_);
+    return *(data_ + i);
+  }
+  /// #[doc.overloads=smallvec.index.usize]
+  constexpr const T& operator[](::sus::num::usize i) && = delete;
+
+  /// Returns a mutable reference to the element at position `i` in the
+  /// `SmallVec`.
+  ///
+  /// # Panics
+  /// If the index `i` is beyond the end of the `SmallVec`, the function will
+  /// panic.
+  /// #[doc.overloads=smallvec.index_mut.usize]
+  _sus_pure constexpr T& operator[](::sus::num::usize i) & noexcept {
+    sus_check(i < len_);
+    return *(data_ + i);
+  }
+
+  /// Returns a subslice which contains elements in `range`.
+  ///
+  /// # Panics
+  /// If the Range would otherwise contain an element that is out of bounds,
+  /// the function will panic.
+  /// #[doc.overloads=smallvec.index.range]
+  _sus_pure constexpr Slice<T> operator[](
+      const ::sus::ops::RangeBounds<::sus::num::usize> auto range)
+      const& noexcept {
+    return as_slice()[range];
+  }
+  /// #[doc.overloads=smallvec.index.range]
+  constexpr Slice<T> operator[](
+      const ::sus::ops::RangeBounds<::sus::num::usize> auto range) && = delete;
+
+  /// Returns a mutable subslice which contains elements in `range`.
+  ///
+  /// # Panics
+  /// If the Range would otherwise contain an element that is out of bounds,
+  /// the function will panic.
+  /// #[doc.overloads=smallvec.index_mut.range]
+  _sus_pure constexpr SliceMut<T> operator[](
+      const ::sus::ops::RangeBounds<::sus::num::usize> auto range) & noexcept {
+    return as_mut_slice()[range];
+  }
+
+  /// Converts to a [`Slice<T>`]($sus::collections::Slice). A `SmallVec` can be
+  /// used anywhere a [`Slice`]($sus::collections::Slice) is wanted.
+  _sus_pure constexpr operator Slice<T>() const& noexcept {
+    sus_check(!is_moved_from());
+    return Slice<T>::from_raw_collection(
+        ::sus::marker::unsafe_fn, iter_refs_.to_view_from_owner(), data_, len_);
+  }
+  _sus_pure constexpr operator Slice<T>() && = delete;
+  _sus_pure constexpr operator Slice<T>() & noexcept {
+    sus_check(!is_moved_from());
+    return Slice<T>::from_raw_collection(
+        ::sus::marker::unsafe_fn, iter_refs_.to_view_from_owner(), data_, len_);
+  }
+
+  /// Converts to a [`SliceMut<T>`]($sus::collections::SliceMut). A mutable
+  /// `SmallVec` can be used anywhere a
+  /// [`SliceMut`]($sus::collections::SliceMut) is wanted.
+  _sus_pure constexpr operator SliceMut<T>() & noexcept {
+    sus_check(!is_moved_from());
+    return SliceMut<T>::from_raw_collection_mut(
+        ::sus::marker::unsafe_fn, iter_refs_.to_view_from_owner(), data_, len_);
+  }
+
+  // Stream support.
+  _sus_format_to_stream(SmallVec);
+
+#define _ptr_expr data_
+#define _len_expr len_
+#define _iter_refs_expr iter_refs_.to_iter_from_owner()
+#define _iter_refs_view_expr iter_refs_.to_view_from_owner()
+#define _delete_rvalue true
+#include "__private/slice_methods.inc"
+#define _ptr_expr data_
+#define _len_expr len_
+#define _iter_refs_expr iter_refs_.to_iter_from_owner()
+#define _iter_refs_view_expr iter_refs_.to_view_from_owner()
+#define _delete_rvalue true
+#include "__private/slice_mut_methods.inc"
+
+ private:
+  /// Requires that there is capacity present for `t` already, and that
+  /// the `SmallVec` is in a valid state to mutate.
+  constexpr void push_with_capacity_internal(const T& t) noexcept {
+    std::construct_at(data_ + len_, t);
+    len_ += 1u;
+  }
+  constexpr void push_with_capacity_internal(T&& t) noexcept {
+    std::construct_at(data_ + len_, ::sus::move(t));
+    len_ += 1u;
+  }
+
+  /// Appends `n` elements copied from `src` with a single `memcpy`.
+  ///
+  /// Requires that the `SmallVec` is in a valid state to mutate, and that
+  /// `src` points to `n` elements that are not in the `SmallVec`.
+  constexpr void extend_trivial_internal(const T* src, usize n) noexcept
+    requires(::sus::mem::TrivialCopy<T>)
+  {
+    if (n == 0u) return;
+    // If this check fails, the source aliases with the `SmallVec`, and the
+    // reserve_internal() call below would invalidate it.
+    sus_check(!(src >= data_ && src <= data_ + len_));
+    reserve_internal(n);
+    if (std::is_constant_evaluated()) {
+      for (usize i; i < n; i += 1u)
+        std::construct_at(data_ + len_ + i, *(src + i));
+    } else {
+      ::sus::ptr::copy_nonoverlapping(::sus::marker::unsafe_fn, src,
+                                      data_ + len_, n);
+    }
+    len_ += n;
+  }
+
+  /// Requires that the `SmallVec` is in a valid state to mutate.
+  constexpr void reserve_internal(usize additional) noexcept {
+    const usize goal = len_ + additional;
+    if (goal <= capacity_) return;
+    usize cap = capacity_;
+    // The same growth function as Vec.
+    while (cap < goal) cap = (cap + 1u) * 3u;
+    grow_to_internal(cap);
+  }
+
+  /// Moves the elements into a heap allocation with capacity for `cap`
+  /// elements.
+  ///
+  /// Requires that `cap` > `capacity()`.
+  constexpr void grow_to_internal(usize cap) noexcept {
+    sus_debug_check(cap > capacity_);
+    T* const new_data = alloc_heap(cap);
+    relocate_elements(data_, new_data, len_);
+    if (is_spilled()) free_heap(data_, capacity_);
+    data_ = new_data;
+    capacity_ = cap;
+  }
+
+  /// Moves `count` elements from `src` to the uninitialized `dst`, leaving
+  /// `src` as uninitialized memory.
+  static constexpr void relocate_elements(T* src, T* dst,
+                                          usize count) noexcept {
+    if constexpr (::sus::mem::TriviallyRelocatable<T>) {
+      if (!std::is_constant_evaluated()) {
+        // SAFETY: `src` and `dst` are different allocations, or the inline
+        // storage of different `SmallVec`s, so they do not overlap.
+        ::sus::ptr::copy_nonoverlapping(::sus::marker::unsafe_fn, src, dst,
+                                        count);
+        return;
+      }
+    }
+    for (usize i; i < count; i += 1u) {
+      std::construct_at(dst + i, ::sus::move(*(src + i)));
+      if constexpr (!std::is_trivially_destructible_v<T>)
+        std::destroy_at(src + i);
+    }
+  }
+
+  /// Takes the elements from `o`, after the other fields have been copied
+  /// from it, and leaves `o` moved-from.
+  constexpr void take_storage_from(SmallVec& o) noexcept {
+    if (o.is_spilled()) {
+      data_ = o.data_;
+    } else {
+      relocate_elements(o.data_, inline_, len_);
+    }
+    o.capacity_ = kMovedFromCapacity;
+    o.data_ = nullptr;
+    o.len_ = kMovedFromLen;
+  }
+
+  static constexpr T* alloc_heap(usize cap) noexcept {
+    sus_check(::sus::mem::size_of<T>() * cap <=
+              ::sus::cast<usize>(isize::MAX));
+    auto alloc = std::allocator<T>();
+    return std::allocator_traits<std::allocator<T>>::allocate(alloc, cap);
+  }
+
+  static constexpr void free_heap(T* ptr, usize cap) noexcept {
+    auto alloc = std::allocator<T>();
+    std::allocator_traits<std::allocator<T>>::deallocate(alloc, ptr, cap);
+  }
+
+  constexpr void destroy_storage_objects() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (usize i = len_; i > 0u; i -= 1u) std::destroy_at(data_ + i - 1u);
+    }
+  }
+
+  constexpr void free_storage() noexcept {
+    destroy_storage_objects();
+    if (is_spilled()) free_heap(data_, capacity_);
+  }
+
+  /// Checks if the elements are in a heap allocation. The heap is only used
+  /// for more than `N` elements, so the capacity is larger than `N` exactly
+  /// when the `SmallVec` has spilled.
+  constexpr inline bool is_spilled() const noexcept { return capacity_ > N; }
+
+  /// Checks if the `SmallVec` has been moved from.
+  constexpr inline bool is_moved_from() const noexcept {
+    return len_ > capacity_;
+  }
+
+  constexpr inline bool has_iterators() const noexcept {
+    return iter_refs_.count_from_owner() != 0u;
+  }
+
+  /// The length is set to this value when `SmallVec` is moved from. It is
+  /// non-zero as `is_moved_from()` returns true when `length > capacity`.
+  static constexpr usize kMovedFromLen = 1_usize;
+  /// The capacity is set to this value when `SmallVec` is moved from. It is
+  /// less than kMovedFromLen to signal its moved-from state.
+  static constexpr usize kMovedFromCapacity = 0_usize;
+
+  usize capacity_;
+  // These are in the same order as Slice/SliceMut.
+  [[_sus_no_unique_address]] ::sus::iter::IterRefCounter iter_refs_;
+  /// Points to `inline_` until the `SmallVec` spills to the heap.
+  T* data_;
+  usize len_;
+  union {
+    T inline_[N];
+  };
+};
+
+#define _ptr_expr data_
+#define _len_expr len_
+#define _iter_refs_expr iter_refs_.to_iter_from_owner()
+#define _iter_refs_view_expr iter_refs_.to_view_from_owner()
+#define _delete_rvalue true
+#define _self_template class T, size_t N
+#define _self SmallVec<T, N>
+#include "__private/slice_methods_impl.inc"
+
+}  // namespace sus::collections
+
+// sus::iter::FromIterator trait for SmallVec.
+template <class T, size_t N>
+struct sus::iter::FromIteratorImpl<::sus::collections::SmallVec<T, N>> {
+  /// Constructs a `SmallVec` by taking all the elements from the iterator.
+  static constexpr ::sus::collections::SmallVec<T, N> from_iter(
+      ::sus::iter::IntoIterator<T> auto&& ii) noexcept
+    requires(::sus::mem::Move<T> &&  //
+             ::sus::mem::IsMoveRef<decltype(ii)>)
+  {
+    auto v = ::sus::collections::SmallVec<T, N>();
+    v.extend(::sus::move(ii));
+    return v;
+  }
+};
+
+// fmt support.
+template <class T, size_t N, class Char>
+struct fmt::formatter<::sus::collections::SmallVec<T, N>, Char> {
+  template <class ParseContext>
+  constexpr auto parse(ParseContext& ctx) {
+    return underlying_.parse(ctx);
+  }
+
+  template <class FormatContext>
+  constexpr auto format(const ::sus::collections::SmallVec<T, N>& vec,
+                        FormatContext& ctx) const {
+    auto out = ctx.out();
+    out = fmt::format_to(out, "[");
+    for (::sus::num::usize i; i < vec.len(); i += 1u) {
+      if (i > 0u) out = fmt::format_to(out, ", ");
+      ctx.advance_to(out);
+      out = underlying_.format(vec[i], ctx);
+    }
+    return fmt::format_to(out, "]");
+  }
+
+ private:
+  ::sus::string::__private::AnyFormatter<T, Char> underlying_;
+};
+
+// Promote SmallVec into the `sus` namespace.
+namespace sus {
+using ::sus::collections::SmallVec;
+}  // namespace sus
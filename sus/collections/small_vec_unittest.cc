@@ -0,0 +1,211 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/collections/small_vec.h"
+
+#include <string>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/collections/vec.h"
+#include "sus/iter/iterator.h"
+#include "sus/mem/move.h"
+#include "sus/prelude.h"
+#include "sus/test/counted.h"
+#include "sus/test/ensure_use.h"
+
+using sus::collections::SmallVec;
+
+namespace {
+
+static_assert(sus::mem::Move<SmallVec<i32, 4>>);
+static_assert(sus::mem::Clone<SmallVec<i32, 4>>);
+static_assert(!sus::mem::Copy<SmallVec<i32, 4>>);
+static_assert(sus::construct::Default<SmallVec<i32, 4>>);
+static_assert(!sus::mem::TriviallyRelocatable<SmallVec<i32, 4>>);
+
+TEST(SmallVec, Construct) {
+  auto empty = SmallVec<i32, 4>();
+  EXPECT_EQ(empty.len(), 0u);
+  EXPECT_EQ(empty.capacity(), 4u);
+  EXPECT_FALSE(empty.spilled());
+
+  auto inline_values = SmallVec<i32, 4>(1, 2, 3);
+  EXPECT_EQ(inline_values.len(), 3u);
+  EXPECT_FALSE(inline_values.spilled());
+
+  auto heap_values = SmallVec<i32, 2>(1, 2, 3);
+  EXPECT_EQ(heap_values.len(), 3u);
+  EXPECT_TRUE(heap_values.spilled());
+  EXPECT_EQ(heap_values.to_vec(), sus::Vec<i32>(1, 2, 3));
+
+  SmallVec<i32, 4> marker = sus::empty;
+  EXPECT_EQ(marker.len(), 0u);
+}
+
+TEST(SmallVec, WithCapacity) {
+  auto small = SmallVec<i32, 4>::with_capacity(3u);
+  EXPECT_EQ(small.capacity(), 4u);
+  EXPECT_FALSE(small.spilled());
+
+  auto large = SmallVec<i32, 4>::with_capacity(10u);
+  EXPECT_EQ(large.capacity(), 10u);
+  EXPECT_TRUE(large.spilled());
+}
+
+TEST(SmallVec, PushSpills) {
+  auto v = SmallVec<i32, 4>();
+  for (i32 i = 0; i < 4; i += 1) v.push(i);
+  EXPECT_FALSE(v.spilled());
+  EXPECT_EQ((SmallVec<i32, 4>::inline_capacity()), 4u);
+  v.push(4);
+  EXPECT_TRUE(v.spilled());
+  EXPECT_GT(v.capacity(), 4u);
+  EXPECT_EQ(v.to_vec(), sus::Vec<i32>(0, 1, 2, 3, 4));
+
+  // Clearing keeps the heap storage.
+  v.clear();
+  EXPECT_TRUE(v.spilled());
+  EXPECT_EQ(v.len(), 0u);
+}
+
+TEST(SmallVec, Pop) {
+  auto v = SmallVec<i32, 2>(1, 2);
+  EXPECT_EQ(v.pop().unwrap(), 2);
+  EXPECT_EQ(v.pop().unwrap(), 1);
+  EXPECT_TRUE(v.pop().is_none());
+}
+
+TEST(SmallVec, Emplace) {
+  auto v = SmallVec<std::string, 1>();
+  v.emplace(3u, 'a');
+  v.emplace(2u, 'b');
+  EXPECT_EQ(v[0u], "aaa");
+  EXPECT_EQ(v[1u], "bb");
+}
+
+TEST(SmallVec, Truncate) {
+  auto v = SmallVec<std::string, 2>(std::string("a"), std::string("b"),
+                                    std::string("c"));
+  v.truncate(5u);
+  EXPECT_EQ(v.len(), 3u);
+  v.truncate(1u);
+  EXPECT_EQ(v.len(), 1u);
+  EXPECT_EQ(v[0u], "a");
+}
+
+TEST(SmallVec, MoveInline) {
+  auto v = SmallVec<std::string, 4>(std::string("a"), std::string("b"));
+  auto m = sus::move(v);
+  EXPECT_FALSE(m.spilled());
+  EXPECT_EQ(m.len(), 2u);
+  EXPECT_EQ(m[1u], "b");
+
+  auto a = SmallVec<std::string, 4>(std::string("z"));
+  a = sus::move(m);
+  EXPECT_EQ(a.len(), 2u);
+  EXPECT_EQ(a[0u], "a");
+}
+
+TEST(SmallVec, MoveSpilled) {
+  auto v = SmallVec<i32, 1>(1, 2, 3);
+  const i32* ptr = v.as_ptr();
+  auto m = sus::move(v);
+  // The heap allocation moves along with the SmallVec.
+  EXPECT_EQ(m.as_ptr(), ptr);
+  EXPECT_EQ(m.to_vec(), sus::Vec<i32>(1, 2, 3));
+}
+
+TEST(SmallVec, Clone) {
+  auto v = SmallVec<i32, 2>(1, 2, 3);
+  auto c = v.clone();
+  EXPECT_EQ(c, v);
+  EXPECT_NE(c.as_ptr(), v.as_ptr());
+}
+
+TEST(SmallVec, Extend) {
+  auto v = SmallVec<i32, 2>();
+  v.extend(sus::Vec<i32>(1, 2, 3).into_iter());
+  EXPECT_EQ(v.to_vec(), sus::Vec<i32>(1, 2, 3));
+  auto tail = sus::Vec<i32>(4, 5);
+  v.extend_from_slice(tail.as_slice());
+  EXPECT_EQ(v.to_vec(), sus::Vec<i32>(1, 2, 3, 4, 5));
+}
+
+TEST(SmallVec, FromIterator) {
+  auto v = sus::Vec<i32>(3, 4, 5).into_iter().collect<SmallVec<i32, 8>>();
+  EXPECT_FALSE(v.spilled());
+  EXPECT_EQ(v.to_vec(), sus::Vec<i32>(3, 4, 5));
+}
+
+TEST(SmallVec, IntoVec) {
+  auto v = SmallVec<i32, 2>(1, 2, 3);
+  auto vec = sus::move(v).into_vec();
+  EXPECT_EQ(vec, sus::Vec<i32>(1, 2, 3));
+
+  auto empty = SmallVec<i32, 2>();
+  EXPECT_EQ(sus::move(empty).into_vec().len(), 0u);
+}
+
+TEST(SmallVec, IntoVecDestroysEachElementOnce) {
+  using sus::test::Counted;
+  Counted::alive = 0;
+  {
+    auto inline_v = SmallVec<Counted, 4>();
+    inline_v.push(Counted(1));
+    inline_v.push(Counted(2));
+    auto spilled_v = SmallVec<Counted, 1>();
+    spilled_v.push(Counted(3));
+    spilled_v.push(Counted(4));
+    spilled_v.push(Counted(5));
+    EXPECT_EQ(Counted::alive, 5);
+
+    auto a = sus::move(inline_v).into_vec();
+    auto b = sus::move(spilled_v).into_vec();
+    EXPECT_EQ(Counted::alive, 5);
+    EXPECT_EQ(a.len(), 2u);
+    EXPECT_EQ(a[1u].v, 2);
+    EXPECT_EQ(b.len(), 3u);
+    EXPECT_EQ(b[2u].v, 5);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(SmallVec, SliceMethods) {
+  auto v = SmallVec<i32, 4>(3, 1, 2);
+  EXPECT_TRUE(v.contains(2));
+  v.sort();
+  EXPECT_EQ(v.to_vec(), sus::Vec<i32>(1, 2, 3));
+  EXPECT_EQ(v.first().unwrap(), 1);
+  EXPECT_EQ(v["1.."_r].to_vec(), sus::Vec<i32>(2, 3));
+  auto windows = v.windows(2u);
+  EXPECT_EQ(sus::move(windows).count(), 2u);
+  for (i32& i : v.iter_mut()) i += 1;
+  EXPECT_EQ(v.to_vec(), sus::Vec<i32>(2, 3, 4));
+}
+
+TEST(SmallVec, Fmt) {
+  auto v = SmallVec<i32, 2>(1, 2, 3);
+  EXPECT_EQ(fmt::format("{}", v), "[1, 2, 3]");
+}
+
+TEST(SmallVecDeathTest, UseAfterMove) {
+  auto v = SmallVec<i32, 2>(1, 2);
+  auto m = sus::move(v);
+  sus::test::ensure_use(&m);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(v.push(3), "");
+#endif
+}
+
+}  // namespace
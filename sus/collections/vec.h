@@ -16,6 +16,7 @@
 // IWYU pragma: friend "sus/.*"
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -26,14 +27,17 @@
 #include "sus/assertions/check.h"
 #include "sus/assertions/debug_check.h"
 #include "sus/cmp/ord.h"
+#include "sus/collections/__private/relocate.h"
 #include "sus/collections/collections.h"
 #include "sus/collections/concat.h"
 #include "sus/collections/iterators/chunks.h"
 #include "sus/collections/iterators/drain.h"
+#include "sus/collections/iterators/extract_if.h"
 #include "sus/collections/iterators/slice_iter.h"
 #include "sus/collections/iterators/vec_iter.h"
 #include "sus/collections/slice.h"
 #include "sus/fn/fn_concepts.h"
+#include "sus/hash/hash.h"
 #include "sus/iter/adaptors/by_ref.h"
 #include "sus/iter/adaptors/enumerate.h"
 #include "sus/iter/adaptors/take.h"
@@ -45,6 +49,7 @@
 #include "sus/macros/lifetimebound.h"
 #include "sus/marker/empty.h"
 #include "sus/marker/unsafe.h"
+#include "sus/mem/allocator.h"
 #include "sus/mem/clone.h"
 #include "sus/mem/move.h"
 #include "sus/mem/relocate.h"
@@ -80,7 +85,16 @@ namespace sus::collections {
 /// Vec requires items are not const:
 /// - A const Vec<T> contains const values, it does not give mutable access to
 ///   its contents, so the const internal type would be redundant.
-template <class T>
+///
+/// The storage is allocated through the allocator `A`, which defaults to
+/// `std::allocator<T>`. Other allocators, such as
+/// [`ArenaAllocator`]($sus::mem::ArenaAllocator) and
+/// [`PoolAllocator`]($sus::mem::PoolAllocator), can be used to control where
+/// the storage comes from. A `Vec` with a stateful allocator is constructed
+/// with the `_in` variants of its constructors, such as
+/// [`with_capacity_in`]($sus::collections::Vec::with_capacity_in), which
+/// receive the allocator.
+template <class T, class A>
 class Vec final {
   static_assert(
       !std::is_reference_v<T>,
@@ -88,10 +102,9 @@ class Vec final {
   static_assert(!std::is_const_v<T>,
                 "`Vec<const T>` should be written `const Vec<T>`, as const "
                 "applies transitively.");
-  // TODO: Make configurable.
-  using A = std::allocator<T>;
+  static_assert(::sus::mem::Allocator<A, T>,
+                "The allocator type `A` must allocate objects of type `T`.");
 
-  // TODO: Represent these allocator requirements as our own concept?
   // Required because otherwise move assignment is immensely complicated.
   // See
   // https://stackoverflow.com/questions/27471053/example-usage-of-propagate-on-container-move-assignment
@@ -110,7 +123,9 @@ class Vec final {
   /// $sus::marker::EmptyMarker) allows the caller to avoid spelling out the
   /// full `Vec` type.
   /// #[doc.overloads=empty]
-  constexpr Vec(::sus::marker::EmptyMarker) : Vec() {}
+  constexpr Vec(::sus::marker::EmptyMarker)
+    requires(std::default_initializable<A>)
+      : Vec() {}
 
   /// Constructs a `Vec`, which constructs objects of type `T` from the given
   /// values.
@@ -123,11 +138,11 @@ class Vec final {
   /// needed. If no arguments are passed, it creates an empty `Vec` and will not
   /// allocate.
   template <std::convertible_to<T>... Ts>
+    requires(std::default_initializable<A>)
   explicit constexpr Vec(Ts&&... values) noexcept
-      : Vec(FROM_PARTS, std::allocator<T>(), sizeof...(values), nullptr,
-            0_usize) {
+      : Vec(FROM_PARTS, A(), sizeof...(values), nullptr, 0_usize) {
     if constexpr (sizeof...(values) > 0u) {
-      data_ = std::allocator_traits<A>::allocate(allocator_, sizeof...(values));
+      data_ = allocate_storage(sizeof...(values));
     }
     (..., push_with_capacity_internal(::sus::forward<Ts>(values)));
   }
@@ -146,10 +161,33 @@ class Vec final {
   ///
   /// # Panics
   /// Panics if the capacity exceeds `isize::MAX` bytes.
-  _sus_pure static constexpr Vec with_capacity(usize capacity) noexcept {
+  _sus_pure static constexpr Vec with_capacity(usize capacity) noexcept
+    requires(std::default_initializable<A>)
+  {
+    return with_capacity_in(capacity, A());
+  }
+
+  /// Constructs an empty `Vec` which will allocate its storage from `alloc`.
+  ///
+  /// The vector will not allocate until elements are pushed onto it.
+  _sus_pure static constexpr Vec new_in(A alloc) noexcept {
+    return Vec(FROM_PARTS, ::sus::move(alloc), 0_usize, nullptr, 0_usize);
+  }
+
+  /// Creates a `Vec` with at least the specified capacity, which allocates
+  /// its storage from `alloc`.
+  ///
+  /// This is the same as
+  /// [`with_capacity`]($sus::collections::Vec::with_capacity) but with a
+  /// given allocator.
+  ///
+  /// # Panics
+  /// Panics if the capacity exceeds `isize::MAX` bytes.
+  _sus_pure static constexpr Vec with_capacity_in(usize capacity,
+                                                 A alloc) noexcept {
     sus_check(::sus::mem::size_of<T>() * capacity <=
-          ::sus::cast<usize>(isize::MAX));
-    return Vec(WITH_CAPACITY, std::allocator<T>(), capacity);
+              ::sus::cast<usize>(isize::MAX));
+    return Vec(WITH_CAPACITY, ::sus::move(alloc), capacity);
   }
 
   /// Creates a `Vec` directly from a pointer, a capacity, and a length.
@@ -159,10 +197,12 @@ class Vec final {
   /// This is highly unsafe, due to the number of invariants that aren’t
   /// checked:
   ///
-  /// * `ptr` must be heap allocated with the same method as Vec uses
-  ///   internally, which is not currently stable. (TODO: Want our own global
-  ///   allocator API.) The only safe way to get this pointer is from
-  ///   `from_raw_parts()`.
+  /// * `ptr` must have been allocated in the same way as `Vec<T, A>` does
+  ///   internally with a default-constructed allocator `A`, and the only safe
+  ///   way to get such a pointer is from
+  ///   [`into_raw_parts`]($sus::collections::Vec::into_raw_parts) on a
+  ///   `Vec<T, A>`. Note that with the default allocator, trivially
+  ///   relocatable types are stored in memory from `malloc()`.
   /// * `T` needs to have an alignment no more than what `ptr` was allocated
   ///   with.
   /// * The size of `T` times the `capacity` (ie. the allocated size in bytes)
@@ -175,8 +215,25 @@ class Vec final {
   ///   vice versa.
   _sus_pure static constexpr Vec from_raw_parts(::sus::marker::UnsafeFnMarker,
                                                T* ptr, usize length,
-                                               usize capacity) noexcept {
-    return Vec(FROM_PARTS, std::allocator<T>(), capacity, ptr, length);
+                                               usize capacity) noexcept
+    requires(std::default_initializable<A>)
+  {
+    return Vec(FROM_PARTS, A(), capacity, ptr, length);
+  }
+
+  /// Creates a `Vec` directly from a pointer, a capacity, a length, and the
+  /// allocator that the pointer was allocated from.
+  ///
+  /// # Safety
+  ///
+  /// The same requirements as
+  /// [`from_raw_parts`]($sus::collections::Vec::from_raw_parts) apply, except
+  /// that `ptr` must have been allocated by `alloc`, or an allocator that
+  /// compares equal to it.
+  _sus_pure static constexpr Vec from_raw_parts_in(
+      ::sus::marker::UnsafeFnMarker, T* ptr, usize length, usize capacity,
+      A alloc) noexcept {
+    return Vec(FROM_PARTS, ::sus::move(alloc), capacity, ptr, length);
   }
 
   /// Constructs a Vec by cloning elements out of a slice.
@@ -186,7 +243,7 @@ class Vec final {
   ///
   /// #[doc.overloads=from.slice]
   static constexpr Vec from(::sus::Slice<T> slice) noexcept
-    requires(sus::mem::Clone<T>)
+    requires(sus::mem::Clone<T> && std::default_initializable<A>)
   {
     auto v = Vec::with_capacity(slice.len());
     for (const T& t : slice) v.push_with_capacity_internal(::sus::clone(t));
@@ -194,7 +251,7 @@ class Vec final {
   }
   /// #[doc.overloads=from.slice]
   static constexpr Vec from(::sus::SliceMut<T> slice) noexcept
-    requires(sus::mem::Clone<T>)
+    requires(sus::mem::Clone<T> && std::default_initializable<A>)
   {
     auto v = Vec::with_capacity(slice.len());
     for (const T& t : slice) v.push_with_capacity_internal(::sus::clone(t));
@@ -211,7 +268,8 @@ class Vec final {
     requires(std::same_as<T, u8> &&  //
              (std::same_as<C, char> || std::same_as<C, signed char> ||
               std::same_as<C, unsigned char>) &&
-             N <= ::sus::cast<usize>(isize::MAX))
+             N <= ::sus::cast<usize>(isize::MAX) &&
+             std::default_initializable<A>)
   static constexpr Vec from(const C (&arr)[N]) {
     auto s = sus::Slice<C>::from(arr);
     auto v = Vec::with_capacity(N - 1);
@@ -258,8 +316,8 @@ class Vec final {
     sus_check(!is_moved_from());
     auto v = Vec(
         WITH_CAPACITY,
-        // TODO: Why do we need to do select_on_container_copy_construction()
-        // instead of just default-constructing a new allocator?
+        // The allocator decides if the clone shares its storage source, which
+        // stateful allocators like ArenaAllocator do.
         std::allocator_traits<A>::select_on_container_copy_construction(
             allocator_),
         capacity_);
@@ -308,12 +366,13 @@ class Vec final {
   ///
   /// Panics if the starting point is greater than the end point or if
   /// the end point is greater than the length of the vector.
-  constexpr Drain<T> drain(::sus::ops::RangeBounds<usize> auto range) noexcept {
+  constexpr Drain<T, A> drain(
+      ::sus::ops::RangeBounds<usize> auto range) noexcept {
     sus_check(!is_moved_from() && !has_iterators());
     ::sus::ops::Range<usize> bounded_range =
         range.start_at(range.start_bound().unwrap_or(0u))
             .end_at(range.end_bound().unwrap_or(len_));
-    return Drain<T>(::sus::move(*this), bounded_range);
+    return Drain<T, A>(::sus::move(*this), bounded_range);
   }
 
   /// Decomposes a `Vec` into its raw components.
@@ -335,6 +394,35 @@ class Vec final {
                       ::sus::mem::replace(capacity_, kMovedFromCapacity));
   }
 
+  /// Returns a reference to the allocator that the vector allocates its
+  /// storage from.
+  _sus_pure constexpr const A& allocator() const& noexcept sus_lifetimebound {
+    return allocator_;
+  }
+
+  /// Moves all the elements of `other` into `self`, leaving `other` empty.
+  ///
+  /// The elements are moved in bulk, with a single `memmove` when `T` is
+  /// [`TriviallyRelocatable`]($sus::mem::TriviallyRelocatable).
+  ///
+  /// # Panics
+  /// Panics if the new capacity exceeds `isize::MAX` bytes, or if `other` is
+  /// `self`.
+  constexpr void append(Vec& other) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    sus_check(!other.is_moved_from() && !other.has_iterators());
+    sus_check(&other != this);
+    const usize other_len = other.len_;
+    if (other_len == 0u) return;
+    T* const dst = reserve_internal(other_len) + len_;
+    // SAFETY: `dst` is in the spare capacity of `self`, which holds no objects
+    // and does not overlap with `other`. The elements of `other` are no longer
+    // alive after being relocated, so its length is set to zero.
+    __private::relocate(::sus::marker::unsafe_fn, other.data_, dst, other_len);
+    other.len_ = 0u;
+    len_ += other_len;
+  }
+
   /// Returns the number of elements there is space allocated for in the vector.
   ///
   /// This may be larger than the number of elements present, which is returned
@@ -354,6 +442,82 @@ class Vec final {
     len_ = 0u;
   }
 
+  /// Removes consecutive repeated elements in the vector according to the
+  /// [`Eq`]($sus::cmp::Eq) concept.
+  ///
+  /// If the vector is sorted, this removes all duplicates.
+  constexpr void dedup() noexcept
+    requires(::sus::cmp::Eq<T>)
+  {
+    dedup_by([](T& a, T& b) { return a == b; });
+  }
+
+  /// Removes all but the first of consecutive elements in the vector
+  /// satisfying a given equality relation.
+  ///
+  /// The `same_bucket` function is passed references to two elements from the
+  /// vector and must determine if the elements compare equal. The elements are
+  /// passed in opposite order from their order in the slice, so if
+  /// `same_bucket(a, b)` returns `true`, `a` is removed.
+  ///
+  /// If the vector is sorted, this removes all duplicates.
+  ///
+  /// # Implementation notes
+  /// The vector is compacted in a single pass. Each run of elements that is
+  /// kept is moved into place together, with a single `memmove` when `T` is
+  /// [`TriviallyRelocatable`]($sus::mem::TriviallyRelocatable).
+  constexpr void dedup_by(::sus::fn::FnMut<bool(T&, T&)> auto same_bucket) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    // Prevent mutation from `same_bucket` while the vector is compacted.
+    sus::iter::IterRef ref = iter_refs_.to_iter_from_owner();
+
+    const usize self_len = len_;
+    if (self_len <= 1u) return;
+    // Elements before the first duplicate stay where they are.
+    usize read = 1u;
+    while (read < self_len &&
+           !::sus::fn::call_mut(same_bucket, *(data_ + read),
+                                *(data_ + read - 1u))) {
+      read += 1u;
+    }
+    usize write = read;
+    while (read < self_len) {
+      // The element at `read` is a duplicate of the one before `write`.
+      if constexpr (!std::is_trivially_destructible_v<T>)
+        std::destroy_at(data_ + read);
+      read += 1u;
+      // Find the run of elements that are kept after it. The first is compared
+      // against the last element kept, which has been moved to `write - 1`,
+      // and the rest against their neighbour, which has not been moved yet.
+      const usize run = read;
+      while (read < self_len &&
+             !::sus::fn::call_mut(
+                 same_bucket, *(data_ + read),
+                 read == run ? *(data_ + write - 1u) : *(data_ + read - 1u))) {
+        read += 1u;
+      }
+      // SAFETY: The elements from `write` up to `run` have been destroyed or
+      // moved from, and `write < run`.
+      __private::relocate(::sus::marker::unsafe_fn, data_ + run, data_ + write,
+                          read - run);
+      write += read - run;
+    }
+    len_ = write;
+  }
+
+  /// Removes all but the first of consecutive elements in the vector that
+  /// resolve to the same key.
+  ///
+  /// If the vector is sorted, this removes all duplicates.
+  template <::sus::fn::FnMut<::sus::fn::NonVoid(T&)> KeyFn, int&...,
+            class Key = std::invoke_result_t<KeyFn&, T&>>
+    requires(::sus::cmp::Eq<Key>)
+  constexpr void dedup_by_key(KeyFn key) noexcept {
+    dedup_by([&key](T& a, T& b) {
+      return ::sus::fn::call_mut(key, a) == ::sus::fn::call_mut(key, b);
+    });
+  }
+
   /// Extends the `Vec` with the contents of an iterator, copying from the
   /// elements.
   ///
@@ -376,12 +540,13 @@ class Vec final {
     // Prevent mutation from other callers inside this method.
     sus::iter::IterRef ref = iter_refs_.to_iter_from_owner();
 
-    // TODO: There's some serious improvements we can do here when the iterator
-    // is over contiguous elements. See
-    // https://doc.rust-lang.org/src/alloc/vec/spec_extend.rs.html
     auto&& it = sus::move(ii).into_iter();
     const usize self_len = len_;
-    if constexpr (sus::iter::TrustedLen<decltype(it)>) {
+    if constexpr (sus::iter::__private::ContiguousIterator<decltype(it)> &&
+                  sus::mem::TrivialCopy<T>) {
+      // The elements are copied out of the iterator's memory all at once.
+      extend_trivial_internal(it.contiguous_data(), it.exact_size_hint());
+    } else if constexpr (sus::iter::TrustedLen<decltype(it)>) {
       const auto [lower, upper] = it.size_hint();
       // If this fails there are more than usize elements in the iterator, but
       // the max container size is isize::MAX. We can't reserve that many so
@@ -435,12 +600,13 @@ class Vec final {
     // Prevent mutation from other callers inside this method.
     sus::iter::IterRef ref = iter_refs_.to_iter_from_owner();
 
-    // TODO: There's some serious improvements we can do here when the iterator
-    // is over contiguous elements. See
-    // https://doc.rust-lang.org/src/alloc/vec/spec_extend.rs.html
     auto&& it = sus::move(ii).into_iter();
     const usize self_len = len_;
-    if constexpr (sus::iter::TrustedLen<decltype(it)>) {
+    if constexpr (sus::iter::__private::ContiguousIterator<decltype(it)> &&
+                  sus::mem::TrivialCopy<T>) {
+      // The elements are copied out of the iterator's memory all at once.
+      extend_trivial_internal(it.contiguous_data(), it.exact_size_hint());
+    } else if constexpr (sus::iter::TrustedLen<decltype(it)>) {
       const auto [lower, upper] = it.size_hint();
       // If this fails there are more than usize elements in the iterator, but
       // the max container size is isize::MAX. We can't reserve that many so
@@ -496,28 +662,88 @@ class Vec final {
     if (s.is_empty()) {
       return;
     }
-    const auto self_len = len_;
-    const auto slice_len = s.len();
-    const T* slice_ptr = s.as_ptr();
-    if (is_alloced()) {
-      // If this check fails, the Slice aliases with the Vec, and the
-      // reserve() call below would invalidate the Slice.
-      //
-      // TODO: Should we handle aliasing with a temp buffer?
-      sus_check(!(slice_ptr >= data_ && slice_ptr <= data_ + self_len));
-      reserve_allocated_internal(slice_len);
-    } else {
-      reserve_internal(slice_len);
-    }
     if constexpr (sus::mem::TrivialCopy<T>) {
-      ::sus::ptr::copy_nonoverlapping(::sus::marker::unsafe_fn, slice_ptr,
-                                      data_ + self_len, slice_len);
-      len_ += slice_len;
+      extend_trivial_internal(s.as_ptr(), s.len());
     } else {
+      const auto self_len = len_;
+      const auto slice_len = s.len();
+      const T* slice_ptr = s.as_ptr();
+      if (is_alloced()) {
+        // If this check fails, the Slice aliases with the Vec, and the
+        // reserve() call below would invalidate the Slice.
+        //
+        // TODO: Should we handle aliasing with a temp buffer?
+        sus_check(!(slice_ptr >= data_ && slice_ptr <= data_ + self_len));
+        reserve_allocated_internal(slice_len);
+      } else {
+        reserve_internal(slice_len);
+      }
       for (const T& t : s) push_with_capacity_internal(::sus::clone(t));
     }
   }
 
+  /// Extends the Vec by up to `n` elements that are written directly into its
+  /// spare capacity by `fill`.
+  ///
+  /// Space for `n` more elements is reserved, and `fill` is called with a
+  /// [`SliceMut`]($sus::collections::SliceMut) over that uninitialized space.
+  /// It writes the new elements to the front of the slice and returns how many
+  /// it wrote, which are then included in the Vec's length. This fits the
+  /// shape of decoders and of system calls such as `read()`, which fill a
+  /// buffer and report how much of it they used, without first writing a
+  /// default value to every element.
+  ///
+  /// The Vec can not be used from within `fill`.
+  ///
+  /// # Panics
+  /// Panics if `fill` returns a value greater than `n`, or if the new capacity
+  /// exceeds `isize::MAX` bytes.
+  void extend_with_uninit(
+      usize n, ::sus::fn::FnOnce<usize(SliceMut<T>)> auto fill) noexcept
+    requires(::sus::mem::TrivialCopy<T>)
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+    const usize self_len = len_;
+    T* const dst = reserve_internal(n) + self_len;
+    usize written;
+    {
+      // Prevent mutation of the Vec from inside `fill`.
+      sus::iter::IterRef ref = iter_refs_.to_iter_from_owner();
+      written = ::sus::fn::call_once(
+          ::sus::move(fill), SliceMut<T>::from_raw_collection_mut(
+                                 ::sus::marker::unsafe_fn,
+                                 iter_refs_.to_view_from_owner(), dst, n));
+    }
+    sus_check_with_message(written <= n,
+                           "extend_with_uninit wrote more than reserved");
+    len_ = self_len + written;
+  }
+
+  /// Creates an iterator which uses a closure to determine if an element should
+  /// be removed.
+  ///
+  /// If the closure returns `true`, then the element is removed and yielded.
+  /// If the closure returns `false`, the element will remain in the vector and
+  /// will not be yielded by the iterator. The closure is given a mutable
+  /// reference to each element, so it may modify the elements that are kept.
+  ///
+  /// If the returned [`ExtractIf`]($sus::collections::ExtractIf) is not
+  /// exhausted, e.g. because it is dropped without iterating, then the
+  /// remaining elements will be retained.
+  ///
+  /// Like with [`drain`]($sus::collections::Vec::drain), the `Vec` becomes
+  /// moved-from and will panic on use while the
+  /// [`ExtractIf`]($sus::collections::ExtractIf) iterator is in use, and will
+  /// be usable again once it is destroyed.
+  ///
+  /// Use [`retain`]($sus::collections::Vec::retain) with a negated predicate
+  /// if the removed elements are not needed.
+  template <::sus::fn::FnMut<bool(T&)> Pred>
+  constexpr ExtractIf<T, A, Pred> extract_if(Pred pred) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    return ExtractIf<T, A, Pred>(::sus::move(*this), ::sus::move(pred));
+  }
+
   /// Increase the capacity of the vector (the total number of elements that the
   /// vector can hold without requiring reallocation) to `cap`, if there is not
   /// already room. Does nothing if capacity is already sufficient.
@@ -532,6 +758,29 @@ class Vec final {
     reserve_exact_internal(cap - len_);
   }
 
+  /// Inserts an element at position `index` within the vector, shifting all
+  /// elements after it to the right.
+  ///
+  /// The elements after `index` are shifted together, with a single `memmove`
+  /// when `T` is [`TriviallyRelocatable`]($sus::mem::TriviallyRelocatable).
+  ///
+  /// # Panics
+  /// Panics if `index > len()`, or if the new capacity exceeds `isize::MAX`
+  /// bytes.
+  constexpr void insert(usize index, T element) noexcept
+    requires(::sus::mem::Move<T>)
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+    const usize self_len = len_;
+    sus_check_with_message(index <= self_len, "insertion index out of bounds");
+    T* const p = reserve_internal(1_usize) + index;
+    // SAFETY: There is capacity for one more element past the end, which holds
+    // no object.
+    __private::relocate(::sus::marker::unsafe_fn, p, p + 1u, self_len - index);
+    std::construct_at(p, ::sus::move(element));
+    len_ = self_len + 1u;
+  }
+
   /// Removes the last element from a vector and returns it, or None if it is
   /// empty.
   constexpr Option<T> pop() noexcept {
@@ -603,6 +852,94 @@ class Vec final {
     reserve_exact_internal(additional);
   }
 
+  /// Removes and returns the element at position `index` within the vector,
+  /// shifting all elements after it to the left.
+  ///
+  /// The elements after `index` are shifted together, with a single `memmove`
+  /// when `T` is [`TriviallyRelocatable`]($sus::mem::TriviallyRelocatable).
+  /// If the order of the elements does not need to be preserved, use
+  /// [`swap_remove`]($sus::collections::Vec::swap_remove) instead, which is
+  /// O(1).
+  ///
+  /// # Panics
+  /// Panics if `index` is out of bounds.
+  constexpr T remove(usize index) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    const usize self_len = len_;
+    sus_check_with_message(index < self_len, "removal index out of bounds");
+    T* const p = data_ + index;
+    T out = ::sus::move(*p);
+    if constexpr (!std::is_trivially_destructible_v<T>) std::destroy_at(p);
+    // SAFETY: The element at `p` was destroyed above.
+    __private::relocate(::sus::marker::unsafe_fn, p + 1u, p,
+                        self_len - index - 1u);
+    len_ = self_len - 1u;
+    return out;
+  }
+
+  /// Resizes the Vec in-place so that `len()` is equal to `new_len`.
+  ///
+  /// If `new_len` is greater than `len()`, the Vec is extended by the
+  /// difference, with each additional slot filled with the result of calling
+  /// the closure `f`. The return values from `f` will end up in the Vec in the
+  /// order they have been generated. Each value is constructed in place, with
+  /// no default value written first.
+  ///
+  /// If `new_len` is less than `len()`, the Vec is simply truncated.
+  ///
+  /// The Vec can not be used from within `f`.
+  ///
+  /// # Panics
+  /// Panics if the new capacity exceeds `isize::MAX` bytes.
+  constexpr void resize_with(usize new_len,
+                             ::sus::fn::FnMut<T()> auto f) noexcept
+    requires(::sus::mem::Move<T>)
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+    const usize self_len = len_;
+    if (new_len <= self_len) {
+      truncate(new_len);
+      return;
+    }
+    T* ptr = reserve_internal(new_len - self_len) + self_len;
+    // Prevent mutation of the Vec from inside `f`.
+    sus::iter::IterRef ref = iter_refs_.to_iter_from_owner();
+    for (T* const end = data_ + new_len; ptr != end; ptr += 1u) {
+      std::construct_at(ptr, ::sus::fn::call_mut(f));
+      len_ += 1u;
+    }
+  }
+
+  /// Retains only the elements specified by the predicate.
+  ///
+  /// In other words, removes all elements `e` for which `f(e)` returns
+  /// `false`. This method operates in place, visiting each element exactly
+  /// once in the original order, and preserves the order of the retained
+  /// elements.
+  ///
+  /// # Implementation notes
+  /// The vector is compacted in a single pass. Each run of elements that is
+  /// kept is moved into place together, with a single `memmove` when `T` is
+  /// [`TriviallyRelocatable`]($sus::mem::TriviallyRelocatable), and the
+  /// elements before the first one removed are not moved at all.
+  constexpr void retain(::sus::fn::FnMut<bool(const T&)> auto f) noexcept {
+    auto pred = [&f](T& t) -> bool {
+      return ::sus::fn::call_mut(f, static_cast<const T&>(t));
+    };
+    retain_internal(pred);
+  }
+
+  /// Retains only the elements specified by the predicate, passing a mutable
+  /// reference to it.
+  ///
+  /// In other words, removes all elements `e` such that `f(e)` returns
+  /// `false`. This method operates in place, visiting each element exactly
+  /// once in the original order, and preserves the order of the retained
+  /// elements.
+  constexpr void retain_mut(::sus::fn::FnMut<bool(T&)> auto f) noexcept {
+    retain_internal(f);
+  }
+
   /// Forces the length of the vector to new_len.
   ///
   /// This is a low-level operation that maintains none of the normal invariants
@@ -623,6 +960,84 @@ class Vec final {
     len_ = new_len;
   }
 
+  /// Returns the remaining spare capacity of the vector as a
+  /// [`SliceMut`]($sus::collections::SliceMut) of uninitialized elements.
+  ///
+  /// The returned slice can be used to fill the vector with data before
+  /// marking the data as initialized using the
+  /// [`set_len`]($sus::collections::Vec::set_len) method, for example from a
+  /// decoder or a system call such as `read()`.
+  /// [`extend_with_uninit`]($sus::collections::Vec::extend_with_uninit)
+  /// does the same without the use of `set_len`.
+  ///
+  /// The elements in the slice are uninitialized and must not be read from
+  /// until they are written. This is only available for
+  /// [`TrivialCopy`]($sus::mem::TrivialCopy) types, which begin their lifetime
+  /// when they are written to, and need no destructor to run. It is not
+  /// `constexpr`, as constant evaluation can not write to objects that have
+  /// not been constructed.
+  SliceMut<T> spare_capacity_mut() & noexcept sus_lifetimebound
+    requires(::sus::mem::TrivialCopy<T>)
+  {
+    sus_check(!is_moved_from());
+    return SliceMut<T>::from_raw_collection_mut(
+        ::sus::marker::unsafe_fn, iter_refs_.to_view_from_owner(),
+        data_ + len_, capacity_ - len_);
+  }
+
+  /// Splits the collection into two at the given index.
+  ///
+  /// Returns a newly allocated vector containing the elements in the range
+  /// `[at, len)`. After the call, the original vector will be left containing
+  /// the elements `[0, at)` with its previous capacity unchanged. The new
+  /// vector uses a copy of the allocator.
+  ///
+  /// The elements are moved in bulk, with a single `memcpy` when `T` is
+  /// [`TriviallyRelocatable`]($sus::mem::TriviallyRelocatable).
+  ///
+  /// # Panics
+  /// Panics if `at > len()`.
+  constexpr Vec split_off(usize at) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    const usize self_len = len_;
+    sus_check_with_message(at <= self_len, "split_off index out of bounds");
+    const usize other_len = self_len - at;
+    auto other = Vec(WITH_CAPACITY, allocator_, other_len);
+    // SAFETY: `other` was just allocated, so does not overlap with `self`, and
+    // holds no objects.
+    __private::relocate(::sus::marker::unsafe_fn, data_ + at, other.data_,
+                        other_len);
+    other.len_ = other_len;
+    len_ = at;
+    return other;
+  }
+
+  /// Removes an element from the vector and returns it.
+  ///
+  /// The removed element is replaced by the last element of the vector.
+  ///
+  /// This does not preserve ordering of the remaining elements, but is O(1).
+  /// If you need to preserve the element order, use
+  /// [`remove`]($sus::collections::Vec::remove) instead.
+  ///
+  /// # Panics
+  /// Panics if `index` is out of bounds.
+  constexpr T swap_remove(usize index) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    const usize self_len = len_;
+    sus_check_with_message(index < self_len,
+                           "swap_remove index out of bounds");
+    T* const p = data_ + index;
+    T out = ::sus::move(*p);
+    if constexpr (!std::is_trivially_destructible_v<T>) std::destroy_at(p);
+    // SAFETY: The element at `p` was destroyed above. When it was the last
+    // element, the source and destination are the same and nothing is moved.
+    __private::relocate(::sus::marker::unsafe_fn, data_ + self_len - 1u, p,
+                        1_usize);
+    len_ = self_len - 1u;
+    return out;
+  }
+
   /// Shortens the vector, keeping the first `len` elements and dropping the
   /// rest.
   ///
@@ -686,32 +1101,34 @@ class Vec final {
   /// Consumes the `Vec` into an [`Iterator`]($sus::iter::Iterator) that will
   /// return ownership of each element in the same order they appear in the
   /// `Vec`.
-  constexpr VecIntoIter<T> into_iter() && noexcept
+  constexpr VecIntoIter<T, A> into_iter() && noexcept
     requires(::sus::mem::Move<T>)
   {
     sus_check(!is_moved_from());
-    return VecIntoIter<T>(::sus::move(*this));
+    return VecIntoIter<T, A>(::sus::move(*this));
   }
 
   /// Satisfies the [`Eq<Vec<T>, Vec<U>>`]($sus::cmp::Eq) concept.
   ///
+  /// Vecs are compared by their elements, regardless of their allocators.
+  ///
   /// #[doc.overloads=vec.eq.vec]
-  template <class U>
+  template <class U, class B>
     requires(::sus::cmp::Eq<T, U>)
-  friend constexpr bool operator==(const Vec<T>& l, const Vec<U>& r) noexcept {
+  friend constexpr bool operator==(const Vec& l, const Vec<U, B>& r) noexcept {
     return l.as_slice() == r.as_slice();
   }
 
-  template <class U>
+  template <class U, class B>
     requires(!::sus::cmp::Eq<T, U>)
-  friend constexpr bool operator==(const Vec<T>& l, const Vec<U>& r) = delete;
+  friend constexpr bool operator==(const Vec& l, const Vec<U, B>& r) = delete;
 
   /// Satisfies the [`Eq<Vec<T>, Slice<U>>`]($sus::cmp::Eq) concept.
   ///
   /// #[doc.overloads=vec.eq.slice]
   template <class U>
     requires(::sus::cmp::Eq<T, U>)
-  friend constexpr bool operator==(const Vec<T>& l,
+  friend constexpr bool operator==(const Vec& l,
                                    const Slice<U>& r) noexcept {
     return l.as_slice() == r;
   }
@@ -721,7 +1138,7 @@ class Vec final {
   /// #[doc.overloads=vec.eq.slicemut]
   template <class U>
     requires(::sus::cmp::Eq<T, U>)
-  friend constexpr bool operator==(const Vec<T>& l,
+  friend constexpr bool operator==(const Vec& l,
                                    const SliceMut<U>& r) noexcept {
     return l.as_slice() == r.as_slice();
   }
@@ -849,8 +1266,7 @@ class Vec final {
   friend sus::iter::FromIteratorImpl<Vec>;
 
   enum FromParts { FROM_PARTS };
-  constexpr Vec(FromParts, std::allocator<T> alloc, usize cap, T* ptr,
-                usize len)
+  constexpr Vec(FromParts, A alloc, usize cap, T* ptr, usize len)
       : allocator_(::sus::move(alloc)),
         capacity_(cap),
         iter_refs_(sus::iter::IterRefCounter::for_owner()),
@@ -858,7 +1274,7 @@ class Vec final {
         len_(len) {}
 
   enum WithCapacity { WITH_CAPACITY };
-  constexpr Vec(WithCapacity, std::allocator<T> alloc, usize cap)
+  constexpr Vec(WithCapacity, A alloc, usize cap)
       : allocator_(::sus::move(alloc)),
         capacity_(0u),
         iter_refs_(sus::iter::IterRefCounter::for_owner()),
@@ -886,8 +1302,61 @@ class Vec final {
 
   constexpr void free_storage() {
     destroy_storage_objects();
-    std::allocator_traits<std::allocator<T>>::deallocate(allocator_, data_,
-                                                         capacity_);
+    deallocate_storage(data_, capacity_);
+  }
+
+  /// Whether the storage comes from `malloc()` instead of the allocator, so
+  /// that it can be grown with `realloc()`.
+  ///
+  /// This is only done for the default allocator, which would otherwise
+  /// allocate with `operator new` that has no way to grow in place. The
+  /// elements must be trivially relocatable, as `realloc()` moves them with
+  /// `memcpy()`, and must not be over-aligned, as `malloc()` only aligns to
+  /// `max_align_t`. During constant evaluation, the allocator is always used.
+  static consteval bool uses_malloc_storage() noexcept {
+    return std::same_as<A, std::allocator<T>> &&
+           ::sus::mem::TriviallyRelocatable<T> &&
+           alignof(T) <= alignof(max_align_t);
+  }
+
+  /// Allocates storage for `cap` elements.
+  constexpr T* allocate_storage(usize cap) noexcept;
+  /// Deallocates storage for `cap` elements that came from
+  /// `allocate_storage()`.
+  constexpr void deallocate_storage(T* ptr, usize cap) noexcept;
+
+  /// Removes the elements for which `f` returns false, moving each run of kept
+  /// elements into place together.
+  ///
+  /// Requires that:
+  /// * Vec is in a valid state to mutate
+  constexpr void retain_internal(auto& f) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    // Prevent mutation from `f` while the vector is compacted.
+    sus::iter::IterRef ref = iter_refs_.to_iter_from_owner();
+
+    const usize self_len = len_;
+    // Elements before the first one removed stay where they are.
+    usize read;
+    while (read < self_len && ::sus::fn::call_mut(f, *(data_ + read)))
+      read += 1u;
+    usize write = read;
+    while (read < self_len) {
+      // The element at `read` is removed.
+      if constexpr (!std::is_trivially_destructible_v<T>)
+        std::destroy_at(data_ + read);
+      read += 1u;
+      // Find the run of elements that are kept after it.
+      const usize run = read;
+      while (read < self_len && ::sus::fn::call_mut(f, *(data_ + read)))
+        read += 1u;
+      // SAFETY: The elements from `write` up to `run` have been destroyed or
+      // moved from, and `write < run`.
+      __private::relocate(::sus::marker::unsafe_fn, data_ + run, data_ + write,
+                          read - run);
+      write += read - run;
+    }
+    len_ = write;
   }
 
   /// Requires that there is capacity present for `t` already, and that
@@ -901,6 +1370,33 @@ class Vec final {
     len_ += 1u;
   }
 
+  /// Appends `n` elements copied from `src` with a single `memcpy`.
+  ///
+  /// Requires that:
+  /// * Vec is in a valid state to mutate
+  /// * `src` points to `n` elements that are not in the Vec.
+  constexpr void extend_trivial_internal(const T* src, usize n) noexcept
+    requires(::sus::mem::TrivialCopy<T>)
+  {
+    if (n == 0u) return;
+    const usize self_len = len_;
+    T* dst;
+    if (is_alloced()) {
+      // If this check fails, the source aliases with the Vec, and the
+      // reserve() call below would invalidate it.
+      sus_check(!(src >= data_ && src <= data_ + self_len));
+      dst = reserve_allocated_internal(n) + self_len;
+    } else {
+      dst = reserve_internal(n) + self_len;
+    }
+    if (std::is_constant_evaluated()) {
+      for (usize i; i < n; i += 1u) std::construct_at(dst + i, *(src + i));
+    } else {
+      ::sus::ptr::copy_nonoverlapping(::sus::marker::unsafe_fn, src, dst, n);
+    }
+    len_ = self_len + n;
+  }
+
   /// Requires that:
   /// * Vec is in a valid state to mutate
   constexpr T* reserve_internal(usize additional) noexcept {
@@ -982,7 +1478,7 @@ class Vec final {
   /// signal its moved-from state.
   static constexpr usize kMovedFromCapacity = 0_usize;
 
-  [[_sus_no_unique_address]] std::allocator<T> allocator_;
+  [[_sus_no_unique_address]] A allocator_;
   usize capacity_;
   // These are in the same order as Slice/SliceMut, and come last to make it
   // easier to reuse the same stack space.
@@ -1008,48 +1504,93 @@ Vec(T&&, Ts&&...) -> Vec<std::remove_cvref_t<T>>;
 #define _iter_refs_expr iter_refs_.to_iter_from_owner()
 #define _iter_refs_view_expr iter_refs_.to_view_from_owner()
 #define _delete_rvalue true
-#define _self_template class T
-#define _self Vec<T>
+#define _self_template class T, class A
+#define _self Vec<T, A>
 #include "__private/slice_methods_impl.inc"
 
-template <class T>
-constexpr T* Vec<T>::alloc_internal_check_cap(usize cap) noexcept {
+template <class T, class A>
+constexpr T* Vec<T, A>::allocate_storage(usize cap) noexcept {
+  if constexpr (uses_malloc_storage()) {
+    if (!std::is_constant_evaluated()) {
+      void* const p = ::malloc(cap.primitive_value * sizeof(T));
+      sus_check_with_message(p != nullptr, "Vec allocation failed");
+      return static_cast<T*>(p);
+    }
+  }
+  return std::allocator_traits<A>::allocate(allocator_, cap);
+}
+
+template <class T, class A>
+constexpr void Vec<T, A>::deallocate_storage(T* ptr, usize cap) noexcept {
+  if constexpr (uses_malloc_storage()) {
+    if (!std::is_constant_evaluated()) {
+      ::free(ptr);
+      return;
+    }
+  }
+  std::allocator_traits<A>::deallocate(allocator_, ptr, cap);
+}
+
+template <class T, class A>
+constexpr T* Vec<T, A>::alloc_internal_check_cap(usize cap) noexcept {
   sus_debug_check(!is_alloced());
-  sus_check(cap <= ::sus::cast<usize>(isize::MAX));
-  T* const new_data = std::allocator_traits<A>::allocate(allocator_, cap);
+  // The size in bytes must fit in `isize`, which also keeps the byte count
+  // given to the allocator from overflowing.
+  sus_check_with_message(
+      cap <= ::sus::cast<usize>(isize::MAX) / ::sus::mem::size_of<T>(),
+      "capacity overflow");
+  T* const new_data = allocate_storage(cap);
   data_ = new_data;
   capacity_ = cap;
   return new_data;
 }
 
-template <class T>
-constexpr T* Vec<T>::grow_to_internal_check_cap(usize cap) noexcept {
+template <class T, class A>
+constexpr T* Vec<T, A>::grow_to_internal_check_cap(usize cap) noexcept {
   sus_debug_check(is_alloced());
   sus_debug_check(cap > capacity_);
-  sus_check(cap <= ::sus::cast<usize>(isize::MAX));
-  T* const new_data =
-      std::allocator_traits<std::allocator<T>>::allocate(allocator_, cap);
+  sus_check_with_message(
+      cap <= ::sus::cast<usize>(isize::MAX) / ::sus::mem::size_of<T>(),
+      "capacity overflow");
   if constexpr (::sus::mem::TriviallyRelocatable<T>) {
     if (!std::is_constant_evaluated()) {
-      // SAFETY: new_t was just allocated above, so does not alias
-      // with `old_t` which was the previous allocation.
+      if constexpr (uses_malloc_storage()) {
+        // `realloc()` extends the block in place when it can, and large blocks
+        // are remapped rather than copied. But when it moves the block, it
+        // copies all of it, so it's only used when most of the block is live.
+        if (len_ * 2u >= capacity_) {
+          void* const p = ::realloc(data_, cap.primitive_value * sizeof(T));
+          sus_check_with_message(p != nullptr, "Vec allocation failed");
+          data_ = static_cast<T*>(p);
+          capacity_ = cap;
+          return data_;
+        }
+      } else if constexpr (::sus::mem::GrowInPlaceAllocator<A, T>) {
+        if (allocator_.grow_in_place(data_, capacity_, cap)) {
+          capacity_ = cap;
+          return data_;
+        }
+      }
+      T* const new_data = allocate_storage(cap);
+      // SAFETY: new_data was just allocated above, so does not alias with
+      // `data_` which was the previous allocation. Only the first `len_`
+      // elements hold objects, the rest is uninitialized memory.
       ::sus::ptr::copy_nonoverlapping(::sus::marker::unsafe_fn, data_, new_data,
-                                      capacity_);
-      std::allocator_traits<std::allocator<T>>::deallocate(allocator_, data_,
-                                                           capacity_);
+                                      len_);
+      deallocate_storage(data_, capacity_);
       data_ = new_data;
       capacity_ = cap;
       return new_data;
     }
   }
 
+  T* const new_data = allocate_storage(cap);
   for (usize i = len_; i > 0u; i -= 1u) {
     std::construct_at(new_data + i - 1u, ::sus::move(*(data_ + i - 1u)));
     if constexpr (!std::is_trivially_destructible_v<T>)
       std::destroy_at(data_ + i - 1u);
   }
-  std::allocator_traits<std::allocator<T>>::deallocate(allocator_, data_,
-                                                       capacity_);
+  deallocate_storage(data_, capacity_);
   data_ = new_data;
   capacity_ = cap;
   return new_data;
@@ -1058,30 +1599,44 @@ constexpr T* Vec<T>::grow_to_internal_check_cap(usize cap) noexcept {
 }  // namespace sus::collections
 
 // sus::iter::FromIterator trait for Vec.
-template <class T>
-struct sus::iter::FromIteratorImpl<::sus::collections::Vec<T>> {
+template <class T, class A>
+  requires(std::default_initializable<A>)
+struct sus::iter::FromIteratorImpl<::sus::collections::Vec<T, A>> {
   /// Constructs a vector by taking all the elements from the iterator.
-  static constexpr ::sus::collections::Vec<T> from_iter(
+  static constexpr ::sus::collections::Vec<T, A> from_iter(
       ::sus::iter::IntoIterator<T> auto&& ii) noexcept
     requires(::sus::mem::Move<T> &&  //
              ::sus::mem::IsMoveRef<decltype(ii)>)
   {
-    auto v = ::sus::collections::Vec<T>();
+    auto v = ::sus::collections::Vec<T, A>();
     v.extend(::sus::move(ii));
     return v;
   }
 };
 
+// sus::hash::Hash support.
+template <class T, class A>
+  requires(::sus::hash::Hash<T>)
+struct sus::hash::HashImpl<::sus::collections::Vec<T, A>> {
+  /// A `Vec` hashes the same as a [`Slice`]($sus::collections::Slice) of its
+  /// elements.
+  template <::sus::hash::Hasher H>
+  _sus_always_inline static constexpr void hash(
+      const ::sus::collections::Vec<T, A>& v, H& state) noexcept {
+    ::sus::hash::hash_into(v.as_slice(), state);
+  }
+};
+
 // fmt support.
-template <class T, class Char>
-struct fmt::formatter<::sus::collections::Vec<T>, Char> {
+template <class T, class A, class Char>
+struct fmt::formatter<::sus::collections::Vec<T, A>, Char> {
   template <class ParseContext>
   constexpr auto parse(ParseContext& ctx) {
     return underlying_.parse(ctx);
   }
 
   template <class FormatContext>
-  constexpr auto format(const ::sus::collections::Vec<T>& vec,
+  constexpr auto format(const ::sus::collections::Vec<T, A>& vec,
                         FormatContext& ctx) const {
     auto out = ctx.out();
     out = fmt::format_to(out, "[");
@@ -0,0 +1,792 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <concepts>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "fmt/core.h"
+#include "sus/assertions/check.h"
+#include "sus/cmp/eq.h"
+#include "sus/collections/__private/relocate.h"
+#include "sus/collections/collections.h"
+#include "sus/collections/iterators/vec_deque_iter.h"
+#include "sus/collections/slice.h"
+#include "sus/hash/hash.h"
+#include "sus/iter/from_iterator.h"
+#include "sus/iter/into_iterator.h"
+#include "sus/iter/iterator_concept.h"
+#include "sus/iter/iterator_loop.h"
+#include "sus/iter/iterator_ref.h"
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/macros/lifetimebound.h"
+#include "sus/macros/pure.h"
+#include "sus/marker/empty.h"
+#include "sus/mem/clone.h"
+#include "sus/mem/move.h"
+#include "sus/mem/relocate.h"
+#include "sus/mem/replace.h"
+#include "sus/mem/size_of.h"
+#include "sus/mem/swap.h"
+#include "sus/num/cast.h"
+#include "sus/num/signed_integer.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/ops/range.h"
+#include "sus/option/option.h"
+#include "sus/ptr/copy.h"
+#include "sus/string/__private/any_formatter.h"
+#include "sus/string/__private/format_to_stream.h"
+#include "sus/tuple/tuple.h"
+
+namespace sus::collections {
+
+/// A double-ended queue of `T`, implemented as a growable ring buffer.
+///
+/// A `VecDeque` stores its elements in a single allocation like a
+/// [`Vec`]($sus::collections::Vec), but the elements may start anywhere in the
+/// allocation and wrap around from its end to its start. This makes pushing
+/// and popping at either end O(1), without the per-block allocations and
+/// pointer chasing of `std::deque`.
+///
+/// The capacity is always a power of two, so positions in the buffer are
+/// found with a mask instead of a division. Growing the buffer moves the
+/// elements to the start of the new allocation, with a single `memcpy` for
+/// each of the two halves when `T` is
+/// [`TriviallyRelocatable`]($sus::mem::TriviallyRelocatable).
+///
+/// As the elements may wrap around the end of the buffer, they can be viewed
+/// as two [`Slice`]($sus::collections::Slice)s with `as_slices()`, or moved to
+/// be a single `Slice` with `make_contiguous()`.
+///
+/// Like `Vec`, the deque tracks its iterators, and will panic if it is mutated
+/// while any of them are alive.
+///
+/// The deque is not usable in constant expressions, and always allocates with
+/// the global `operator new`.
+template <class T>
+class VecDeque final {
+  static_assert(!std::is_reference_v<T>,
+                "VecDeque must hold value types. Use pointers instead of "
+                "references.");
+  static_assert(!std::is_const_v<T>,
+                "`VecDeque<const T>` should be written `const VecDeque<T>`, "
+                "as const applies transitively.");
+
+ public:
+  /// Constructs a `VecDeque`, which constructs objects of type `T` from the
+  /// given values, from front to back.
+  ///
+  /// This constructor also satisfies `sus::construct::Default` by accepting no
+  /// arguments to create an empty `VecDeque`, which will not allocate.
+  template <std::convertible_to<T>... Ts>
+  explicit VecDeque(Ts&&... values) noexcept
+      : VecDeque(FROM_PARTS, nullptr, 0_usize, 0_usize) {
+    if constexpr (sizeof...(values) > 0u) {
+      grow_to(capacity_for(sizeof...(values)));
+      (..., push_back_with_capacity(::sus::forward<Ts>(values)));
+    }
+  }
+
+  /// Constructs an empty `VecDeque`.
+  ///
+  /// This constructor is implicit so that using the [`EmptyMarker`](
+  /// $sus::marker::EmptyMarker) allows the caller to avoid spelling out the
+  /// full `VecDeque` type.
+  /// #[doc.overloads=empty]
+  VecDeque(::sus::marker::EmptyMarker) noexcept : VecDeque() {}
+
+  /// Creates an empty `VecDeque` which can hold at least `capacity` elements
+  /// without reallocating.
+  ///
+  /// # Panics
+  /// Panics if the capacity exceeds `isize::MAX` bytes.
+  _sus_pure static VecDeque with_capacity(usize capacity) noexcept {
+    auto d = VecDeque();
+    if (capacity > 0u) d.grow_to(capacity_for(capacity));
+    return d;
+  }
+
+  ~VecDeque() noexcept {
+    // `buf_` is null when the deque is moved-from.
+    if (buf_ != nullptr) {
+      destroy_range(0u, len_);
+      free_storage();
+    }
+  }
+
+  /// Satisifes the [`Move`]($sus::mem::Move) concept.
+  /// #[doc.overloads=vecdeque.move]
+  VecDeque(VecDeque&& o) noexcept
+      : iter_refs_(o.iter_refs_.take_for_owner()),
+        buf_(::sus::mem::replace(o.buf_, nullptr)),
+        cap_(::sus::mem::replace(o.cap_, kMovedFromCapacity)),
+        head_(::sus::mem::replace(o.head_, 0u)),
+        len_(::sus::mem::replace(o.len_, kMovedFromLen)) {
+    sus_check(!is_moved_from() && !has_iterators());
+  }
+  /// Satisifes the [`Move`]($sus::mem::Move) concept.
+  /// #[doc.overloads=vecdeque.move]
+  VecDeque& operator=(VecDeque&& o) noexcept {
+    sus_check(!o.is_moved_from());
+    sus_check(!has_iterators());
+    sus_check(!o.has_iterators());
+    if (buf_ != nullptr) {
+      destroy_range(0u, len_);
+      free_storage();
+    }
+    iter_refs_ = o.iter_refs_.take_for_owner();
+    buf_ = ::sus::mem::replace(o.buf_, nullptr);
+    cap_ = ::sus::mem::replace(o.cap_, kMovedFromCapacity);
+    head_ = ::sus::mem::replace(o.head_, 0u);
+    len_ = ::sus::mem::replace(o.len_, kMovedFromLen);
+    return *this;
+  }
+
+  /// Satisfies the [`Clone`]($sus::mem::Clone) concept.
+  ///
+  /// The clone is contiguous, starting at the front of its buffer.
+  VecDeque clone() const& noexcept
+    requires(::sus::mem::Clone<T>)
+  {
+    sus_check(!is_moved_from());
+    auto d = VecDeque::with_capacity(len_);
+    for (const T& t : iter()) d.push_back_with_capacity(::sus::clone(t));
+    return d;
+  }
+
+  /// Returns the number of elements in the deque.
+  _sus_pure usize len() const& noexcept {
+    sus_check(!is_moved_from());
+    return len_;
+  }
+
+  /// Returns `true` if the deque contains no elements.
+  _sus_pure bool is_empty() const& noexcept { return len() == 0u; }
+
+  /// Returns the number of elements the deque can hold without reallocating.
+  ///
+  /// This is always zero or a power of two.
+  _sus_pure usize capacity() const& noexcept {
+    sus_check(!is_moved_from());
+    return cap_;
+  }
+
+  /// Returns a reference to the element at index `i`, counting from the front
+  /// of the deque, or `None` if `i` is out of bounds.
+  _sus_pure Option<const T&> get(usize i) const& noexcept {
+    sus_check(!is_moved_from());
+    if (i >= len_) return Option<const T&>();
+    return Option<const T&>(*slot(i));
+  }
+  Option<const T&> get(usize i) && = delete;
+
+  /// Returns a mutable reference to the element at index `i`, counting from
+  /// the front of the deque, or `None` if `i` is out of bounds.
+  _sus_pure Option<T&> get_mut(usize i) & noexcept {
+    sus_check(!is_moved_from());
+    if (i >= len_) return Option<T&>();
+    return Option<T&>(*slot(i));
+  }
+
+  /// Returns a reference to the element at index `i`, counting from the front
+  /// of the deque.
+  ///
+  /// # Panics
+  /// If the index `i` is beyond the end of the deque, the function will panic.
+  _sus_pure const T& operator[](usize i) const& noexcept {
+    sus_check(i < len_);
+    return *slot(i);
+  }
+  const T& operator[](usize i) && = delete;
+
+  /// Returns a mutable reference to the element at index `i`, counting from
+  /// the front of the deque.
+  ///
+  /// # Panics
+  /// If the index `i` is beyond the end of the deque, the function will panic.
+  _sus_pure T& operator[](usize i) & noexcept {
+    sus_check(i < len_);
+    return *slot(i);
+  }
+
+  /// Returns a reference to the front element, or `None` if the deque is
+  /// empty.
+  _sus_pure Option<const T&> front() const& noexcept { return get(0u); }
+  Option<const T&> front() && = delete;
+
+  /// Returns a mutable reference to the front element, or `None` if the deque
+  /// is empty.
+  _sus_pure Option<T&> front_mut() & noexcept { return get_mut(0u); }
+
+  /// Returns a reference to the back element, or `None` if the deque is
+  /// empty.
+  _sus_pure Option<const T&> back() const& noexcept {
+    sus_check(!is_moved_from());
+    if (len_ == 0u) return Option<const T&>();
+    return Option<const T&>(*slot(len_ - 1u));
+  }
+  Option<const T&> back() && = delete;
+
+  /// Returns a mutable reference to the back element, or `None` if the deque
+  /// is empty.
+  _sus_pure Option<T&> back_mut() & noexcept {
+    sus_check(!is_moved_from());
+    if (len_ == 0u) return Option<T&>();
+    return Option<T&>(*slot(len_ - 1u));
+  }
+
+  /// Appends an element to the back of the deque.
+  ///
+  /// # Panics
+  /// Panics if the new capacity exceeds `isize::MAX` bytes.
+  ///
+  /// # Implementation note
+  /// Like [`Vec::push`]($sus::collections::Vec::push), receives by value so
+  /// that the argument can not refer into the deque's storage that growing
+  /// the deque would invalidate.
+  void push_back(T t) noexcept
+    requires(::sus::mem::Move<T>)
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+    if (len_ == cap_) grow_for_push();
+    push_back_with_capacity(::sus::move(t));
+  }
+
+  /// Prepends an element to the front of the deque.
+  ///
+  /// # Panics
+  /// Panics if the new capacity exceeds `isize::MAX` bytes.
+  void push_front(T t) noexcept
+    requires(::sus::mem::Move<T>)
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+    if (len_ == cap_) grow_for_push();
+    // Step back one slot without underflowing when the head is at 0.
+    head_ = (head_ + cap_ - 1u) & mask();
+    std::construct_at(buf_ + head_, ::sus::move(t));
+    len_ += 1u;
+  }
+
+  /// Removes the front element and returns it, or `None` if the deque is
+  /// empty.
+  Option<T> pop_front() noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    if (len_ == 0u) return Option<T>();
+    T* const p = buf_ + head_;
+    auto o = Option<T>(::sus::move(*p));
+    if constexpr (!std::is_trivially_destructible_v<T>) std::destroy_at(p);
+    head_ = (head_ + 1u) & mask();
+    len_ -= 1u;
+    return o;
+  }
+
+  /// Removes the back element and returns it, or `None` if the deque is
+  /// empty.
+  Option<T> pop_back() noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    if (len_ == 0u) return Option<T>();
+    T* const p = slot(len_ - 1u);
+    auto o = Option<T>(::sus::move(*p));
+    if constexpr (!std::is_trivially_destructible_v<T>) std::destroy_at(p);
+    len_ -= 1u;
+    return o;
+  }
+
+  /// Swaps the elements at indices `i` and `j`.
+  ///
+  /// # Panics
+  /// Panics if either index is out of bounds.
+  void swap(usize i, usize j) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    sus_check(i < len_ && j < len_);
+    ::sus::mem::swap(*slot(i), *slot(j));
+  }
+
+  /// Shortens the deque, keeping the first `len` elements and destroying the
+  /// rest.
+  ///
+  /// If `len` is greater than the deque's current length, this has no effect.
+  void truncate(usize len) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    if (len >= len_) return;
+    destroy_range(len, len_);
+    len_ = len;
+  }
+
+  /// Removes all elements from the deque.
+  ///
+  /// Note that this method has no effect on the allocated capacity of the
+  /// deque.
+  void clear() noexcept {
+    truncate(0u);
+    head_ = 0u;
+  }
+
+  /// Reserves capacity for at least `additional` more elements to be inserted
+  /// in the deque. The capacity is rounded up to a power of two.
+  ///
+  /// # Panics
+  /// Panics if the new capacity exceeds `isize::MAX` bytes.
+  void reserve(usize additional) noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    reserve_internal(additional);
+  }
+
+  /// Shrinks the capacity of the deque to the smallest power of two that
+  /// holds its elements.
+  ///
+  /// The elements are moved to the front of the new buffer, so the deque is
+  /// contiguous afterward.
+  void shrink_to_fit() noexcept {
+    sus_check(!is_moved_from() && !has_iterators());
+    if (len_ == 0u) {
+      if (buf_ != nullptr) free_storage();
+      buf_ = nullptr;
+      cap_ = head_ = 0u;
+      return;
+    }
+    const usize target = len_.next_power_of_two();
+    if (target < cap_) grow_to(target);
+  }
+
+  /// Returns a pair of slices which contain, in order, the contents of the
+  /// deque.
+  ///
+  /// The second slice is empty unless the elements wrap around the end of the
+  /// buffer. The slices can be joined into one with `make_contiguous()`.
+  _sus_pure Tuple<Slice<T>, Slice<T>> as_slices() const& noexcept
+      sus_lifetimebound {
+    sus_check(!is_moved_from());
+    const usize first = front_len();
+    return Tuple<Slice<T>, Slice<T>>(
+        Slice<T>::from_raw_collection(::sus::marker::unsafe_fn,
+                                      iter_refs_.to_view_from_owner(),
+                                      buf_ + head_, first),
+        Slice<T>::from_raw_collection(::sus::marker::unsafe_fn,
+                                      iter_refs_.to_view_from_owner(), buf_,
+                                      len_ - first));
+  }
+  Tuple<Slice<T>, Slice<T>> as_slices() && = delete;
+
+  /// Returns a pair of mutable slices which contain, in order, the contents of
+  /// the deque.
+  ///
+  /// The second slice is empty unless the elements wrap around the end of the
+  /// buffer. The slices can be joined into one with `make_contiguous()`.
+  _sus_pure Tuple<SliceMut<T>, SliceMut<T>> as_mut_slices() & noexcept
+      sus_lifetimebound {
+    sus_check(!is_moved_from());
+    const usize first = front_len();
+    return Tuple<SliceMut<T>, SliceMut<T>>(
+        SliceMut<T>::from_raw_collection_mut(::sus::marker::unsafe_fn,
+                                             iter_refs_.to_view_from_owner(),
+                                             buf_ + head_, first),
+        SliceMut<T>::from_raw_collection_mut(::sus::marker::unsafe_fn,
+                                             iter_refs_.to_view_from_owner(),
+                                             buf_, len_ - first));
+  }
+
+  /// Rearranges the storage of the deque so its elements are contiguous, and
+  /// returns a mutable slice over all of them.
+  ///
+  /// This does not allocate. If the elements wrap around the end of the
+  /// buffer, the shorter run is moved into the free space when it fits, with a
+  /// `memmove` when `T` is
+  /// [`TriviallyRelocatable`]($sus::mem::TriviallyRelocatable). Otherwise the
+  /// elements are rotated in place.
+  SliceMut<T> make_contiguous() & noexcept sus_lifetimebound {
+    sus_check(!is_moved_from() && !has_iterators());
+    const usize a = front_len();
+    if (a < len_) {
+      // The elements in [head, cap) are followed by the wrapped elements in
+      // [0, b), and the free space is in [b, head).
+      const usize b = len_ - a;
+      const usize free = cap_ - len_;
+      if (free >= a) {
+        __private::relocate(::sus::marker::unsafe_fn, buf_, buf_ + a, b);
+        __private::relocate(::sus::marker::unsafe_fn, buf_ + head_, buf_, a);
+        head_ = 0u;
+      } else if (free >= b) {
+        __private::relocate(::sus::marker::unsafe_fn, buf_ + head_,
+                            buf_ + head_ - b, a);
+        __private::relocate(::sus::marker::unsafe_fn, buf_, buf_ + cap_ - b,
+                            b);
+        head_ -= b;
+      } else {
+        __private::relocate(::sus::marker::unsafe_fn, buf_ + head_, buf_ + b,
+                            a);
+        std::rotate(buf_, buf_ + b, buf_ + len_);
+        head_ = 0u;
+      }
+    }
+    return SliceMut<T>::from_raw_collection_mut(
+        ::sus::marker::unsafe_fn, iter_refs_.to_view_from_owner(),
+        buf_ + head_, len_);
+  }
+
+  /// Returns an iterator over the elements of the deque, from front to back.
+  VecDequeIter<const T&> iter() const& noexcept sus_lifetimebound {
+    sus_check(!is_moved_from());
+    return VecDequeIter<const T&>(iter_refs_.to_iter_from_owner(), buf_,
+                                  mask(), head_, head_ + len_);
+  }
+  VecDequeIter<const T&> iter() && = delete;
+
+  /// Returns an iterator over mutable references to the elements of the
+  /// deque, from front to back.
+  VecDequeIterMut<T&> iter_mut() & noexcept sus_lifetimebound {
+    sus_check(!is_moved_from());
+    return VecDequeIterMut<T&>(iter_refs_.to_iter_from_owner(), buf_, mask(),
+                               head_, head_ + len_);
+  }
+
+  /// Consumes the deque into an iterator over its elements, from front to
+  /// back.
+  VecDequeIntoIter<T> into_iter() && noexcept
+    requires(::sus::mem::Move<T>)
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+    return VecDequeIntoIter<T>(::sus::move(*this));
+  }
+
+  /// Removes the specified range from the deque, returning the removed
+  /// elements as an iterator.
+  ///
+  /// If the iterator is destroyed before being fully consumed, it destroys
+  /// the remaining removed elements. The elements on the shorter side of the
+  /// removed range are then moved to close the gap, with a `memmove` when `T`
+  /// is [`TriviallyRelocatable`]($sus::mem::TriviallyRelocatable).
+  ///
+  /// The deque may not be used while the
+  /// [`VecDequeDrain`]($sus::collections::VecDequeDrain) iterator is alive.
+  ///
+  /// # Panics
+  /// Panics if the starting point is greater than the end point or if the end
+  /// point is greater than the length of the deque.
+  VecDequeDrain<T> drain(::sus::ops::RangeBounds<usize> auto range) noexcept
+      sus_lifetimebound {
+    sus_check(!is_moved_from() && !has_iterators());
+    const usize start = range.start_bound().unwrap_or(0u);
+    const usize end = range.end_bound().unwrap_or(len_);
+    sus_check(start <= end && end <= len_);
+    const usize tail_len = len_ - end;
+    // The elements from `start` on are hidden until the iterator is
+    // destroyed.
+    len_ = start;
+    return VecDequeDrain<T>(*this, iter_refs_.to_iter_from_owner(), start,
+                            end - start, tail_len);
+  }
+
+  /// Extends the deque with the contents of an iterator, appending them to
+  /// the back.
+  ///
+  /// If the iterator is over a contiguous array of
+  /// [`TrivialCopy`]($sus::mem::TrivialCopy) elements, such as an iterator
+  /// over a [`Slice`]($sus::collections::Slice), they are copied with at most
+  /// two `memcpy`s, one on each side of the wrap-around point.
+  ///
+  /// Satisfies the [`Extend<T>`]($sus::iter::Extend) concept for
+  /// `VecDeque<T>`.
+  void extend(::sus::iter::IntoIterator<T> auto&& ii) noexcept
+    requires(::sus::mem::IsMoveRef<decltype(ii)>)
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+
+    // Prevent mutation from other callers inside this method.
+    ::sus::iter::IterRef ref = iter_refs_.to_iter_from_owner();
+
+    auto&& it = ::sus::move(ii).into_iter();
+    if constexpr (::sus::iter::__private::ContiguousIterator<decltype(it)> &&
+                  ::sus::mem::TrivialCopy<T>) {
+      extend_trivial(it.contiguous_data(), it.exact_size_hint());
+    } else {
+      reserve_internal(it.size_hint().lower);
+      for (T&& t : it) {
+        if (len_ == cap_) grow_for_push();
+        push_back_with_capacity(::sus::move(t));
+      }
+    }
+  }
+
+  /// Extends the deque by cloning the contents of a slice onto its back.
+  ///
+  /// If `T` is [`TrivialCopy`]($sus::mem::TrivialCopy), then the copy is done
+  /// by at most two `memcpy`s.
+  ///
+  /// # Panics
+  /// If the slice is non-empty and points into the deque, the function will
+  /// panic, as growing the deque would invalidate the slice.
+  void extend_from_slice(Slice<T> s) noexcept
+    requires(::sus::mem::Clone<T>)
+  {
+    sus_check(!is_moved_from() && !has_iterators());
+    if (s.is_empty()) return;
+    sus_check(!(s.as_ptr() >= buf_ && s.as_ptr() < buf_ + cap_));
+    if constexpr (::sus::mem::TrivialCopy<T>) {
+      extend_trivial(s.as_ptr(), s.len());
+    } else {
+      reserve_internal(s.len());
+      for (const T& t : s) push_back_with_capacity(::sus::clone(t));
+    }
+  }
+
+  /// Satisfies the [`Eq<VecDeque<T>>`]($sus::cmp::Eq) concept.
+  ///
+  /// Deques are equal if they hold equal elements in the same order,
+  /// regardless of where the elements are in their buffers.
+  friend bool operator==(const VecDeque& l, const VecDeque& r) noexcept
+    requires(::sus::cmp::Eq<T>)
+  {
+    if (l.len() != r.len()) return false;
+    for (usize i; i < l.len_; i += 1u) {
+      if (!(*l.slot(i) == *r.slot(i))) return false;
+    }
+    return true;
+  }
+
+  // Stream support.
+  _sus_format_to_stream(VecDeque);
+
+ private:
+  template <class>
+  friend struct VecDequeDrain;
+
+  enum FromParts { FROM_PARTS };
+  explicit VecDeque(FromParts, T* buf, usize cap, usize len) noexcept
+      : iter_refs_(::sus::iter::IterRefCounter::for_owner()),
+        buf_(buf),
+        cap_(cap),
+        head_(0u),
+        len_(len) {}
+
+  /// The capacity is a power of two, so a position in the buffer is found by
+  /// masking an index that may have gone past its end.
+  usize mask() const noexcept { return cap_ == 0u ? 0_usize : cap_ - 1u; }
+  /// The slot of the element at index `i` from the front.
+  T* slot(usize i) const noexcept { return buf_ + ((head_ + i) & mask()); }
+  /// The number of elements from the head to the end of the buffer, before
+  /// they wrap around.
+  usize front_len() const noexcept {
+    const usize to_end = cap_ - head_;
+    return len_ < to_end ? len_ : to_end;
+  }
+
+  /// The capacity to allocate to hold `n` elements.
+  static usize capacity_for(usize n) noexcept {
+    return n <= kMinCapacity ? kMinCapacity : n.next_power_of_two();
+  }
+
+  void grow_for_push() noexcept {
+    grow_to(cap_ == 0u ? kMinCapacity : cap_ * 2u);
+  }
+  void reserve_internal(usize additional) noexcept {
+    const usize needed = len_ + additional;
+    if (needed > cap_) grow_to(capacity_for(needed));
+  }
+
+  /// Moves the elements into a new buffer of `new_cap` elements, starting at
+  /// its front.
+  void grow_to(usize new_cap) noexcept {
+    sus_check_with_message(new_cap <= ::sus::cast<usize>(isize::MAX) /
+                                          ::sus::mem::size_of<T>(),
+                           "capacity overflow");
+    void* const p = ::operator new(new_cap * ::sus::mem::size_of<T>(),
+                                   std::align_val_t(alignof(T)), std::nothrow);
+    sus_check_with_message(p != nullptr, "VecDeque allocation failed");
+    T* const new_buf = static_cast<T*>(p);
+    if (buf_ != nullptr) {
+      const usize first = front_len();
+      __private::relocate(::sus::marker::unsafe_fn, buf_ + head_, new_buf,
+                          first);
+      __private::relocate(::sus::marker::unsafe_fn, buf_, new_buf + first,
+                          len_ - first);
+      free_storage();
+    }
+    buf_ = new_buf;
+    cap_ = new_cap;
+    head_ = 0u;
+  }
+  void free_storage() noexcept {
+    ::operator delete(static_cast<void*>(buf_), std::align_val_t(alignof(T)));
+  }
+
+  void push_back_with_capacity(T&& t) noexcept {
+    std::construct_at(slot(len_), ::sus::move(t));
+    len_ += 1u;
+  }
+
+  /// Copies `n` elements from `src` onto the back of the deque, in the two
+  /// runs on either side of the wrap-around point.
+  void extend_trivial(const T* src, usize n) noexcept {
+    if (n == 0u) return;
+    reserve_internal(n);
+    const usize back = (head_ + len_) & mask();
+    const usize to_end = cap_ - back;
+    const usize first = n < to_end ? n : to_end;
+    ::sus::ptr::copy_nonoverlapping(::sus::marker::unsafe_fn, src, buf_ + back,
+                                    first);
+    if (first < n) {
+      ::sus::ptr::copy_nonoverlapping(::sus::marker::unsafe_fn, src + first,
+                                      buf_, n - first);
+    }
+    len_ += n;
+  }
+
+  /// Destroys the elements at indices `[start, end)` from the front.
+  void destroy_range(usize start, usize end) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (usize i = start; i < end; i += 1u) std::destroy_at(slot(i));
+    }
+  }
+
+  /// Moves `n` elements from index `src` to index `dst`, counting from the
+  /// front, where the destination holds no elements outside of the source
+  /// range. The indices are split at the wrap-around point into runs that are
+  /// each moved by `relocate()`, visiting them in an order that reads each
+  /// element before it is overwritten.
+  void relocate_within(usize src, usize dst, usize n) noexcept {
+    if (dst < src) {
+      usize done;
+      while (done < n) {
+        const usize s = (head_ + src + done) & mask();
+        const usize d = (head_ + dst + done) & mask();
+        usize c = n - done;
+        if (cap_ - s < c) c = cap_ - s;
+        if (cap_ - d < c) c = cap_ - d;
+        __private::relocate(::sus::marker::unsafe_fn, buf_ + s, buf_ + d, c);
+        done += c;
+      }
+    } else {
+      usize left = n;
+      while (left > 0u) {
+        // One past the last element in the run, which is at most `cap_`.
+        const usize s_end = ((head_ + src + left - 1u) & mask()) + 1u;
+        const usize d_end = ((head_ + dst + left - 1u) & mask()) + 1u;
+        usize c = left;
+        if (s_end < c) c = s_end;
+        if (d_end < c) c = d_end;
+        __private::relocate(::sus::marker::unsafe_fn, buf_ + s_end - c,
+                            buf_ + d_end - c, c);
+        left -= c;
+      }
+    }
+  }
+
+  /// Called by `VecDequeDrain` once the `drain_len` elements after `start`
+  /// have been moved out or destroyed, to close the gap between the elements
+  /// before them and the `tail_len` elements after them.
+  void finish_drain(usize start, usize drain_len, usize tail_len) noexcept {
+    if (drain_len > 0u && tail_len > 0u) {
+      if (start <= tail_len) {
+        // Move the front elements toward the back, and the head with them.
+        relocate_within(0u, drain_len, start);
+        head_ = (head_ + drain_len) & mask();
+      } else {
+        relocate_within(start + drain_len, start, tail_len);
+      }
+    }
+    len_ = start + tail_len;
+  }
+
+  bool is_moved_from() const noexcept { return len_ > cap_; }
+  bool has_iterators() const noexcept {
+    return iter_refs_.count_from_owner() != 0u;
+  }
+
+  static constexpr usize kMinCapacity = 4u;
+  // The moved-from state has `len_ > cap_`.
+  static constexpr usize kMovedFromLen = 1u;
+  static constexpr usize kMovedFromCapacity = 0u;
+
+  [[_sus_no_unique_address]] ::sus::iter::IterRefCounter iter_refs_;
+  T* buf_;
+  /// Zero or a power of two.
+  usize cap_;
+  /// The position of the front element in the buffer.
+  usize head_;
+  usize len_;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn,
+                                  decltype(iter_refs_), decltype(buf_),
+                                  decltype(cap_), decltype(head_),
+                                  decltype(len_));
+};
+
+}  // namespace sus::collections
+
+// sus::iter::FromIterator trait for VecDeque.
+template <class T>
+struct sus::iter::FromIteratorImpl<::sus::collections::VecDeque<T>> {
+  static ::sus::collections::VecDeque<T> from_iter(
+      ::sus::iter::IntoIterator<T> auto&& ii) noexcept
+    requires(::sus::mem::Move<T> &&  //
+             ::sus::mem::IsMoveRef<decltype(ii)>)
+  {
+    auto d = ::sus::collections::VecDeque<T>();
+    d.extend(::sus::move(ii));
+    return d;
+  }
+};
+
+// sus::hash::Hash support.
+template <class T>
+  requires(::sus::hash::Hash<T>)
+struct sus::hash::HashImpl<::sus::collections::VecDeque<T>> {
+  /// A `VecDeque` hashes its length and then each of its elements, so that
+  /// equal deques hash the same wherever their elements wrap around.
+  template <::sus::hash::Hasher H>
+  static void hash(const ::sus::collections::VecDeque<T>& d,
+                   H& state) noexcept {
+    ::sus::hash::hash_into(d.len(), state);
+    for (const T& t : d.iter()) ::sus::hash::hash_into(t, state);
+  }
+};
+
+// fmt support.
+template <class T, class Char>
+struct fmt::formatter<::sus::collections::VecDeque<T>, Char> {
+  template <class ParseContext>
+  constexpr auto parse(ParseContext& ctx) {
+    return underlying_.parse(ctx);
+  }
+
+  template <class FormatContext>
+  constexpr auto format(const ::sus::collections::VecDeque<T>& deque,
+                        FormatContext& ctx) const {
+    auto out = ctx.out();
+    out = fmt::format_to(out, "[");
+    bool first = true;
+    for (const T& t : deque.iter()) {
+      if (!first) out = fmt::format_to(out, ", ");
+      first = false;
+      ctx.advance_to(out);
+      out = underlying_.format(t, ctx);
+    }
+    return fmt::format_to(out, "]");
+  }
+
+ private:
+  ::sus::string::__private::AnyFormatter<T, Char> underlying_;
+};
+
+// Promote VecDeque into the `sus` namespace.
+namespace sus {
+using ::sus::collections::VecDeque;
+}  // namespace sus
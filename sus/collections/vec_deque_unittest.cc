@@ -0,0 +1,515 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/collections/vec_deque.h"
+
+#include <sstream>
+#include <string>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/collections/vec.h"
+#include "sus/hash/default_hasher.h"
+#include "sus/iter/iterator.h"
+#include "sus/mem/move.h"
+#include "sus/ops/range.h"
+#include "sus/prelude.h"
+#include "sus/test/counted.h"
+#include "sus/test/ensure_use.h"
+
+namespace {
+
+using sus::collections::VecDeque;
+using sus::test::Counted;
+using sus::test::ensure_use;
+
+static_assert(sus::mem::TriviallyRelocatable<i32>);
+
+/// Returns the elements of the deque, from front to back.
+template <class T>
+sus::Vec<i32> values(const VecDeque<T>& d) {
+  auto v = sus::Vec<i32>();
+  for (const T& t : d.iter()) {
+    if constexpr (std::same_as<T, Counted>)
+      v.push(t.v);
+    else
+      v.push(t);
+  }
+  return v;
+}
+
+/// Builds a deque with capacity `cap` whose elements `1..=len` start at
+/// position `head` in the buffer.
+template <class T>
+VecDeque<T> deque_at(usize cap, usize head, i32 len) {
+  auto d = VecDeque<T>::with_capacity(cap);
+  EXPECT_EQ(d.capacity(), cap);
+  // Move the head forward by pushing and popping at the back of the deque.
+  for (usize i : sus::ops::range(0_usize, head)) {
+    (void)i;
+    d.push_back(T(0));
+    d.pop_front();
+  }
+  for (i32 i : sus::ops::range(1_i32, len + 1)) d.push_back(T(i));
+  EXPECT_EQ(d.capacity(), cap);
+  return d;
+}
+
+TEST(VecDeque, Default) {
+  auto d = VecDeque<i32>();
+  EXPECT_EQ(d.len(), 0u);
+  EXPECT_EQ(d.is_empty(), true);
+  EXPECT_EQ(d.capacity(), 0u);
+  EXPECT_EQ(d.front().is_none(), true);
+  EXPECT_EQ(d.back().is_none(), true);
+  EXPECT_EQ(d.pop_front().is_none(), true);
+  EXPECT_EQ(d.pop_back().is_none(), true);
+  auto [a, b] = d.as_slices();
+  EXPECT_EQ(a.len(), 0u);
+  EXPECT_EQ(b.len(), 0u);
+
+  VecDeque<i32> e = sus::empty;
+  EXPECT_EQ(e.len(), 0u);
+}
+
+TEST(VecDeque, Construct) {
+  auto d = VecDeque<i32>(1, 2, 3, 4, 5);
+  EXPECT_EQ(d.len(), 5u);
+  EXPECT_EQ(d.capacity(), 8u);
+  EXPECT_EQ(values(d), sus::Vec<i32>(1, 2, 3, 4, 5));
+
+  auto c = VecDeque<i32>::with_capacity(5u);
+  EXPECT_EQ(c.capacity(), 8u);
+  EXPECT_EQ(c.len(), 0u);
+  EXPECT_EQ(VecDeque<i32>::with_capacity(1u).capacity(), 4u);
+}
+
+TEST(VecDeque, PushPop) {
+  auto d = VecDeque<i32>();
+  d.push_back(2);
+  d.push_back(3);
+  d.push_front(1);
+  d.push_front(0);
+  EXPECT_EQ(d.len(), 4u);
+  EXPECT_EQ(values(d), sus::Vec<i32>(0, 1, 2, 3));
+  EXPECT_EQ(d.front().copied().unwrap(), 0);
+  EXPECT_EQ(d.back().copied().unwrap(), 3);
+  EXPECT_EQ(d.pop_front().unwrap(), 0);
+  EXPECT_EQ(d.pop_back().unwrap(), 3);
+  EXPECT_EQ(d.pop_back().unwrap(), 2);
+  EXPECT_EQ(d.pop_front().unwrap(), 1);
+  EXPECT_EQ(d.is_empty(), true);
+  EXPECT_EQ(d.front_mut().is_none(), true);
+}
+
+TEST(VecDeque, IndexGet) {
+  auto d = VecDeque<i32>(1, 2, 3);
+  d.push_front(0);
+  EXPECT_EQ(d[0u], 0);
+  EXPECT_EQ(d[3u], 3);
+  EXPECT_EQ(d.get(2u).copied().unwrap(), 2);
+  EXPECT_EQ(d.get(4u).is_none(), true);
+  d[1u] = 10;
+  d.get_mut(2u).unwrap() = 20;
+  d.front_mut().unwrap() = -1;
+  d.back_mut().unwrap() = 30;
+  EXPECT_EQ(values(d), sus::Vec<i32>(-1, 10, 20, 30));
+  d.swap(0u, 3u);
+  EXPECT_EQ(values(d), sus::Vec<i32>(30, 10, 20, -1));
+}
+
+TEST(VecDeque, WrapAround) {
+  auto d = deque_at<i32>(8u, 6u, 5);
+  EXPECT_EQ(values(d), sus::Vec<i32>(1, 2, 3, 4, 5));
+  auto [a, b] = d.as_slices();
+  EXPECT_EQ(a, sus::Vec<i32>(1, 2));
+  EXPECT_EQ(b, sus::Vec<i32>(3, 4, 5));
+
+  // Pushing at the front steps back from the head without wrapping below
+  // zero.
+  auto f = VecDeque<i32>::with_capacity(4u);
+  f.push_front(2);
+  f.push_front(1);
+  auto [fa, fb] = f.as_slices();
+  EXPECT_EQ(fa, sus::Vec<i32>(1, 2));
+  EXPECT_EQ(fb.len(), 0u);
+  EXPECT_EQ(f.capacity(), 4u);
+}
+
+TEST(VecDeque, GrowWhileWrapped) {
+  auto d = deque_at<i32>(4u, 3u, 4);
+  EXPECT_EQ(d.len(), d.capacity());
+  d.push_back(5);
+  EXPECT_EQ(d.capacity(), 8u);
+  d.push_front(0);
+  EXPECT_EQ(values(d), sus::Vec<i32>(0, 1, 2, 3, 4, 5));
+
+  Counted::alive = 0;
+  {
+    auto c = deque_at<Counted>(4u, 2u, 4);
+    c.push_back(Counted(5));
+    EXPECT_EQ(values(c), sus::Vec<i32>(1, 2, 3, 4, 5));
+    EXPECT_EQ(Counted::alive, 5);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+
+  auto g = VecDeque<i32>();
+  for (i32 i : sus::ops::range(0_i32, 1000_i32)) {
+    if (i % 2 == 0)
+      g.push_back(i);
+    else
+      g.push_front(i);
+  }
+  EXPECT_EQ(g.len(), 1000u);
+  EXPECT_EQ(g.capacity(), 1024u);
+  EXPECT_EQ(g.front().copied().unwrap(), 999);
+  EXPECT_EQ(g.back().copied().unwrap(), 998);
+}
+
+TEST(VecDeque, ReserveShrink) {
+  auto d = deque_at<i32>(8u, 6u, 3);
+  d.reserve(5u);
+  EXPECT_EQ(d.capacity(), 8u);
+  d.reserve(6u);
+  EXPECT_EQ(d.capacity(), 16u);
+  EXPECT_EQ(values(d), sus::Vec<i32>(1, 2, 3));
+  d.shrink_to_fit();
+  EXPECT_EQ(d.capacity(), 4u);
+  EXPECT_EQ(values(d), sus::Vec<i32>(1, 2, 3));
+  d.clear();
+  EXPECT_EQ(d.capacity(), 4u);
+  d.shrink_to_fit();
+  EXPECT_EQ(d.capacity(), 0u);
+  d.push_back(1);
+  EXPECT_EQ(values(d), sus::Vec<i32>(1));
+}
+
+TEST(VecDeque, Truncate) {
+  Counted::alive = 0;
+  {
+    auto d = deque_at<Counted>(8u, 5u, 6);
+    d.truncate(10u);
+    EXPECT_EQ(d.len(), 6u);
+    d.truncate(2u);
+    EXPECT_EQ(values(d), sus::Vec<i32>(1, 2));
+    EXPECT_EQ(Counted::alive, 2);
+    d.clear();
+    EXPECT_EQ(Counted::alive, 0);
+    d.push_back(Counted(1));
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(VecDeque, AsMutSlices) {
+  auto d = deque_at<i32>(8u, 5u, 6);
+  auto [a, b] = d.as_mut_slices();
+  EXPECT_EQ(a.len(), 3u);
+  EXPECT_EQ(b.len(), 3u);
+  for (i32& i : a.iter_mut()) i *= 10;
+  b[0u] = 0;
+  EXPECT_EQ(values(d), sus::Vec<i32>(10, 20, 30, 0, 5, 6));
+}
+
+template <class T>
+void check_make_contiguous(usize head, i32 len) {
+  auto d = deque_at<T>(8u, head, len);
+  auto s = d.make_contiguous();
+  EXPECT_EQ(s.len(), sus::cast<usize>(len));
+  for (usize i : sus::ops::range(0_usize, s.len())) {
+    if constexpr (std::same_as<T, Counted>)
+      EXPECT_EQ(s[i].v, i32::try_from(i).unwrap() + 1);
+    else
+      EXPECT_EQ(s[i], i32::try_from(i).unwrap() + 1);
+  }
+  auto [a, b] = d.as_slices();
+  EXPECT_EQ(a.len(), sus::cast<usize>(len));
+  EXPECT_EQ(b.len(), 0u);
+  EXPECT_EQ(d.capacity(), 8u);
+  // The deque keeps working from wherever its head was moved.
+  d.push_back(T(len + 1));
+  d.push_front(T(0));
+  auto expected = sus::Vec<i32>();
+  for (i32 i : sus::ops::range(0_i32, len + 2)) expected.push(i);
+  EXPECT_EQ(values(d), expected);
+}
+
+TEST(VecDeque, MakeContiguous) {
+  Counted::alive = 0;
+  // Not wrapped.
+  check_make_contiguous<i32>(2u, 4);
+  check_make_contiguous<Counted>(2u, 4);
+  // The wrapped back part is moved over to make room for the front part.
+  check_make_contiguous<i32>(6u, 4);
+  check_make_contiguous<Counted>(6u, 4);
+  // The front part is moved back to join the wrapped back part.
+  check_make_contiguous<i32>(7u, 4);
+  check_make_contiguous<Counted>(7u, 4);
+  // Neither part fits in the free space, so they are rotated.
+  check_make_contiguous<i32>(4u, 7);
+  check_make_contiguous<Counted>(4u, 7);
+  check_make_contiguous<i32>(3u, 6);
+  check_make_contiguous<Counted>(3u, 6);
+  // Full.
+  check_make_contiguous<i32>(5u, 8);
+  check_make_contiguous<Counted>(5u, 8);
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(VecDeque, Iter) {
+  auto d = deque_at<i32>(8u, 6u, 5);
+  auto it = d.iter();
+  EXPECT_EQ(it.exact_size_hint(), 5u);
+  EXPECT_EQ(it.size_hint().upper.unwrap(), 5u);
+  EXPECT_EQ(it.next().copied().unwrap(), 1);
+  EXPECT_EQ(it.next_back().copied().unwrap(), 5);
+  EXPECT_EQ(it.exact_size_hint(), 3u);
+  EXPECT_EQ(sus::move(it).copied().collect<sus::Vec<i32>>(),
+            sus::Vec<i32>(2, 3, 4));
+
+  EXPECT_EQ(d.iter().rev().copied().collect<sus::Vec<i32>>(),
+            sus::Vec<i32>(5, 4, 3, 2, 1));
+
+  for (i32& i : d.iter_mut()) i += 1;
+  EXPECT_EQ(values(d), sus::Vec<i32>(2, 3, 4, 5, 6));
+
+  // Zip walks the deque by position.
+  auto z = d.iter().zip(d.iter().rev()).map([](auto&& p) {
+    auto&& [a, b] = p;
+    return a + b;
+  });
+  EXPECT_EQ(sus::move(z).collect<sus::Vec<i32>>(),
+            sus::Vec<i32>(8, 8, 8, 8, 8));
+}
+
+TEST(VecDeque, IntoIter) {
+  Counted::alive = 0;
+  {
+    auto d = deque_at<Counted>(8u, 6u, 5);
+    auto it = sus::move(d).into_iter();
+    EXPECT_EQ(it.exact_size_hint(), 5u);
+    EXPECT_EQ(it.next().unwrap().v, 1);
+    EXPECT_EQ(it.next_back().unwrap().v, 5);
+    EXPECT_EQ(it.exact_size_hint(), 3u);
+    EXPECT_EQ(Counted::alive, 3);
+    // The remaining elements are destroyed with the iterator.
+  }
+  EXPECT_EQ(Counted::alive, 0);
+
+  auto d = VecDeque<i32>(1, 2, 3);
+  EXPECT_EQ(sus::move(d).into_iter().rev().collect<sus::Vec<i32>>(),
+            sus::Vec<i32>(3, 2, 1));
+}
+
+template <class T>
+void check_drain(usize head, i32 len, usize start, usize end) {
+  auto d = deque_at<T>(8u, head, len);
+  auto drained = sus::Vec<i32>();
+  for (T&& t : d.drain(sus::ops::range(start, end))) {
+    if constexpr (std::same_as<T, Counted>)
+      drained.push(t.v);
+    else
+      drained.push(t);
+  }
+  auto expected_drained = sus::Vec<i32>();
+  auto expected_kept = sus::Vec<i32>();
+  for (i32 i : sus::ops::range(1_i32, len + 1)) {
+    const usize idx = sus::cast<usize>(i - 1);
+    if (idx >= start && idx < end)
+      expected_drained.push(i);
+    else
+      expected_kept.push(i);
+  }
+  EXPECT_EQ(drained, expected_drained);
+  EXPECT_EQ(values(d), expected_kept);
+  EXPECT_EQ(d.len(), expected_kept.len());
+  // The deque is usable again.
+  d.push_back(T(100));
+  d.push_front(T(0));
+  EXPECT_EQ(d.len(), expected_kept.len() + 2u);
+}
+
+TEST(VecDeque, Drain) {
+  Counted::alive = 0;
+  for (usize head : sus::ops::range(0_usize, 8_usize)) {
+    for (usize start : sus::ops::range(0_usize, 7_usize)) {
+      for (usize end : sus::ops::range(start, 7_usize)) {
+        check_drain<i32>(head, 6, start, end);
+        check_drain<Counted>(head, 6, start, end);
+      }
+    }
+  }
+  EXPECT_EQ(Counted::alive, 0);
+
+  auto d = VecDeque<i32>(1, 2, 3, 4);
+  EXPECT_EQ(d.drain(sus::ops::RangeFull<usize>()).collect<sus::Vec<i32>>(),
+            sus::Vec<i32>(1, 2, 3, 4));
+  EXPECT_EQ(d.is_empty(), true);
+}
+
+TEST(VecDeque, DrainPartial) {
+  Counted::alive = 0;
+  {
+    auto d = deque_at<Counted>(8u, 6u, 6);
+    {
+      auto it = d.drain(sus::ops::range(1_usize, 5_usize));
+      EXPECT_EQ(it.exact_size_hint(), 4u);
+      EXPECT_EQ(it.next().unwrap().v, 2);
+      EXPECT_EQ(it.next_back().unwrap().v, 5);
+      EXPECT_EQ(Counted::alive, 4);
+      // The elements 3 and 4 are destroyed with the iterator.
+    }
+    EXPECT_EQ(Counted::alive, 2);
+    EXPECT_EQ(values(d), sus::Vec<i32>(1, 6));
+
+    // A moved-from drain does nothing on destruction.
+    auto it = d.drain(sus::ops::range(0_usize, 1_usize));
+    auto it2 = sus::move(it);
+    EXPECT_EQ(it2.next().unwrap().v, 1);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(VecDeque, Extend) {
+  // A contiguous iterator of a trivial type is copied in two runs on either
+  // side of the wrap-around point.
+  auto d = deque_at<i32>(8u, 5u, 2);
+  d.extend(sus::Vec<i32>(3, 4, 5, 6));
+  EXPECT_EQ(values(d), sus::Vec<i32>(1, 2, 3, 4, 5, 6));
+  EXPECT_EQ(d.capacity(), 8u);
+  auto [a, b] = d.as_slices();
+  EXPECT_EQ(a.len(), 3u);
+  EXPECT_EQ(b.len(), 3u);
+
+  // Growing first.
+  auto v = sus::Vec<i32>(7, 8, 9);
+  d.extend(v.iter().copied());
+  EXPECT_EQ(values(d), sus::Vec<i32>(1, 2, 3, 4, 5, 6, 7, 8, 9));
+  EXPECT_EQ(d.capacity(), 16u);
+
+  // An iterator without a known length.
+  d.extend(sus::Vec<i32>(10, 11, 12).into_iter().filter([](const i32& i) {
+    return i != 11;
+  }));
+  EXPECT_EQ(values(d), sus::Vec<i32>(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 12));
+
+  Counted::alive = 0;
+  {
+    auto c = deque_at<Counted>(4u, 3u, 1);
+    auto cv = sus::Vec<Counted>();
+    for (i32 i : sus::ops::range(2_i32, 7_i32)) cv.push(Counted(i));
+    c.extend(sus::move(cv));
+    EXPECT_EQ(values(c), sus::Vec<i32>(1, 2, 3, 4, 5, 6));
+    EXPECT_EQ(Counted::alive, 6);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(VecDeque, ExtendFromSlice) {
+  auto d = deque_at<i32>(8u, 7u, 1);
+  auto w = sus::Vec<i32>(2, 3);
+  d.extend_from_slice(w);
+  EXPECT_EQ(values(d), sus::Vec<i32>(1, 2, 3));
+
+  auto s = VecDeque<std::string>();
+  s.push_front(std::string("a"));
+  auto v = sus::Vec<std::string>(std::string("b"), std::string("c"));
+  s.extend_from_slice(v);
+  EXPECT_EQ(s.len(), 3u);
+  EXPECT_EQ(s[2u], "c");
+  EXPECT_EQ(v[0u], "b");
+}
+
+TEST(VecDeque, CloneEq) {
+  auto a = deque_at<i32>(8u, 6u, 5);
+  auto b = VecDeque<i32>(1, 2, 3, 4, 5);
+  // Equal regardless of where the elements wrap.
+  EXPECT_EQ(a, b);
+  auto c = sus::clone(a);
+  EXPECT_EQ(c, a);
+  auto [ca, cb] = c.as_slices();
+  EXPECT_EQ(ca.len(), 5u);
+  EXPECT_EQ(cb.len(), 0u);
+  c.pop_back();
+  EXPECT_NE(c, a);
+  c.push_back(6);
+  EXPECT_NE(c, a);
+}
+
+TEST(VecDeque, Hash) {
+  auto a = deque_at<i32>(8u, 6u, 5);
+  auto b = VecDeque<i32>(1, 2, 3, 4, 5);
+  static_assert(sus::hash::Hash<VecDeque<i32>>);
+  const auto h = sus::hash::BuildHasherDefault<>();
+  EXPECT_EQ(h(a), h(b));
+  b.pop_back();
+  EXPECT_NE(h(a), h(b));
+}
+
+TEST(VecDeque, FromIterator) {
+  auto d = sus::Vec<i32>(1, 2, 3).into_iter().collect<VecDeque<i32>>();
+  EXPECT_EQ(values(d), sus::Vec<i32>(1, 2, 3));
+}
+
+TEST(VecDeque, Move) {
+  auto a = VecDeque<i32>(1, 2, 3);
+  auto b = sus::move(a);
+  EXPECT_EQ(values(b), sus::Vec<i32>(1, 2, 3));
+  a = sus::move(b);
+  EXPECT_EQ(values(a), sus::Vec<i32>(1, 2, 3));
+}
+
+TEST(VecDequeDeathTest, PushWhileIterating) {
+#if !defined(SUS_ITERATOR_INVALIDATION) || SUS_ITERATOR_INVALIDATION
+  auto d = VecDeque<i32>(1);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(
+      {
+        auto it = d.iter();
+        d.push_back(2);
+        ensure_use(&it);
+      },
+      "");
+  EXPECT_DEATH(
+      {
+        auto it = d.drain(sus::ops::RangeFull<usize>());
+        d.push_front(2);
+        ensure_use(&it);
+      },
+      "");
+#endif
+#endif
+}
+
+TEST(VecDequeDeathTest, IndexOutOfBounds) {
+  auto d = VecDeque<i32>(1);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(ensure_use(&d[1u]), "");
+#endif
+}
+
+TEST(VecDeque, fmt) {
+  auto d = VecDeque<i32>();
+  EXPECT_EQ(fmt::format("{}", d), "[]");
+  d.push_back(2);
+  d.push_front(1);
+  EXPECT_EQ(fmt::format("{:02}", d), "[01, 02]");
+}
+
+TEST(VecDeque, Stream) {
+  std::stringstream ss;
+  auto d = VecDeque<i32>(1, 2);
+  ss << d;
+  EXPECT_EQ(ss.str(), "[1, 2]");
+}
+
+}  // namespace
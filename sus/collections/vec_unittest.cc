@@ -16,8 +16,12 @@
 
 #include <concepts>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include "googletest/include/gtest/gtest.h"
+#include "sus/collections/array.h"
+#include "sus/iter/compat_ranges.h"
 #include "sus/iter/extend.h"
 #include "sus/iter/iterator.h"
 #include "sus/mem/move.h"
@@ -515,6 +519,26 @@ TEST(Vec, GrowthNonTriviallyRelocatable) {
   EXPECT_EQ(v[0u].i, 43_i32);
 }
 
+TEST(Vec, GrowthKeepsLiveElements) {
+  // Grows through reallocation of a mostly-full buffer, including to sizes
+  // that are large enough to be memory mapped.
+  auto v = Vec<u64>();
+  for (u64 i; i < 1_u64 << 20u; i += 1u) v.push(i);
+  bool all_match = true;
+  for (usize i; i < v.len(); i += 1u) {
+    all_match &= v[i] == u64::try_from(i).unwrap();
+  }
+  EXPECT_TRUE(all_match);
+
+  // Grows from a mostly-empty buffer, where only the live elements move.
+  auto w = Vec<u64>::with_capacity(100u);
+  w.push(7u);
+  w.push(8u);
+  w.reserve_exact(1000u);
+  EXPECT_EQ(w.capacity(), 1002u);
+  EXPECT_EQ(w, Vec<u64>(7u, 8u));
+}
+
 TEST(Vec, Reserve) {
   {
     auto v = Vec<i32>();
@@ -1143,6 +1167,78 @@ TEST(Vec, Extend) {
   }
 }
 
+TEST(Vec, ExtendContiguous) {
+  using sus::iter::__private::ContiguousIterator;
+  using sus::collections::SliceIter;
+  static_assert(ContiguousIterator<SliceIter<const i32&>>);
+  static_assert(ContiguousIterator<decltype(Vec<i32>().into_iter())>);
+  static_assert(ContiguousIterator<decltype(Vec<i32>().into_iter().copied())>);
+  static_assert(ContiguousIterator<decltype(sus::Array<i32, 3>().into_iter())>);
+  static_assert(!ContiguousIterator<decltype(sus::Array<i32, 0>().into_iter())>);
+  static_assert(!ContiguousIterator<decltype(Vec<i32>().into_iter().rev())>);
+
+  // Partially consumed iterators copy only what is left in them.
+  {
+    auto v1 = Vec<i32>(1, 2);
+    auto v2 = Vec<i32>(3, 4, 5, 6);
+    auto it = v2.iter();
+    it.next();
+    it.next_back();
+    v1.extend(sus::move(it));
+    EXPECT_EQ(v1, sus::Vec<i32>(1, 2, 4, 5));
+  }
+  {
+    auto v1 = Vec<i32>();
+    auto it = Vec<i32>(3, 4, 5, 6).into_iter();
+    it.next();
+    v1.extend(sus::move(it));
+    EXPECT_EQ(v1, sus::Vec<i32>(4, 5, 6));
+  }
+  {
+    auto v1 = Vec<i32>(1);
+    auto it = sus::Array<i32, 3>(2, 3, 4).into_iter();
+    it.next_back();
+    v1.extend(sus::move(it));
+    EXPECT_EQ(v1, sus::Vec<i32>(1, 2, 3));
+  }
+  // Copied and cloned iterators over contiguous elements.
+  {
+    auto v1 = Vec<i32>(1);
+    auto v2 = Vec<i32>(2, 3);
+    v1.extend(v2.iter().copied());
+    v1.extend(v2.iter_mut().cloned());
+    EXPECT_EQ(v1, sus::Vec<i32>(1, 2, 3, 2, 3));
+  }
+  // Ranges over contiguous memory.
+  {
+    const auto std_v = std::vector<i32>({1, 2, 3});
+    auto v1 = Vec<i32>(0);
+    v1.extend(sus::iter::from_range(std_v));
+    EXPECT_EQ(v1, sus::Vec<i32>(0, 1, 2, 3));
+    auto std_v2 = std::vector<i32>({4, 5});
+    v1.extend(sus::iter::from_range(std_v2).moved(unsafe_fn));
+    EXPECT_EQ(v1, sus::Vec<i32>(0, 1, 2, 3, 4, 5));
+  }
+  // Many elements, into a Vec which has to grow.
+  {
+    auto v2 = Vec<u64>();
+    for (u64 i; i < 1000u; i += 1u) v2.push(i);
+    auto v1 = Vec<u64>(1u, 2u);
+    v1.extend(v2.iter());
+    EXPECT_EQ(v1.len(), 1002u);
+    EXPECT_EQ(v1["2.."_r], v2.as_slice());
+  }
+  // Empty iterators.
+  {
+    auto v1 = Vec<i32>();
+    auto v2 = Vec<i32>();
+    v1.extend(v2.iter());
+    v1.extend(Vec<i32>());
+    EXPECT_EQ(v1.len(), 0u);
+    EXPECT_EQ(v1.capacity(), 0u);
+  }
+}
+
 TEST(Vec, Drain_TriviallyRelocatable) {
   static_assert(sus::mem::TriviallyRelocatable<i32>);
 
@@ -1410,6 +1506,276 @@ TEST(VecDeathTest, DrainMove) {
   }
 }
 
+TEST(Vec, Insert) {
+  auto v = Vec<i32>(1, 2, 3);
+  v.insert(1u, 4);
+  EXPECT_EQ(v, Vec<i32>(1, 4, 2, 3));
+  v.insert(4u, 5);
+  EXPECT_EQ(v, Vec<i32>(1, 4, 2, 3, 5));
+  v.insert(0u, 6);
+  EXPECT_EQ(v, Vec<i32>(6, 1, 4, 2, 3, 5));
+
+  auto e = Vec<i32>();
+  e.insert(0u, 1);
+  EXPECT_EQ(e, Vec<i32>(1));
+
+  auto s = Vec<std::string>(std::string("a"), std::string("c"));
+  s.insert(1u, std::string("b"));
+  EXPECT_EQ(s, Vec<std::string>(std::string("a"), std::string("b"),
+                                std::string("c")));
+}
+
+TEST(VecDeathTest, InsertOutOfBounds) {
+  auto v = Vec<i32>(1, 2, 3);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(v.insert(4u, 4), "");
+#endif
+}
+
+TEST(VecDeathTest, CapacityOverflowsBytes) {
+  // The capacity fits in `isize` but its size in bytes does not.
+  const usize cap = usize(1u) << 62u;
+  auto v = Vec<i32>(1, 2, 3);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(Vec<i32>().reserve(cap), "");
+  EXPECT_DEATH(Vec<i32>().reserve_exact(cap), "");
+  EXPECT_DEATH(v.reserve(cap), "");
+  EXPECT_DEATH(v.reserve_exact(cap), "");
+#endif
+}
+
+TEST(Vec, Remove) {
+  auto v = Vec<i32>(1, 2, 3, 4);
+  EXPECT_EQ(v.remove(1u), 2);
+  EXPECT_EQ(v, Vec<i32>(1, 3, 4));
+  EXPECT_EQ(v.remove(2u), 4);
+  EXPECT_EQ(v, Vec<i32>(1, 3));
+  EXPECT_EQ(v.remove(0u), 1);
+  EXPECT_EQ(v, Vec<i32>(3));
+
+  auto s = Vec<std::string>(std::string("a"), std::string("b"),
+                            std::string("c"));
+  EXPECT_EQ(s.remove(0u), "a");
+  EXPECT_EQ(s, Vec<std::string>(std::string("b"), std::string("c")));
+}
+
+TEST(Vec, SwapRemove) {
+  auto v = Vec<i32>(1, 2, 3, 4);
+  EXPECT_EQ(v.swap_remove(0u), 1);
+  EXPECT_EQ(v, Vec<i32>(4, 2, 3));
+  EXPECT_EQ(v.swap_remove(2u), 3);
+  EXPECT_EQ(v, Vec<i32>(4, 2));
+
+  auto s = Vec<std::string>(std::string("a"), std::string("b"),
+                            std::string("c"));
+  EXPECT_EQ(s.swap_remove(1u), "b");
+  EXPECT_EQ(s, Vec<std::string>(std::string("a"), std::string("c")));
+}
+
+TEST(Vec, Retain) {
+  auto v = Vec<i32>(1, 2, 3, 4, 5, 6, 7, 8);
+  v.retain([](const i32& i) { return i % 3 != 0; });
+  EXPECT_EQ(v, Vec<i32>(1, 2, 4, 5, 7, 8));
+  v.retain([](const i32&) { return true; });
+  EXPECT_EQ(v, Vec<i32>(1, 2, 4, 5, 7, 8));
+  v.retain([](const i32& i) { return i > 4; });
+  EXPECT_EQ(v, Vec<i32>(5, 7, 8));
+  v.retain([](const i32&) { return false; });
+  EXPECT_EQ(v, Vec<i32>());
+
+  // Each element is visited once, in order.
+  auto visited = Vec<i32>();
+  auto w = Vec<i32>(1, 2, 3, 4);
+  w.retain([&](const i32& i) {
+    visited.push(i);
+    return i % 2 == 0;
+  });
+  EXPECT_EQ(visited, Vec<i32>(1, 2, 3, 4));
+  EXPECT_EQ(w, Vec<i32>(2, 4));
+
+  auto s = Vec<std::string>(std::string("a"), std::string("bb"),
+                            std::string("c"), std::string("dd"));
+  s.retain([](const std::string& x) { return x.size() == 2u; });
+  EXPECT_EQ(s, Vec<std::string>(std::string("bb"), std::string("dd")));
+}
+
+TEST(Vec, RetainMut) {
+  auto v = Vec<i32>(1, 2, 3, 4);
+  v.retain_mut([](i32& i) {
+    i *= 10;
+    return i != 20;
+  });
+  EXPECT_EQ(v, Vec<i32>(10, 30, 40));
+}
+
+TEST(Vec, Dedup) {
+  auto v = Vec<i32>(1, 1, 2, 3, 3, 3, 1, 4, 4);
+  v.dedup();
+  EXPECT_EQ(v, Vec<i32>(1, 2, 3, 1, 4));
+
+  auto e = Vec<i32>();
+  e.dedup();
+  EXPECT_EQ(e, Vec<i32>());
+
+  auto k = Vec<i32>(10, 20, 21, 30, 20);
+  k.dedup_by_key([](i32& i) { return i / 10; });
+  EXPECT_EQ(k, Vec<i32>(10, 20, 30, 20));
+
+  auto s = Vec<std::string>(std::string("foo"), std::string("bar"),
+                            std::string("Bar"), std::string("baz"),
+                            std::string("bar"));
+  s.dedup_by([](std::string& a, std::string& b) {
+    return std::tolower(a[0]) == std::tolower(b[0]) && a.substr(1) == b.substr(1);
+  });
+  EXPECT_EQ(s, Vec<std::string>(std::string("foo"), std::string("bar"),
+                                std::string("baz"), std::string("bar")));
+}
+
+TEST(Vec, SplitOff) {
+  auto v = Vec<i32>(1, 2, 3, 4);
+  auto cap = v.capacity();
+  auto w = v.split_off(1u);
+  EXPECT_EQ(v, Vec<i32>(1));
+  EXPECT_EQ(v.capacity(), cap);
+  EXPECT_EQ(w, Vec<i32>(2, 3, 4));
+  EXPECT_EQ(v.split_off(1u), Vec<i32>());
+  EXPECT_EQ(v.split_off(0u), Vec<i32>(1));
+  EXPECT_EQ(v, Vec<i32>());
+
+  auto s = Vec<std::string>(std::string("a"), std::string("b"));
+  EXPECT_EQ(s.split_off(1u), Vec<std::string>(std::string("b")));
+  EXPECT_EQ(s, Vec<std::string>(std::string("a")));
+}
+
+TEST(Vec, Append) {
+  auto v = Vec<i32>(1, 2);
+  auto w = Vec<i32>(3, 4);
+  v.append(w);
+  EXPECT_EQ(v, Vec<i32>(1, 2, 3, 4));
+  EXPECT_EQ(w, Vec<i32>());
+  v.append(w);
+  EXPECT_EQ(v, Vec<i32>(1, 2, 3, 4));
+
+  auto s = Vec<std::string>(std::string("a"));
+  auto t = Vec<std::string>(std::string("b"), std::string("c"));
+  s.append(t);
+  EXPECT_EQ(s, Vec<std::string>(std::string("a"), std::string("b"),
+                                std::string("c")));
+  EXPECT_EQ(t.len(), 0u);
+}
+
+TEST(Vec, ExtractIf) {
+  auto v = Vec<i32>(1, 2, 3, 4, 5, 6);
+  {
+    auto evens = v.extract_if([](i32& i) { return i % 2 == 0; }).collect_vec();
+    EXPECT_EQ(evens, Vec<i32>(2, 4, 6));
+  }
+  EXPECT_EQ(v, Vec<i32>(1, 3, 5));
+
+  // Dropping the iterator early keeps the elements that were not visited.
+  auto w = Vec<i32>(1, 2, 3, 4, 5, 6);
+  {
+    auto it = w.extract_if([](i32& i) { return i % 2 == 0; });
+    EXPECT_EQ(it.next().unwrap(), 2);
+  }
+  EXPECT_EQ(w, Vec<i32>(1, 3, 4, 5, 6));
+
+  auto s = Vec<std::string>(std::string("a"), std::string("bb"),
+                            std::string("c"), std::string("dd"));
+  {
+    auto it = s.extract_if([](std::string& x) { return x.size() == 1u; });
+    EXPECT_EQ(it.next().unwrap(), "a");
+  }
+  EXPECT_EQ(s, Vec<std::string>(std::string("bb"), std::string("c"),
+                                std::string("dd")));
+}
+
+TEST(Vec, RemoveNonTriviallyRelocatable) {
+  struct S {
+    S(int i) : i(i) {}
+    ~S() {}
+    S(S&& o) : i(o.i) {}
+    S& operator=(S&& o) { return i = o.i, *this; }
+
+    bool operator==(const S& o) const noexcept { return i == o.i; }
+
+    i32 i;
+  };
+  static_assert(!sus::mem::TriviallyRelocatable<S>);
+
+  auto v = Vec<S>(1, 2, 3, 4, 5, 6);
+  v.retain([](const S& s) { return s.i % 2 == 0; });
+  EXPECT_EQ(v, Vec<S>(2, 4, 6));
+  v.insert(0u, S(1));
+  EXPECT_EQ(v, Vec<S>(1, 2, 4, 6));
+  EXPECT_EQ(v.remove(1u).i, 2);
+  EXPECT_EQ(v, Vec<S>(1, 4, 6));
+  auto w = v.split_off(1u);
+  EXPECT_EQ(w, Vec<S>(4, 6));
+  v.append(w);
+  EXPECT_EQ(v, Vec<S>(1, 4, 6));
+}
+
+TEST(Vec, SpareCapacityMut) {
+  auto v = Vec<u8>::with_capacity(4u);
+  auto spare = v.spare_capacity_mut();
+  EXPECT_GE(spare.len(), 4u);
+  spare[0u] = 1_u8;
+  spare[1u] = 2_u8;
+  v.set_len(unsafe_fn, 2u);
+  EXPECT_EQ(v, Vec<u8>(1_u8, 2_u8));
+  EXPECT_EQ(v.spare_capacity_mut().len(), v.capacity() - 2u);
+  EXPECT_EQ(v.spare_capacity_mut().as_ptr(), v.as_ptr() + 2u);
+
+  auto e = Vec<u8>();
+  EXPECT_EQ(e.spare_capacity_mut().len(), 0u);
+}
+
+TEST(Vec, ExtendWithUninit) {
+  auto v = Vec<u8>(1_u8);
+  v.extend_with_uninit(4u, [](SliceMut<u8> s) {
+    EXPECT_EQ(s.len(), 4u);
+    s[0u] = 2_u8;
+    s[1u] = 3_u8;
+    return 2_usize;
+  });
+  EXPECT_EQ(v, Vec<u8>(1_u8, 2_u8, 3_u8));
+  EXPECT_GE(v.capacity(), 5u);
+
+  v.extend_with_uninit(0u, [](SliceMut<u8> s) {
+    EXPECT_EQ(s.len(), 0u);
+    return 0_usize;
+  });
+  EXPECT_EQ(v, Vec<u8>(1_u8, 2_u8, 3_u8));
+}
+
+TEST(VecDeathTest, ExtendWithUninitTooMany) {
+  auto v = Vec<u8>();
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(v.extend_with_uninit(2u, [](SliceMut<u8>) { return 3_usize; }),
+               "");
+#endif
+}
+
+TEST(Vec, ResizeWith) {
+  auto v = Vec<i32>(1, 2);
+  i32 next = 3;
+  v.resize_with(5u, [&]() {
+    next += 1;
+    return next - 1;
+  });
+  EXPECT_EQ(v, Vec<i32>(1, 2, 3, 4, 5));
+  v.resize_with(2u, []() -> i32 {
+    ADD_FAILURE();
+    return 0;
+  });
+  EXPECT_EQ(v, Vec<i32>(1, 2));
+
+  auto s = Vec<std::string>();
+  s.resize_with(2u, []() { return std::string("a"); });
+  EXPECT_EQ(s, Vec<std::string>(std::string("a"), std::string("a")));
+}
+
 TEST(Vec, fmt) {
   auto v = Vec<i32>(1, 2, 3, 4, 5);
   EXPECT_EQ(fmt::format("{}", v), "[1, 2, 3, 4, 5]");
@@ -1458,6 +1824,33 @@ TEST(VecDeathTest, IteratorInvalidation) {
 #endif
 }
 
+TEST(Vec, IterateOnThreads) {
+  auto v = sus::Vec<i32>();
+  for (i32 i : sus::ops::range(0_i32, 1000_i32)) v.push(i);
+
+  // Iterators on a shared Vec can be created and destroyed from many threads
+  // at once.
+  const auto& shared = v;
+  auto sums = sus::Array<i32, 8u>();
+  std::vector<std::thread> threads;
+  for (usize t : sus::ops::range(0_usize, 8_usize)) {
+    threads.emplace_back([&shared, &sums, t] {
+      for (usize n : sus::ops::range(0_usize, 100_usize)) {
+        i32 sum;
+        for (const i32& i : shared.iter()) sum += i;
+        sums[t] = sum;
+        ensure_use(&n);
+      }
+    });
+  }
+  for (std::thread& t : threads) t.join();
+  for (i32 sum : sums) EXPECT_EQ(sum, 499500);
+
+  // Every iterator was counted and released, so the Vec can be mutated.
+  v.push(1000);
+  EXPECT_EQ(v.len(), 1001u);
+}
+
 TEST(Vec, SliceInvalidation) {
   auto vec = sus::Vec<i32>(1, 2);
   const sus::Slice<i32>& s = vec;
@@ -0,0 +1,269 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <bit>
+#include <type_traits>
+
+#if _MSC_VER
+#  include <intrin.h>
+#endif
+
+#include "sus/collections/slice.h"
+#include "sus/hash/hash.h"
+#include "sus/macros/inline.h"
+#include "sus/macros/pure.h"
+#include "sus/mem/relocate.h"
+#include "sus/num/unsigned_integer.h"
+
+namespace sus::hash {
+
+namespace __private {
+
+/// Multiplies `x` and `y` into 128 bits, and folds the high half into the
+/// low half with xor.
+__sus_pure_const _sus_always_inline constexpr uint64_t folded_multiply(
+    uint64_t x, uint64_t y) noexcept {
+#if _MSC_VER
+  if (!std::is_constant_evaluated()) {
+    uint64_t hi;
+    const uint64_t lo = _umul128(x, y, &hi);
+    return lo ^ hi;
+  }
+  // Schoolbook multiplication of 32-bit halves, for constant evaluation.
+  const uint64_t x_lo = x & 0xffffffffu, x_hi = x >> 32u;
+  const uint64_t y_lo = y & 0xffffffffu, y_hi = y >> 32u;
+  const uint64_t ll = x_lo * y_lo, lh = x_lo * y_hi;
+  const uint64_t hl = x_hi * y_lo, hh = x_hi * y_hi;
+  const uint64_t mid = (ll >> 32u) + (lh & 0xffffffffu) + (hl & 0xffffffffu);
+  const uint64_t lo = (mid << 32u) | (ll & 0xffffffffu);
+  const uint64_t hi = hh + (lh >> 32u) + (hl >> 32u) + (mid >> 32u);
+  return lo ^ hi;
+#else
+  const __uint128_t full = __uint128_t{x} * __uint128_t{y};
+  return static_cast<uint64_t>(full) ^ static_cast<uint64_t>(full >> 64u);
+#endif
+}
+
+/// Reads `N` bytes from `p` as a little-endian integer.
+template <size_t N>
+_sus_always_inline constexpr uint64_t read_le(
+    const ::sus::num::u8* p) noexcept {
+  if (std::is_constant_evaluated()) {
+    uint64_t out = 0u;
+    for (size_t i = 0u; i < N; i += 1u)
+      out |= uint64_t{p[i].primitive_value} << (i * 8u);
+    return out;
+  }
+  std::conditional_t<N == 8u, uint64_t, uint32_t> out;
+  static_assert(sizeof(out) == N);
+  memcpy(&out, p, N);
+  if constexpr (std::endian::native == std::endian::big) {
+    if constexpr (N == 8u)
+      out = __builtin_bswap64(out);
+    else
+      out = __builtin_bswap32(out);
+  }
+  return out;
+}
+
+// Digits of pi, as arbitrary constants with lots of set and unset bits.
+inline constexpr uint64_t kHashSeeds[5u] = {
+    0x243f6a8885a308d3u, 0x13198a2e03707344u, 0xa4093822299f31d0u,
+    0x082efa98ec4e6c89u, 0x452821e638d01377u,
+};
+
+}  // namespace __private
+
+/// A fast, non-cryptographic [`Hasher`]($sus::hash::Hasher).
+///
+/// `DefaultHasher` is the `Hasher` used by
+/// [`HashMap`]($sus::collections::HashMap) and
+/// [`HashSet`]($sus::collections::HashSet), through
+/// [`BuildHasherDefault`]($sus::hash::BuildHasherDefault).
+///
+/// It is in the family of folded-multiply hashers such as wyhash and foldhash.
+/// Each step multiplies two 64-bit values into a 128-bit product and folds its
+/// halves together with xor, which mixes every input bit into the output in a
+/// single multiply instruction.
+/// * Integers written with `write_u8()` through `write_u64()` are packed into
+///   a 128-bit buffer, and are only mixed into the hash state once the buffer
+///   is full or the hash is finished. Hashing a tuple of small integers costs
+///   a single multiply for every 16 bytes.
+/// * Bytes written with `write()` are read 16 bytes at a time, in two
+///   independent lanes for inputs of more than 32 bytes. Short inputs are read
+///   with two overlapping loads and no loop.
+///
+/// `DefaultHasher` is deterministic: the same values written in the same
+/// order produce the same hash value within a build of the program. Use
+/// `with_seed()` to vary the hash values. It does not protect against
+/// adversarial inputs that are crafted to collide, so it should not be used
+/// for tables whose keys come from untrusted sources unless it is seeded with
+/// a secret random value.
+///
+/// `DefaultHasher` can be used in constant expressions.
+class DefaultHasher final {
+ public:
+  /// Constructs a `DefaultHasher` with a fixed seed.
+  ///
+  /// Satisfies the [`Default`]($sus::construct::Default) concept.
+  constexpr DefaultHasher() noexcept : DefaultHasher(uint64_t{0u}) {}
+
+  /// Constructs a `DefaultHasher` whose hash values depend on `seed`.
+  _sus_pure static constexpr DefaultHasher with_seed(
+      ::sus::num::u64 seed) noexcept {
+    return DefaultHasher(seed.primitive_value);
+  }
+
+  /// Writes the bytes into the hash state.
+  ///
+  /// Satisfies the [`Hasher`]($sus::hash::Hasher) concept.
+  constexpr void write(
+      ::sus::collections::Slice<::sus::num::u8> bytes) noexcept {
+    using __private::folded_multiply;
+    using __private::kHashSeeds;
+    using __private::read_le;
+
+    const ::sus::num::u8* p = bytes.as_ptr();
+    const size_t len = bytes.len().primitive_value;
+    uint64_t a, b;
+    uint64_t s0 = accumulator_;
+    uint64_t s1 = fold_seed_;
+    if (len <= 16u) {
+      if (len >= 8u) {
+        a = read_le<8u>(p);
+        b = read_le<8u>(p + len - 8u);
+      } else if (len >= 4u) {
+        a = read_le<4u>(p);
+        b = read_le<4u>(p + len - 4u);
+      } else if (len > 0u) {
+        a = p[0u].primitive_value;
+        b = uint64_t{p[len / 2u].primitive_value} << 8u |
+            uint64_t{p[len - 1u].primitive_value};
+      } else {
+        a = b = 0u;
+      }
+    } else {
+      const ::sus::num::u8* const end = p + len;
+      size_t remain = len;
+      while (remain > 32u) {
+        s0 = folded_multiply(read_le<8u>(p) ^ kHashSeeds[1u],
+                             read_le<8u>(p + 8u) ^ s0);
+        s1 = folded_multiply(read_le<8u>(p + 16u) ^ kHashSeeds[2u],
+                             read_le<8u>(p + 24u) ^ s1);
+        p += 32u;
+        remain -= 32u;
+      }
+      if (remain > 16u) {
+        s0 = folded_multiply(read_le<8u>(p) ^ kHashSeeds[1u],
+                             read_le<8u>(p + 8u) ^ s0);
+      }
+      // The last 16 bytes, which may overlap with bytes already read.
+      a = read_le<8u>(end - 16u);
+      b = read_le<8u>(end - 8u);
+      s0 ^= s1;
+      s1 = fold_seed_;
+    }
+    accumulator_ = folded_multiply(a ^ s0, b ^ s1 ^ uint64_t{len});
+  }
+
+  /// Writes the integer into the hash state.
+  ///
+  /// Satisfies the [`Hasher`]($sus::hash::Hasher) concept.
+  _sus_always_inline constexpr void write_u8(::sus::num::u8 i) noexcept {
+    write_num(i.primitive_value, 8u);
+  }
+  /// Writes the integer into the hash state.
+  ///
+  /// Satisfies the [`Hasher`]($sus::hash::Hasher) concept.
+  _sus_always_inline constexpr void write_u16(::sus::num::u16 i) noexcept {
+    write_num(i.primitive_value, 16u);
+  }
+  /// Writes the integer into the hash state.
+  ///
+  /// Satisfies the [`Hasher`]($sus::hash::Hasher) concept.
+  _sus_always_inline constexpr void write_u32(::sus::num::u32 i) noexcept {
+    write_num(i.primitive_value, 32u);
+  }
+  /// Writes the integer into the hash state.
+  ///
+  /// Satisfies the [`Hasher`]($sus::hash::Hasher) concept.
+  _sus_always_inline constexpr void write_u64(::sus::num::u64 i) noexcept {
+    write_num(i.primitive_value, 64u);
+  }
+
+  /// Returns the hash value for everything written so far.
+  ///
+  /// Satisfies the [`Hasher`]($sus::hash::Hasher) concept.
+  _sus_pure constexpr ::sus::num::u64 finish() const& noexcept {
+    uint64_t acc = accumulator_;
+    if (sponge_bits_ > 0u)
+      acc = __private::folded_multiply(sponge_lo_ ^ acc,
+                                       sponge_hi_ ^ fold_seed_);
+    return __private::folded_multiply(acc, finish_seed_);
+  }
+
+ private:
+  explicit constexpr DefaultHasher(uint64_t seed) noexcept
+      : accumulator_(seed ^ __private::kHashSeeds[0u]),
+        fold_seed_(__private::folded_multiply(seed ^ __private::kHashSeeds[1u],
+                                              __private::kHashSeeds[2u]) ^
+                   __private::kHashSeeds[3u]),
+        finish_seed_(fold_seed_ ^ __private::kHashSeeds[4u]) {}
+
+  /// Appends an integer of `bits` bits to the 128-bit sponge, and mixes the
+  /// sponge into the accumulator first if the integer would not fit.
+  _sus_always_inline constexpr void write_num(uint64_t x,
+                                              uint32_t bits) noexcept {
+    if (sponge_bits_ + bits > 128u) {
+      accumulator_ = __private::folded_multiply(sponge_lo_ ^ accumulator_,
+                                                sponge_hi_ ^ fold_seed_);
+      sponge_lo_ = x;
+      sponge_hi_ = 0u;
+      sponge_bits_ = bits;
+    } else if (sponge_bits_ < 64u) {
+      sponge_lo_ |= x << sponge_bits_;
+      // The high bits of `x` that do not fit in the low word.
+      if (sponge_bits_ + bits > 64u) sponge_hi_ |= x >> (64u - sponge_bits_);
+      sponge_bits_ += bits;
+    } else {
+      sponge_hi_ |= x << (sponge_bits_ - 64u);
+      sponge_bits_ += bits;
+    }
+  }
+
+  uint64_t accumulator_;
+  uint64_t fold_seed_;
+  uint64_t finish_seed_;
+  uint64_t sponge_lo_ = 0u;
+  uint64_t sponge_hi_ = 0u;
+  uint32_t sponge_bits_ = 0u;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn,
+                                  decltype(accumulator_), decltype(fold_seed_),
+                                  decltype(finish_seed_), decltype(sponge_lo_),
+                                  decltype(sponge_hi_),
+                                  decltype(sponge_bits_));
+};
+
+}  // namespace sus::hash
+
+// Promote the hashing types into the `sus` namespace.
+namespace sus {
+using ::sus::hash::DefaultHasher;
+}  // namespace sus
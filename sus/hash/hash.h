@@ -0,0 +1,264 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <bit>
+#include <concepts>
+#include <functional>
+#include <type_traits>
+
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/macros/inline.h"
+
+namespace sus {
+/// Generic hashing support.
+///
+/// Types are hashed by feeding their contents into a
+/// [`Hasher`]($sus::hash::Hasher) through the [`Hash`]($sus::hash::Hash)
+/// concept.
+namespace hash {}
+}  // namespace sus
+
+namespace sus::hash {
+
+/// Specialize `HashImpl` to make a type satisfy [`Hash`]($sus::hash::Hash)
+/// when the type can not be given a `hash()` method, such as for types from
+/// other libraries.
+///
+/// The specialization provides a static method:
+/// ```
+/// template <::sus::hash::Hasher H>
+/// static constexpr void hash(const T& value, H& state) noexcept;
+/// ```
+template <class T>
+struct HashImpl;
+
+/// A `Hasher` builds a hash value out of a stream of bytes and integers.
+///
+/// Types that satisfy [`Hash`]($sus::hash::Hash) feed their contents to a
+/// `Hasher`, which combines them into a `u64` returned from `finish()`. The
+/// [`DefaultHasher`]($sus::hash::DefaultHasher) is a fast `Hasher` and is what
+/// is used by [`HashMap`]($sus::collections::HashMap) and
+/// [`HashSet`]($sus::collections::HashSet) by default.
+///
+/// A `Hasher` has the following methods:
+/// * `write(Slice<u8>)` to write a contiguous run of bytes. Types should
+///   write their contents in as few calls as possible, as each call has some
+///   overhead.
+/// * `write_u8(u8)`, `write_u16(u16)`, `write_u32(u32)` and `write_u64(u64)`
+///   to write a single integer. A `Hasher` may buffer the integers and combine
+///   them together, which is much faster than writing them as bytes.
+/// * `finish() const -> u64` to produce the hash value of everything written
+///   so far. It does not reset the `Hasher`.
+///
+/// Like [`std::hash`](https://en.cppreference.com/w/cpp/utility/hash), the
+/// hash values are not portable across builds, platforms or versions of the
+/// library, and should not be persisted.
+template <class H>
+concept Hasher = requires(
+    H& h, const H& ch, ::sus::collections::Slice<::sus::num::u8> bytes,
+    ::sus::num::u8 v8, ::sus::num::u16 v16, ::sus::num::u32 v32,
+    ::sus::num::u64 v64) {
+  { h.write(bytes) } -> std::same_as<void>;
+  { h.write_u8(v8) } -> std::same_as<void>;
+  { h.write_u16(v16) } -> std::same_as<void>;
+  { h.write_u32(v32) } -> std::same_as<void>;
+  { h.write_u64(v64) } -> std::same_as<void>;
+  { ch.finish() } -> std::same_as<::sus::num::u64>;
+};
+
+namespace __private {
+
+/// A type that satisfies `Hasher` for checking if a type is `Hash`.
+struct HasherArchetype {
+  void write(::sus::collections::Slice<::sus::num::u8>);
+  void write_u8(::sus::num::u8);
+  void write_u16(::sus::num::u16);
+  void write_u32(::sus::num::u32);
+  void write_u64(::sus::num::u64);
+  ::sus::num::u64 finish() const;
+};
+
+template <class T, class H>
+concept HasHashImpl = requires(const T& t, H& h) {
+  { HashImpl<T>::hash(t, h) } -> std::same_as<void>;
+};
+
+template <class T, class H>
+concept HasHashMethod = requires(const T& t, H& h) {
+  { t.hash(h) } -> std::same_as<void>;
+};
+
+template <class T>
+concept HashAsScalar =
+    std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T> ||
+    std::same_as<T, float> || std::same_as<T, double> ||
+    std::same_as<T, std::nullptr_t>;
+
+template <class T>
+concept HasStdHash = requires(const T& t) {
+  { std::hash<T>()(t) } -> std::convertible_to<size_t>;
+};
+
+/// Writes an unsigned integer of 1 to 8 bytes to the `Hasher`, with the
+/// matching `write_uN()` method.
+template <class U, Hasher H>
+_sus_always_inline constexpr void write_unsigned(U u, H& state) noexcept {
+  static_assert(std::is_unsigned_v<U>);
+  if constexpr (sizeof(U) == 1u) {
+    state.write_u8(uint8_t{u});
+  } else if constexpr (sizeof(U) == 2u) {
+    state.write_u16(uint16_t{u});
+  } else if constexpr (sizeof(U) == 4u) {
+    state.write_u32(uint32_t{u});
+  } else if constexpr (sizeof(U) == 8u) {
+    state.write_u64(uint64_t{u});
+  } else {
+    static_assert(sizeof(U) == 16u);
+    state.write_u64(static_cast<uint64_t>(u));
+    state.write_u64(static_cast<uint64_t>(u >> 64u));
+  }
+}
+
+template <class T, Hasher H>
+_sus_always_inline constexpr void hash_scalar(const T& t, H& state) noexcept {
+  if constexpr (std::is_same_v<T, bool>) {
+    state.write_u8(uint8_t{t});
+  } else if constexpr (std::is_integral_v<T>) {
+    write_unsigned(static_cast<std::make_unsigned_t<T>>(t), state);
+  } else if constexpr (std::is_enum_v<T>) {
+    write_unsigned(
+        static_cast<std::make_unsigned_t<std::underlying_type_t<T>>>(t),
+        state);
+  } else if constexpr (std::is_pointer_v<T>) {
+    write_unsigned(std::bit_cast<uintptr_t>(t), state);
+  } else if constexpr (std::is_same_v<T, std::nullptr_t>) {
+    state.write_u8(uint8_t{0u});
+  } else {
+    // Floating point. Zero and negative zero are equal, so they must hash the
+    // same. NaN is not equal to anything, so its bits are hashed as is.
+    using U = std::conditional_t<sizeof(T) == 4u, uint32_t, uint64_t>;
+    write_unsigned(t == T{0} ? U{0u} : std::bit_cast<U>(t), state);
+  }
+}
+
+}  // namespace __private
+
+/// Feeds `value` into the `Hasher` `state`.
+///
+/// This is the generic way to hash any type that satisfies
+/// [`Hash`]($sus::hash::Hash), and is how types should hash their members
+/// from their own `hash()` method.
+template <class T, Hasher H>
+  requires(__private::HasHashImpl<T, H> || __private::HasHashMethod<T, H> ||
+           __private::HashAsScalar<T> || __private::HasStdHash<T>)
+_sus_always_inline constexpr void hash_into(const T& value, H& state) noexcept {
+  if constexpr (__private::HasHashImpl<T, H>) {
+    HashImpl<T>::hash(value, state);
+  } else if constexpr (__private::HasHashMethod<T, H>) {
+    value.hash(state);
+  } else if constexpr (__private::HashAsScalar<T>) {
+    __private::hash_scalar(value, state);
+  } else {
+    // A type from outside the library which provides `std::hash` only. Its
+    // hash value is mixed into the `Hasher` like any other integer.
+    __private::write_unsigned(static_cast<size_t>(std::hash<T>()(value)),
+                              state);
+  }
+}
+
+/// A `Hash` type can be fed into a [`Hasher`]($sus::hash::Hasher) to produce
+/// a hash value for it.
+///
+/// Values that are equal must produce the same hash value, which means they
+/// must write the same things into the `Hasher`. Values that are different
+/// should write different things into the `Hasher`, though hash values can
+/// always collide.
+///
+/// A type `T` is `Hash` if one of the following holds:
+/// * There is a specialization of [`HashImpl<T>`]($sus::hash::HashImpl). This
+///   is how the library types are `Hash`.
+/// * It has a method `template <Hasher H> void hash(H& state) const`.
+/// * It is an integer, `bool`, enum, pointer, `float` or `double`.
+/// * It has a `std::hash<T>` specialization. The `size_t` produced by
+///   `std::hash` is written into the `Hasher`. This allows types from other
+///   libraries, like `std::string`, to be used as keys in a
+///   [`HashMap`]($sus::collections::HashMap).
+///
+/// This concept tests the object type of `T`, looking through reference types
+/// `T&` or `const T&`.
+///
+/// # Implementing `Hash`
+/// A type hashes each of the fields that participate in its `operator==`:
+/// ```
+/// struct Point {
+///   i32 x;
+///   i32 y;
+///
+///   template <sus::hash::Hasher H>
+///   constexpr void hash(H& state) const noexcept {
+///     sus::hash::hash_into(x, state);
+///     sus::hash::hash_into(y, state);
+///   }
+///   friend bool operator==(const Point&, const Point&) = default;
+/// };
+/// ```
+template <class T>
+concept Hash = requires(const std::remove_cvref_t<T>& t,
+                        __private::HasherArchetype& h) {
+  ::sus::hash::hash_into(t, h);
+};
+
+/// Builds [`Hasher`]($sus::hash::Hasher)s of type `H` by default-constructing
+/// them, and uses them to hash values.
+///
+/// `BuildHasherDefault` can be called as `size_t(const T&)` for any type that
+/// satisfies [`Hash`]($sus::hash::Hash), which makes it usable as the hasher
+/// for [`HashMap`]($sus::collections::HashMap) and
+/// [`HashSet`]($sus::collections::HashSet), and also as the hash function of
+/// standard containers such as `std::unordered_map`:
+/// ```
+/// auto m = std::unordered_map<sus::Option<i32>, i32,
+///                             sus::hash::BuildHasherDefault<>>();
+/// ```
+template <class H>
+struct BuildHasherDefault {
+  static_assert(Hasher<H>);
+  static_assert(std::default_initializable<H>);
+
+  /// Constructs a new [`Hasher`]($sus::hash::Hasher).
+  _sus_always_inline constexpr H build_hasher() const noexcept { return H(); }
+
+  /// Computes the hash value of `value` with a new
+  /// [`Hasher`]($sus::hash::Hasher), returning the `u64` from its `finish()`.
+  template <Hash T>
+  _sus_always_inline constexpr auto hash_one(const T& value) const noexcept {
+    H state = build_hasher();
+    ::sus::hash::hash_into(value, state);
+    return state.finish();
+  }
+
+  /// Computes the hash value of `value` as a `size_t`, like `std::hash`.
+  template <Hash T>
+  _sus_always_inline constexpr size_t operator()(
+      const T& value) const noexcept {
+    return static_cast<size_t>(hash_one(value).primitive_value);
+  }
+};
+
+}  // namespace sus::hash
@@ -0,0 +1,257 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/hash/hash.h"
+
+#include <string>
+#include <unordered_map>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/choice/choice.h"
+#include "sus/collections/array.h"
+#include "sus/collections/vec.h"
+#include "sus/hash/default_hasher.h"
+#include "sus/option/option.h"
+#include "sus/prelude.h"
+#include "sus/result/result.h"
+#include "sus/tuple/tuple.h"
+
+namespace {
+
+using sus::hash::BuildHasherDefault;
+using sus::hash::DefaultHasher;
+using sus::hash::Hash;
+using sus::hash::Hasher;
+
+struct Point {
+  i32 x;
+  i32 y;
+
+  template <Hasher H>
+  constexpr void hash(H& state) const noexcept {
+    sus::hash::hash_into(x, state);
+    sus::hash::hash_into(y, state);
+  }
+  friend bool operator==(const Point&, const Point&) = default;
+};
+
+struct NotHash {};
+
+static_assert(Hasher<DefaultHasher>);
+static_assert(Hash<i32>);
+static_assert(Hash<const u64&>);
+static_assert(Hash<f64>);
+static_assert(Hash<int>);
+static_assert(Hash<bool>);
+static_assert(Hash<int*>);
+static_assert(Hash<std::string>);
+static_assert(Hash<Point>);
+static_assert(Hash<sus::Option<i32>>);
+static_assert(Hash<sus::Option<i32&>>);
+static_assert(Hash<sus::Result<void, i32>>);
+static_assert(Hash<sus::Tuple<i32, std::string>>);
+static_assert(Hash<sus::Slice<i32>>);
+static_assert(Hash<sus::SliceMut<i32>>);
+static_assert(Hash<sus::Vec<Point>>);
+static_assert(Hash<sus::Array<i32, 3>>);
+static_assert(!Hash<NotHash>);
+static_assert(!Hash<sus::Option<NotHash>>);
+static_assert(!Hash<sus::Tuple<i32, NotHash>>);
+static_assert(!Hash<sus::Vec<NotHash>>);
+
+template <class T>
+constexpr u64 hash_of(const T& t) {
+  return BuildHasherDefault<>().hash_one(t);
+}
+
+TEST(Hash, Integers) {
+  EXPECT_EQ(hash_of(1_i32), hash_of(1_i32));
+  EXPECT_NE(hash_of(1_i32), hash_of(2_i32));
+  EXPECT_NE(hash_of(0_i32), hash_of(-1_i32));
+  // Sus integers hash the same as their primitive values.
+  EXPECT_EQ(hash_of(7_u64), hash_of(uint64_t{7u}));
+  EXPECT_EQ(hash_of(-7_i16), hash_of(int16_t{-7}));
+
+  // Nearby values land in different buckets of a small table.
+  auto low_bits = sus::Vec<u64>();
+  for (u64 i : sus::ops::range(0_u64, 64_u64))
+    low_bits.push(hash_of(i) & 0xff_u64);
+  low_bits.sort();
+  low_bits.dedup();
+  EXPECT_GT(low_bits.len(), 32u);
+}
+
+TEST(Hash, Floats) {
+  EXPECT_EQ(hash_of(0.0_f64), hash_of(-0.0_f64));
+  EXPECT_EQ(hash_of(0.0_f32), hash_of(-0.0_f32));
+  EXPECT_NE(hash_of(1.0_f64), hash_of(2.0_f64));
+  EXPECT_EQ(hash_of(1.5_f32), hash_of(1.5f));
+}
+
+TEST(Hash, Constexpr) {
+  constexpr u64 a = hash_of(1_i32);
+  EXPECT_EQ(a, hash_of(1_i32));
+
+  static constexpr u8 bytes[] = {1_u8, 2_u8, 3_u8};
+  constexpr u64 b = hash_of(
+      sus::Slice<u8>::from_raw_parts(unsafe_fn, bytes, sizeof(bytes)));
+  EXPECT_EQ(b, hash_of(sus::Array<u8, 3>(1_u8, 2_u8, 3_u8)));
+
+  // Slices of integers are hashed as bytes, which is emulated in a constant
+  // expression.
+  constexpr u64 c = hash_of(sus::Array<i32, 3>(1, 2, 3));
+  EXPECT_EQ(c, hash_of(sus::Vec<i32>(1, 2, 3)));
+}
+
+TEST(Hash, Collections) {
+  auto v = sus::Vec<i32>(1, 2, 3);
+  auto a = sus::Array<i32, 3>(1, 2, 3);
+  EXPECT_EQ(hash_of(v), hash_of(a));
+  EXPECT_EQ(hash_of(v), hash_of(v.as_slice()));
+  EXPECT_EQ(hash_of(v), hash_of(v.as_mut_slice()));
+  EXPECT_NE(hash_of(v), hash_of(sus::Vec<i32>(1, 2)));
+  EXPECT_NE(hash_of(v), hash_of(sus::Vec<i32>(3, 2, 1)));
+
+  // The length is hashed, so moving an element between nested collections
+  // changes the hash.
+  auto n1 = sus::Vec<sus::Vec<i32>>(sus::Vec<i32>(1, 2), sus::Vec<i32>(3));
+  auto n2 = sus::Vec<sus::Vec<i32>>(sus::Vec<i32>(1), sus::Vec<i32>(2, 3));
+  EXPECT_NE(hash_of(n1), hash_of(n2));
+
+  // Elements that are not hashed as bytes.
+  auto p = sus::Vec<Point>(Point(1, 2), Point(3, 4));
+  EXPECT_EQ(hash_of(p), hash_of(sus::Vec<Point>(Point(1, 2), Point(3, 4))));
+  EXPECT_NE(hash_of(p), hash_of(sus::Vec<Point>(Point(1, 2), Point(4, 3))));
+}
+
+TEST(Hash, Option) {
+  EXPECT_EQ(hash_of(sus::Option<i32>(1_i32)), hash_of(sus::Option<i32>(1_i32)));
+  EXPECT_NE(hash_of(sus::Option<i32>()), hash_of(sus::Option<i32>(0_i32)));
+  i32 i = 3;
+  EXPECT_EQ(hash_of(sus::Option<i32&>(i)), hash_of(sus::Option<i32>(3_i32)));
+}
+
+TEST(Hash, Result) {
+  using R = sus::Result<i32, i32>;
+  EXPECT_EQ(hash_of(R(1_i32)), hash_of(R(1_i32)));
+  EXPECT_NE(hash_of(R(1_i32)), hash_of(R::with_err(1_i32)));
+  using V = sus::Result<void, i32>;
+  EXPECT_NE(hash_of(V(sus::result::OkVoid())), hash_of(V::with_err(0_i32)));
+}
+
+TEST(Hash, Tuple) {
+  auto t = sus::Tuple<i32, i32>(1, 2);
+  EXPECT_EQ(hash_of(t), hash_of(sus::Tuple<i32, i32>(1, 2)));
+  EXPECT_NE(hash_of(t), hash_of(sus::Tuple<i32, i32>(2, 1)));
+  // A Tuple hashes the same as a type that hashes the same fields.
+  EXPECT_EQ(hash_of(t), hash_of(Point(1, 2)));
+}
+
+TEST(Hash, Choice) {
+  enum class Tag { A, B, C };
+  using C = sus::Choice<sus_choice_types((Tag::A, i32), (Tag::B, i32),
+                                         (Tag::C, void))>;
+  static_assert(Hash<C>);
+  EXPECT_EQ(hash_of(C::with<Tag::A>(1)), hash_of(C::with<Tag::A>(1)));
+  EXPECT_NE(hash_of(C::with<Tag::A>(1)), hash_of(C::with<Tag::A>(2)));
+  EXPECT_NE(hash_of(C::with<Tag::A>(1)), hash_of(C::with<Tag::B>(1)));
+  EXPECT_EQ(hash_of(C::with<Tag::C>()), hash_of(C::with<Tag::C>()));
+
+  using N = sus::Choice<sus_choice_types((Tag::A, NotHash), (Tag::B, i32))>;
+  static_assert(!Hash<N>);
+}
+
+TEST(Hash, StdHash) {
+  EXPECT_EQ(hash_of(std::string("hello")), hash_of(std::string("hello")));
+  EXPECT_NE(hash_of(std::string("hello")), hash_of(std::string("world")));
+}
+
+TEST(Hash, UnorderedMap) {
+  auto m = std::unordered_map<sus::Option<i32>, i32, BuildHasherDefault<>>();
+  m[sus::Option<i32>(1_i32)] = 2;
+  m[sus::Option<i32>()] = 3;
+  EXPECT_EQ(m.at(sus::Option<i32>(1_i32)), 2);
+  EXPECT_EQ(m.at(sus::Option<i32>()), 3);
+}
+
+TEST(DefaultHasher, WriteLengths) {
+  auto bytes = sus::Vec<u8>();
+  for (u8 i : sus::ops::range(0_u8, 200_u8)) bytes.push(i);
+
+  // Every length, including those read with overlapping loads, and inputs
+  // that are longer than the 2-lane loop.
+  auto hashes = sus::Vec<u64>();
+  for (usize len : sus::ops::range(0_usize, 129_usize)) {
+    auto h = DefaultHasher();
+    h.write(bytes[sus::ops::range(0_usize, len)]);
+    hashes.push(h.finish());
+
+    auto h2 = DefaultHasher();
+    h2.write(bytes[sus::ops::range(0_usize, len)]);
+    EXPECT_EQ(h.finish(), h2.finish());
+  }
+  hashes.sort();
+  hashes.dedup();
+  EXPECT_EQ(hashes.len(), 129u);
+
+  // Changing any single byte changes the hash.
+  for (usize len : sus::Array<usize, 4>(17u, 32u, 33u, 100u)) {
+    auto h = DefaultHasher();
+    h.write(bytes[sus::ops::range(0_usize, len)]);
+    const u64 first = h.finish();
+    for (usize i : sus::ops::range(0_usize, len)) {
+      auto copy = sus::Vec<u8>::from(bytes[sus::ops::range(0_usize, len)]);
+      copy[i] ^= 0x80_u8;
+      auto h2 = DefaultHasher();
+      h2.write(copy);
+      EXPECT_NE(h2.finish(), first);
+    }
+  }
+}
+
+TEST(DefaultHasher, WriteIntegers) {
+  // Integers written after the buffer is full are still hashed.
+  auto a = DefaultHasher();
+  auto b = DefaultHasher();
+  for (u32 i : sus::ops::range(0_u32, 9_u32)) a.write_u32(i);
+  for (u32 i : sus::ops::range(0_u32, 9_u32)) b.write_u32(i == 8u ? 9_u32 : i);
+  EXPECT_NE(a.finish(), b.finish());
+
+  // The width of a write spans two words of the buffer.
+  auto c = DefaultHasher();
+  c.write_u32(1u);
+  c.write_u64(2u);
+  auto d = DefaultHasher();
+  d.write_u32(1u);
+  d.write_u64(3u);
+  EXPECT_NE(c.finish(), d.finish());
+
+  // Finishing does not reset the hasher.
+  EXPECT_EQ(c.finish(), c.finish());
+  auto e = DefaultHasher();
+  EXPECT_NE(e.finish(), c.finish());
+}
+
+TEST(DefaultHasher, WithSeed) {
+  auto a = DefaultHasher();
+  auto b = DefaultHasher::with_seed(1u);
+  auto c = DefaultHasher::with_seed(0u);
+  a.write_u64(5u);
+  b.write_u64(5u);
+  c.write_u64(5u);
+  EXPECT_NE(a.finish(), b.finish());
+  EXPECT_EQ(a.finish(), c.finish());
+}
+
+}  // namespace
@@ -0,0 +1,81 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+
+#include <type_traits>
+
+#include "sus/iter/size_hint.h"
+#include "sus/lib/__private/forward_decl.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+
+namespace sus::iter::__private {
+
+/// Types which always produce the same number of items when iterated, such as
+/// `Array`, have `kLen` set to that number.
+template <class T>
+struct FixedLen {
+  static constexpr bool kIsFixed = false;
+};
+
+template <class T, size_t N>
+struct FixedLen<::sus::collections::Array<T, N>> {
+  static constexpr bool kIsFixed = true;
+  static constexpr size_t kLen = N;
+};
+
+template <class T>
+concept FixedLenIterable = FixedLen<std::remove_cvref_t<T>>::kIsFixed;
+
+/// Returns the size hint of a flattening iterator, from the hints of the
+/// partly consumed iterators at its `front` and `back`, and of the iterator
+/// over the `rest` of the iterables.
+///
+/// When the iterables are `FixedLenIterable`, the iterables left in `rest` are
+/// counted too, so the hint is exact if the others are.
+template <class Iterable>
+constexpr SizeHint flatten_size_hint(const SizeHint& front,
+                                     const SizeHint& back,
+                                     const SizeHint& rest) noexcept {
+  usize lower = front.lower.saturating_add(back.lower);
+  if constexpr (FixedLenIterable<Iterable>) {
+    constexpr size_t kLen = FixedLen<std::remove_cvref_t<Iterable>>::kLen;
+    lower = lower.saturating_add(rest.lower.saturating_mul(kLen));
+    ::sus::Option<usize> upper;
+    if (front.upper.is_some() && back.upper.is_some()) {
+      upper = front.upper.as_value().checked_add(back.upper.as_value());
+      if constexpr (kLen > 0u) {
+        if (upper.is_some() && rest.upper.is_some()) {
+          const usize seen = upper.as_value();
+          upper = rest.upper.as_value().checked_mul(kLen).and_then(
+              [seen](usize in_rest) { return seen.checked_add(in_rest); });
+        } else {
+          upper = ::sus::Option<usize>();
+        }
+      }
+    }
+    return SizeHint(lower, ::sus::move(upper));
+  } else {
+    // We have no upper bound if there's any other iterators left, and we can't
+    // tell if there's any iterators left without additional tracking state.
+    return SizeHint(lower, ::sus::Option<usize>());
+  }
+}
+
+}  // namespace sus::iter::__private
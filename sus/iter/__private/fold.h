@@ -0,0 +1,65 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <type_traits>
+
+#include "sus/fn/fn_concepts.h"
+#include "sus/mem/addressof.h"
+#include "sus/mem/forward.h"
+#include "sus/mem/move.h"
+
+// Iterator adaptors may provide their own `fold()` and `try_fold()`, which
+// hide the ones in `IteratorBase`. They walk over their inner iterators with
+// those iterators' own `fold()` and `try_fold()` instead of going through
+// `next()` for each item, which lets nested iteration become a sequence of
+// plain loops. The methods of `IteratorBase` that consume items, such as
+// `count()`, `for_each()`, `all()` and `any()`, are built on them.
+
+namespace sus::iter::__private {
+
+/// The accumulator of a fold that only calls a function on each item, such as
+/// in `for_each()`.
+struct FoldUnit {};
+
+/// Returns a closure which calls `f` through a reference, to be given to the
+/// `fold()` or `try_fold()` of an inner iterator when `f` is used again after.
+template <class B, class Item, class F>
+constexpr auto fold_by_ref(F& f) noexcept {
+  return [&f](B acc, Item item) -> decltype(auto) {
+    return ::sus::fn::call_mut(f, ::sus::forward<B>(acc),
+                               ::sus::forward<Item>(item));
+  };
+}
+
+/// Folds `iter` into an accumulator of reference type `B`.
+///
+/// A reference can not be reassigned, so this folds over pointers instead,
+/// which lets adaptors implement `fold()` only for accumulators which are
+/// values.
+template <class B, class Item, class Iter, class F>
+  requires(std::is_reference_v<B>)
+constexpr B fold_through_pointer(Iter&& iter, B init, F& f) noexcept {
+  using P = std::remove_reference_t<B>*;
+  return *::sus::move(iter).template fold<P>(
+      ::sus::mem::addressof(init), [&f](P acc, Item item) -> P {
+        return ::sus::mem::addressof(
+            ::sus::fn::call_mut(f, *acc, ::sus::forward<Item>(item)));
+      });
+}
+
+}  // namespace sus::iter::__private
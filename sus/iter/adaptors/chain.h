@@ -17,6 +17,7 @@
 #pragma once
 
 #include "sus/fn/fn_concepts.h"
+#include "sus/iter/__private/fold.h"
 #include "sus/iter/iterator_defn.h"
 #include "sus/mem/move.h"
 #include "sus/mem/relocate.h"
@@ -124,6 +125,51 @@ class [[nodiscard]] Chain final
 
   // No exact_size_hint() as the size of two iterators may overflow.
 
+  /// Folds the items of each iterator in turn, with their own `fold()`.
+  template <class B, ::sus::fn::FnMut<::sus::fn::NonVoid(B, Item)> F>
+    requires(std::convertible_to<std::invoke_result_t<F&, B &&, Item &&>, B> &&
+             (!std::is_reference_v<B> ||
+              std::is_reference_v<std::invoke_result_t<F&, B &&, Item &&>>))
+  constexpr B fold(B init, F f) && noexcept {
+    if constexpr (std::is_reference_v<B>) {
+      return __private::fold_through_pointer<B, Item>(::sus::move(*this), init,
+                                                      f);
+    } else {
+      if (first_iter_.is_some()) {
+        init = ::sus::move(first_iter_)
+                   .unwrap_unchecked(::sus::marker::unsafe_fn)
+                   .fold(::sus::move(init), __private::fold_by_ref<B, Item>(f));
+      }
+      if (second_iter_.is_some()) {
+        init = ::sus::move(second_iter_)
+                   .unwrap_unchecked(::sus::marker::unsafe_fn)
+                   .fold(::sus::move(init), ::sus::move(f));
+      }
+      return init;
+    }
+  }
+
+  /// Folds the items of each iterator in turn, with their own `try_fold()`,
+  /// until `f` returns a failure.
+  template <class B, ::sus::fn::FnMut<::sus::fn::NonVoid(B, Item)> F, int&...,
+            class R = std::invoke_result_t<F&, B&&, Item&&>>
+    requires(::sus::ops::Try<R> &&
+             std::convertible_to<typename ::sus::ops::TryImpl<R>::Output, B>)
+  constexpr R try_fold(B init, F f) noexcept {
+    if (first_iter_.is_some()) {
+      R out = first_iter_.as_value_mut().try_fold(
+          ::sus::move(init), __private::fold_by_ref<B, Item>(f));
+      if (!::sus::ops::try_is_success(out)) return out;
+      init = ::sus::ops::try_into_output(::sus::move(out));
+      first_iter_ = Option<InnerSizedIter>();
+    }
+    if (second_iter_.is_some()) {
+      return second_iter_.as_value_mut().try_fold(
+          ::sus::move(init), __private::fold_by_ref<B, Item>(f));
+    }
+    return ::sus::ops::try_from_output<R>(::sus::move(init));
+  }
+
   // TODO: Implement nth(), nth_back(), etc...
 
  private:
@@ -57,7 +57,7 @@ class [[nodiscard]] Cloned final
 
   // sus::iter::DoubleEndedIterator trait.
   constexpr Option<Item> next_back() noexcept
-    requires(DoubleEndedIterator<InnerSizedIter, Item>)
+    requires(DoubleEndedIterator<InnerSizedIter, typename InnerSizedIter::Item>)
   {
     return next_iter_.next_back().map(
         [](const Item& item) { return ::sus::clone(item); });
@@ -65,7 +65,7 @@ class [[nodiscard]] Cloned final
 
   // sus::iter::ExactSizeIterator trait.
   constexpr usize exact_size_hint() const noexcept
-    requires(ExactSizeIterator<InnerSizedIter, Item>)
+    requires(ExactSizeIterator<InnerSizedIter, typename InnerSizedIter::Item>)
   {
     return next_iter_.exact_size_hint();
   }
@@ -78,6 +78,14 @@ class [[nodiscard]] Cloned final
     return {};
   }
 
+  /// sus::iter::__private::ContiguousIterator trait.
+  /// #[doc.hidden]
+  constexpr const Item* contiguous_data() const noexcept
+    requires(__private::ContiguousIterator<InnerSizedIter>)
+  {
+    return next_iter_.contiguous_data();
+  }
+
  private:
   template <class U, class V>
   friend class IteratorBase;
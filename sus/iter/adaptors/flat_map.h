@@ -17,6 +17,8 @@
 #pragma once
 
 #include "sus/fn/fn_concepts.h"
+#include "sus/iter/__private/flatten_size.h"
+#include "sus/iter/__private/fold.h"
 #include "sus/iter/iterator_defn.h"
 #include "sus/mem/move.h"
 #include "sus/mem/relocate.h"
@@ -86,17 +88,33 @@ class [[nodiscard]] FlatMap final
 
   /// sus::iter::Iterator trait.
   constexpr SizeHint size_hint() const noexcept {
-    auto [flo, fhi] = front_iter_.as_ref().map_or(
-        SizeHint(0u, ::sus::some(0u)),
-        [](const EachIter& i) { return i.size_hint(); });
-    auto [blo, bhi] = back_iter_.as_ref().map_or(
-        SizeHint(0u, ::sus::some(0u)),
-        [](const EachIter& i) { return i.size_hint(); });
-    // Lower bound is the items in the iterators we can see.
-    usize lo = flo.saturating_add(blo);
-    // We have no upper bound if there's any other iterators left, and we can't
-    // tell if there's any iterators left without additional tracking state.
-    return SizeHint(lo, ::sus::Option<usize>());
+    // The hint is exact when each iterable is an `Array`, as the remaining
+    // iterables can be counted.
+    return __private::flatten_size_hint<IntoIterable>(
+        front_iter_.as_ref().map_or(
+            SizeHint(0u, ::sus::some(0u)),
+            [](const EachIter& i) { return i.size_hint(); }),
+        back_iter_.as_ref().map_or(
+            SizeHint(0u, ::sus::some(0u)),
+            [](const EachIter& i) { return i.size_hint(); }),
+        iters_.size_hint());
+  }
+
+  /// sus::iter::ExactSizeIterator trait.
+  constexpr usize exact_size_hint() const noexcept
+    requires(__private::FixedLenIterable<IntoIterable> &&
+             ExactSizeIterator<InnerSizedIter, typename InnerSizedIter::Item>)
+  {
+    return size_hint().lower;
+  }
+
+  /// sus::iter::TrustedLen trait.
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept
+    requires(__private::FixedLenIterable<IntoIterable> &&
+             TrustedLen<InnerSizedIter> && TrustedLen<EachIter>)
+  {
+    return {};
   }
 
   // sus::iter::DoubleEndedIterator trait.
@@ -131,6 +149,75 @@ class [[nodiscard]] FlatMap final
     return out;
   }
 
+  /// Folds the items of each iterator in turn, with their own `fold()`.
+  template <class B, ::sus::fn::FnMut<::sus::fn::NonVoid(B, Item)> F>
+    requires(std::convertible_to<std::invoke_result_t<F&, B &&, Item &&>, B> &&
+             (!std::is_reference_v<B> ||
+              std::is_reference_v<std::invoke_result_t<F&, B &&, Item &&>>))
+  constexpr B fold(B init, F f) && noexcept {
+    if constexpr (std::is_reference_v<B>) {
+      return __private::fold_through_pointer<B, Item>(::sus::move(*this), init,
+                                                      f);
+    } else {
+      using InnerItem = typename InnerSizedIter::Item;
+      if (front_iter_.is_some()) {
+        init = ::sus::move(front_iter_)
+                   .unwrap_unchecked(::sus::marker::unsafe_fn)
+                   .fold(::sus::move(init), __private::fold_by_ref<B, Item>(f));
+      }
+      init = ::sus::move(iters_).fold(
+          ::sus::move(init), [this, &f](B acc, InnerItem item) -> B {
+            return ::sus::fn::call_mut(map_fn_,
+                                       ::sus::forward<InnerItem>(item))
+                .into_iter()
+                .fold(::sus::move(acc), __private::fold_by_ref<B, Item>(f));
+          });
+      if (back_iter_.is_some()) {
+        init = ::sus::move(back_iter_)
+                   .unwrap_unchecked(::sus::marker::unsafe_fn)
+                   .fold(::sus::move(init), ::sus::move(f));
+      }
+      return init;
+    }
+  }
+
+  /// Folds the items of each iterator in turn, with their own `try_fold()`,
+  /// until `f` returns a failure.
+  template <class B, ::sus::fn::FnMut<::sus::fn::NonVoid(B, Item)> F, int&...,
+            class R = std::invoke_result_t<F&, B&&, Item&&>>
+    requires(::sus::ops::Try<R> &&
+             std::convertible_to<typename ::sus::ops::TryImpl<R>::Output, B>)
+  constexpr R try_fold(B init, F f) noexcept {
+    using InnerItem = typename InnerSizedIter::Item;
+    if (front_iter_.is_some()) {
+      R out = front_iter_.as_value_mut().try_fold(
+          ::sus::move(init), __private::fold_by_ref<B, Item>(f));
+      if (!::sus::ops::try_is_success(out)) return out;
+      init = ::sus::ops::try_into_output(::sus::move(out));
+    }
+    // On failure, the iterator that produced it is left in front_iter_ so that
+    // iteration can resume from there.
+    R out = iters_.try_fold(
+        ::sus::move(init), [this, &f](B acc, InnerItem item) -> R {
+          return front_iter_
+              .insert(::sus::fn::call_mut(map_fn_,
+                                          ::sus::forward<InnerItem>(item))
+                          .into_iter())
+              .try_fold(::sus::move(acc), __private::fold_by_ref<B, Item>(f));
+        });
+    if (!::sus::ops::try_is_success(out)) return out;
+    init = ::sus::ops::try_into_output(::sus::move(out));
+    front_iter_ = Option<EachIter>();
+    if (back_iter_.is_some()) {
+      out = back_iter_.as_value_mut().try_fold(
+          ::sus::move(init), __private::fold_by_ref<B, Item>(f));
+      if (!::sus::ops::try_is_success(out)) return out;
+      init = ::sus::ops::try_into_output(::sus::move(out));
+      back_iter_ = Option<EachIter>();
+    }
+    return ::sus::ops::try_from_output<R>(::sus::move(init));
+  }
+
  private:
   template <class U, class V>
   friend class IteratorBase;
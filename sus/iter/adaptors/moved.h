@@ -87,6 +87,14 @@ class [[nodiscard]] Moved final
     return {};
   }
 
+  /// sus::iter::__private::ContiguousIterator trait.
+  /// #[doc.hidden]
+  constexpr const Item* contiguous_data() const noexcept
+    requires(__private::ContiguousIterator<InnerSizedIter>)
+  {
+    return next_iter_.contiguous_data();
+  }
+
  private:
   template <class R, class B, class E, class I>
   friend class IteratorOverRange;
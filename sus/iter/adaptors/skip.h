@@ -46,10 +46,7 @@ class [[nodiscard]] Skip final
 
   // sus::iter::Iterator trait.
   constexpr Option<Item> next() noexcept {
-    while (skip_ > 0u) {
-      next_iter_.next();
-      skip_ -= 1u;
-    }
+    skip_front();
     return next_iter_.next();
   }
   /// sus::iter::Iterator trait.
@@ -74,10 +71,47 @@ class [[nodiscard]] Skip final
   }
 
   // sus::iter::ExactSizeIterator trait.
-  constexpr usize exact_size_hint() const noexcept {
+  constexpr usize exact_size_hint() const noexcept
+    requires(ExactSizeIterator<InnerSizedIter, Item>)
+  {
     return next_iter_.exact_size_hint().saturating_sub(skip_);
   }
 
+  /// Skips the first items, then folds the rest with the inner iterator's
+  /// `fold()`.
+  template <class B, ::sus::fn::FnMut<::sus::fn::NonVoid(B, Item)> F>
+    requires(std::convertible_to<std::invoke_result_t<F&, B &&, Item &&>, B> &&
+             (!std::is_reference_v<B> ||
+              std::is_reference_v<std::invoke_result_t<F&, B &&, Item &&>>))
+  constexpr B fold(B init, F f) && noexcept {
+    skip_front();
+    return ::sus::move(next_iter_)
+        .template fold<B>(::sus::forward<B>(init), ::sus::move(f));
+  }
+
+  /// Skips the first items, then folds the rest with the inner iterator's
+  /// `try_fold()`.
+  template <class B, ::sus::fn::FnMut<::sus::fn::NonVoid(B, Item)> F, int&...,
+            class R = std::invoke_result_t<F&, B&&, Item&&>>
+    requires(::sus::ops::Try<R> &&
+             std::convertible_to<typename ::sus::ops::TryImpl<R>::Output, B>)
+  constexpr R try_fold(B init, F f) noexcept {
+    skip_front();
+    return next_iter_.try_fold(::sus::move(init), ::sus::move(f));
+  }
+
+  /// sus::iter::TrustedLen trait.
+  ///
+  /// An `ExactSizeIterator` has at most `usize::MAX` items, so skipping some of
+  /// them leaves a length that is known exactly.
+  constexpr ::sus::iter::__private::TrustedLenMarker trusted_len()
+      const noexcept
+    requires(TrustedLen<InnerSizedIter> &&
+             ExactSizeIterator<InnerSizedIter, Item>)
+  {
+    return {};
+  }
+
  private:
   template <class U, class V>
   friend class IteratorBase;
@@ -85,6 +119,13 @@ class [[nodiscard]] Skip final
   explicit constexpr Skip(usize n, InnerSizedIter&& next_iter) noexcept
       : skip_(n), next_iter_(::sus::move(next_iter)) {}
 
+  constexpr void skip_front() noexcept {
+    while (skip_ > 0u) {
+      next_iter_.next();
+      skip_ -= 1u;
+    }
+  }
+
   usize skip_;
   InnerSizedIter next_iter_;
 
@@ -16,6 +16,7 @@
 // IWYU pragma: friend "sus/.*"
 #pragma once
 
+#include "sus/iter/__private/fold.h"
 #include "sus/iter/iterator_defn.h"
 #include "sus/mem/move.h"
 #include "sus/mem/relocate.h"
@@ -79,6 +80,68 @@ class [[nodiscard]] StepBy final
     }
   }
 
+  /// Folds every `step`-th item, which are found with the inner iterator's
+  /// `nth()`.
+  template <class B, ::sus::fn::FnMut<::sus::fn::NonVoid(B, Item)> F>
+    requires(std::convertible_to<std::invoke_result_t<F&, B &&, Item &&>, B> &&
+             (!std::is_reference_v<B> ||
+              std::is_reference_v<std::invoke_result_t<F&, B &&, Item &&>>))
+  constexpr B fold(B init, F f) && noexcept {
+    if constexpr (std::is_reference_v<B>) {
+      return __private::fold_through_pointer<B, Item>(::sus::move(*this), init,
+                                                      f);
+    } else {
+      if (first_take_) {
+        first_take_ = false;
+        Option<Item> first = next_iter_.next();
+        if (first.is_none()) return init;
+        // SAFETY: `first` was checked to hold Some already.
+        init = ::sus::fn::call_mut(
+            f, ::sus::move(init),
+            ::sus::move(first).unwrap_unchecked(::sus::marker::unsafe_fn));
+      }
+      while (true) {
+        Option<Item> o = next_iter_.nth(step_);
+        if (o.is_none()) return init;
+        // SAFETY: `o` was checked to hold Some already.
+        init = ::sus::fn::call_mut(
+            f, ::sus::move(init),
+            ::sus::move(o).unwrap_unchecked(::sus::marker::unsafe_fn));
+      }
+    }
+  }
+
+  /// Folds every `step`-th item, which are found with the inner iterator's
+  /// `nth()`, until `f` returns a failure.
+  template <class B, ::sus::fn::FnMut<::sus::fn::NonVoid(B, Item)> F, int&...,
+            class R = std::invoke_result_t<F&, B&&, Item&&>>
+    requires(::sus::ops::Try<R> &&
+             std::convertible_to<typename ::sus::ops::TryImpl<R>::Output, B>)
+  constexpr R try_fold(B init, F f) noexcept {
+    if (first_take_) {
+      first_take_ = false;
+      Option<Item> first = next_iter_.next();
+      if (first.is_none())
+        return ::sus::ops::try_from_output<R>(::sus::move(init));
+      // SAFETY: `first` was checked to hold Some already.
+      R out = ::sus::fn::call_mut(
+          f, ::sus::move(init),
+          ::sus::move(first).unwrap_unchecked(::sus::marker::unsafe_fn));
+      if (!::sus::ops::try_is_success(out)) return out;
+      init = ::sus::ops::try_into_output(::sus::move(out));
+    }
+    while (true) {
+      Option<Item> o = next_iter_.nth(step_);
+      if (o.is_none()) return ::sus::ops::try_from_output<R>(::sus::move(init));
+      // SAFETY: `o` was checked to hold Some already.
+      R out = ::sus::fn::call_mut(
+          f, ::sus::move(init),
+          ::sus::move(o).unwrap_unchecked(::sus::marker::unsafe_fn));
+      if (!::sus::ops::try_is_success(out)) return out;
+      init = ::sus::ops::try_into_output(::sus::move(out));
+    }
+  }
+
   // sus::iter::DoubleEndedIterator trait.
   constexpr Option<Item> next_back() noexcept
     requires(DoubleEndedIterator<InnerSizedIter, Item> &&  //
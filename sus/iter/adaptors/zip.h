@@ -16,7 +16,10 @@
 // IWYU pragma: friend "sus/.*"
 #pragma once
 
+#include <utility>
+
 #include "sus/fn/fn_concepts.h"
+#include "sus/iter/__private/fold.h"
 #include "sus/iter/iterator_defn.h"
 #include "sus/mem/move.h"
 #include "sus/mem/relocate.h"
@@ -46,6 +49,26 @@ inline constexpr Option<TupleItem> nexts(auto& iters, T&&... args) {
   }
 }
 
+/// Returns the next item of each iterator in `iters`, which must not be at
+/// their end.
+template <class TupleItem, size_t... Is>
+inline constexpr TupleItem nexts_unchecked(::sus::marker::UnsafeFnMarker,
+                                           auto& iters,
+                                           std::index_sequence<Is...>) {
+  return TupleItem(iters.template at_mut<Is>().next().unwrap_unchecked(
+      ::sus::marker::unsafe_fn)...);
+}
+
+/// Returns the item at position `i` of each iterator in `iters`, which must
+/// all be `TrustedRandomAccess` with more than `i` items left.
+template <class TupleItem, size_t... Is>
+inline constexpr TupleItem gets_unchecked(::sus::marker::UnsafeFnMarker,
+                                          auto& iters, usize i,
+                                          std::index_sequence<Is...>) {
+  return TupleItem(iters.template at_mut<Is>().get_unchecked(
+      ::sus::marker::unsafe_fn, i)...);
+}
+
 template <size_t I, size_t N>
 inline constexpr SizeHint size_hints(auto& iters) noexcept {
   if constexpr (I == N - 1) {
@@ -88,6 +111,10 @@ template <class... InnerSizedIters>
 class [[nodiscard]] Zip final
     : public IteratorBase<Zip<InnerSizedIters...>,
                           sus::Tuple<__private::GetItem<InnerSizedIters>...>> {
+  // Whether the items can be produced by their position in every iterator.
+  static constexpr bool kTrustedRandomAccess =
+      (... && __private::TrustedRandomAccess<InnerSizedIters>);
+
  public:
   using Item = sus::Tuple<__private::GetItem<InnerSizedIters>...>;
 
@@ -104,7 +131,16 @@ class [[nodiscard]] Zip final
 
   // sus::iter::Iterator trait.
   constexpr Option<Item> next() noexcept {
-    return __private::nexts<Item, sizeof...(InnerSizedIters)>(iters_);
+    if constexpr (kTrustedRandomAccess) {
+      if (exact_size_hint() == 0u) return Option<Item>();
+      // SAFETY: Every iterator has at least one item left, and the front of
+      // each is moved past it right after.
+      Option<Item> out(get_unchecked(::sus::marker::unsafe_fn, 0u));
+      advance_unchecked(::sus::marker::unsafe_fn, 1u);
+      return out;
+    } else {
+      return __private::nexts<Item, sizeof...(InnerSizedIters)>(iters_);
+    }
   }
   /// sus::iter::Iterator trait.
   constexpr SizeHint size_hint() const noexcept {
@@ -128,6 +164,106 @@ class [[nodiscard]] Zip final
     return {};
   }
 
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr Item get_unchecked(::sus::marker::UnsafeFnMarker,
+                               usize i) noexcept
+    requires(kTrustedRandomAccess)
+  {
+    return __private::gets_unchecked<Item>(::sus::marker::unsafe_fn, iters_, i,
+                                           kIndices);
+  }
+
+  /// sus::iter::__private::TrustedRandomAccess trait.
+  /// #[doc.hidden]
+  constexpr void advance_unchecked(::sus::marker::UnsafeFnMarker,
+                                   usize n) noexcept
+    requires(kTrustedRandomAccess)
+  {
+    advance_unchecked_impl(n, kIndices);
+  }
+
+  /// When every iterator is `TrustedRandomAccess`, the items are folded by
+  /// their position up to the length of the shortest iterator. Otherwise, when
+  /// every iterator is `TrustedLen`, the number of items is known up front and
+  /// they are folded without checking each iterator for its end.
+  template <class B, ::sus::fn::FnMut<::sus::fn::NonVoid(B, Item)> F>
+    requires(std::convertible_to<std::invoke_result_t<F&, B &&, Item &&>, B> &&
+             (!std::is_reference_v<B> ||
+              std::is_reference_v<std::invoke_result_t<F&, B &&, Item &&>>))
+  constexpr B fold(B init, F f) && noexcept {
+    if constexpr (std::is_reference_v<B>) {
+      return __private::fold_through_pointer<B, Item>(::sus::move(*this), init,
+                                                      f);
+    } else if constexpr (kTrustedRandomAccess) {
+      const usize len = exact_size_hint();
+      for (usize i; i < len; i += 1u) {
+        // SAFETY: `i` is less than the length of every iterator, and each
+        // position is produced once before advancing past all of them.
+        init = ::sus::fn::call_mut(
+            f, ::sus::move(init),
+            get_unchecked(::sus::marker::unsafe_fn, i));
+      }
+      advance_unchecked(::sus::marker::unsafe_fn, len);
+      return init;
+    } else {
+      if constexpr ((... && TrustedLen<InnerSizedIters>)) {
+        // SAFETY: Each iterator has at least `size_hint().lower` items left,
+        // as they are `TrustedLen`.
+        for (usize n = size_hint().lower; n > 0u; n -= 1u) {
+          init = ::sus::fn::call_mut(
+              f, ::sus::move(init),
+              __private::nexts_unchecked<Item>(::sus::marker::unsafe_fn, iters_,
+                                               kIndices));
+        }
+      }
+      // Any items past `usize::MAX` are folded one at a time.
+      return static_cast<IteratorBase<Zip, Item>&&>(*this).fold(
+          ::sus::move(init), ::sus::move(f));
+    }
+  }
+
+  /// Like `fold()`, the items are folded by their position when every
+  /// iterator is `TrustedRandomAccess`, or without checking each iterator for
+  /// its end when every iterator is `TrustedLen`, until `f` returns a
+  /// failure.
+  template <class B, ::sus::fn::FnMut<::sus::fn::NonVoid(B, Item)> F, int&...,
+            class R = std::invoke_result_t<F&, B&&, Item&&>>
+    requires(::sus::ops::Try<R> &&
+             std::convertible_to<typename ::sus::ops::TryImpl<R>::Output, B>)
+  constexpr R try_fold(B init, F f) noexcept {
+    if constexpr (kTrustedRandomAccess) {
+      const usize len = exact_size_hint();
+      for (usize i; i < len; i += 1u) {
+        // SAFETY: `i` is less than the length of every iterator, and each
+        // position is produced once before advancing past all of them.
+        R out = ::sus::fn::call_mut(
+            f, ::sus::move(init), get_unchecked(::sus::marker::unsafe_fn, i));
+        if (!::sus::ops::try_is_success(out)) {
+          advance_unchecked(::sus::marker::unsafe_fn, i + 1u);
+          return out;
+        }
+        init = ::sus::ops::try_into_output(::sus::move(out));
+      }
+      advance_unchecked(::sus::marker::unsafe_fn, len);
+      return ::sus::ops::try_from_output<R>(::sus::move(init));
+    } else if constexpr ((... && TrustedLen<InnerSizedIters>)) {
+      // SAFETY: Each iterator has at least `size_hint().lower` items left,
+      // as they are `TrustedLen`.
+      for (usize n = size_hint().lower; n > 0u; n -= 1u) {
+        R out = ::sus::fn::call_mut(
+            f, ::sus::move(init),
+            __private::nexts_unchecked<Item>(::sus::marker::unsafe_fn, iters_,
+                                             kIndices));
+        if (!::sus::ops::try_is_success(out)) return out;
+        init = ::sus::ops::try_into_output(::sus::move(out));
+      }
+    }
+    // Any items past `usize::MAX` are folded one at a time.
+    return static_cast<IteratorBase<Zip, Item>&>(*this).try_fold(
+        ::sus::move(init), ::sus::move(f));
+  }
+
  private:
   template <class U, class V>
   friend class IteratorBase;
@@ -135,6 +271,16 @@ class [[nodiscard]] Zip final
   explicit constexpr Zip(::sus::Tuple<InnerSizedIters...>&& iters) noexcept
       : iters_(::sus::move(iters)) {}
 
+  static constexpr auto kIndices =
+      std::make_index_sequence<sizeof...(InnerSizedIters)>();
+
+  template <size_t... Is>
+  constexpr void advance_unchecked_impl(usize n,
+                                        std::index_sequence<Is...>) noexcept {
+    (..., iters_.template at_mut<Is>().advance_unchecked(
+              ::sus::marker::unsafe_fn, n));
+  }
+
   ::sus::Tuple<InnerSizedIters...> iters_;
 
   sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn,
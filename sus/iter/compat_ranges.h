@@ -147,6 +147,14 @@ class IteratorOverRange final
     return {};
   }
 
+  /// sus::iter::__private::ContiguousIterator trait.
+  /// #[doc.hidden]
+  constexpr const std::remove_cvref_t<Item>* contiguous_data() const noexcept
+    requires(std::contiguous_iterator<B> && std::sized_sentinel_for<E, B>)
+  {
+    return std::to_address(begin_);
+  }
+
   /// Creates an iterator which moves all of its elements. If the range does not
   /// own its elements, or the elements are used afterward, this can cause use-
   /// after-move and Undefined Behaviour.
@@ -33,4 +33,15 @@ concept Extend =
       { c.extend(::sus::move(iter)) } -> std::same_as<void>;
     };
 
+namespace __private {
+
+/// Reserves space in `c` for `additional` more items that are about to be
+/// added with `extend()`, if the collection supports reserving space.
+template <class Collection, class Usize>
+constexpr void extend_reserve(Collection& c, Usize additional) noexcept {
+  if constexpr (requires { c.reserve(additional); }) c.reserve(additional);
+}
+
+}  // namespace __private
+
 }  // namespace sus::iter
@@ -20,6 +20,7 @@
 #include <type_traits>
 
 #include "sus/lib/__private/forward_decl.h"
+#include "sus/marker/unsafe.h"
 #include "sus/ptr/subclass.h"
 
 namespace sus::iter {
@@ -165,16 +166,65 @@ struct TrustedLenMarker {};
 /// information.
 ///
 /// This is why [`Skip<I>`]($sus::iter::Skip) isn't `TrustedLen`, even
-/// when `I` implements `TrustedLen`.
+/// when `I` implements `TrustedLen`, unless `I` is also an
+/// [`ExactSizeIterator`]($sus::iter::ExactSizeIterator) and thus can't be
+/// longer than [`usize::MAX`]($sus::num::usize::MAX).
 ///
 /// # Safety
 /// This trait must only be implemented when the contract is upheld. Consumers
 /// of this trait must inspect `Iterator::size_hint()`'s upper bound.
-// TODO: Satisfy this concept for our iterator adaptors if the underlying
-// iterator is trusted.
 template <class T>
 concept TrustedLen = requires(const std::remove_cvref_t<T>& t) {
   { t.trusted_len() } -> std::same_as<__private::TrustedLenMarker>;
 };
 
+namespace __private {
+
+/// An iterator over elements that are stored contiguously in memory, which
+/// opts into letting collections copy the remaining elements in a single
+/// operation. The `contiguous_data() const` method returns a pointer to the
+/// remaining elements, and `exact_size_hint()` is the number of them.
+///
+/// Consumers may only copy the elements directly from memory when the element
+/// type is [`TrivialCopy`]($sus::mem::TrivialCopy), as for those types the
+/// copy, clone or move of an element produced by the iterator is the same
+/// as its bytes.
+template <class T>
+concept ContiguousIterator = requires(const std::remove_cvref_t<T>& t) {
+  {
+    t.contiguous_data()
+  } -> std::same_as<
+      const std::remove_cvref_t<typename std::remove_cvref_t<T>::Item>*>;
+  { t.exact_size_hint() };
+};
+
+/// An iterator whose remaining items can be produced by their position,
+/// which lets an adaptor like `Zip` walk over several such iterators with a
+/// single index and no check for the end of each one.
+///
+/// The `get_unchecked(unsafe_fn, i)` method returns the item `i` positions
+/// past the front of the iterator without moving the front, and
+/// `advance_unchecked(unsafe_fn, n)` moves the front past `n` items. The
+/// number of items left is given by `exact_size_hint()`.
+///
+/// # Safety
+/// The position given to `get_unchecked()` must be less than
+/// `exact_size_hint()`, and each position may only be produced once, as it may
+/// move the item out of the iterator. Before the iterator is used in any other
+/// way, it must be advanced past every position that was produced, and
+/// `advance_unchecked()` must not move past the end.
+template <class T>
+concept TrustedRandomAccess =
+    requires(std::remove_cvref_t<T>& t, const std::remove_cvref_t<T>& c) {
+      { c.exact_size_hint() } -> std::same_as<::sus::num::usize>;
+      {
+        t.get_unchecked(::sus::marker::unsafe_fn, c.exact_size_hint())
+      } -> std::same_as<typename std::remove_cvref_t<T>::Item>;
+      {
+        t.advance_unchecked(::sus::marker::unsafe_fn, c.exact_size_hint())
+      } -> std::same_as<void>;
+    };
+
+}  // namespace __private
+
 }  // namespace sus::iter
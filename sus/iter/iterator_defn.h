@@ -22,6 +22,7 @@
 #include "sus/construct/default.h"
 #include "sus/construct/into.h"
 #include "sus/fn/fn.h"
+#include "sus/iter/__private/fold.h"
 #include "sus/iter/__private/is_generator.h"
 #include "sus/iter/__private/iter_compare.h"
 #include "sus/iter/__private/iterator_end.h"
@@ -35,6 +36,7 @@
 #include "sus/macros/__private/compiler_bugs.h"
 #include "sus/mem/addressof.h"
 #include "sus/mem/move.h"
+#include "sus/mem/replace.h"
 #include "sus/mem/size_of.h"
 #include "sus/num/unsigned_integer.h"
 #include "sus/ops/try.h"
@@ -581,6 +583,26 @@ class IteratorBase {
     requires(::sus::cmp::Eq<ItemT, OtherItem>)
   constexpr bool ne(Other&& other) && noexcept;
 
+  /// Advances the iterator and returns an [`Array`]($sus::collections::Array)
+  /// containing the next `N` values.
+  ///
+  /// If there are not enough elements to fill the array then `Err` is
+  /// returned containing a [`Vec`]($sus::collections::Vec) of the remaining
+  /// elements.
+  ///
+  /// The length of the returned `Array` is known at compile time, so loops
+  /// over it have a fixed trip count. When the iterator is `TrustedLen` and
+  /// has at least `N` items left, they are moved into the `Array` without
+  /// checking for the end of the iterator.
+  ///
+  /// Use `cloned()` or `copied()` to convert an iterator of references to
+  /// values first, as an `Array` can not hold references.
+  template <size_t N>
+  constexpr ::sus::result::Result<::sus::collections::Array<ItemT, N>,
+                                  ::sus::collections::Vec<ItemT>>
+  next_chunk() noexcept
+    requires(!std::is_reference_v<ItemT>);
+
   /// Returns the nth element of the iterator.
   ///
   /// Like most indexing operations, the count starts from zero, so `nth(0u)`
@@ -1139,27 +1161,33 @@ class IteratorBase {
 template <class Iter, class Item>
 constexpr bool IteratorBase<Iter, Item>::all(
     ::sus::fn::FnMut<bool(Item)> auto f) noexcept {
-  while (true) {
-    Option<Item> item = as_subclass_mut().next();
-    if (item.is_none()) return true;
-    // SAFETY: `item` was checked to hold Some already.
-    if (!::sus::fn::call_mut(
-            f, ::sus::move(item).unwrap_unchecked(::sus::marker::unsafe_fn)))
-      return false;
-  }
+  // Stops with `None` at the first item that does not satisfy `f`.
+  return as_subclass_mut()
+      .try_fold(__private::FoldUnit(),
+                [&f](__private::FoldUnit u,
+                     Item&& item) -> Option<__private::FoldUnit> {
+                  if (::sus::fn::call_mut(f, ::sus::forward<Item>(item)))
+                    return ::sus::some(u);
+                  else
+                    return ::sus::none();
+                })
+      .is_some();
 }
 
 template <class Iter, class Item>
 constexpr bool IteratorBase<Iter, Item>::any(
     ::sus::fn::FnMut<bool(Item)> auto f) noexcept {
-  while (true) {
-    Option<Item> item = as_subclass_mut().next();
-    if (item.is_none()) return false;
-    // SAFETY: `item` was checked to hold Some already.
-    if (::sus::fn::call_mut(
-            f, ::sus::move(item).unwrap_unchecked(::sus::marker::unsafe_fn)))
-      return true;
-  }
+  // Stops with `None` at the first item that satisfies `f`.
+  return as_subclass_mut()
+      .try_fold(__private::FoldUnit(),
+                [&f](__private::FoldUnit u,
+                     Item&& item) -> Option<__private::FoldUnit> {
+                  if (::sus::fn::call_mut(f, ::sus::forward<Item>(item)))
+                    return ::sus::none();
+                  else
+                    return ::sus::some(u);
+                })
+      .is_none();
 }
 
 template <class Iter, class Item>
@@ -1218,9 +1246,8 @@ Iterator<std::remove_cvref_t<Item>> auto constexpr IteratorBase<
 
 template <class Iter, class Item>
 constexpr ::sus::num::usize IteratorBase<Iter, Item>::count() && noexcept {
-  auto c = 0_usize;
-  while (as_subclass_mut().next().is_some()) c += 1_usize;
-  return c;
+  return static_cast<Iter&&>(*this).fold(
+      0_usize, [](usize c, Item&&) { return c + 1_usize; });
 }
 
 template <class Iter, class Item>
@@ -1345,13 +1372,11 @@ constexpr B IteratorBase<Iter, Item>::fold(B init, F f) && noexcept {
 template <class Iter, class Item>
 template <::sus::fn::FnMut<void(Item&&)> F>
 constexpr void IteratorBase<Iter, Item>::for_each(F f) && noexcept {
-  // TODO: Implement with fold()? Allow fold to take B=void?
-  while (true) {
-    if (Option<Item> o = as_subclass_mut().next(); o.is_none())
-      break;
-    else
-      ::sus::fn::call_mut(f, std::move(o).unwrap());
-  }
+  static_cast<Iter&&>(*this).fold(
+      __private::FoldUnit(), [&f](__private::FoldUnit u, Item&& item) {
+        ::sus::fn::call_mut(f, ::sus::forward<Item>(item));
+        return u;
+      });
 }
 
 template <class Iter, class Item>
@@ -1580,6 +1605,51 @@ constexpr bool IteratorBase<Iter, Item>::ne(Other&& other) && noexcept {
   return !static_cast<Iter&&>(*this).eq(::sus::move(other));
 }
 
+template <class Iter, class Item>
+template <size_t N>
+constexpr ::sus::result::Result<::sus::collections::Array<Item, N>,
+                                ::sus::collections::Vec<Item>>
+IteratorBase<Iter, Item>::next_chunk() noexcept
+  requires(!std::is_reference_v<Item>)
+{
+  using Array = ::sus::collections::Array<Item, N>;
+  using Vec = ::sus::collections::Vec<Item>;
+  using R = ::sus::result::Result<Array, Vec>;
+
+  if constexpr (TrustedLen<Iter>) {
+    if (as_subclass().size_hint().lower >= N) {
+      // SAFETY: The iterator is `TrustedLen`, so it has at least
+      // `size_hint().lower` items left.
+      return R(Array::with_initializer([this]() -> Item {
+        return as_subclass_mut().next().unwrap_unchecked(
+            ::sus::marker::unsafe_fn);
+      }));
+    }
+  }
+
+  auto items = ::sus::collections::Array<Option<Item>, N>();
+  for (usize i; i < N; i += 1u) {
+    Option<Item>& slot = items.get_unchecked_mut(::sus::marker::unsafe_fn, i);
+    slot = as_subclass_mut().next();
+    if (slot.is_none()) {
+      auto rest = Vec::with_capacity(i);
+      for (usize j; j < i; j += 1u) {
+        rest.push(items.get_unchecked_mut(::sus::marker::unsafe_fn, j)
+                      .take()
+                      .unwrap_unchecked(::sus::marker::unsafe_fn));
+      }
+      return R::with_err(::sus::move(rest));
+    }
+  }
+  // SAFETY: Every slot in `items` was filled above.
+  return R(Array::with_initializer([&items, i = 0_usize]() mutable -> Item {
+    return items.get_unchecked_mut(::sus::marker::unsafe_fn,
+                                   ::sus::mem::replace(i, i + 1u))
+        .take()
+        .unwrap_unchecked(::sus::marker::unsafe_fn);
+  }));
+}
+
 template <class Iter, class Item>
 constexpr Option<Item> IteratorBase<Iter, Item>::nth(usize n) noexcept {
   while (true) {
@@ -14,6 +14,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <type_traits>
+
+#include "sus/macros/inline.h"
 #include "sus/marker/unsafe.h"
 #include "sus/mem/relocate.h"
 #include "sus/mem/replace.h"
@@ -22,6 +26,10 @@
 #if defined(SUS_ITERATOR_INVALIDATION)
 static_assert(SUS_ITERATOR_INVALIDATION == 0 || SUS_ITERATOR_INVALIDATION == 1);
 #endif
+#if defined(SUS_ITERATOR_INVALIDATION_ATOMIC)
+static_assert(SUS_ITERATOR_INVALIDATION_ATOMIC == 0 ||
+              SUS_ITERATOR_INVALIDATION_ATOMIC == 1);
+#endif
 
 namespace sus::iter {
 
@@ -29,6 +37,65 @@ struct IterRefCounter;
 
 #if !defined(SUS_ITERATOR_INVALIDATION) || SUS_ITERATOR_INVALIDATION
 
+namespace __private {
+
+/// Access to the count of outstanding iterators on a collection.
+///
+/// A collection that is not being mutated can be iterated from many threads
+/// at once, so by default the count is changed with relaxed atomic operations
+/// at runtime. The count only needs to be exact when the collection is
+/// mutated, and mutation requires exclusive access, which already orders it
+/// with any other thread's use of the collection. Defining
+/// `SUS_ITERATOR_INVALIDATION_ATOMIC` to 0 uses plain operations instead,
+/// which is only correct if collections are never iterated from more than one
+/// thread at a time.
+struct IterCount {
+  using Atomic = std::atomic_ref<size_t>;
+  static_assert(Atomic::required_alignment == alignof(size_t));
+#  if !defined(SUS_ITERATOR_INVALIDATION_ATOMIC) || \
+      SUS_ITERATOR_INVALIDATION_ATOMIC
+  static constexpr bool kAtomic = true;
+#  else
+  static constexpr bool kAtomic = false;
+#  endif
+
+  _sus_always_inline static constexpr void inc(usize& count) noexcept {
+    if constexpr (kAtomic) {
+      if (!std::is_constant_evaluated()) {
+        Atomic(count.primitive_value).fetch_add(1u, std::memory_order_relaxed);
+        return;
+      }
+    }
+    count += 1u;
+  }
+  _sus_always_inline static constexpr void dec(usize& count) noexcept {
+    if constexpr (kAtomic) {
+      if (!std::is_constant_evaluated()) {
+        Atomic(count.primitive_value).fetch_sub(1u, std::memory_order_relaxed);
+        return;
+      }
+    }
+    count -= 1u;
+  }
+  _sus_always_inline static constexpr usize load(usize& count) noexcept {
+    if constexpr (kAtomic) {
+      if (!std::is_constant_evaluated())
+        return Atomic(count.primitive_value).load(std::memory_order_relaxed);
+    }
+    return count;
+  }
+  _sus_always_inline static constexpr usize take(usize& count) noexcept {
+    if constexpr (kAtomic) {
+      if (!std::is_constant_evaluated())
+        return Atomic(count.primitive_value)
+            .exchange(0u, std::memory_order_relaxed);
+    }
+    return ::sus::mem::replace(count, 0u);
+  }
+};
+
+}  // namespace __private
+
 /// An iterator's refcount on the owning collection, preventig mutation while
 /// the iterator is alive.
 struct [[_sus_trivial_abi]] IterRef final {
@@ -60,10 +127,10 @@ struct [[_sus_trivial_abi]] IterRef final {
   constexpr void inc() {
     // TODO: Remove this condition? Some slices have no collection so the
     // iterator doesn't either.
-    if (count_ptr_) *count_ptr_ += 1u;
+    if (count_ptr_) __private::IterCount::inc(*count_ptr_);
   }
   constexpr void dec() {
-    if (count_ptr_) *count_ptr_ -= 1u;
+    if (count_ptr_) __private::IterCount::dec(*count_ptr_);
   }
 
   sus_class_trivially_relocatable(::sus::marker::unsafe_fn,
@@ -104,14 +171,16 @@ struct [[_sus_trivial_abi]] IterRefCounter final {
   }
 
   /// Only valid to be called on owning collections such as Vec.
-  constexpr usize count_from_owner() const noexcept { return count; }
+  constexpr usize count_from_owner() const noexcept {
+    return __private::IterCount::load(count);
+  }
 
   /// Resets self to no ref counts, returning a new IterRefCounter containing
   /// the old ref counts.
   ///
   /// Only valid to be called on owning collections such as Vec.
   constexpr IterRefCounter take_for_owner() & noexcept {
-    return IterRefCounter(FOR_OWNER, ::sus::mem::replace(count, 0u));
+    return IterRefCounter(FOR_OWNER, __private::IterCount::take(count));
   }
   /// Resets self to no pointer to a ref count, returning a new IterRefCounter
   /// containing the old pointetr.
@@ -129,9 +198,9 @@ struct [[_sus_trivial_abi]] IterRefCounter final {
   constexpr IterRefCounter(ForView, usize* ptr) noexcept : count_ptr(ptr) {}
 
   union {
-    /// The `count` member is active in owning collections like `Vec`.
-    // TODO: This needs to be atomic: a container can be iterated on multiple
-    // threads.
+    /// The `count` member is active in owning collections like `Vec`. It is
+    /// accessed through `IterCount` so that a collection can be iterated on
+    /// multiple threads.
     mutable usize count;
     /// The `count_ptr` member is active in view collections like `Slice`. It
     /// points to he owning collection. The presence of a `count_ptr` must also
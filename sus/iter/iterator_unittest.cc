@@ -1816,6 +1816,64 @@ TEST(Iterator, Flatten) {
   );
 }
 
+TEST(Iterator, FlattenArrays) {
+  // Arrays always have the same number of items, so the iterator knows its
+  // length exactly.
+  {
+    auto arrays = sus::Vec<Array<i32, 2>>(Array<i32, 2>(1, 2),  //
+                                          Array<i32, 2>(3, 4),  //
+                                          Array<i32, 2>(5, 6));
+    auto it = sus::move(arrays).into_iter().flatten();
+    static_assert(sus::iter::ExactSizeIterator<decltype(it), i32>);
+    static_assert(sus::iter::TrustedLen<decltype(it)>);
+    EXPECT_EQ(it.size_hint(), sus::iter::SizeHint(6u, sus::some(6u)));
+    EXPECT_EQ(it.next().unwrap(), 1);
+    EXPECT_EQ(it.size_hint(), sus::iter::SizeHint(5u, sus::some(5u)));
+    EXPECT_EQ(it.next_back().unwrap(), 6);
+    EXPECT_EQ(it.exact_size_hint(), 4u);
+    EXPECT_EQ(it.next().unwrap(), 2);
+    EXPECT_EQ(it.next().unwrap(), 3);
+    EXPECT_EQ(it.exact_size_hint(), 2u);
+    EXPECT_EQ(it.next_back().unwrap(), 5);
+    EXPECT_EQ(it.next_back().unwrap(), 4);
+    EXPECT_EQ(it.size_hint(), sus::iter::SizeHint(0u, sus::some(0u)));
+    EXPECT_EQ(it.next(), sus::None);
+  }
+  // Empty arrays.
+  {
+    auto it = sus::Array<Array<i32, 0>, 3>().into_iter().flatten();
+    EXPECT_EQ(it.size_hint(), sus::iter::SizeHint(0u, sus::some(0u)));
+    EXPECT_EQ(it.next(), sus::None);
+  }
+  // Iterables without a fixed length can't be counted before they are reached.
+  {
+    auto vecs = sus::Vec<Vec<i32>>(sus::Vec<i32>(1, 2));
+    auto it = sus::move(vecs).into_iter().flatten();
+    static_assert(!sus::iter::ExactSizeIterator<decltype(it), i32>);
+    static_assert(!sus::iter::TrustedLen<decltype(it)>);
+  }
+  // FlatMap into arrays.
+  {
+    auto it = sus::Array<i32, 3>(1, 2, 3).into_iter().flat_map(
+        [](i32 i) { return Array<i32, 2>(i, i * 10); });
+    static_assert(sus::iter::TrustedLen<decltype(it)>);
+    EXPECT_EQ(it.size_hint(), sus::iter::SizeHint(6u, sus::some(6u)));
+    EXPECT_EQ(it.next().unwrap(), 1);
+    EXPECT_EQ(it.next().unwrap(), 10);
+    EXPECT_EQ(it.exact_size_hint(), 4u);
+  }
+  // Collecting allocates exactly once.
+  {
+    auto v = sus::Array<i32, 4>(1, 2, 3, 4)
+                 .into_iter()
+                 .flat_map([](i32 i) { return Array<i32, 3>(i, i, i); })
+                 .skip(2u)
+                 .collect_vec();
+    EXPECT_EQ(v.len(), 10u);
+    EXPECT_EQ(v.capacity(), 10u);
+  }
+}
+
 TEST(Iterator, FlatMap) {
   struct Integers {
     i32 a;
@@ -2017,6 +2075,114 @@ TEST(Iterator, Fold) {
                     }) == sus::Vec('a', 'b', 'c', 'd', 'e'));
 }
 
+TEST(Iterator, FoldAdaptors) {
+  // Records the order in which items are folded.
+  auto record = [](std::string acc, i32 i) {
+    return fmt::format("{}{}", acc, i);
+  };
+
+  // Chain, with the first iterator partly consumed.
+  {
+    auto it = sus::Array<i32, 3>(1, 2, 3).into_iter().chain(
+        sus::Array<i32, 2>(4, 5).into_iter());
+    EXPECT_EQ(it.next(), sus::some(1));
+    EXPECT_EQ(sus::move(it).fold(std::string(), record), "2345");
+  }
+  // Chain, with the first iterator used up.
+  {
+    auto it = sus::Array<i32, 1>(1).into_iter().chain(
+        sus::Array<i32, 2>(2, 3).into_iter());
+    EXPECT_EQ(it.next(), sus::some(1));
+    EXPECT_EQ(it.next(), sus::some(2));
+    EXPECT_EQ(sus::move(it).fold(std::string(), record), "3");
+  }
+  // Flatten, with iterators in progress at the front and back.
+  {
+    auto vecs = sus::Vec<Vec<i32>>(sus::Vec<i32>(1, 2, 3),  //
+                                   sus::Vec<i32>(),         //
+                                   sus::Vec<i32>(4),        //
+                                   sus::Vec<i32>(5, 6, 7));
+    auto it = sus::move(vecs).into_iter().flatten();
+    EXPECT_EQ(it.next(), sus::some(1));
+    EXPECT_EQ(it.next_back(), sus::some(7));
+    EXPECT_EQ(sus::move(it).fold(std::string(), record), "23456");
+  }
+  // FlatMap.
+  {
+    auto it = sus::Array<i32, 3>(1, 2, 3).into_iter().flat_map(
+        [](i32 i) { return sus::Array<i32, 2>(i, i * 10); });
+    EXPECT_EQ(it.next(), sus::some(1));
+    EXPECT_EQ(sus::move(it).fold(std::string(), record), "10220330");
+  }
+  // Skip.
+  {
+    auto it = sus::Array<i32, 5>(1, 2, 3, 4, 5).into_iter().skip(2u);
+    EXPECT_EQ(sus::move(it).fold(std::string(), record), "345");
+    auto past_end = sus::Array<i32, 2>(1, 2).into_iter().skip(3u);
+    EXPECT_EQ(sus::move(past_end).fold(std::string(), record), "");
+  }
+  // StepBy, before and after the first item is taken.
+  {
+    auto it = sus::Array<i32, 6>(1, 2, 3, 4, 5, 6).into_iter().step_by(2u);
+    EXPECT_EQ(sus::move(it).fold(std::string(), record), "135");
+    auto taken =
+        sus::Array<i32, 7>(1, 2, 3, 4, 5, 6, 7).into_iter().step_by(3u);
+    EXPECT_EQ(taken.next(), sus::some(1));
+    EXPECT_EQ(sus::move(taken).fold(std::string(), record), "47");
+  }
+  // Zip, with `TrustedLen` iterators of different lengths.
+  {
+    auto it = sus::Array<i32, 4>(1, 2, 3, 4).into_iter().zip(
+        sus::Array<i32, 3>(5, 6, 7).into_iter());
+    EXPECT_EQ(it.next(), (sus::some(sus::tuple(1, 5))));
+    auto record_pair = [](std::string acc, sus::Tuple<i32, i32> t) {
+      auto [a, b] = sus::move(t);
+      return fmt::format("{}{}{}", acc, a, b);
+    };
+    EXPECT_EQ(sus::move(it).fold(std::string(), record_pair), "2637");
+  }
+  // Zip, without a `TrustedLen` iterator.
+  {
+    auto it = sus::Array<i32, 4>(1, 2, 3, 4)
+                  .into_iter()
+                  .filter([](const i32& i) { return i % 2 == 0; })
+                  .zip(sus::Array<i32, 3>(5, 6, 7).into_iter());
+    EXPECT_EQ(sus::move(it).count(), 2u);
+  }
+
+  // Folding into a reference.
+  {
+    auto v = sus::Vec<i32>(1, 2, 3);
+    auto w = sus::Vec<i32>(4, 5);
+    i32 init;
+    i32& out = v.iter_mut().chain(w.iter_mut()).fold<i32&>(
+        init, [](i32&, i32& v) -> i32& { return v; });
+    EXPECT_EQ(&out, &w.last().unwrap());
+  }
+
+  // The methods built on fold() use the adaptors' folds.
+  {
+    auto a = sus::Array<i32, 3>(1, 2, 3);
+    auto b = sus::Array<i32, 2>(4, 5);
+    EXPECT_EQ(a.iter().chain(b.iter()).count(), 5u);
+    auto sum = sus::move(a).into_iter().chain(sus::move(b).into_iter()).sum();
+    EXPECT_EQ(sum, 15);
+    auto c = sus::Array<i32, 3>(1, 2, 3)
+                 .into_iter()
+                 .flat_map([](i32 i) { return sus::Array<i32, 2>(i, i); });
+    auto seen = std::string();
+    sus::move(c).for_each([&](i32 i) { seen = fmt::format("{}{}", seen, i); });
+    EXPECT_EQ(seen, "112233");
+  }
+
+  static_assert(sus::Array<i32, 3>(1, 2, 3)
+                    .into_iter()
+                    .chain(sus::Array<i32, 2>(4, 5).into_iter())
+                    .skip(1u)
+                    .fold(0_i32, [](i32 acc, i32 i) { return acc * 10 + i; }) ==
+                2345);
+}
+
 TEST(Iterator, Fold_Example_References) {
   auto v = sus::Vec<i32>(1, 2, 3);
   i32 init;
@@ -2886,6 +3052,33 @@ TEST(Iterator, Ne) {
       sus::Vec<i32>(2, 3, 4).into_iter().ne(sus::Array<i32, 3>(2, 3, 5)));
 }
 
+TEST(Iterator, NextChunk) {
+  {
+    auto it = sus::Vec<i32>(1, 2, 3, 4, 5).into_iter();
+    sus::Array<i32, 2> a = it.next_chunk<2u>().unwrap();
+    EXPECT_EQ(a, (sus::Array<i32, 2>(1, 2)));
+    EXPECT_EQ(it.next_chunk<2u>().unwrap(), (sus::Array<i32, 2>(3, 4)));
+    // Not enough items left, they are returned in the error.
+    EXPECT_EQ(it.next_chunk<2u>().unwrap_err(), sus::Vec<i32>(5));
+    EXPECT_EQ(it.next(), sus::None);
+  }
+  {
+    // Without TrustedLen.
+    auto it = sus::Vec<i32>(1, 2, 3, 4, 5).into_iter().filter(
+        [](const i32& i) { return i != 2; });
+    EXPECT_EQ(it.next_chunk<3u>().unwrap(), (sus::Array<i32, 3>(1, 3, 4)));
+    EXPECT_EQ(it.next_chunk<3u>().unwrap_err(), sus::Vec<i32>(5));
+  }
+  {
+    // Moves the items.
+    auto it = sus::Vec<std::string>(std::string("a"), std::string("b"))
+                  .into_iter();
+    auto a = it.next_chunk<2u>().unwrap();
+    EXPECT_EQ(a[0u], "a");
+    EXPECT_EQ(a[1u], "b");
+  }
+}
+
 TEST(Iterator, Nth) {
   {
     auto it = sus::Array<i32, 0>().into_iter();
@@ -3528,6 +3721,7 @@ TEST(Iterator, Skip) {
     static_assert(sus::iter::Iterator<decltype(it), i32>);
     static_assert(sus::iter::DoubleEndedIterator<decltype(it), i32>);
     static_assert(sus::iter::ExactSizeIterator<decltype(it), i32>);
+    static_assert(sus::iter::TrustedLen<decltype(it)>);
     EXPECT_EQ(it.exact_size_hint(), 3u);
     EXPECT_EQ(it.size_hint(), sus::iter::SizeHint(3u, sus::some(3u)));
 
@@ -4085,6 +4279,75 @@ TEST(Iterator, TryFold) {
                     }) == sus::none());
 }
 
+TEST(Iterator, TryFoldAdaptors) {
+  // Sums items until reaching one that is over 5.
+  auto f = [](i32 acc, i32 i) -> Option<i32> {
+    if (i > 5) return sus::none();
+    return sus::some(acc + i);
+  };
+
+  // Chain stops in the second iterator, and resumes from there.
+  {
+    auto it = sus::Array<i32, 2>(1, 2).into_iter().chain(
+        sus::Array<i32, 3>(3, 6, 4).into_iter());
+    EXPECT_EQ(it.try_fold(0_i32, f), sus::none());
+    EXPECT_EQ(it.try_fold(0_i32, f), sus::some(4));
+    EXPECT_EQ(it.next(), sus::none());
+  }
+  // Flatten stops in an inner iterator, and resumes from there.
+  {
+    auto vecs = sus::Vec<Vec<i32>>(sus::Vec<i32>(1, 2),  //
+                                   sus::Vec<i32>(3, 6, 4),
+                                   sus::Vec<i32>(5));
+    auto it = sus::move(vecs).into_iter().flatten();
+    EXPECT_EQ(it.try_fold(0_i32, f), sus::none());
+    EXPECT_EQ(it.try_fold(0_i32, f), sus::some(4 + 5));
+    EXPECT_EQ(it.next(), sus::none());
+  }
+  // FlatMap, with an iterator in progress at the back.
+  {
+    auto it = sus::Array<i32, 3>(1, 2, 3).into_iter().flat_map(
+        [](i32 i) { return sus::Array<i32, 2>(i, i); });
+    EXPECT_EQ(it.next_back(), sus::some(3));
+    EXPECT_EQ(it.try_fold(0_i32, f), sus::some(1 + 1 + 2 + 2 + 3));
+    EXPECT_EQ(it.next(), sus::none());
+  }
+  // Skip only skips once.
+  {
+    auto it = sus::Array<i32, 5>(1, 7, 2, 3, 4).into_iter().skip(1u);
+    EXPECT_EQ(it.try_fold(0_i32, f), sus::none());
+    EXPECT_EQ(it.try_fold(0_i32, f), sus::some(2 + 3 + 4));
+  }
+  // StepBy.
+  {
+    auto it = sus::Array<i32, 7>(1, 0, 9, 0, 2, 0, 3).into_iter().step_by(2u);
+    EXPECT_EQ(it.try_fold(0_i32, f), sus::none());
+    EXPECT_EQ(it.try_fold(0_i32, f), sus::some(2 + 3));
+  }
+  // Zip.
+  {
+    auto it = sus::Array<i32, 4>(1, 2, 9, 3).into_iter().zip(
+        sus::Array<i32, 4>(1, 1, 1, 1).into_iter());
+    auto g = [](i32 acc, sus::Tuple<i32, i32> t) -> Option<i32> {
+      auto [a, b] = sus::move(t);
+      if (a > 5) return sus::none();
+      return sus::some(acc + a * b);
+    };
+    EXPECT_EQ(it.try_fold(0_i32, g), sus::none());
+    EXPECT_EQ(it.try_fold(0_i32, g), sus::some(3));
+  }
+
+  // The methods built on try_fold() use the adaptors' try_folds.
+  {
+    auto it = sus::Array<i32, 2>(1, 2).into_iter().chain(
+        sus::Array<i32, 3>(3, 4, 5).into_iter());
+    EXPECT_TRUE(it.any([](i32 i) { return i == 3; }));
+    EXPECT_EQ(it.next(), sus::some(4));
+    EXPECT_TRUE(it.all([](i32 i) { return i == 5; }));
+    EXPECT_EQ(it.next(), sus::none());
+  }
+}
+
 TEST(Iterator, TryRfold) {
   // With Option.
   {
@@ -4237,6 +4500,9 @@ TEST(Iterator, Unzip) {
     static_assert(std::same_as<decltype(u), Tuple<Vec<i32>, Vec<f32>>>);
     EXPECT_EQ(u.at<0>(), sus::Slice<i32>::from({1, 2, 3, 4, 5}));
     EXPECT_EQ(u.at<1>(), sus::Slice<f32>::from({2.f, 3.f, 4.f, 5.f, 6.f}));
+    // Each collection reserved space for all the items at once.
+    EXPECT_EQ(u.at<0>().capacity(), 5u);
+    EXPECT_EQ(u.at<1>().capacity(), 5u);
   }
 
   static_assert(sus::Array<Tuple<i32, f32>, 5>(::sus::tuple(1, 2.f),  //
@@ -4359,6 +4625,71 @@ TEST(Iterator, Zip) {
           .sum() == 2 + 3);
 }
 
+TEST(Iterator, ZipTrustedRandomAccess) {
+  using sus::iter::__private::TrustedRandomAccess;
+  static_assert(TrustedRandomAccess<sus::collections::SliceIter<const i32&>>);
+  static_assert(TrustedRandomAccess<sus::collections::SliceIterMut<i32&>>);
+  static_assert(TrustedRandomAccess<sus::collections::ArrayIntoIter<i32, 2>>);
+  static_assert(TrustedRandomAccess<sus::collections::VecIntoIter<i32>>);
+  static_assert(TrustedRandomAccess<sus::collections::ChunksExact<i32>>);
+  static_assert(TrustedRandomAccess<sus::collections::ChunksExactMut<i32>>);
+  static_assert(!TrustedRandomAccess<sus::collections::Chunks<i32>>);
+  // A Zip of random access iterators is random access too.
+  static_assert(TrustedRandomAccess<
+                sus::iter::Zip<sus::collections::SliceIter<const i32&>,
+                               sus::collections::ChunksExact<i32>>>);
+
+  // Iterating by position stops at the end of the shortest iterator.
+  {
+    auto a = sus::Vec<i32>(1, 2, 3, 4);
+    auto b = sus::Vec<i32>(5, 6, 7);
+    auto it = sus::iter::zip(a.iter(), b.iter());
+    EXPECT_EQ(it.exact_size_hint(), 3u);
+    auto [x, y] = it.next().unwrap();
+    EXPECT_EQ(x, 1);
+    EXPECT_EQ(y, 5);
+    EXPECT_EQ(it.exact_size_hint(), 2u);
+    auto dot = sus::move(it).fold(0_i32, [](i32 acc, auto pair) {
+      auto [x, y] = pair;
+      return acc + x * y;
+    });
+    EXPECT_EQ(dot, 2 * 6 + 3 * 7);
+  }
+  // Chunks by position.
+  {
+    auto a = sus::Vec<i32>(1, 2, 3, 4, 5, 6, 7);
+    auto b = sus::Vec<i32>(1, 2, 3, 4, 0, 6);
+    auto it = sus::iter::zip(a.chunks_exact(2u), b.chunks_exact(2u));
+    EXPECT_EQ(it.exact_size_hint(), 3u);
+    auto count_equal = [](usize n, auto chunks) -> Option<usize> {
+      auto [x, y] = chunks;
+      if (x != y) return sus::none();
+      return sus::some(n + 1u);
+    };
+    EXPECT_EQ(it.try_fold(0_usize, count_equal), sus::none());
+    // The failed chunk was consumed, and iteration resumes after it.
+    EXPECT_EQ(it.exact_size_hint(), 0u);
+    EXPECT_EQ(it.next(), sus::none());
+  }
+  // Moving items out by position.
+  {
+    auto a = sus::Vec<std::string>(std::string("a"), std::string("b"),
+                                   std::string("c"));
+    auto b = sus::Array<i32, 3>(1, 2, 3);
+    auto it =
+        sus::iter::zip(sus::move(a).into_iter(), sus::move(b).into_iter());
+    auto [x, y] = it.next().unwrap();
+    EXPECT_EQ(x, "a");
+    EXPECT_EQ(y, 1);
+    auto joined =
+        sus::move(it).fold(std::string(), [](std::string acc, auto pair) {
+          auto [x, y] = sus::move(pair);
+          return fmt::format("{}{}{}", acc, x, y);
+        });
+    EXPECT_EQ(joined, "b2c3");
+  }
+}
+
 TEST(Iterator, Zip_Example) {
   auto a = sus::Array<i32, 2>(2, 3);
   auto b = sus::Array<f32, 5>(3.f, 4.f, 5.f, 6.f, 7.f);
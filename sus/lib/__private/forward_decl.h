@@ -19,6 +19,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <memory>
 #include <type_traits>
 
 // Forward declarations of all types that ever need a forward declaration.
@@ -40,6 +41,32 @@ template <class T, size_t N>
 struct ArrayIntoIter;
 }
 
+namespace sus::hash {
+class DefaultHasher;
+}
+
+namespace sus::hash {
+template <class H = DefaultHasher>
+struct BuildHasherDefault;
+}
+
+namespace sus::collections {
+template <class K, class V,
+          class S = ::sus::hash::BuildHasherDefault<::sus::hash::DefaultHasher>>
+class HashMap;
+}
+
+namespace sus::collections {
+template <class K, class V, class S>
+class HashMapEntry;
+}
+
+namespace sus::collections {
+template <class T,
+          class S = ::sus::hash::BuildHasherDefault<::sus::hash::DefaultHasher>>
+class HashSet;
+}
+
 namespace sus::collections {
 template <class T>
 class Slice;
@@ -50,6 +77,11 @@ template <class T>
 class SliceMut;
 }
 
+namespace sus::collections {
+template <class T, size_t N>
+class SmallVec;
+}
+
 namespace sus::collections {
 template <class T>
 struct SliceIter;
@@ -61,12 +93,33 @@ struct SliceIterMut;
 }
 
 namespace sus::collections {
-template <class T>
+template <class T, class A = std::allocator<T>>
 class Vec;
 }
 
 namespace sus::collections {
 template <class T>
+class VecDeque;
+}
+
+namespace sus::collections {
+template <class T, size_t D = 2u>
+class DaryHeap;
+}
+
+namespace sus::collections {
+class BitVec;
+template <size_t N>
+class BitSet;
+}
+
+namespace sus::collections {
+template <class T>
+class SlotMap;
+}
+
+namespace sus::collections {
+template <class T, class A = std::allocator<T>>
 struct VecIntoIter;
 }
 
@@ -0,0 +1,69 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <concepts>
+#include <memory>
+
+namespace sus::mem {
+
+/// A type that can allocate and deallocate storage for objects of type `T`
+/// for use in a collection.
+///
+/// The concept is satisfied by types that meet the [C++ Allocator](
+/// https://en.cppreference.com/w/cpp/named_req/Allocator) requirements
+/// through [`std::allocator_traits`](
+/// https://en.cppreference.com/w/cpp/memory/allocator_traits), such as
+/// [`std::allocator<T>`](https://en.cppreference.com/w/cpp/memory/allocator),
+/// [`ArenaAllocator<T>`]($sus::mem::ArenaAllocator) and
+/// [`PoolAllocator<T>`]($sus::mem::PoolAllocator).
+///
+/// Allocators are handles, and must be cheap to copy. Two allocators compare
+/// equal if storage allocated by one can be deallocated by the other.
+///
+/// An allocator can also satisfy
+/// [`GrowInPlaceAllocator`]($sus::mem::GrowInPlaceAllocator) to let
+/// collections extend their storage without moving it.
+template <class A, class T>
+concept Allocator =
+    std::same_as<typename A::value_type, T> &&  //
+    std::copy_constructible<A> &&               //
+    std::equality_comparable<A> &&              //
+    requires(A& a, T* p, size_t n) {
+      { std::allocator_traits<A>::allocate(a, n) } -> std::same_as<T*>;
+      { std::allocator_traits<A>::deallocate(a, p, n) };
+    };
+
+/// An [`Allocator`]($sus::mem::Allocator) that can try to extend an
+/// allocation without moving it.
+///
+/// The call `a.grow_in_place(p, n, new_n)` receives storage `p` for `n`
+/// objects that was allocated from `a`. It returns true if the storage at `p`
+/// was extended to hold `new_n` objects, after which it must be deallocated
+/// with `new_n` as its size. Otherwise it returns false and the storage is
+/// unchanged.
+///
+/// Collections use this when growing storage of
+/// [`TriviallyRelocatable`]($sus::mem::TriviallyRelocatable) types, to avoid
+/// copying their contents to a new allocation.
+template <class A, class T>
+concept GrowInPlaceAllocator =
+    Allocator<A, T> && requires(A& a, T* p, size_t n) {
+      { a.grow_in_place(p, n, n) } -> std::same_as<bool>;
+    };
+
+}  // namespace sus::mem
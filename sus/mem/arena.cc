@@ -0,0 +1,165 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/mem/arena.h"
+
+#include <stdint.h>
+
+#include <new>
+
+#include "sus/assertions/check.h"
+#include "sus/assertions/debug_check.h"
+#include "sus/cmp/ord.h"
+#include "sus/num/types.h"
+#include "sus/result/result.h"
+
+namespace sus::mem {
+
+/// The header at the front of each chunk of memory owned by an `Arena`. The
+/// usable memory follows directly after it.
+struct Arena::Chunk {
+  Chunk* prev;
+  usize size;
+
+  char* begin() noexcept { return reinterpret_cast<char*>(this + 1); }
+  char* end() noexcept { return begin() + size; }
+};
+
+namespace {
+
+char* align_up(char* p, usize align) noexcept {
+  const uintptr_t mask = align.primitive_value - 1u;
+  return reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(p) + mask) &
+                                 ~mask);
+}
+
+}  // namespace
+
+Arena::Arena(usize chunk_size) noexcept
+    : chunk_size_(chunk_size), live_(0u), capacity_(0u) {
+  sus_check(chunk_size > 0u);
+}
+
+Arena::~Arena() noexcept {
+  sus_check_with_message(live_ == 0u,
+                         "Arena destroyed with live allocations");
+  while (current_ != nullptr) {
+    Chunk* prev = current_->prev;
+    ::operator delete(current_);
+    current_ = prev;
+  }
+}
+
+void* Arena::allocate(usize size, usize align) noexcept {
+  sus_check(align.is_power_of_two());
+  char* const p = align_up(cursor_, align);
+  // `cursor_` and `end_` are both null before the first chunk is allocated, in
+  // which case `p` is null too and we fall through to the slow path.
+  if (p != nullptr && p <= end_ &&
+      size <= usize::try_from(end_ - p).unwrap()) {
+    cursor_ = p + size;
+    live_ += 1u;
+    return p;
+  }
+  return allocate_slow(size, align);
+}
+
+void* Arena::allocate_slow(usize size, usize align) noexcept {
+  // The chunk header is aligned to `max_align_t`, so over-aligned requests
+  // need room to pad the start of the allocation.
+  const usize padding =
+      align > alignof(max_align_t) ? align - alignof(max_align_t) : 0u;
+  const usize needed = size.checked_add(padding).expect("overflow");
+  const usize chunk_size = ::sus::cmp::max(needed, chunk_size_);
+  const usize alloc_size =
+      chunk_size.checked_add(sizeof(Chunk)).expect("overflow");
+  void* raw = ::operator new(alloc_size.primitive_value);
+  auto* chunk = static_cast<Chunk*>(raw);
+  chunk->prev = current_;
+  chunk->size = chunk_size;
+  capacity_ += chunk_size;
+
+  // Stay in the current chunk if the new chunk is only for a single large
+  // allocation and the current chunk has more room left in it.
+  char* const p = align_up(chunk->begin(), align);
+  const usize new_room = usize::try_from(chunk->end() - (p + size)).unwrap();
+  const usize old_room =
+      current_ != nullptr ? usize::try_from(end_ - cursor_).unwrap() : 0u;
+  if (current_ != nullptr && new_room < old_room) {
+    // Insert the new chunk behind the current one, so it's owned and freed
+    // with the others.
+    chunk->prev = current_->prev;
+    current_->prev = chunk;
+  } else {
+    current_ = chunk;
+    cursor_ = p + size;
+    end_ = chunk->end();
+  }
+  live_ += 1u;
+  return p;
+}
+
+void Arena::deallocate(void* ptr, usize size) noexcept {
+  sus_debug_check(live_ > 0u);
+  live_ -= 1u;
+  // Give the memory back if it's the most recent allocation, which allows for
+  // reuse in a LIFO pattern, such as when a Vec grows.
+  if (static_cast<char*>(ptr) + size == cursor_) {
+    cursor_ = static_cast<char*>(ptr);
+  }
+  if (live_ == 0u && current_ != nullptr) {
+    // Nothing is live, so the whole current chunk can be reused.
+    cursor_ = current_->begin();
+  }
+}
+
+bool Arena::grow_in_place(void* ptr, usize size, usize new_size) noexcept {
+  char* const p = static_cast<char*>(ptr);
+  if (p + size != cursor_) return false;
+  if (new_size < size) return false;
+  if (new_size - size > usize::try_from(end_ - cursor_).unwrap()) return false;
+  cursor_ = p + new_size;
+  return true;
+}
+
+void Arena::reset() noexcept {
+  sus_check_with_message(live_ == 0u, "Arena reset with live allocations");
+  // Keep the largest chunk, and release the rest.
+  Chunk* keep = nullptr;
+  while (current_ != nullptr) {
+    Chunk* prev = current_->prev;
+    if (keep == nullptr || current_->size > keep->size) {
+      if (keep != nullptr) {
+        capacity_ -= keep->size;
+        ::operator delete(keep);
+      }
+      keep = current_;
+    } else {
+      capacity_ -= current_->size;
+      ::operator delete(current_);
+    }
+    current_ = prev;
+  }
+  current_ = keep;
+  if (keep != nullptr) {
+    keep->prev = nullptr;
+    cursor_ = keep->begin();
+    end_ = keep->end();
+  } else {
+    cursor_ = nullptr;
+    end_ = nullptr;
+  }
+}
+
+}  // namespace sus::mem
@@ -0,0 +1,232 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <type_traits>
+
+#include "sus/macros/lifetimebound.h"
+#include "sus/macros/pure.h"
+#include "sus/mem/size_of.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+
+namespace sus::mem {
+
+/// A bump allocator which hands out memory from large chunks, and releases it
+/// all at once.
+///
+/// Allocating from an `Arena` is a pointer increment in the common case, and
+/// deallocation is free. Memory is returned to the system when the `Arena` is
+/// destroyed, or reused when it is [`reset`]($sus::mem::Arena::reset). This
+/// makes it a good fit for many short-lived allocations that share a lifetime,
+/// such as the collections built while handling a single request.
+///
+/// When the most recent allocation is deallocated, its memory is given back to
+/// the arena, so a collection that grows by reallocating does not leave a trail
+/// of dead buffers behind it.
+///
+/// Collections use an `Arena` through an
+/// [`ArenaAllocator`]($sus::mem::ArenaAllocator), which is a handle that
+/// refers to the `Arena`, such as with `Vec<T, ArenaAllocator<T>>`.
+///
+/// An `Arena` can not be moved or copied, as allocators refer to it by
+/// address. It is not thread-safe.
+///
+/// # Panics
+/// The `Arena` tracks the number of live allocations made from it. Destroying
+/// or resetting an `Arena` while any allocation is still live will panic, as
+/// those allocations would be left dangling.
+class Arena final {
+ public:
+  /// Constructs an `Arena` which allocates chunks of memory with the default
+  /// chunk size.
+  ///
+  /// No memory is allocated until the first allocation is made from the
+  /// `Arena`.
+  Arena() noexcept : Arena(kDefaultChunkSize) {}
+
+  /// Constructs an `Arena` which allocates chunks of memory with a size of at
+  /// least `chunk_size` bytes.
+  ///
+  /// Allocations larger than the chunk size are given their own chunk.
+  static Arena with_chunk_size(usize chunk_size) noexcept {
+    return Arena(chunk_size);
+  }
+
+  ~Arena() noexcept;
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  /// Allocates `size` bytes with an alignment of `align`.
+  ///
+  /// The returned memory is uninitialized.
+  ///
+  /// # Panics
+  /// Panics if `align` is not a power of two, or if the size of the allocation
+  /// overflows.
+  void* allocate(usize size, usize align) noexcept;
+
+  /// Returns memory back to the `Arena` that was allocated with `allocate()`.
+  ///
+  /// If `ptr` is the most recent allocation from the `Arena`, its bytes will be
+  /// reused by the next allocation. Otherwise the memory is not reused until
+  /// the `Arena` is reset.
+  ///
+  /// # Safety
+  /// The `ptr` must have been returned from `allocate()` on this `Arena` with
+  /// the same `size`, and must not have been deallocated already.
+  void deallocate(void* ptr, usize size) noexcept;
+
+  /// Tries to extend the allocation at `ptr` from `size` bytes to `new_size`
+  /// bytes without moving it, and returns whether it succeeded.
+  ///
+  /// This succeeds when `ptr` is the most recent allocation from the `Arena`
+  /// and there is room left in its chunk.
+  ///
+  /// # Safety
+  /// The `ptr` must have been returned from `allocate()` on this `Arena` with
+  /// the same `size`, and must not have been deallocated already.
+  bool grow_in_place(void* ptr, usize size, usize new_size) noexcept;
+
+  /// Releases all allocations from the arena so that their memory can be
+  /// reused. The largest chunk is kept for reuse, and the others are returned
+  /// to the system.
+  ///
+  /// # Panics
+  /// Panics if there are any live allocations made from the `Arena`.
+  void reset() noexcept;
+
+  /// The number of allocations from the `Arena` that have not been
+  /// deallocated.
+  _sus_pure usize live_allocations() const noexcept { return live_; }
+
+  /// The total number of bytes held in chunks by the `Arena`.
+  _sus_pure usize capacity_bytes() const noexcept { return capacity_; }
+
+  /// The chunk size used when constructing an `Arena` with its default
+  /// constructor.
+  static constexpr usize kDefaultChunkSize = 64_usize * 1024_usize;
+
+ private:
+  explicit Arena(usize chunk_size) noexcept;
+
+  struct Chunk;
+
+  /// Allocates a new chunk that can hold at least `size` bytes with `align`
+  /// alignment, makes it current, and allocates from it.
+  void* allocate_slow(usize size, usize align) noexcept;
+
+  usize chunk_size_;
+  /// The most recently allocated chunk, which is where allocations are made.
+  /// Each chunk points to the one allocated before it.
+  Chunk* current_ = nullptr;
+  /// The position in `current_` where the next allocation will begin.
+  char* cursor_ = nullptr;
+  /// The end of the usable memory in `current_`.
+  char* end_ = nullptr;
+  usize live_;
+  usize capacity_;
+};
+
+/// An [`Allocator`]($sus::mem::Allocator) that allocates from an
+/// [`Arena`]($sus::mem::Arena).
+///
+/// The `ArenaAllocator` refers to the `Arena` by pointer, so the `Arena` must
+/// outlive all allocators, and all collections that use them.
+///
+/// The allocator propagates on move assignment, so that a collection
+/// moved-into takes the arena of the collection it is moved from. It does not
+/// propagate on copy assignment, so cloning into an existing collection keeps
+/// its arena.
+///
+/// # Examples
+/// ```
+/// auto arena = sus::mem::Arena();
+/// auto v = sus::Vec<i32, sus::mem::ArenaAllocator<i32>>::with_capacity_in(
+///     4u, sus::mem::ArenaAllocator<i32>(arena));
+/// v.push(1);
+/// sus_check(arena.live_allocations() == 1u);
+/// ```
+template <class T>
+class ArenaAllocator final {
+ public:
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  /// Constructs an `ArenaAllocator` that allocates from `arena`.
+  constexpr ArenaAllocator(Arena& arena sus_lifetimebound) noexcept
+      : arena_(&arena) {}
+
+  /// Converts from an `ArenaAllocator` of another type, which allocates from
+  /// the same `Arena`.
+  template <class U>
+  constexpr ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : arena_(other.arena_) {}
+
+  /// Allocates uninitialized storage for `n` objects of type `T`.
+  ///
+  /// # Panics
+  /// Panics if the size of the allocation in bytes overflows.
+  T* allocate(size_t n) noexcept {
+    const usize bytes =
+        usize(n).checked_mul(::sus::mem::size_of<T>()).expect("overflow");
+    return static_cast<T*>(arena_->allocate(bytes, alignof(T)));
+  }
+
+  /// Deallocates storage for `n` objects of type `T` at `p`, which was
+  /// returned from `allocate(n)`.
+  void deallocate(T* p, size_t n) noexcept {
+    arena_->deallocate(p, usize(n) * ::sus::mem::size_of<T>());
+  }
+
+  /// Tries to extend the storage at `p` from `n` to `new_n` objects of type `T`
+  /// without moving it. Satisfies the
+  /// [`GrowInPlaceAllocator`]($sus::mem::GrowInPlaceAllocator) concept.
+  bool grow_in_place(T* p, size_t n, size_t new_n) noexcept {
+    const usize new_bytes =
+        usize(new_n).checked_mul(::sus::mem::size_of<T>()).expect("overflow");
+    return arena_->grow_in_place(p, usize(n) * ::sus::mem::size_of<T>(),
+                                 new_bytes);
+  }
+
+  /// Returns the `Arena` that the allocator allocates from.
+  _sus_pure constexpr Arena& arena() const noexcept { return *arena_; }
+
+  /// Satisfies the [`Eq`]($sus::cmp::Eq) concept. Allocators are equal if they
+  /// allocate from the same `Arena`.
+  template <class U>
+  friend constexpr bool operator==(const ArenaAllocator& l,
+                                   const ArenaAllocator<U>& r) noexcept {
+    return &l.arena() == &r.arena();
+  }
+  friend constexpr bool operator==(const ArenaAllocator& l,
+                                   const ArenaAllocator& r) noexcept {
+    return l.arena_ == r.arena_;
+  }
+
+ private:
+  template <class U>
+  friend class ArenaAllocator;
+
+  Arena* arena_;
+};
+
+}  // namespace sus::mem
@@ -0,0 +1,163 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/mem/arena.h"
+
+#include <stdint.h>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/collections/vec.h"
+#include "sus/mem/allocator.h"
+#include "sus/prelude.h"
+
+namespace sus::mem {
+namespace {
+
+static_assert(Allocator<ArenaAllocator<i32>, i32>);
+static_assert(!Allocator<ArenaAllocator<i32>, u32>);
+
+TEST(Arena, Allocate) {
+  auto arena = Arena();
+  EXPECT_EQ(arena.capacity_bytes(), 0u);
+
+  void* a = arena.allocate(4u, 4u);
+  void* b = arena.allocate(8u, 8u);
+  EXPECT_EQ(arena.live_allocations(), 2u);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % 4u, 0u);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 8u, 0u);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(arena.capacity_bytes(), Arena::kDefaultChunkSize);
+
+  arena.deallocate(b, 8u);
+  arena.deallocate(a, 4u);
+  EXPECT_EQ(arena.live_allocations(), 0u);
+}
+
+TEST(Arena, LastAllocationIsReused) {
+  auto arena = Arena();
+  void* a = arena.allocate(16u, 8u);
+  void* b = arena.allocate(16u, 8u);
+  arena.deallocate(b, 16u);
+  void* c = arena.allocate(16u, 8u);
+  EXPECT_EQ(b, c);
+  arena.deallocate(c, 16u);
+  arena.deallocate(a, 16u);
+}
+
+TEST(Arena, OverAligned) {
+  auto arena = Arena::with_chunk_size(64u);
+  void* a = arena.allocate(1u, 1u);
+  void* b = arena.allocate(32u, 256u);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 256u, 0u);
+  arena.deallocate(b, 32u);
+  arena.deallocate(a, 1u);
+}
+
+TEST(Arena, LargerThanChunk) {
+  auto arena = Arena::with_chunk_size(64u);
+  void* a = arena.allocate(8u, 8u);
+  void* big = arena.allocate(1024u, 8u);
+  // The current chunk still has room, so small allocations keep using it.
+  void* b = arena.allocate(8u, 8u);
+  EXPECT_EQ(static_cast<char*>(a) + 8u, static_cast<char*>(b));
+  EXPECT_EQ(arena.capacity_bytes(), 64u + 1024u);
+  arena.deallocate(b, 8u);
+  arena.deallocate(big, 1024u);
+  arena.deallocate(a, 8u);
+}
+
+TEST(Arena, Reset) {
+  auto arena = Arena::with_chunk_size(64u);
+  void* a = arena.allocate(48u, 8u);
+  void* b = arena.allocate(48u, 8u);
+  arena.deallocate(a, 48u);
+  arena.deallocate(b, 48u);
+  EXPECT_EQ(arena.capacity_bytes(), 128u);
+  arena.reset();
+  EXPECT_EQ(arena.capacity_bytes(), 64u);
+  void* c = arena.allocate(48u, 8u);
+  arena.deallocate(c, 48u);
+  EXPECT_EQ(arena.capacity_bytes(), 64u);
+}
+
+TEST(Arena, GrowInPlace) {
+  auto arena = Arena::with_chunk_size(64u);
+  void* a = arena.allocate(8u, 8u);
+  void* b = arena.allocate(8u, 8u);
+  // Only the most recent allocation can grow.
+  EXPECT_FALSE(arena.grow_in_place(a, 8u, 16u));
+  EXPECT_TRUE(arena.grow_in_place(b, 8u, 16u));
+  // There's no room left in the chunk.
+  EXPECT_FALSE(arena.grow_in_place(b, 16u, 64u));
+  void* c = arena.allocate(8u, 8u);
+  EXPECT_EQ(static_cast<char*>(b) + 16u, static_cast<char*>(c));
+  arena.deallocate(c, 8u);
+  arena.deallocate(b, 16u);
+  arena.deallocate(a, 8u);
+}
+
+TEST(ArenaDeathTest, ResetWithLiveAllocation) {
+  auto arena = Arena();
+  void* a = arena.allocate(4u, 4u);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(arena.reset(), "");
+#endif
+  arena.deallocate(a, 4u);
+}
+
+TEST(ArenaAllocator, Eq) {
+  auto arena1 = Arena();
+  auto arena2 = Arena();
+  EXPECT_EQ(ArenaAllocator<i32>(arena1), ArenaAllocator<i32>(arena1));
+  EXPECT_NE(ArenaAllocator<i32>(arena1), ArenaAllocator<i32>(arena2));
+  EXPECT_TRUE(ArenaAllocator<i32>(arena1) == ArenaAllocator<u8>(arena1));
+  EXPECT_EQ(&ArenaAllocator<u8>(ArenaAllocator<i32>(arena2)).arena(), &arena2);
+}
+
+TEST(ArenaAllocator, Vec) {
+  auto arena = Arena();
+  {
+    auto v = Vec<i32, ArenaAllocator<i32>>::with_capacity_in(
+        2u, ArenaAllocator<i32>(arena));
+    EXPECT_EQ(arena.live_allocations(), 1u);
+    const i32* const ptr = v.as_ptr();
+    for (i32 i = 0; i < 100; i += 1) v.push(i);
+    EXPECT_EQ(v.len(), 100u);
+    EXPECT_EQ(v[99u], 99);
+    // The storage was the last allocation in the arena, so it grew in place.
+    EXPECT_EQ(v.as_ptr(), ptr);
+    EXPECT_EQ(arena.live_allocations(), 1u);
+
+    auto c = v.clone();
+    EXPECT_EQ(&c.allocator().arena(), &arena);
+    EXPECT_EQ(c, v);
+    EXPECT_EQ(arena.live_allocations(), 2u);
+
+    auto other = Arena();
+    auto m = Vec<i32, ArenaAllocator<i32>>::new_in(ArenaAllocator<i32>(other));
+    m = sus::move(c);
+    // The allocator propagates on move.
+    EXPECT_EQ(&m.allocator().arena(), &arena);
+    EXPECT_EQ(m, Vec<i32>::from(v.as_slice()));
+
+    auto [ptr, len, cap] = sus::move(m).into_raw_parts();
+    auto r = Vec<i32, ArenaAllocator<i32>>::from_raw_parts_in(
+        unsafe_fn, ptr, len, cap, ArenaAllocator<i32>(arena));
+    EXPECT_EQ(r, v);
+  }
+  EXPECT_EQ(arena.live_allocations(), 0u);
+}
+
+}  // namespace
+}  // namespace sus::mem
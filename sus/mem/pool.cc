@@ -0,0 +1,120 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/mem/pool.h"
+
+#include <new>
+
+#include "sus/assertions/check.h"
+#include "sus/assertions/debug_check.h"
+#include "sus/num/types.h"
+#include "sus/result/result.h"
+
+namespace sus::mem {
+
+/// A block on a free list. The link is stored in the block's own memory while
+/// it is not allocated.
+struct Pool::FreeBlock {
+  FreeBlock* next;
+};
+
+/// The header at the front of each slab of memory owned by a `Pool`. The
+/// blocks carved from the slab follow directly after it.
+struct alignas(max_align_t) Pool::Slab {
+  Slab* prev;
+};
+
+namespace {
+
+/// The number of bytes in each slab that is carved into blocks. Every size
+/// class gets at least 4 blocks from a slab.
+constexpr usize kSlabBytes = 64_usize * 1024_usize;
+static_assert(kSlabBytes / Pool::kMaxBlockSize >= 4u);
+
+/// Returns the size class index for an allocation of `size` bytes, where
+/// `size` is at most `Pool::kMaxBlockSize`.
+size_t size_class_of(usize size) noexcept {
+  if (size <= Pool::kMinBlockSize) return 0u;
+  return size_t{(size - 1u).log2() - Pool::kMinBlockSize.log2() + 1u};
+}
+
+usize block_size_of(size_t size_class) noexcept {
+  return Pool::kMinBlockSize << size_class;
+}
+
+bool is_pooled(usize size, usize align) noexcept {
+  return size <= Pool::kMaxBlockSize && align <= alignof(max_align_t);
+}
+
+}  // namespace
+
+Pool::~Pool() noexcept {
+  sus_check_with_message(live_ == 0u, "Pool destroyed with live allocations");
+  while (slabs_ != nullptr) {
+    Slab* prev = slabs_->prev;
+    ::operator delete(slabs_);
+    slabs_ = prev;
+  }
+}
+
+void* Pool::allocate(usize size, usize align) noexcept {
+  sus_check(align.is_power_of_two());
+  live_ += 1u;
+  if (!is_pooled(size, align)) {
+    return ::operator new(size.primitive_value,
+                          std::align_val_t(align.primitive_value));
+  }
+  const size_t size_class = size_class_of(size);
+  if (FreeBlock* block = free_lists_[size_class]; block != nullptr) {
+    free_lists_[size_class] = block->next;
+    return block;
+  }
+  return refill(size_class);
+}
+
+void* Pool::refill(size_t size_class) noexcept {
+  const usize block_size = block_size_of(size_class);
+  void* raw = ::operator new(sizeof(Slab) + kSlabBytes.primitive_value);
+  auto* slab = static_cast<Slab*>(raw);
+  slab->prev = slabs_;
+  slabs_ = slab;
+
+  // Hand out the first block, and thread the rest onto the free list in
+  // address order.
+  char* const first = reinterpret_cast<char*>(slab + 1);
+  const usize count = kSlabBytes / block_size;
+  FreeBlock* head = free_lists_[size_class];
+  for (usize i = count - 1u; i > 0u; i -= 1u) {
+    auto* block = reinterpret_cast<FreeBlock*>(first + i * block_size);
+    block->next = head;
+    head = block;
+  }
+  free_lists_[size_class] = head;
+  return first;
+}
+
+void Pool::deallocate(void* ptr, usize size, usize align) noexcept {
+  sus_debug_check(live_ > 0u);
+  live_ -= 1u;
+  if (!is_pooled(size, align)) {
+    ::operator delete(ptr, std::align_val_t(align.primitive_value));
+    return;
+  }
+  const size_t size_class = size_class_of(size);
+  auto* block = static_cast<FreeBlock*>(ptr);
+  block->next = free_lists_[size_class];
+  free_lists_[size_class] = block;
+}
+
+}  // namespace sus::mem
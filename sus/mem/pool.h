@@ -0,0 +1,168 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <type_traits>
+
+#include "sus/macros/lifetimebound.h"
+#include "sus/macros/pure.h"
+#include "sus/mem/size_of.h"
+#include "sus/num/unsigned_integer.h"
+#include "sus/option/option.h"
+
+namespace sus::mem {
+
+/// A pool of fixed-size blocks grouped into size classes, which recycles
+/// deallocated blocks for future allocations of the same size class.
+///
+/// Each allocation is rounded up to the nearest power of two, starting at
+/// [`kMinBlockSize`]($sus::mem::Pool::kMinBlockSize) bytes, and served from a
+/// free list for that size class. Free lists are refilled by carving a large
+/// slab of memory into blocks. Deallocated blocks are pushed back onto their
+/// free list, so a steady state of allocations and deallocations does not
+/// reach the system allocator at all.
+///
+/// Allocations larger than [`kMaxBlockSize`]($sus::mem::Pool::kMaxBlockSize),
+/// or with an alignment larger than `alignof(max_align_t)`, are passed
+/// through to the global `operator new`.
+///
+/// Collections use a `Pool` through a
+/// [`PoolAllocator`]($sus::mem::PoolAllocator), which is a handle that refers
+/// to the `Pool`, such as with `Vec<T, PoolAllocator<T>>`.
+///
+/// A `Pool` can not be moved or copied, as allocators refer to it by address.
+/// It is not thread-safe.
+///
+/// # Panics
+/// Destroying a `Pool` while any allocation from it is still live will panic,
+/// as those allocations would be left dangling.
+class Pool final {
+ public:
+  /// Constructs an empty `Pool`. No memory is allocated until the first
+  /// allocation is made from the `Pool`.
+  Pool() noexcept = default;
+  ~Pool() noexcept;
+
+  Pool(const Pool&) = delete;
+  Pool& operator=(const Pool&) = delete;
+
+  /// Allocates `size` bytes with an alignment of `align`.
+  ///
+  /// The returned memory is uninitialized.
+  ///
+  /// # Panics
+  /// Panics if `align` is not a power of two.
+  void* allocate(usize size, usize align) noexcept;
+
+  /// Returns memory back to the `Pool` that was allocated with `allocate()`.
+  ///
+  /// # Safety
+  /// The `ptr` must have been returned from `allocate()` on this `Pool` with
+  /// the same `size` and `align`, and must not have been deallocated already.
+  void deallocate(void* ptr, usize size, usize align) noexcept;
+
+  /// The number of allocations from the `Pool` that have not been deallocated.
+  _sus_pure usize live_allocations() const noexcept { return live_; }
+
+  /// The smallest block size, in bytes, handed out by the `Pool`.
+  static constexpr usize kMinBlockSize = 16u;
+  /// The largest block size, in bytes, handed out by the `Pool`. Larger
+  /// allocations go directly to the system allocator.
+  static constexpr usize kMaxBlockSize = 16u * 1024u;
+
+ private:
+  static constexpr size_t kNumSizeClasses = 11u;  // 16 B through 16 KiB.
+
+  struct FreeBlock;
+  struct Slab;
+
+  /// Refills the free list for `size_class` from a new slab and returns a
+  /// block from it.
+  void* refill(size_t size_class) noexcept;
+
+  FreeBlock* free_lists_[kNumSizeClasses] = {};
+  /// The slabs that blocks are carved from. Each slab points to the one
+  /// allocated before it.
+  Slab* slabs_ = nullptr;
+  usize live_;
+};
+
+/// An [`Allocator`]($sus::mem::Allocator) that allocates from a
+/// [`Pool`]($sus::mem::Pool).
+///
+/// The `PoolAllocator` refers to the `Pool` by pointer, so the `Pool` must
+/// outlive all allocators, and all collections that use them.
+///
+/// The allocator propagates on move assignment, so that a collection
+/// moved-into takes the pool of the collection it is moved from. It does not
+/// propagate on copy assignment, so cloning into an existing collection keeps
+/// its pool.
+template <class T>
+class PoolAllocator final {
+ public:
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  /// Constructs a `PoolAllocator` that allocates from `pool`.
+  constexpr PoolAllocator(Pool& pool sus_lifetimebound) noexcept
+      : pool_(&pool) {}
+
+  /// Converts from a `PoolAllocator` of another type, which allocates from
+  /// the same `Pool`.
+  template <class U>
+  constexpr PoolAllocator(const PoolAllocator<U>& other) noexcept
+      : pool_(&other.pool()) {}
+
+  /// Allocates uninitialized storage for `n` objects of type `T`.
+  ///
+  /// # Panics
+  /// Panics if the size of the allocation in bytes overflows.
+  T* allocate(size_t n) noexcept {
+    const usize bytes =
+        usize(n).checked_mul(::sus::mem::size_of<T>()).expect("overflow");
+    return static_cast<T*>(pool_->allocate(bytes, alignof(T)));
+  }
+
+  /// Deallocates storage for `n` objects of type `T` at `p`, which was
+  /// returned from `allocate(n)`.
+  void deallocate(T* p, size_t n) noexcept {
+    pool_->deallocate(p, usize(n) * ::sus::mem::size_of<T>(), alignof(T));
+  }
+
+  /// Returns the `Pool` that the allocator allocates from.
+  _sus_pure constexpr Pool& pool() const noexcept { return *pool_; }
+
+  /// Satisfies the [`Eq`]($sus::cmp::Eq) concept. Allocators are equal if they
+  /// allocate from the same `Pool`.
+  template <class U>
+  friend constexpr bool operator==(const PoolAllocator& l,
+                                   const PoolAllocator<U>& r) noexcept {
+    return &l.pool() == &r.pool();
+  }
+  friend constexpr bool operator==(const PoolAllocator& l,
+                                   const PoolAllocator& r) noexcept {
+    return l.pool_ == r.pool_;
+  }
+
+ private:
+  Pool* pool_;
+};
+
+}  // namespace sus::mem
@@ -0,0 +1,107 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/mem/pool.h"
+
+#include <stdint.h>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/collections/vec.h"
+#include "sus/mem/allocator.h"
+#include "sus/prelude.h"
+
+namespace sus::mem {
+namespace {
+
+static_assert(Allocator<PoolAllocator<i32>, i32>);
+
+TEST(Pool, Allocate) {
+  auto pool = Pool();
+  void* a = pool.allocate(4u, 4u);
+  void* b = pool.allocate(4u, 4u);
+  EXPECT_EQ(pool.live_allocations(), 2u);
+  EXPECT_NE(a, b);
+  // Both are in the smallest size class.
+  EXPECT_EQ(static_cast<char*>(a) + 16u, static_cast<char*>(b));
+  pool.deallocate(a, 4u, 4u);
+  pool.deallocate(b, 4u, 4u);
+  EXPECT_EQ(pool.live_allocations(), 0u);
+}
+
+TEST(Pool, ReusesBlocks) {
+  auto pool = Pool();
+  void* a = pool.allocate(100u, 8u);
+  pool.deallocate(a, 100u, 8u);
+  // A different size in the same size class gets the same block back.
+  void* b = pool.allocate(128u, 8u);
+  EXPECT_EQ(a, b);
+  // A different size class does not.
+  void* c = pool.allocate(129u, 8u);
+  EXPECT_NE(b, c);
+  pool.deallocate(b, 128u, 8u);
+  pool.deallocate(c, 129u, 8u);
+}
+
+TEST(Pool, Alignment) {
+  auto pool = Pool();
+  for (usize size : {1_usize, 16_usize, 24_usize, 1000_usize, 4096_usize}) {
+    void* p = pool.allocate(size, alignof(max_align_t));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % alignof(max_align_t), 0u);
+    pool.deallocate(p, size, alignof(max_align_t));
+  }
+  void* over = pool.allocate(8u, 256u);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(over) % 256u, 0u);
+  pool.deallocate(over, 8u, 256u);
+}
+
+TEST(Pool, Oversize) {
+  auto pool = Pool();
+  void* p = pool.allocate(Pool::kMaxBlockSize + 1u, 8u);
+  EXPECT_EQ(pool.live_allocations(), 1u);
+  pool.deallocate(p, Pool::kMaxBlockSize + 1u, 8u);
+  EXPECT_EQ(pool.live_allocations(), 0u);
+}
+
+TEST(PoolDeathTest, DestroyWithLiveAllocation) {
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(
+      {
+        auto pool = Pool();
+        pool.allocate(4u, 4u);
+      },
+      "");
+#endif
+}
+
+TEST(PoolAllocator, Vec) {
+  auto pool = Pool();
+  {
+    auto v = Vec<i32, PoolAllocator<i32>>::new_in(PoolAllocator<i32>(pool));
+    EXPECT_EQ(pool.live_allocations(), 0u);
+    for (i32 i = 0; i < 1000; i += 1) v.push(i);
+    EXPECT_EQ(pool.live_allocations(), 1u);
+    EXPECT_EQ(v[999u], 999);
+
+    auto c = v.clone();
+    EXPECT_EQ(&c.allocator().pool(), &pool);
+    EXPECT_EQ(pool.live_allocations(), 2u);
+
+    auto it = sus::move(v).into_iter();
+    EXPECT_EQ(it.next().unwrap(), 0);
+  }
+  EXPECT_EQ(pool.live_allocations(), 0u);
+}
+
+}  // namespace
+}  // namespace sus::mem
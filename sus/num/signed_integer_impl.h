@@ -17,6 +17,7 @@
 #pragma once
 
 #include "sus/collections/array.h"
+#include "sus/hash/hash.h"
 #include "sus/num/signed_integer.h"
 #include "sus/ptr/copy.h"
 
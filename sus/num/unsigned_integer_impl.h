@@ -20,6 +20,7 @@
 #include <stdint.h>
 
 #include "sus/collections/array.h"
+#include "sus/hash/hash.h"
 #include "sus/num/unsigned_integer.h"
 #include "sus/option/option.h"
 #include "sus/ptr/copy.h"
@@ -25,6 +25,7 @@
 #include "sus/construct/default.h"
 #include "sus/construct/into.h"
 #include "sus/fn/fn_concepts.h"
+#include "sus/hash/hash.h"
 #include "sus/iter/from_iterator.h"
 #include "sus/iter/into_iterator.h"
 #include "sus/iter/iterator_concept.h"
@@ -2055,8 +2056,23 @@ struct sus::ops::TryImpl<::sus::option::Option<T>> {
   }
 };
 
+// sus::hash::Hash support.
+template <class T>
+  requires(::sus::hash::Hash<T>)
+struct sus::hash::HashImpl<::sus::option::Option<T>> {
+  template <::sus::hash::Hasher H>
+  static constexpr void hash(const ::sus::option::Option<T>& o,
+                             H& state) noexcept {
+    // The discriminant keeps `None` from colliding with `Some` of a value that
+    // writes nothing.
+    state.write_u8(uint8_t{o.is_some()});
+    if (o.is_some()) ::sus::hash::hash_into(o.as_value(), state);
+  }
+};
+
 // std hash support.
 template <class T>
+  requires(requires(const T& t) { std::hash<T>()(t); })
 struct std::hash<::sus::option::Option<T>> {
   auto operator()(const ::sus::option::Option<T>& u) const noexcept {
     if (u.is_some())
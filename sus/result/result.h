@@ -25,6 +25,7 @@
 #include "sus/assertions/unreachable.h"
 #include "sus/cmp/__private/void_concepts.h"
 #include "sus/fn/fn_concepts.h"
+#include "sus/hash/hash.h"
 #include "sus/iter/into_iterator.h"
 #include "sus/iter/iterator_defn.h"
 #include "sus/iter/once.h"
@@ -1092,14 +1093,35 @@ struct sus::iter::FromIteratorImpl<::sus::result::Result<T, E>> {
   }
 };
 
+// sus::hash::Hash support.
+template <class T, class E>
+  requires((std::is_void_v<T> || ::sus::hash::Hash<T>) && ::sus::hash::Hash<E>)
+struct sus::hash::HashImpl<::sus::result::Result<T, E>> {
+  template <::sus::hash::Hasher H>
+  static constexpr void hash(const ::sus::result::Result<T, E>& r,
+                             H& state) noexcept {
+    state.write_u8(uint8_t{r.is_ok()});
+    if (r.is_ok()) {
+      if constexpr (!std::is_void_v<T>)
+        ::sus::hash::hash_into(r.as_value(), state);
+    } else {
+      ::sus::hash::hash_into(r.as_err(), state);
+    }
+  }
+};
+
 // std hash support.
 template <class T, class E>
+  requires(requires(const T& t, const E& e) {
+    std::hash<T>()(t);
+    std::hash<E>()(e);
+  })
 struct std::hash<::sus::result::Result<T, E>> {
   auto operator()(const ::sus::result::Result<T, E>& u) const noexcept {
     if (u.is_ok())
       return std::hash<T>()(u.as_value());
     else
-      return std::hash<T>()(u.as_err());
+      return std::hash<E>()(u.as_err());
   }
 };
 template <class T, class E>
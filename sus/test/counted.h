@@ -0,0 +1,54 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <compare>
+
+#include "sus/mem/relocate.h"
+#include "sus/num/signed_integer.h"
+
+namespace sus::test {
+
+/// Counts how many of its instances are alive, so that tests can check that a
+/// collection destroys each of its elements exactly once.
+///
+/// Tests should set `alive` to 0 before making any instances. The move
+/// constructor and move assignment are user-written, so the type is not
+/// trivially relocatable and collections move it one element at a time.
+struct Counted {
+  static inline i32 alive = 0;
+
+  explicit Counted(i32 v) : v(v) { alive += 1; }
+  Counted(Counted&& o) : v(o.v) { alive += 1; }
+  Counted& operator=(Counted&& o) {
+    v = o.v;
+    return *this;
+  }
+  ~Counted() { alive -= 1; }
+
+  friend bool operator==(const Counted& a, const Counted& b) noexcept {
+    return a.v == b.v;
+  }
+  friend std::strong_ordering operator<=>(const Counted& a,
+                                          const Counted& b) noexcept {
+    return a.v <=> b.v;
+  }
+
+  i32 v;
+};
+
+static_assert(!::sus::mem::TriviallyRelocatable<Counted>);
+
+}  // namespace sus::test
@@ -25,6 +25,7 @@
 #include "sus/cmp/ord.h"
 #include "sus/construct/default.h"
 #include "sus/construct/safe_from_reference.h"
+#include "sus/hash/hash.h"
 #include "sus/iter/extend.h"
 #include "sus/iter/into_iterator.h"
 #include "sus/lib/__private/forward_decl.h"
@@ -363,7 +364,14 @@ class Tuple final {
       ::sus::iter::IntoIterator<Tuple<U, Us...>> auto&& ii) noexcept
     requires(::sus::mem::IsMoveRef<decltype(ii)>)
   {
-    for (Tuple<U, Us...>&& item : ::sus::move(ii).into_iter()) {
+    auto&& it = ::sus::move(ii).into_iter();
+    // Each collection receives one item per tuple, so they can all reserve
+    // space for the iterator's lower bound up front.
+    [this, lower = it.size_hint().lower]<size_t... Is>(
+        std::index_sequence<Is...>) {
+      (..., ::sus::iter::__private::extend_reserve(at_mut<Is>(), lower));
+    }(std::make_index_sequence<1u + sizeof...(Ts)>());
+    for (Tuple<U, Us...>&& item : it) {
       auto f = [this]<size_t... Is>(Tuple<U, Us...>&& item,
                                     std::index_sequence<Is...>) mutable {
         // Alias to avoid packs in the fold expression.
@@ -541,6 +549,25 @@ struct tuple_element<0, ::sus::tuple_type::Tuple<T, Types...>> {
 
 }  // namespace std
 
+// sus::hash::Hash support.
+template <class... Types>
+  requires((::sus::hash::Hash<Types> && ...))
+struct sus::hash::HashImpl<::sus::tuple_type::Tuple<Types...>> {
+  template <::sus::hash::Hasher H>
+  static constexpr void hash(const ::sus::tuple_type::Tuple<Types...>& t,
+                             H& state) noexcept {
+    hash_values(t, state, std::make_index_sequence<sizeof...(Types)>());
+  }
+
+ private:
+  template <size_t... Is, ::sus::hash::Hasher H>
+  _sus_always_inline static constexpr void hash_values(
+      const ::sus::tuple_type::Tuple<Types...>& t, H& state,
+      std::index_sequence<Is...>) noexcept {
+    (..., ::sus::hash::hash_into(t.template at<Is>(), state));
+  }
+};
+
 // fmt support.
 template <class... Types, class Char>
 struct fmt::formatter<::sus::tuple_type::Tuple<Types...>, Char> {